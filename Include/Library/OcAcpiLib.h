@@ -238,6 +238,20 @@ AcpiApplyPatch (
   IN     OC_ACPI_PATCH    *Patch
   );
 
+/**
+  Patch ACPI tables with multiple patches, walking every table once.
+
+  @param Context     ACPI library context.
+  @param Patches     ACPI patches.
+  @param PatchCount  Number of ACPI patches.
+**/
+EFI_STATUS
+AcpiApplyPatches (
+  IN OUT OC_ACPI_CONTEXT  *Context,
+  IN     OC_ACPI_PATCH    *Patches,
+  IN     UINT32           PatchCount
+  );
+
 /**
   Try to load ACPI regions.
 
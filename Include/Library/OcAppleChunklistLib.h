@@ -15,6 +15,8 @@
 
 #include <IndustryStandard/AppleChunklist.h>
 
+#include <Protocol/MpService.h>
+
 #include <Library/OcAppleRamDiskLib.h>
 #include <Library/OcCryptoLib.h>
 
@@ -58,20 +60,24 @@ OcAppleChunklistVerifySignature (
 
 /**
   Verifies the specified data against a chunklist context.
+  Chunks are hashed directly from RAM disk extent memory.
 
-  @param[in] Context            The Context to verify against.
-  @param[in] ExtentTable        A pointer to the RAM disk extent table to be
+  @param[in]  Context           The Context to verify against.
+  @param[in]  ExtentTable       A pointer to the RAM disk extent table to be
                                 verified.
+  @param[in]  MpServices        Optional MP services protocol to distribute
+                                chunks across application processors.
+  @param[out] FailedChunk       Optional index of the first invalid chunk,
+                                or chunk count when all chunks are valid.
 
-  @retval EFI_SUCCESS           The data was verified successfully.
-  @retval EFI_INVALID_PARAMETER One or more parameters are invalid.
-  @retval EFI_END_OF_FILE       The end of Buffer was reached.
-  @retval EFI_COMPROMISED_DATA  The data failed verification.
+  @retval TRUE when all chunks are valid.
 **/
 BOOLEAN
 OcAppleChunklistVerifyData (
   IN OUT OC_APPLE_CHUNKLIST_CONTEXT         *Context,
-  IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+  IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
+  IN     EFI_MP_SERVICES_PROTOCOL           *MpServices OPTIONAL,
+  OUT    UINT64                             *FailedChunk OPTIONAL
   );
 
 #endif // APPLE_CHUNKLIST_LIB_H
@@ -20,16 +20,50 @@
 #include <Library/OcAppleChunklistLib.h>
 #include <Library/OcAppleRamDiskLib.h>
 
+//
+// Default byte budget of decompressed chunk cache.
+//
+#define OC_APPLE_DISK_IMAGE_CHUNK_CACHE_SIZE  (8U * 1024U * 1024U)
+
+//
+// Disk image chunk index entry, sorted by absolute sector.
+//
+typedef struct {
+  UINT64                      SectorNumber;
+  UINT64                      SectorCount;
+  APPLE_DISK_IMAGE_BLOCK_DATA *Block;
+  APPLE_DISK_IMAGE_CHUNK      *Chunk;
+} OC_APPLE_DISK_IMAGE_CHUNK_INDEX;
+
 //
 // Disk image context.
 //
 typedef struct {
     CONST APPLE_RAM_DISK_EXTENT_TABLE *ExtentTable;
+    OC_APPLE_RAM_DISK_INDEX           ExtentIndex;
 
     UINT64                            SectorCount;
 
     UINT32                            BlockCount;
     APPLE_DISK_IMAGE_BLOCK_DATA       **Blocks;
+    //
+    // Chunks of all blocks sorted by absolute sector, and last found chunk.
+    //
+    UINT32                            ChunkCount;
+    UINT32                            LastChunk;
+    OC_APPLE_DISK_IMAGE_CHUNK_INDEX   *Chunks;
+    //
+    // Decompressed chunk cache, most recently used chunk first.
+    //
+    LIST_ENTRY                        ChunkCache;
+    UINTN                             ChunkCacheSize;
+    UINTN                             ChunkCacheBudget;
+    UINT64                            ChunkCacheHits;
+    UINT64                            ChunkCacheMisses;
+    //
+    // MP services for decompressing chunks of large reads in parallel.
+    //
+    EFI_MP_SERVICES_PROTOCOL          *MpServices;
 } OC_APPLE_DISK_IMAGE_CONTEXT;
 
 BOOLEAN
@@ -57,7 +91,8 @@ OcAppleDiskImageFreeFile (
 BOOLEAN
 OcAppleDiskImageVerifyData (
   IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN OUT OC_APPLE_CHUNKLIST_CONTEXT   *ChunklistContext
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT   *ChunklistContext,
+  IN     EFI_MP_SERVICES_PROTOCOL     *MpServices OPTIONAL
   );
 
 BOOLEAN
@@ -68,6 +103,32 @@ OcAppleDiskImageRead (
   OUT VOID                         *Buffer
   );
 
+/**
+  Set decompressed chunk cache byte budget, evicting chunks over it.
+
+  @param[in,out] Context  Disk image context.
+  @param[in]     Budget   Cache size in bytes, 0 disables caching.
+**/
+VOID
+OcAppleDiskImageSetChunkCacheBudget (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Budget
+  );
+
+/**
+  Set MP services used to decompress chunks fully covered by a read
+  request on all processors. Chunks of other reads and chunk types
+  needing memory allocation are still decompressed on the BSP.
+
+  @param[in,out] Context     Disk image context.
+  @param[in]     MpServices  MP services protocol, NULL to disable.
+**/
+VOID
+OcAppleDiskImageSetMpServices (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     EFI_MP_SERVICES_PROTOCOL     *MpServices OPTIONAL
+  );
+
 EFI_HANDLE
 OcAppleDiskImageInstallBlockIo (
   IN  OC_APPLE_DISK_IMAGE_CONTEXT     *Context,
@@ -16,6 +16,7 @@
 #define OC_APPLE_KERNEL_LIB_H
 
 #include <Library/OcMachoLib.h>
+#include <Library/OcStorageLib.h>
 #include <Library/OcXmlLib.h>
 #include <Protocol/SimpleFileSystem.h>
 
@@ -127,6 +128,27 @@ typedef struct {
   // Used for caching prelinked kexts.
   //
   LIST_ENTRY               PrelinkedKexts;
+  //
+  // Open addressing hash index of kext identifiers (PRELINKED_KEXT_INDEX_ENTRY).
+  // Built on first identifier lookup, may be NULL on allocation failure.
+  //
+  VOID                     *KextIndex;
+  //
+  // Number of slots in KextIndex, power of two.
+  //
+  UINT32                   KextIndexSize;
+  //
+  // Number of used slots in KextIndex.
+  //
+  UINT32                   KextIndexCount;
+  //
+  // Set once KextIndex build was attempted, not retried on failure.
+  //
+  BOOLEAN                  KextIndexBuilt;
+  //
+  // Link cache (PRELINKED_LINK_CACHE), NULL unless PrelinkedLinkCacheLoad was called.
+  //
+  VOID                     *LinkCache;
 } PRELINKED_CONTEXT;
 
 //
@@ -320,6 +342,43 @@ PrelinkedInjectKext (
   IN     UINT32             ExecutableSize OPTIONAL
   );
 
+/**
+  Enable link cache for kext injection and load it from storage.
+  Cached links are replayed by PrelinkedInjectKext when the prelinkedkernel,
+  the injected kexts, their order, and the linker are unchanged.
+  Must be called after PrelinkedContextInit and before PrelinkedInjectPrepare.
+
+  @param[in,out] Context   Prelinked context.
+  @param[in]     Storage   Storage to read the cache from.
+  @param[in]     FileName  Cache file path relative to storage root.
+
+  @retval EFI_SUCCESS      Link cache is enabled, even if no valid cache was read.
+  @retval EFI_UNSUPPORTED  Link cache cannot be used, e.g. storage has a vault.
+**/
+RETURN_STATUS
+PrelinkedLinkCacheLoad (
+  IN OUT PRELINKED_CONTEXT   *Context,
+  IN     OC_STORAGE_CONTEXT  *Storage,
+  IN     CONST CHAR16        *FileName
+  );
+
+/**
+  Write link cache with the links performed in this session.
+  Nothing is written when the loaded cache is up to date.
+
+  @param[in,out] Context   Prelinked context.
+  @param[in]     Storage   Storage to write the cache to.
+  @param[in]     FileName  Cache file path relative to storage root.
+
+  @return  EFI_SUCCESS on success.
+**/
+RETURN_STATUS
+PrelinkedLinkCacheSave (
+  IN OUT PRELINKED_CONTEXT   *Context,
+  IN     OC_STORAGE_CONTEXT  *Storage,
+  IN     CONST CHAR16        *FileName
+  );
+
 /**
   Initialize patcher from prelinked context for kext patching.
 
@@ -382,6 +441,26 @@ PatcherApplyGenericPatch (
   IN     PATCHER_GENERIC_PATCH  *Patch
   );
 
+/**
+  Apply multiple generic patches. Patches without a symbol base
+  are applied in a single pass over the binary, others are applied
+  one by one via PatcherApplyGenericPatch.
+
+  @param[in,out] Context         Patcher context.
+  @param[in]     Patches         Patch descriptions.
+  @param[in]     PatchCount      Number of patches.
+  @param[out]    Results         Per-patch application results, optional.
+
+  @return  EFI_SUCCESS when all patches were applied.
+**/
+RETURN_STATUS
+PatcherApplyGenericPatches (
+  IN OUT PATCHER_CONTEXT        *Context,
+  IN     PATCHER_GENERIC_PATCH  *Patches,
+  IN     UINT32                 PatchCount,
+     OUT RETURN_STATUS          *Results  OPTIONAL
+  );
+
 /**
   Block kext from loading.
 
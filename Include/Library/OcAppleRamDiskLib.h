@@ -18,6 +18,29 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Protocol/AppleRamDisk.h>
 #include <Protocol/SimpleFileSystem.h>
 
+/**
+  Maximum amount of extents in an extent table.
+**/
+#define OC_APPLE_RAM_DISK_MAX_EXTENTS \
+  (sizeof (((APPLE_RAM_DISK_EXTENT_TABLE *) 0)->Extents) / sizeof (APPLE_RAM_DISK_EXTENT))
+
+/**
+  Extent lookup index. Offsets[Index] is the RAM disk offset of extent Index,
+  Offsets[ExtentCount] is the total RAM disk size.
+**/
+typedef struct {
+  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable;
+  UINT64                             Offsets[OC_APPLE_RAM_DISK_MAX_EXTENTS + 1];
+} OC_APPLE_RAM_DISK_INDEX;
+
+/**
+  Contiguous piece of RAM disk data.
+**/
+typedef struct {
+  CONST VOID  *Data;
+  UINTN       Size;
+} OC_APPLE_RAM_DISK_SEGMENT;
+
 /**
   Request allocation of Size bytes in extents table.
 
@@ -68,6 +91,43 @@ OcAppleRamDiskWrite (
   IN CONST VOID                         *Buffer
   );
 
+/**
+  Initialise extent lookup index.
+
+  @param[out] Index       Extent index to initialise.
+  @param[in]  ExtentTable Allocated extent table.
+**/
+VOID
+OcAppleRamDiskInitializeIndex (
+  OUT OC_APPLE_RAM_DISK_INDEX            *Index,
+  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+  );
+
+/**
+  Map RAM disk data for read-only access without copying.
+  The range is returned as a list of segments in extent memory.
+  When SegmentCount is not enough to describe the whole range,
+  only its beginning is mapped, and the caller may continue from
+  Offset plus the returned size.
+
+  @param[in]     Index         Extent index.
+  @param[in]     Offset        Offset in RAM disk.
+  @param[in]     Size          Amount of data to map.
+  @param[out]    Segments      Resulting segments.
+  @param[in,out] SegmentCount  Segment capacity on input,
+                               amount of filled segments on output.
+
+  @retval Mapped data size, 0 when Offset is out of range.
+**/
+UINTN
+OcAppleRamDiskMap (
+  IN     CONST OC_APPLE_RAM_DISK_INDEX  *Index,
+  IN     UINT64                         Offset,
+  IN     UINTN                          Size,
+  OUT    OC_APPLE_RAM_DISK_SEGMENT      *Segments,
+  IN OUT UINT32                         *SegmentCount
+  );
+
 /**
   Load file into RAM disk as it is.
 
@@ -117,4 +117,91 @@ DecompressZLIB (
   IN  UINTN        SrcLen
   );
 
+/**
+  Scratch memory size for DecompressZLIBRange to run without
+  memory allocation services, e.g. on application processors.
+**/
+#define OC_INFLATE_SCRATCH_SIZE  (48U * 1024U)
+
+/**
+  Decompress part of ZLIB stream split into several source buffers.
+  Decompressed data before DstOffset is discarded, and decompression
+  stops as soon as DstLen bytes after it are produced.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstOffset   Offset of the requested range in decompressed data.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffers.
+  @param[in]   SrcLen      Source buffer sizes.
+  @param[in]   SrcCount    Source buffer count.
+  @param[in]   Scratch     OC_INFLATE_SCRATCH_SIZE bytes of 8-byte aligned
+                           memory to use instead of memory allocation, optional.
+
+  @return  DstLen on success otherwise 0.
+**/
+UINTN
+DecompressZLIBRange (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstOffset,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  **Src,
+  IN  CONST UINTN  *SrcLen,
+  IN  UINTN        SrcCount,
+  IN  VOID         *Scratch  OPTIONAL
+  );
+
+/**
+  Decompress buffer with ADC algorithm.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressADC (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  );
+
+/**
+  Decompress buffer with BZIP2 algorithm.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressBZIP2 (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  );
+
+/**
+  Decompress buffer with LZFSE algorithm.
+
+  @param[out]  Dst         Destination buffer.
+  @param[in]   DstLen      Destination buffer size.
+  @param[in]   Src         Source buffer.
+  @param[in]   SrcLen      Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+UINTN
+DecompressLZFSE (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  );
+
 #endif // OC_COMPRESSION_LIB_H
@@ -21,6 +21,19 @@
 //
 #define OC_CPU_SNB_QPB_CLOCK 0x19U
 
+//
+// Feature bits of CPUID 1 (EDX | ECX << 32) reported in Features.
+//
+#define OC_CPU_FEATURE_SSE2    BIT26
+#define OC_CPU_FEATURE_SSSE3   BIT41
+#define OC_CPU_FEATURE_SSE4_1  BIT51
+#define OC_CPU_FEATURE_AES     BIT57
+
+//
+// Structured extended feature bits of CPUID 7 (EBX | ECX << 32) reported in ExtFeatures.
+//
+#define OC_CPU_EXT_FEATURE_SHA  BIT29
+
 typedef struct {
   //
   // Note, Vendor and BrandString are reordered for proper alignment.
@@ -20,7 +20,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define OC_CRYPTO_LIB_H
 
 //
-// Default to 2048-bit key length for RSA.
+// Default to 2048-bit key length for RSA, used by RSA_PUBLIC_KEY.
 //
 #ifndef CONFIG_RSA_KEY_BIT_SIZE
 #define CONFIG_RSA_KEY_BIT_SIZE 2048
@@ -28,7 +28,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #endif
 
 //
-// Default to 128-bit key length for AES.
+// Default to 128-bit key length for AES, used by AesInitCtxIv.
 //
 #ifndef CONFIG_AES_KEY_SIZE
 #define CONFIG_AES_KEY_SIZE 16
@@ -48,27 +48,43 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define AES_BLOCK_SIZE 16
 
 //
-// Support all AES key sizes.
+// Support all AES key sizes, the size is chosen per context.
 //
-#if CONFIG_AES_KEY_SIZE == 32
-#define AES_KEY_EXP_SIZE 240
-#elif CONFIG_AES_KEY_SIZE == 24
-#define AES_KEY_EXP_SIZE 208
-#elif CONFIG_AES_KEY_SIZE == 16
-#define AES_KEY_EXP_SIZE 176
-#else
+#define AES_128_KEY_SIZE 16
+#define AES_192_KEY_SIZE 24
+#define AES_256_KEY_SIZE 32
+
+#if CONFIG_AES_KEY_SIZE != AES_128_KEY_SIZE \
+  && CONFIG_AES_KEY_SIZE != AES_192_KEY_SIZE \
+  && CONFIG_AES_KEY_SIZE != AES_256_KEY_SIZE
 #error "Only AES-128, AES-192, and AES-256 are supported!"
 #endif
 
 //
-// For now abort on anything but 2048, but we can support 1024 and 4096 at least.
+// Expanded key size in 32-bit words for the largest key (AES-256, 14 rounds).
+//
+#define AES_KEY_EXP_WORDS 60
+
+//
+// RsaVerify supports 2048, 3072, and 4096-bit keys.
 //
-#if CONFIG_RSA_KEY_BIT_SIZE != 2048 || CONFIG_RSA_KEY_SIZE != 256
-#error "Only RSA-2048 is supported"
+#define RSA_MAX_KEY_BIT_SIZE 4096
+#define RSA_MAX_KEY_SIZE (RSA_MAX_KEY_BIT_SIZE / 8)
+
+#if CONFIG_RSA_KEY_BIT_SIZE != 2048 && CONFIG_RSA_KEY_BIT_SIZE != 3072 \
+  && CONFIG_RSA_KEY_BIT_SIZE != 4096
+#error "Only RSA-2048, RSA-3072, and RSA-4096 are supported"
 #endif
 
 #pragma pack(push, 1)
 
+//
+// Pre-processed public key with 65537 exponent, as produced by RsaTool.
+// Size is the number of 32-bit words in N, N0Inv is -1 / N[0] mod 2^32,
+// and Rr is R^2 mod N with R = 2^(32 * Size). The structure describes
+// CONFIG_RSA_KEY_SIZE keys, other key sizes follow the same layout
+// with Rr placed right after Size words of N.
+//
 typedef struct RSA_PUBLIC_KEY_ {
   UINT32  Size;
   UINT32  N0Inv;
@@ -78,9 +94,16 @@ typedef struct RSA_PUBLIC_KEY_ {
 
 #pragma pack(pop)
 
+//
+// Round keys are stored as little endian column words, so that their
+// in-memory layout matches the AES byte order on little endian targets.
+// InvRoundKey holds the equivalent inverse cipher schedule.
+//
 typedef struct AES_CONTEXT_ {
-  UINT8 RoundKey[AES_KEY_EXP_SIZE];
-  UINT8 Iv[AES_BLOCK_SIZE];
+  UINT32  RoundKey[AES_KEY_EXP_WORDS];
+  UINT32  InvRoundKey[AES_KEY_EXP_WORDS];
+  UINT32  Rounds;
+  UINT8   Iv[AES_BLOCK_SIZE];
 } AES_CONTEXT;
 
 typedef struct MD5_CONTEXT_ {
@@ -108,6 +131,18 @@ typedef struct SHA256_CONTEXT_ {
 //
 // Functions prototypes
 //
+//
+// Returns key modulus and signature size in bytes, or 0 for unsupported keys.
+//
+UINT32
+RsaGetKeySize (
+  CONST RSA_PUBLIC_KEY  *Key
+  );
+
+//
+// Verify SHA-256 PKCS#1 v1.5 signature of RsaGetKeySize bytes.
+// Montgomery parameters of recently used keys are cached.
+//
 BOOLEAN
 RsaVerify (
   RSA_PUBLIC_KEY  *Key,
@@ -115,6 +150,9 @@ RsaVerify (
   UINT8           *Sha256
   );
 
+//
+// Initialise AES context with CONFIG_AES_KEY_SIZE key.
+//
 VOID
 AesInitCtxIv (
   AES_CONTEXT  *Context,
@@ -122,6 +160,18 @@ AesInitCtxIv (
   CONST UINT8  *Iv
   );
 
+//
+// Initialise AES context with AES_128_KEY_SIZE, AES_192_KEY_SIZE,
+// or AES_256_KEY_SIZE key. Returns FALSE for unsupported key sizes.
+//
+BOOLEAN
+AesInitCtxIvEx (
+  AES_CONTEXT  *Context,
+  CONST UINT8  *Key,
+  UINT32       KeySize,
+  CONST UINT8  *Iv
+  );
+
 VOID
 AesSetCtxIv (
   AES_CONTEXT  *Context,
@@ -162,6 +212,19 @@ AesCtrXcryptBuffer (
   UINT32       Len
   );
 
+/**
+  Enable hardware accelerated algorithm implementations supported by the CPU.
+  Portable implementations are used until this is called.
+
+  @param[in] Features     CPUID leaf 1 features, as OC_CPU_INFO Features.
+  @param[in] ExtFeatures  CPUID leaf 7 features, as OC_CPU_INFO ExtFeatures.
+**/
+VOID
+OcCryptoInitAcceleration (
+  IN UINT64  Features,
+  IN UINT64  ExtFeatures
+  );
+
 VOID
 Md5Init (
   MD5_CONTEXT  *Context
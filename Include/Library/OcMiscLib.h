@@ -196,8 +196,156 @@ ApplyPatch (
   IN UINT32        Skip
   );
 
+//
+// Single entry of a multi-pattern patch set.
+//
+typedef struct {
+  //
+  // Find bytes.
+  //
+  CONST UINT8  *Pattern;
+  //
+  // Find mask or NULL.
+  //
+  CONST UINT8  *PatternMask;
+  //
+  // Replace bytes.
+  //
+  CONST UINT8  *Replace;
+  //
+  // Replace mask or NULL.
+  //
+  CONST UINT8  *ReplaceMask;
+  //
+  // Pattern size.
+  //
+  UINT32       PatternSize;
+  //
+  // Replace count or 0 for all.
+  //
+  UINT32       Count;
+  //
+  // Skip count or 0 to start from 1 match.
+  //
+  UINT32       Skip;
+  //
+  // Limit replacement size to this value or 0, which assumes data size.
+  //
+  UINT32       Limit;
+} PATTERN_PATCH;
+
+//
+// Per-patch matching state, reset for every buffer.
+//
+typedef struct {
+  //
+  // Remaining replacements or 0 for unlimited.
+  //
+  UINT32   Count;
+  //
+  // Remaining findings to skip.
+  //
+  UINT32   Skip;
+  //
+  // First offset the pattern may match at (previous match end).
+  //
+  UINT32   NextOff;
+  //
+  // End of the searched area for this patch.
+  //
+  UINT32   End;
+  //
+  // Patch is exhausted or disabled for current buffer.
+  //
+  BOOLEAN  Done;
+} PATTERN_PATCH_STATE;
+
+//
+// Compiled multi-pattern matcher.
+//
+typedef struct {
+  //
+  // Patches, owned by the caller.
+  //
+  CONST PATTERN_PATCH  *Patches;
+  //
+  // Number of patches.
+  //
+  UINT32               PatchCount;
+  //
+  // First byte buckets: 257 start offsets into BucketIndices.
+  //
+  UINT32               *BucketStarts;
+  //
+  // Patch indices in ascending order for every bucket.
+  //
+  UINT32               *BucketIndices;
+  //
+  // Matching state for every patch.
+  //
+  PATTERN_PATCH_STATE  *States;
+} PATTERN_MATCHER;
+
+/**
+  Compile multi-pattern matcher for a set of patches.
+  Must be freed with PatternMatcherFree on success.
+
+  @param[out] Matcher     Matcher to initialise.
+  @param[in]  Patches     Patches to match, must outlive the matcher.
+  @param[in]  PatchCount  Number of patches.
+
+  @retval RETURN_SUCCESS on success.
+**/
+RETURN_STATUS
+PatternMatcherInit (
+  OUT PATTERN_MATCHER      *Matcher,
+  IN  CONST PATTERN_PATCH  *Patches,
+  IN  UINT32               PatchCount
+  );
+
+/**
+  Free multi-pattern matcher resources.
+
+  @param[in,out] Matcher  Matcher to free.
+**/
+VOID
+PatternMatcherFree (
+  IN OUT PATTERN_MATCHER  *Matcher
+  );
+
+/**
+  Apply all matcher patches to the buffer in a single pass.
+  Count, Skip, and Limit semantics are the same as with ApplyPatch.
+
+  The buffer is walked once from start to end. At every offset enabled
+  patches are tried in array order, each seeing the data with all the
+  replacements made at lower offsets and by preceding patches at this
+  offset. Sequential ApplyPatch calls instead let every patch see the
+  whole buffer after all preceding patches and none of the following.
+  The results are therefore equal only when no replacement overlaps
+  the matching area of a different patch. Otherwise a patch sees bytes
+  written by following patches at lower offsets, and does not see bytes
+  written by preceding patches at higher offsets.
+
+  @param[in,out] Matcher        Compiled matcher.
+  @param[in,out] Data           Buffer to patch.
+  @param[in]     DataSize       Buffer size.
+  @param[in]     Enabled        Per-patch enable flags or NULL for all.
+  @param[out]    ReplaceCounts  Per-patch replacement counts, optional.
+
+  @return  total number of replacements performed.
+**/
+UINT32
+ApplyPatches (
+  IN OUT PATTERN_MATCHER  *Matcher,
+  IN OUT UINT8            *Data,
+  IN     UINT32           DataSize,
+  IN     CONST BOOLEAN    *Enabled        OPTIONAL,
+     OUT UINT32           *ReplaceCounts  OPTIONAL
+  );
+
 /**
-  @param[in] Protocol    The published unique identifier of the protocol. It is the callers responsibility to pass in
+  @param[in] Protocol    The published unique identifier of the protocol. It is the caller�s responsibility to pass in
                          a valid GUID.
 
   @retval EFI_SUCCESS on success.
@@ -20,21 +20,14 @@
 #include <Library/OcFileLib.h>
 #include <Library/OcSerializeLib.h>
 
-/**
-  Ensure that we actually use RSA 2048.
-**/
-OC_GLOBAL_STATIC_ASSERT (
-  CONFIG_RSA_KEY_BIT_SIZE == 2048 && CONFIG_RSA_KEY_SIZE == 256,
-  "Unsupported RSA key size"
-  );
-
 /**
   Storage vault file containing a dictionary with SHA-256 hashes for all files.
 **/
 #define OC_STORAGE_VAULT_PATH L"vault.plist"
 
 /**
-  RSA-2048 signature of SHA-256 hash of vault.plist.
+  RSA signature of SHA-256 hash of vault.plist, its size must match
+  the vault key size (2048, 3072, or 4096 bits).
 **/
 #define OC_STORAGE_VAULT_SIGNATURE_PATH L"vault.sig"
 
@@ -59,6 +52,20 @@ OC_GLOBAL_STATIC_ASSERT (
   _(OC_STORAGE_VAULT_FILES      , Files    ,     , OC_CONSTR (OC_STORAGE_VAULT_FILES, _, __) , OC_DESTR (OC_STORAGE_VAULT_FILES))
   OC_DECLARE (OC_STORAGE_VAULT)
 
+/**
+  Vault file path hash index slot.
+**/
+typedef struct {
+  ///
+  /// Vault file path hash.
+  ///
+  UINT32                           Hash;
+  ///
+  /// Vault file index + 1, 0 for free slots.
+  ///
+  UINT32                           Index;
+} OC_STORAGE_VAULT_INDEX;
+
 /**
   Storage abstraction context
 **/
@@ -79,6 +86,11 @@ typedef struct {
   /// Vault status.
   ///
   BOOLEAN                          HasVault;
+  ///
+  /// Vault file path hash index, power of two size, optional.
+  ///
+  OC_STORAGE_VAULT_INDEX           *VaultIndex;
+  UINT32                           VaultIndexSize;
 } OC_STORAGE_CONTEXT;
 
 /**
@@ -90,6 +90,21 @@ AsciiUint64ToLowerHex (
   IN  UINT64  Value
   );
 
+/**
+  Calculate 32-bit FNV-1a hash of a null terminated ascii string
+  for use in lookup tables.
+
+  @param[in]  String  Ascii string to hash.
+  @param[out] Length  String length, optional.
+
+  @retval  String hash value.
+**/
+UINT32
+AsciiStrHash (
+  IN  CONST CHAR8  *String,
+  OUT UINT32       *Length  OPTIONAL
+  );
+
 /**
   Performs a case insensitive comparison of two Null-terminated Unicode strings,
   and returns the difference between the first mismatched Unicode characters.
@@ -182,6 +197,22 @@ UnicodeUefiSlashes (
   IN OUT CHAR16  *String
   );
 
+/**
+  Calculate 32-bit FNV-1a hash of a null terminated unicode string
+  for use in lookup tables. Only the low byte of every character is
+  hashed, so for ASCII strings the result matches AsciiStrHash.
+
+  @param[in]  String  Unicode string to hash.
+  @param[out] Length  String length, optional.
+
+  @retval  String hash value.
+**/
+UINT32
+UnicodeStrHash (
+  IN  CONST CHAR16  *String,
+  OUT UINT32        *Length  OPTIONAL
+  );
+
 /**
   Filter string from unprintable characters.
 
@@ -125,6 +125,15 @@ typedef struct XML_NODE_ XML_NODE;
 //     document
 // @warning `Buffer` contents are permanently modified during parsing
 //
+// Binary plists (bplist00) are detected by signature and read in place:
+// nodes are created on first access with the same names as in XML plists,
+// `Buffer` is not modified, and `WithRefs` is ignored. Data and integer
+// accessors decode values directly, strings are converted to UTF-8 on
+// first content access with unpaired surrogates replaced by U+FFFD.
+// Real and date nodes have no content.
+//
+// @warning Binary plist documents cannot be exported.
+//
 // @return The parsed xml fragment iff parsing was successful, 0 otherwise
 //
 XML_DOCUMENT *
@@ -134,6 +143,23 @@ XmlDocumentParse (
   BOOLEAN  WithRefs
   );
 
+//
+// Same as XmlDocumentParse, but children of nodes are only skipped over and
+// get parsed on first access through XmlNodeChildren, XmlNodeChild, or
+// functions using them. Nodes with ID attribute are parsed immediately.
+// Export copies never accessed children from `Buffer` as is.
+//
+// @warning Only tag nesting is validated for skipped children, malformed
+//     children are reported as missing on first access. The document then
+//     refuses to export, see XmlDocumentLazyFailed.
+//
+XML_DOCUMENT *
+XmlDocumentParseLazy (
+  CHAR8    *Buffer,
+  UINT32   Length,
+  BOOLEAN  WithRefs
+  );
+
 //
 // Exports parsed document into the buffer.
 //
@@ -150,6 +176,43 @@ XmlDocumentExport (
   UINT32        Skip
   );
 
+//
+// Calculates exported document length.
+//
+// @param Document XML_DOCUMENT to export
+// @param Length   Resulting length of the export without trailing \0
+// @param Skip     N root levels before exporting, normally 0.
+//
+// @return TRUE if the length fits into UINT32.
+//
+BOOLEAN
+XmlDocumentExportSize (
+  XML_DOCUMENT  *Document,
+  UINT32        *Length,
+  UINT32        Skip
+  );
+
+//
+// Exports parsed document into caller provided buffer.
+//
+// @param Document   XML_DOCUMENT to export
+// @param Buffer     Destination buffer
+// @param BufferSize Destination buffer size including space for trailing \0
+// @param Length     Resulting length without trailing \0 (optional), set to
+//                   the required length when Buffer is too small.
+// @param Skip       N root levels before exporting, normally 0.
+//
+// @return TRUE if the document was exported.
+//
+BOOLEAN
+XmlDocumentExportBuffer (
+  XML_DOCUMENT  *Document,
+  CHAR8         *Buffer,
+  UINT32        BufferSize,
+  UINT32        *Length,
+  UINT32        Skip
+  );
+
 //
 // Frees all resources associated with the document. All XML_NODE
 // references obtained through the document will be invalidated.
@@ -169,6 +232,14 @@ XmlDocumentRoot (
   XML_DOCUMENT  *Document
   );
 
+//
+// @return TRUE if children of some lazily parsed node were malformed.
+//
+BOOLEAN
+XmlDocumentLazyFailed (
+  XML_DOCUMENT  *Document
+  );
+
 //
 // @return The XML_NODE's tag name.
 //
@@ -298,6 +369,19 @@ PlistKeyValue (
   XML_NODE  *Node
   );
 
+//
+// Looks up dictionary value by key. Larger dictionaries get a key hash
+// index on first lookup, which is dropped when children are added.
+//
+// @return value of the first matching key or NULL.
+// @warning Renaming keys through XmlNodeChangeContent is not tracked.
+//
+XML_NODE *
+PlistDictFind (
+  XML_NODE     *Node,
+  CONST CHAR8  *Key
+  );
+
 //
 // @return string value for valid type or empty string ("").
 //
@@ -25,13 +25,14 @@
 ///
 /// The defines for the log flags.
 ///
-#define OC_LOG_ENABLE       BIT0
-#define OC_LOG_CONSOLE      BIT1
-#define OC_LOG_DATA_HUB     BIT2
-#define OC_LOG_SERIAL       BIT3
-#define OC_LOG_VARIABLE     BIT4
-#define OC_LOG_NONVOLATILE  BIT5
-#define OC_LOG_FILE         BIT6
+#define OC_LOG_ENABLE         BIT0
+#define OC_LOG_CONSOLE        BIT1
+#define OC_LOG_DATA_HUB       BIT2
+#define OC_LOG_SERIAL         BIT3
+#define OC_LOG_VARIABLE       BIT4
+#define OC_LOG_NONVOLATILE    BIT5
+#define OC_LOG_FILE           BIT6
+#define OC_LOG_FILE_BUFFERED  BIT7
 
 typedef UINT32 OC_LOG_OPTIONS;
 
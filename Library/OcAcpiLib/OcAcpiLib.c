@@ -1008,6 +1008,173 @@ AcpiApplyPatch (
   return EFI_SUCCESS;
 }
 
+/**
+  Apply enabled patches to one ACPI table and refresh its checksum.
+
+  @param Matcher        Compiled patch matcher.
+  @param Patches        ACPI patches the matcher was built from.
+  @param Enabled        Per-patch enable flags.
+  @param ReplaceCounts  Per-patch replacement count scratch buffer.
+  @param Table          ACPI table to patch.
+**/
+STATIC
+VOID
+AcpiApplyPatchesToTable (
+  IN OUT PATTERN_MATCHER         *Matcher,
+  IN     OC_ACPI_PATCH           *Patches,
+  IN     BOOLEAN                 *Enabled,
+  IN OUT UINT32                  *ReplaceCounts,
+  IN OUT EFI_ACPI_COMMON_HEADER  *Table
+  )
+{
+  UINT32  Index;
+  UINT32  ReplaceCount;
+
+  ReplaceCount = ApplyPatches (
+    Matcher,
+    (UINT8 *) Table,
+    Table->Length,
+    Enabled,
+    ReplaceCounts
+    );
+
+  for (Index = 0; Index < Matcher->PatchCount; ++Index) {
+    if (Enabled[Index]) {
+      DEBUG ((
+        ReplaceCounts[Index] > 0 ? DEBUG_INFO : DEBUG_BULK_INFO,
+        "OCA: Patching %08x (%016Lx, %u) with patch %u replaced %u of %u\n",
+        Table->Signature,
+        AcpiReadOemTableId (Table),
+        Table->Length,
+        Index,
+        ReplaceCounts[Index],
+        Patches[Index].Count
+        ));
+    }
+  }
+
+  if (ReplaceCount > 0 && Table->Length >= sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+    ((EFI_ACPI_DESCRIPTION_HEADER *) Table)->Checksum = 0;
+    ((EFI_ACPI_DESCRIPTION_HEADER *) Table)->Checksum = CalculateCheckSum8 (
+      (UINT8 *) Table,
+      Table->Length
+      );
+
+    DEBUG ((
+      DEBUG_INFO,
+      "OCA: Refreshed %08x checksum to %02x\n",
+      Table->Signature,
+      ((EFI_ACPI_DESCRIPTION_HEADER *) Table)->Checksum
+      ));
+  }
+}
+
+EFI_STATUS
+AcpiApplyPatches (
+  IN OUT OC_ACPI_CONTEXT  *Context,
+  IN     OC_ACPI_PATCH    *Patches,
+  IN     UINT32           PatchCount
+  )
+{
+  EFI_STATUS       Status;
+  PATTERN_PATCH    *Patterns;
+  BOOLEAN          *Enabled;
+  UINT32           *ReplaceCounts;
+  PATTERN_MATCHER  Matcher;
+  UINT32           Index;
+  UINT32           PatchIndex;
+  UINT64           CurrOemTableId;
+  BOOLEAN          HasEnabled;
+
+  if (PatchCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  DEBUG ((DEBUG_INFO, "OCA: Applying %u ACPI patches in a single pass\n", PatchCount));
+
+  Patterns = AllocatePool (PatchCount * (sizeof (*Patterns) + sizeof (*ReplaceCounts) + sizeof (*Enabled)));
+  if (Patterns == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ReplaceCounts = (UINT32 *) &Patterns[PatchCount];
+  Enabled       = (BOOLEAN *) &ReplaceCounts[PatchCount];
+
+  for (PatchIndex = 0; PatchIndex < PatchCount; ++PatchIndex) {
+    Patterns[PatchIndex].Pattern     = Patches[PatchIndex].Find;
+    Patterns[PatchIndex].PatternMask = Patches[PatchIndex].Mask;
+    Patterns[PatchIndex].Replace     = Patches[PatchIndex].Replace;
+    Patterns[PatchIndex].ReplaceMask = Patches[PatchIndex].ReplaceMask;
+    Patterns[PatchIndex].PatternSize = Patches[PatchIndex].Size;
+    Patterns[PatchIndex].Count       = Patches[PatchIndex].Count;
+    Patterns[PatchIndex].Skip        = Patches[PatchIndex].Skip;
+    Patterns[PatchIndex].Limit       = Patches[PatchIndex].Limit;
+  }
+
+  Status = PatternMatcherInit (&Matcher, Patterns, PatchCount);
+  if (EFI_ERROR (Status)) {
+    FreePool (Patterns);
+    return Status;
+  }
+
+  if (Context->Dsdt != NULL) {
+    HasEnabled = FALSE;
+    for (PatchIndex = 0; PatchIndex < PatchCount; ++PatchIndex) {
+      Enabled[PatchIndex] = (Patches[PatchIndex].TableSignature == 0
+          || Patches[PatchIndex].TableSignature == EFI_ACPI_6_2_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE)
+        && (Patches[PatchIndex].TableLength == 0 || Context->Dsdt->Length == Patches[PatchIndex].TableLength)
+        && (Patches[PatchIndex].OemTableId == 0 || Context->Dsdt->OemTableId == Patches[PatchIndex].OemTableId);
+      if (Enabled[PatchIndex]) {
+        HasEnabled = TRUE;
+      }
+    }
+
+    if (HasEnabled) {
+      AcpiApplyPatchesToTable (
+        &Matcher,
+        Patches,
+        Enabled,
+        ReplaceCounts,
+        (EFI_ACPI_COMMON_HEADER *) Context->Dsdt
+        );
+    }
+  }
+
+  for (Index = 0; Index < Context->NumberOfTables; ++Index) {
+    if (Context->Tables[Index]->Length >= sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
+      CurrOemTableId = ((EFI_ACPI_DESCRIPTION_HEADER *) Context->Tables[Index])->OemTableId;
+    } else {
+      CurrOemTableId = 0;
+    }
+
+    HasEnabled = FALSE;
+    for (PatchIndex = 0; PatchIndex < PatchCount; ++PatchIndex) {
+      Enabled[PatchIndex] = (Patches[PatchIndex].TableSignature == 0
+          || Context->Tables[Index]->Signature == Patches[PatchIndex].TableSignature)
+        && (Patches[PatchIndex].TableLength == 0 || Context->Tables[Index]->Length == Patches[PatchIndex].TableLength)
+        && (Patches[PatchIndex].OemTableId == 0 || CurrOemTableId == Patches[PatchIndex].OemTableId);
+      if (Enabled[PatchIndex]) {
+        HasEnabled = TRUE;
+      }
+    }
+
+    if (HasEnabled) {
+      AcpiApplyPatchesToTable (
+        &Matcher,
+        Patches,
+        Enabled,
+        ReplaceCounts,
+        Context->Tables[Index]
+        );
+    }
+  }
+
+  PatternMatcherFree (&Matcher);
+  FreePool (Patterns);
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 AcpiLoadRegions (
   IN OUT OC_ACPI_CONTEXT  *Context
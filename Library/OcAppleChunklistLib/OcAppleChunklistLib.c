@@ -12,6 +12,8 @@
 
 #include <Uefi.h>
 
+#include <Protocol/MpService.h>
+
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -19,6 +21,8 @@
 #include <Library/OcAppleRamDiskLib.h>
 #include <Library/OcCryptoLib.h>
 #include <Library/OcGuardLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
 
 BOOLEAN
 OcAppleChunklistInitializeContext (
@@ -117,22 +121,329 @@ OcAppleChunklistVerifySignature (
   return Result;
 }
 
+/**
+  Hash chunk data directly from RAM disk extent memory.
+
+  @param[in]  Index   RAM disk extent index.
+  @param[in]  Offset  Chunk offset in RAM disk.
+  @param[in]  Size    Chunk size.
+  @param[out] Hash    Resulting SHA-256 digest.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalHashExtentData (
+  IN  CONST OC_APPLE_RAM_DISK_INDEX  *Index,
+  IN  UINT64                         Offset,
+  IN  UINT32                         Size,
+  OUT UINT8                          *Hash
+  )
+{
+  SHA256_CONTEXT             ShaContext;
+  OC_APPLE_RAM_DISK_SEGMENT  Segments[4];
+  UINT32                     SegmentCount;
+  UINT32                     SegmentIndex;
+  UINTN                      MappedSize;
+
+  Sha256Init (&ShaContext);
+
+  while (Size > 0) {
+    SegmentCount = ARRAY_SIZE (Segments);
+    MappedSize   = OcAppleRamDiskMap (Index, Offset, Size, Segments, &SegmentCount);
+    if (MappedSize == 0) {
+      return FALSE;
+    }
+
+    for (SegmentIndex = 0; SegmentIndex < SegmentCount; ++SegmentIndex) {
+      Sha256Update (
+        &ShaContext,
+        Segments[SegmentIndex].Data,
+        Segments[SegmentIndex].Size
+        );
+    }
+
+    Offset += MappedSize;
+    Size   -= (UINT32) MappedSize;
+  }
+
+  Sha256Final (&ShaContext, Hash);
+  return TRUE;
+}
+
+/**
+  Verify a single chunk against its checksum.
+
+  @param[in] Index   RAM disk extent index.
+  @param[in] Chunk   Chunk to verify.
+  @param[in] Offset  Chunk offset in RAM disk.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalVerifyChunk (
+  IN CONST OC_APPLE_RAM_DISK_INDEX  *Index,
+  IN CONST APPLE_CHUNKLIST_CHUNK    *Chunk,
+  IN UINT64                         Offset
+  )
+{
+  UINT8  ChunkHash[SHA256_DIGEST_SIZE];
+
+  if (!InternalHashExtentData (Index, Offset, Chunk->Length, ChunkHash)) {
+    return FALSE;
+  }
+
+  return CompareMem (ChunkHash, Chunk->Checksum, SHA256_DIGEST_SIZE) == 0;
+}
+
+/**
+  Verification state shared between processors.
+**/
+typedef struct {
+  CONST OC_APPLE_RAM_DISK_INDEX      *ExtentIndex;
+  CONST APPLE_CHUNKLIST_CHUNK        *Chunks;
+  CONST UINT64                       *Offsets;
+  BOOLEAN                            *Valid;
+  UINT32                             ChunkCount;
+  volatile UINT32                    NextChunk;
+  volatile UINT32                    FinishedWorkers;
+} INTERNAL_CHUNKLIST_MP_CONTEXT;
+
+/**
+  Verify chunks until none are left. Chunks are claimed one at a time,
+  so processors finishing early pick up the remaining work.
+  This runs on APs and must not use boot services or print.
+
+  @param[in,out] MpContext  Verification state.
+**/
+STATIC
+VOID
+InternalVerifyChunksLoop (
+  IN OUT INTERNAL_CHUNKLIST_MP_CONTEXT  *MpContext
+  )
+{
+  UINT32  Index;
+
+  while (TRUE) {
+    Index = InterlockedIncrement (&MpContext->NextChunk) - 1;
+    if (Index >= MpContext->ChunkCount) {
+      break;
+    }
+
+    MpContext->Valid[Index] = InternalVerifyChunk (
+                                MpContext->ExtentIndex,
+                                &MpContext->Chunks[Index],
+                                MpContext->Offsets[Index]
+                                );
+  }
+}
+
+/**
+  AP entry point, verifies chunks and reports completion.
+
+  @param[in,out] Buffer  Verification state.
+**/
+STATIC
+VOID
+EFIAPI
+InternalVerifyChunksWorker (
+  IN OUT VOID  *Buffer
+  )
+{
+  INTERNAL_CHUNKLIST_MP_CONTEXT  *MpContext;
+
+  MpContext = Buffer;
+
+  InternalVerifyChunksLoop (MpContext);
+
+  //
+  // Verification state may be freed as soon as every AP is counted.
+  //
+  InterlockedIncrement (&MpContext->FinishedWorkers);
+}
+
+/**
+  Close AP completion event once MP services reap the APs.
+
+  @param[in] Event    Completion event.
+  @param[in] Context  Unused.
+**/
+STATIC
+VOID
+EFIAPI
+InternalCloseApEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  gBS->CloseEvent (Event);
+}
+
+/**
+  Verify chunks across all processors.
+
+  @param[in]  Context      Chunklist context.
+  @param[in]  ExtentIndex  RAM disk extent index.
+  @param[in]  MpServices   MP services protocol.
+  @param[out] FailedChunk  First failed chunk index.
+
+  @retval EFI_SUCCESS           All chunks are valid.
+  @retval EFI_COMPROMISED_DATA  FailedChunk is invalid.
+  @retval EFI_OUT_OF_RESOURCES  Verification could not be started.
+  @retval EFI_NOT_STARTED       No APs are available.
+**/
+STATIC
+EFI_STATUS
+InternalVerifyDataMp (
+  IN  CONST OC_APPLE_CHUNKLIST_CONTEXT   *Context,
+  IN  CONST OC_APPLE_RAM_DISK_INDEX      *ExtentIndex,
+  IN  EFI_MP_SERVICES_PROTOCOL           *MpServices,
+  OUT UINT64                             *FailedChunk
+  )
+{
+  EFI_STATUS                     Status;
+  INTERNAL_CHUNKLIST_MP_CONTEXT  MpContext;
+  UINT64                         *Offsets;
+  UINT64                         CurrentOffset;
+  UINT32                         Index;
+  UINTN                          ProcessorCount;
+  UINTN                          EnabledProcessorCount;
+  EFI_EVENT                      ApEvent;
+  BOOLEAN                        Blocking;
+
+  Status = MpServices->GetNumberOfProcessors (
+                         MpServices,
+                         &ProcessorCount,
+                         &EnabledProcessorCount
+                         );
+  if (EFI_ERROR (Status) || EnabledProcessorCount < 2) {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCCL: No APs for verification, %u enabled - %r\n",
+      (UINT32) (EFI_ERROR (Status) ? 0 : EnabledProcessorCount),
+      Status
+      ));
+    return EFI_NOT_STARTED;
+  }
+
+  Offsets = AllocatePool (
+              (UINTN) Context->ChunkCount * (sizeof (*Offsets) + sizeof (*MpContext.Valid))
+              );
+  if (Offsets == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  MpContext.ExtentIndex     = ExtentIndex;
+  MpContext.Chunks          = Context->Chunks;
+  MpContext.Offsets         = Offsets;
+  MpContext.Valid           = (BOOLEAN *) &Offsets[Context->ChunkCount];
+  MpContext.ChunkCount      = (UINT32) Context->ChunkCount;
+  MpContext.NextChunk       = 0;
+  MpContext.FinishedWorkers = 0;
+
+  CurrentOffset = 0;
+  for (Index = 0; Index < MpContext.ChunkCount; ++Index) {
+    Offsets[Index]  = CurrentOffset;
+    CurrentOffset  += Context->Chunks[Index].Length;
+  }
+
+  //
+  // Start APs in non-blocking mode, so that the BSP verifies at the same time.
+  // MP services signal the event only from a periodic timer, so APs report
+  // completion through a counter, and the event just closes itself afterwards.
+  // Fall back to blocking mode when no event can be used.
+  //
+  Status = gBS->CreateEvent (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  InternalCloseApEvent,
+                  NULL,
+                  &ApEvent
+                  );
+  Blocking = EFI_ERROR (Status);
+  if (!Blocking) {
+    Status = MpServices->StartupAllAPs (
+                           MpServices,
+                           InternalVerifyChunksWorker,
+                           FALSE,
+                           ApEvent,
+                           0,
+                           &MpContext,
+                           NULL
+                           );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (ApEvent);
+      Blocking = Status == EFI_UNSUPPORTED;
+    }
+  }
+
+  if (Blocking) {
+    Status = MpServices->StartupAllAPs (
+                           MpServices,
+                           InternalVerifyChunksWorker,
+                           FALSE,
+                           NULL,
+                           0,
+                           &MpContext,
+                           NULL
+                           );
+  }
+
+  //
+  // When APs failed to start, BSP verifies every chunk below.
+  //
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      DEBUG_INFO,
+      "OCCL: StartupAllAPs for %u chunks failed - %r\n",
+      MpContext.ChunkCount,
+      Status
+      ));
+  }
+
+  InternalVerifyChunksLoop (&MpContext);
+
+  //
+  // Locked read makes AP verification results visible once all of them are counted.
+  //
+  if (!EFI_ERROR (Status)) {
+    while (InterlockedCompareExchange32 (&MpContext.FinishedWorkers, 0, 0)
+      < EnabledProcessorCount - 1) {
+      CpuPause ();
+    }
+  }
+
+  for (Index = 0; Index < MpContext.ChunkCount; ++Index) {
+    if (!MpContext.Valid[Index]) {
+      break;
+    }
+  }
+
+  FreePool (Offsets);
+
+  *FailedChunk = Index;
+  if (Index < Context->ChunkCount) {
+    return EFI_COMPROMISED_DATA;
+  }
+
+  return EFI_SUCCESS;
+}
+
 BOOLEAN
 OcAppleChunklistVerifyData (
   IN OUT OC_APPLE_CHUNKLIST_CONTEXT         *Context,
-  IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+  IN     CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
+  IN     EFI_MP_SERVICES_PROTOCOL           *MpServices OPTIONAL,
+  OUT    UINT64                             *FailedChunk OPTIONAL
   )
 {
-  BOOLEAN                     Result;
-
+  EFI_STATUS                  Status;
+  OC_APPLE_RAM_DISK_INDEX     ExtentIndex;
   UINT64                      Index;
-  UINT8                       ChunkHash[SHA256_DIGEST_SIZE];
   CONST APPLE_CHUNKLIST_CHUNK *CurrentChunk;
   UINT64                      CurrentOffset;
 
-  UINTN                       ChunkDataSize;
-  VOID                        *ChunkData;
-
   ASSERT (Context != NULL);
   ASSERT (Context->Chunks != NULL);
   ASSERT (ExtentTable != NULL);
@@ -141,47 +452,41 @@ OcAppleChunklistVerifyData (
     ASSERT (Context->Signature == NULL);
     );
 
-  ChunkDataSize = 0;
-  for (Index = 0; Index < Context->ChunkCount; ++Index) {
-    CurrentChunk = &Context->Chunks[Index];
-    if (ChunkDataSize < CurrentChunk->Length) {
-      ChunkDataSize = CurrentChunk->Length;
+  OcAppleRamDiskInitializeIndex (&ExtentIndex, ExtentTable);
+
+  Status = EFI_NOT_STARTED;
+
+  //
+  // Worker chunk claiming counter is 32-bit, which is plenty for 10 MB chunks.
+  //
+  if (MpServices != NULL && Context->ChunkCount < MAX_UINT32 / 2) {
+    Status = InternalVerifyDataMp (Context, &ExtentIndex, MpServices, &Index);
+  }
+
+  if (Status != EFI_SUCCESS && Status != EFI_COMPROMISED_DATA) {
+    CurrentOffset = 0;
+    for (Index = 0; Index < Context->ChunkCount; ++Index) {
+      CurrentChunk = &Context->Chunks[Index];
+
+      DEBUG ((DEBUG_VERBOSE, "AppleChunklistVerifyData(): Validating chunk %lu of %lu\n",
+        Index, Context->ChunkCount));
+      if (!InternalVerifyChunk (&ExtentIndex, CurrentChunk, CurrentOffset)) {
+        break;
+      }
+
+      CurrentOffset += CurrentChunk->Length;
     }
   }
 
-  ChunkData = AllocatePool (ChunkDataSize);
-  if (ChunkData == NULL) {
-    return FALSE;
+  if (FailedChunk != NULL) {
+    *FailedChunk = Index;
   }
 
-  CurrentOffset = 0;
-  for (Index = 0; Index < Context->ChunkCount; Index++) {
-    CurrentChunk = &Context->Chunks[Index];
-
-    Result = OcAppleRamDiskRead (
-               ExtentTable,
-               CurrentOffset,
-               CurrentChunk->Length,
-               ChunkData
-               );
-    if (!Result) {
-      FreePool (ChunkData);
-      return FALSE;
-    }
-    //
-    // Calculate checksum of data and ensure they match.
-    //
-    DEBUG ((DEBUG_VERBOSE, "AppleChunklistVerifyData(): Validating chunk %lu of %lu\n",
+  if (Index < Context->ChunkCount) {
+    DEBUG ((DEBUG_INFO, "AppleChunklistVerifyData(): Chunk %lu of %lu is invalid\n",
       Index, Context->ChunkCount));
-    Sha256 (ChunkHash, ChunkData, CurrentChunk->Length);
-    if (CompareMem (ChunkHash, CurrentChunk->Checksum, SHA256_DIGEST_SIZE) != 0) {
-      FreePool (ChunkData);
-      return FALSE;
-    }
-
-    CurrentOffset += CurrentChunk->Length;
+    return FALSE;
   }
 
-  FreePool (ChunkData);
   return TRUE;
 }
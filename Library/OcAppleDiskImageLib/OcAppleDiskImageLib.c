@@ -23,9 +23,35 @@
 #include <Library/OcCompressionLib.h>
 #include <Library/OcFileLib.h>
 #include <Library/OcGuardLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
 
 #include "OcAppleDiskImageLibInternal.h"
 
+/**
+  Chunk fully covered by a read request, decompressed on any processor.
+**/
+typedef struct {
+  CONST APPLE_DISK_IMAGE_CHUNK  *Chunk;
+  UINT8                         *Buffer;
+  UINTN                         Size;
+  BOOLEAN                       Done;
+} INTERNAL_DMG_MP_JOB;
+
+/**
+  Decompression state shared between processors.
+**/
+typedef struct {
+  OC_APPLE_DISK_IMAGE_CONTEXT   *Context;
+  INTERNAL_DMG_MP_JOB           *Jobs;
+  UINT32                        JobCount;
+  volatile UINT32               NextJob;
+  UINT8                         *Scratch;
+  UINT32                        ScratchCount;
+  volatile UINT32               NextScratch;
+  volatile UINT32               FinishedWorkers;
+} INTERNAL_DMG_MP_CONTEXT;
+
 BOOLEAN
 OcAppleDiskImageInitializeContext (
   OUT OC_APPLE_DISK_IMAGE_CONTEXT        *Context,
@@ -141,10 +167,28 @@ OcAppleDiskImageInitializeContext (
   }
 
   Context->ExtentTable = ExtentTable;
+  OcAppleRamDiskInitializeIndex (&Context->ExtentIndex, ExtentTable);
   Context->BlockCount  = DmgBlockCount;
   Context->Blocks      = DmgBlocks;
   Context->SectorCount = SectorCount;
 
+  Result = InternalBuildChunkIndex (Context);
+  if (!Result) {
+    while ((DmgBlockCount--) != 0) {
+      FreePool (DmgBlocks[DmgBlockCount]);
+    }
+
+    FreePool (DmgBlocks);
+    return FALSE;
+  }
+
+  InitializeListHead (&Context->ChunkCache);
+  Context->ChunkCacheSize   = 0;
+  Context->ChunkCacheBudget = OC_APPLE_DISK_IMAGE_CHUNK_CACHE_SIZE;
+  Context->ChunkCacheHits   = 0;
+  Context->ChunkCacheMisses = 0;
+  Context->MpServices       = NULL;
+
   return TRUE;
 }
 
@@ -191,7 +235,8 @@ OcAppleDiskImageInitializeFromFile (
 BOOLEAN
 OcAppleDiskImageVerifyData (
   IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN OUT OC_APPLE_CHUNKLIST_CONTEXT   *ChunklistContext
+  IN OUT OC_APPLE_CHUNKLIST_CONTEXT   *ChunklistContext,
+  IN     EFI_MP_SERVICES_PROTOCOL     *MpServices OPTIONAL
   )
 {
   ASSERT (Context != NULL);
@@ -199,7 +244,9 @@ OcAppleDiskImageVerifyData (
 
   return OcAppleChunklistVerifyData (
            ChunklistContext,
-           Context->ExtentTable
+           Context->ExtentTable,
+           MpServices,
+           NULL
            );
 }
 
@@ -212,11 +259,24 @@ OcAppleDiskImageFreeContext (
 
   ASSERT (Context != NULL);
 
+  DEBUG ((
+    DEBUG_INFO,
+    "DMG chunk cache hits %Lu misses %Lu\n",
+    Context->ChunkCacheHits,
+    Context->ChunkCacheMisses
+    ));
+
+  InternalTrimChunkCache (Context, 0);
+
   for (Index = 0; Index < Context->BlockCount; ++Index) {
     FreePool (Context->Blocks[Index]);
   }
 
   FreePool (Context->Blocks);
+
+  if (Context->Chunks != NULL) {
+    FreePool (Context->Chunks);
+  }
 }
 
 VOID
@@ -228,12 +288,482 @@ OcAppleDiskImageFreeFile (
   OcAppleDiskImageFreeContext (Context);
 }
 
+VOID
+OcAppleDiskImageSetChunkCacheBudget (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Budget
+  )
+{
+  ASSERT (Context != NULL);
+
+  InternalTrimChunkCache (Context, Budget);
+  Context->ChunkCacheBudget = Budget;
+}
+
+VOID
+OcAppleDiskImageSetMpServices (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     EFI_MP_SERVICES_PROTOCOL     *MpServices OPTIONAL
+  )
+{
+  ASSERT (Context != NULL);
+
+  Context->MpServices = MpServices;
+}
+
+/**
+  Decompress chunk data from RAM disk extents. ZLIB chunks are streamed
+  and may be decompressed partially, other types need the whole chunk
+  and contiguous compressed data.
+
+  @param[in]  Context      DMG context.
+  @param[in]  Chunk        Compressed chunk.
+  @param[in]  ChunkOffset  Offset in decompressed chunk data.
+  @param[out] Buffer       Resulting data.
+  @param[in]  BufferSize   Amount of data to decompress.
+  @param[in]  Scratch      OC_INFLATE_SCRATCH_SIZE bytes of memory, optional.
+                           When passed, no memory is allocated, as needed on APs.
+                           Only ADC and ZLIB chunks are supported in this case.
+
+  @retval TRUE on success.
+**/
+STATIC
 BOOLEAN
-OcAppleDiskImageRead (
+InternalDecompressChunk (
+  IN  OC_APPLE_DISK_IMAGE_CONTEXT   *Context,
+  IN  CONST APPLE_DISK_IMAGE_CHUNK  *Chunk,
+  IN  UINTN                         ChunkOffset,
+  OUT UINT8                         *Buffer,
+  IN  UINTN                         BufferSize,
+  IN  VOID                          *Scratch  OPTIONAL
+  )
+{
+  BOOLEAN                    Result;
+  OC_APPLE_RAM_DISK_SEGMENT  Segments[4];
+  CONST UINT8                *Src[ARRAY_SIZE (Segments)];
+  UINTN                      SrcLen[ARRAY_SIZE (Segments)];
+  UINT32                     SegmentCount;
+  UINT32                     Index;
+  UINTN                      MappedSize;
+  UINT8                      *CompressedData;
+  UINTN                      OutSize;
+
+  if (Chunk->CompressedLength > OC_COMPRESSION_MAX_LENGTH) {
+    return FALSE;
+  }
+
+  //
+  // This also runs on APs, so report misuse instead of asserting.
+  //
+  if (Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB && ChunkOffset != 0) {
+    return FALSE;
+  }
+
+  if (Scratch != NULL
+    && Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB
+    && Chunk->Type != APPLE_DISK_IMAGE_CHUNK_TYPE_ADC) {
+    return FALSE;
+  }
+
+  SegmentCount = Chunk->Type == APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB ? ARRAY_SIZE (Segments) : 1;
+  MappedSize   = OcAppleRamDiskMap (
+                   &Context->ExtentIndex,
+                   Chunk->CompressedOffset,
+                   (UINTN) Chunk->CompressedLength,
+                   Segments,
+                   &SegmentCount
+                   );
+
+  //
+  // Compressed data normally spans one or two extents at most,
+  // otherwise gather it into a contiguous buffer first.
+  // Only ZLIB can consume several extents directly.
+  //
+  CompressedData = NULL;
+
+  if (MappedSize == Chunk->CompressedLength) {
+    for (Index = 0; Index < SegmentCount; ++Index) {
+      Src[Index]    = Segments[Index].Data;
+      SrcLen[Index] = Segments[Index].Size;
+    }
+  } else {
+    if (Scratch != NULL) {
+      return FALSE;
+    }
+
+    CompressedData = AllocatePool ((UINTN) Chunk->CompressedLength);
+    if (CompressedData == NULL) {
+      return FALSE;
+    }
+
+    Result = OcAppleRamDiskRead (
+               Context->ExtentTable,
+               Chunk->CompressedOffset,
+               (UINTN) Chunk->CompressedLength,
+               CompressedData
+               );
+    if (!Result) {
+      FreePool (CompressedData);
+      return FALSE;
+    }
+
+    Src[0]       = CompressedData;
+    SrcLen[0]    = (UINTN) Chunk->CompressedLength;
+    SegmentCount = 1;
+  }
+
+  switch (Chunk->Type) {
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB:
+      OutSize = DecompressZLIBRange (
+                  Buffer,
+                  ChunkOffset,
+                  BufferSize,
+                  Src,
+                  SrcLen,
+                  SegmentCount,
+                  Scratch
+                  );
+      break;
+
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_ADC:
+      OutSize = DecompressADC (Buffer, BufferSize, Src[0], SrcLen[0]);
+      break;
+
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_BZIP2:
+      OutSize = DecompressBZIP2 (Buffer, BufferSize, Src[0], SrcLen[0]);
+      break;
+
+    case APPLE_DISK_IMAGE_CHUNK_TYPE_LZFSE:
+      OutSize = DecompressLZFSE (Buffer, BufferSize, Src[0], SrcLen[0]);
+      break;
+
+    default:
+      OutSize = 0;
+      break;
+  }
+
+  if (CompressedData != NULL) {
+    FreePool (CompressedData);
+  }
+
+  return OutSize == BufferSize;
+}
+
+/**
+  Decompress chunks until none are left. Chunks are claimed one at a time,
+  so processors finishing early pick up the remaining work.
+  This runs on APs and must not use boot services or print.
+
+  @param[in,out] MpContext  Decompression state.
+  @param[in]     Scratch    OC_INFLATE_SCRATCH_SIZE bytes owned by this processor.
+**/
+STATIC
+VOID
+InternalDecompressChunksLoop (
+  IN OUT INTERNAL_DMG_MP_CONTEXT  *MpContext,
+  IN     UINT8                    *Scratch
+  )
+{
+  INTERNAL_DMG_MP_JOB      *Job;
+  UINT32                   Index;
+
+  while (TRUE) {
+    Index = InterlockedIncrement (&MpContext->NextJob) - 1;
+    if (Index >= MpContext->JobCount) {
+      break;
+    }
+
+    Job       = &MpContext->Jobs[Index];
+    Job->Done = InternalDecompressChunk (
+                  MpContext->Context,
+                  Job->Chunk,
+                  0,
+                  Job->Buffer,
+                  Job->Size,
+                  Scratch
+                  );
+  }
+}
+
+/**
+  AP entry point, claims a scratch buffer and decompresses chunks.
+  Scratch buffer 0 is reserved for the BSP.
+
+  @param[in,out] Buffer  Decompression state.
+**/
+STATIC
+VOID
+EFIAPI
+InternalDecompressChunksWorker (
+  IN OUT VOID  *Buffer
+  )
+{
+  INTERNAL_DMG_MP_CONTEXT  *MpContext;
+  UINT32                   Index;
+
+  MpContext = Buffer;
+
+  Index = InterlockedIncrement (&MpContext->NextScratch) - 1;
+  if (Index < MpContext->ScratchCount) {
+    InternalDecompressChunksLoop (
+      MpContext,
+      MpContext->Scratch + (UINTN) Index * OC_INFLATE_SCRATCH_SIZE
+      );
+  }
+
+  //
+  // Decompression state may be freed as soon as every AP is counted.
+  //
+  InterlockedIncrement (&MpContext->FinishedWorkers);
+}
+
+/**
+  Close AP completion event once MP services reap the APs.
+
+  @param[in] Event    Completion event.
+  @param[in] Context  Unused.
+**/
+STATIC
+VOID
+EFIAPI
+InternalCloseApEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  gBS->CloseEvent (Event);
+}
+
+/**
+  Collect ADC and ZLIB chunks fully covered by read request.
+
+  @param[in,out] Context     DMG context.
+  @param[in]     Lba         First sector to read.
+  @param[in]     BufferSize  Amount of data to read.
+  @param[out]    Buffer      Resulting data.
+  @param[out]    Jobs        Decompression jobs, optional.
+
+  @return  Number of chunks found.
+**/
+STATIC
+UINT32
+InternalCollectChunkJobs (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINT64                       Lba,
+  IN     UINTN                        BufferSize,
+  OUT    UINT8                        *Buffer,
+  OUT    INTERNAL_DMG_MP_JOB          *Jobs  OPTIONAL
+  )
+{
+  APPLE_DISK_IMAGE_BLOCK_DATA *BlockData;
+  APPLE_DISK_IMAGE_CHUNK      *Chunk;
+  UINT64                      LbaOffset;
+  UINT64                      ChunkTotalLength;
+  UINT64                      ChunkOffset;
+  UINTN                       BufferChunkSize;
+  UINT32                      JobCount;
+
+  JobCount = 0;
+
+  while (BufferSize > 0 && JobCount < MAX_UINT32 / 2) {
+    if (!InternalGetBlockChunk (Context, Lba, &BlockData, &Chunk)) {
+      break;
+    }
+
+    LbaOffset = Lba - DMG_SECTOR_START_ABS (BlockData, Chunk);
+    if (OcOverflowMulU64 (Chunk->SectorCount, APPLE_DISK_IMAGE_SECTOR_SIZE, &ChunkTotalLength)) {
+      break;
+    }
+
+    ChunkOffset     = LbaOffset * APPLE_DISK_IMAGE_SECTOR_SIZE;
+    BufferChunkSize = (UINTN) MIN (BufferSize, ChunkTotalLength - ChunkOffset);
+
+    if ((Chunk->Type == APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB
+      || Chunk->Type == APPLE_DISK_IMAGE_CHUNK_TYPE_ADC)
+      && ChunkOffset == 0 && BufferChunkSize == ChunkTotalLength) {
+      if (Jobs != NULL) {
+        Jobs[JobCount].Chunk  = Chunk;
+        Jobs[JobCount].Buffer = Buffer;
+        Jobs[JobCount].Size   = BufferChunkSize;
+        Jobs[JobCount].Done   = FALSE;
+      }
+
+      ++JobCount;
+    }
+
+    BufferSize -= BufferChunkSize;
+    Buffer     += BufferChunkSize;
+    Lba        += Chunk->SectorCount - LbaOffset;
+  }
+
+  return JobCount;
+}
+
+/**
+  Decompress chunks fully covered by read request across all processors.
+  Chunks failing to decompress on APs are left to the BSP.
+
+  @param[in,out] Context     DMG context.
+  @param[in]     Lba         First sector to read.
+  @param[in]     BufferSize  Amount of data to read.
+  @param[out]    Buffer      Resulting data.
+  @param[out]    JobCount    Number of returned jobs.
+
+  @return  Decompression jobs in request order, NULL when not applicable.
+**/
+STATIC
+INTERNAL_DMG_MP_JOB *
+InternalDecompressChunksMp (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINT64                       Lba,
+  IN     UINTN                        BufferSize,
+  OUT    UINT8                        *Buffer,
+  OUT    UINT32                       *JobCount
+  )
+{
+  EFI_STATUS               Status;
+  INTERNAL_DMG_MP_CONTEXT  MpContext;
+  UINTN                    ProcessorCount;
+  UINTN                    EnabledProcessorCount;
+  EFI_EVENT                ApEvent;
+  BOOLEAN                  Blocking;
+
+  Status = Context->MpServices->GetNumberOfProcessors (
+                                  Context->MpServices,
+                                  &ProcessorCount,
+                                  &EnabledProcessorCount
+                                  );
+  if (EFI_ERROR (Status) || EnabledProcessorCount < 2) {
+    return NULL;
+  }
+
+  //
+  // Parallel decompression only pays off with several chunks.
+  //
+  MpContext.JobCount = InternalCollectChunkJobs (Context, Lba, BufferSize, Buffer, NULL);
+  if (MpContext.JobCount < 2) {
+    return NULL;
+  }
+
+  MpContext.Jobs = AllocatePool (MpContext.JobCount * sizeof (*MpContext.Jobs));
+  if (MpContext.Jobs == NULL) {
+    return NULL;
+  }
+
+  //
+  // Enabled processor count includes the BSP, which decompresses as well.
+  //
+  MpContext.ScratchCount = (UINT32) MIN (EnabledProcessorCount, MpContext.JobCount);
+  MpContext.Scratch      = AllocatePool (MpContext.ScratchCount * OC_INFLATE_SCRATCH_SIZE);
+  if (MpContext.Scratch == NULL) {
+    FreePool (MpContext.Jobs);
+    return NULL;
+  }
+
+  InternalCollectChunkJobs (Context, Lba, BufferSize, Buffer, MpContext.Jobs);
+
+  MpContext.Context         = Context;
+  MpContext.NextJob         = 0;
+  MpContext.NextScratch     = 1;
+  MpContext.FinishedWorkers = 0;
+
+  //
+  // Start APs in non-blocking mode, so that the BSP decompresses at the same time.
+  // MP services signal the event only from a periodic timer, so APs report
+  // completion through a counter, and the event just closes itself afterwards.
+  // Fall back to blocking mode when no event can be used.
+  //
+  Status = gBS->CreateEvent (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  InternalCloseApEvent,
+                  NULL,
+                  &ApEvent
+                  );
+  Blocking = EFI_ERROR (Status);
+  if (!Blocking) {
+    Status = Context->MpServices->StartupAllAPs (
+                                    Context->MpServices,
+                                    InternalDecompressChunksWorker,
+                                    FALSE,
+                                    ApEvent,
+                                    0,
+                                    &MpContext,
+                                    NULL
+                                    );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (ApEvent);
+      Blocking = Status == EFI_UNSUPPORTED;
+    }
+  }
+
+  if (Blocking) {
+    Status = Context->MpServices->StartupAllAPs (
+                                    Context->MpServices,
+                                    InternalDecompressChunksWorker,
+                                    FALSE,
+                                    NULL,
+                                    0,
+                                    &MpContext,
+                                    NULL
+                                    );
+  }
+
+  //
+  // APs stay busy until MP services reap them, so back to back reads
+  // may find them not ready and run on the BSP alone.
+  //
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      Status == EFI_NOT_READY ? DEBUG_VERBOSE : DEBUG_INFO,
+      "OCDI: StartupAllAPs for %u chunks failed - %r\n",
+      MpContext.JobCount,
+      Status
+      ));
+  }
+
+  //
+  // Chunks not taken by APs, or left when APs failed to start, are done here.
+  //
+  InternalDecompressChunksLoop (&MpContext, MpContext.Scratch);
+
+  //
+  // Locked read makes AP decompressed data visible once all of them are counted.
+  //
+  if (!EFI_ERROR (Status)) {
+    while (InterlockedCompareExchange32 (&MpContext.FinishedWorkers, 0, 0)
+      < EnabledProcessorCount - 1) {
+      CpuPause ();
+    }
+  }
+
+  FreePool (MpContext.Scratch);
+
+  *JobCount = MpContext.JobCount;
+  return MpContext.Jobs;
+}
+
+/**
+  Read disk image data, skipping chunks already decompressed in parallel.
+
+  @param[in,out] Context     DMG context.
+  @param[in]     Lba         First sector to read.
+  @param[in]     BufferSize  Amount of data to read.
+  @param[out]    Buffer      Resulting data.
+  @param[in]     Jobs        Parallel decompression jobs in request order, optional.
+  @param[in]     JobCount    Number of parallel decompression jobs.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalDiskImageRead (
   IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
   IN  UINT64                       Lba,
   IN  UINTN                        BufferSize,
-  OUT VOID                         *Buffer
+  OUT VOID                         *Buffer,
+  IN  CONST INTERNAL_DMG_MP_JOB    *Jobs  OPTIONAL,
+  IN  UINT32                       JobCount
   )
 {
   BOOLEAN                     Result;
@@ -244,7 +774,6 @@ OcAppleDiskImageRead (
   UINT64                      ChunkLength;
   UINT64                      ChunkOffset;
   UINT8                       *ChunkData;
-  UINT8                       *ChunkDataCompressed;
 
   UINT64                      LbaCurrent;
   UINT64                      LbaOffset;
@@ -253,13 +782,14 @@ OcAppleDiskImageRead (
   UINTN                       BufferChunkSize;
   UINT8                       *BufferCurrent;
 
-  UINTN                       OutSize;
-
-  ASSERT (Context != NULL);
-  ASSERT (Buffer != NULL);
-  ASSERT (Lba < Context->SectorCount);
+  OC_APPLE_RAM_DISK_SEGMENT   Segment;
+  UINT32                      SegmentCount;
+  UINTN                       MappedSize;
+  UINTN                       MappedOffset;
+  UINT32                      JobIndex;
 
   LbaCurrent          = Lba;
+  JobIndex            = 0;
   RemainingBufferSize = BufferSize;
   BufferCurrent       = Buffer;
 
@@ -304,51 +834,92 @@ OcAppleDiskImageRead (
 
       case APPLE_DISK_IMAGE_CHUNK_TYPE_RAW:
       {
-        Result = OcAppleRamDiskRead (
-                   Context->ExtentTable,
-                   (Chunk->CompressedOffset + ChunkOffset),
-                   BufferChunkSize,
-                   BufferCurrent
-                   );
-        if (!Result) {
-          return FALSE;
+        for (
+          MappedOffset = 0;
+          MappedOffset < BufferChunkSize;
+          MappedOffset += Segment.Size
+          ) {
+          SegmentCount = 1;
+          MappedSize   = OcAppleRamDiskMap (
+                           &Context->ExtentIndex,
+                           Chunk->CompressedOffset + ChunkOffset + MappedOffset,
+                           BufferChunkSize - MappedOffset,
+                           &Segment,
+                           &SegmentCount
+                           );
+          if (MappedSize == 0) {
+            return FALSE;
+          }
+
+          CopyMem (BufferCurrent + MappedOffset, Segment.Data, Segment.Size);
         }
 
         break;
       }
 
+      case APPLE_DISK_IMAGE_CHUNK_TYPE_ADC:
       case APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB:
+      case APPLE_DISK_IMAGE_CHUNK_TYPE_BZIP2:
+      case APPLE_DISK_IMAGE_CHUNK_TYPE_LZFSE:
       {
-        ChunkData = AllocatePool (ChunkTotalLength + Chunk->CompressedLength);
+        if (JobIndex < JobCount && Jobs[JobIndex].Chunk == Chunk) {
+          if (Jobs[JobIndex++].Done) {
+            break;
+          }
+        }
+
+        ChunkData = InternalGetCachedChunk (Context, Chunk);
+        if (ChunkData != NULL) {
+          CopyMem (BufferCurrent, (ChunkData + ChunkOffset), BufferChunkSize);
+          break;
+        }
+
+        //
+        // Decompress straight into the caller buffer when the whole chunk
+        // is requested. ZLIB can also be inflated partially when the chunk
+        // will not fit the cache anyway.
+        //
+        if ((ChunkOffset == 0 && BufferChunkSize == ChunkTotalLength)
+          || (Chunk->Type == APPLE_DISK_IMAGE_CHUNK_TYPE_ZLIB
+            && ChunkTotalLength > Context->ChunkCacheBudget)) {
+          Result = InternalDecompressChunk (
+                     Context,
+                     Chunk,
+                     (UINTN) ChunkOffset,
+                     BufferCurrent,
+                     BufferChunkSize,
+                     NULL
+                     );
+          if (!Result) {
+            return FALSE;
+          }
+
+          break;
+        }
+
+        ChunkData = AllocatePool (ChunkTotalLength);
         if (ChunkData == NULL) {
           return FALSE;
         }
 
-        ChunkDataCompressed = (ChunkData + ChunkTotalLength);
-        Result = OcAppleRamDiskRead (
-                   Context->ExtentTable,
-                   Chunk->CompressedOffset,
-                   Chunk->CompressedLength,
-                   ChunkDataCompressed
+        Result = InternalDecompressChunk (
+                   Context,
+                   Chunk,
+                   0,
+                   ChunkData,
+                   (UINTN) ChunkTotalLength,
+                   NULL
                    );
         if (!Result) {
           FreePool (ChunkData);
           return FALSE;
         }
 
-        OutSize = DecompressZLIB (
-                    ChunkData,
-                    ChunkTotalLength,
-                    ChunkDataCompressed,
-                    Chunk->CompressedLength
-                    );
-        if (OutSize != ChunkTotalLength) {
+        CopyMem (BufferCurrent, (ChunkData + ChunkOffset), BufferChunkSize);
+
+        if (!InternalCacheChunk (Context, Chunk, ChunkData, (UINTN)ChunkTotalLength)) {
           FreePool (ChunkData);
-          return FALSE;
         }
-
-        CopyMem (BufferCurrent, (ChunkData + ChunkOffset), BufferChunkSize);
-        FreePool (ChunkData);
         break;
       }
 
@@ -370,3 +941,35 @@ OcAppleDiskImageRead (
 
   return TRUE;
 }
+
+BOOLEAN
+OcAppleDiskImageRead (
+  IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN  UINT64                       Lba,
+  IN  UINTN                        BufferSize,
+  OUT VOID                         *Buffer
+  )
+{
+  BOOLEAN              Result;
+  INTERNAL_DMG_MP_JOB  *Jobs;
+  UINT32               JobCount;
+
+  ASSERT (Context != NULL);
+  ASSERT (Buffer != NULL);
+  ASSERT (Lba < Context->SectorCount);
+
+  Jobs     = NULL;
+  JobCount = 0;
+
+  if (Context->MpServices != NULL) {
+    Jobs = InternalDecompressChunksMp (Context, Lba, BufferSize, Buffer, &JobCount);
+  }
+
+  Result = InternalDiskImageRead (Context, Lba, BufferSize, Buffer, Jobs, JobCount);
+
+  if (Jobs != NULL) {
+    FreePool (Jobs);
+  }
+
+  return Result;
+}
@@ -13,6 +13,7 @@
 #include <Uefi.h>
 
 #include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcAppleDiskImageLib.h>
@@ -21,48 +22,6 @@
 
 #include "OcAppleDiskImageLibInternal.h"
 
-STATIC
-BOOLEAN
-InternalFindPlistDictChild (
-  IN  XML_NODE  *Node,
-  IN  CHAR8     *KeyName,
-  OUT XML_NODE  **Key,
-  OUT XML_NODE  **Value
-  )
-{
-  UINT32      ChildCount;
-  XML_NODE    *ChildValue;
-  XML_NODE    *ChildKey;
-  CONST CHAR8 *ChildKeyName;
-  UINT32      Index;
-
-  ASSERT (Node != NULL);
-  ASSERT (KeyName != NULL);
-  ASSERT (Key != NULL);
-  ASSERT (Value != NULL);
-
-  ChildCount = PlistDictChildren (Node);
-  for (Index = 0; Index < ChildCount; ++Index) {
-    ChildKey = PlistDictChild (Node, Index, &ChildValue);
-    if (ChildKey == NULL) {
-      break;
-    }
-
-    ChildKeyName = PlistKeyValue (ChildKey);
-    if (ChildKeyName == NULL) {
-      break;
-    }
-
-    if (AsciiStrCmp (ChildKeyName, KeyName) == 0) {
-      *Key   = ChildKey;
-      *Value = ChildValue;
-      return TRUE;
-    }
-  }
-
-  return FALSE;
-}
-
 STATIC
 BOOLEAN
 InternalSwapBlockData (
@@ -172,13 +131,10 @@ InternalParsePlist (
 
   XML_DOCUMENT                *XmlPlistDoc;
   XML_NODE                    *NodeRoot;
-  XML_NODE                    *NodeResourceForkKey;
   XML_NODE                    *NodeResourceForkValue;
-  XML_NODE                    *NodeBlockListKey;
   XML_NODE                    *NodeBlockListValue;
 
   XML_NODE                    *NodeBlockDict;
-  XML_NODE                    *BlockDictChildKey;
   XML_NODE                    *BlockDictChildValue;
   UINT32                      BlockDictChildDataSize;
 
@@ -210,23 +166,15 @@ InternalParsePlist (
     goto DONE_ERROR;
   }
 
-  Result = InternalFindPlistDictChild (
-             NodeRoot,
-             DMG_PLIST_RESOURCE_FORK_KEY,
-             &NodeResourceForkKey,
-             &NodeResourceForkValue
-             );
-  if (!Result) {
+  NodeResourceForkValue = PlistDictFind (NodeRoot, DMG_PLIST_RESOURCE_FORK_KEY);
+  if (NodeResourceForkValue == NULL) {
+    Result = FALSE;
     goto DONE_ERROR;
   }
 
-  Result = InternalFindPlistDictChild (
-             NodeResourceForkValue,
-             DMG_PLIST_BLOCK_LIST_KEY,
-             &NodeBlockListKey,
-             &NodeBlockListValue
-             );
-  if (!Result) {
+  NodeBlockListValue = PlistDictFind (NodeResourceForkValue, DMG_PLIST_BLOCK_LIST_KEY);
+  if (NodeBlockListValue == NULL) {
+    Result = FALSE;
     goto DONE_ERROR;
   }
 
@@ -250,13 +198,9 @@ InternalParsePlist (
   for (Index = 0; Index < NumDmgBlocks; ++Index) {
     NodeBlockDict = XmlNodeChild (NodeBlockListValue, Index);
 
-    Result = InternalFindPlistDictChild (
-               NodeBlockDict,
-               DMG_PLIST_DATA,
-               &BlockDictChildKey,
-               &BlockDictChildValue
-               );
-    if (!Result) {
+    BlockDictChildValue = PlistDictFind (NodeBlockDict, DMG_PLIST_DATA);
+    if (BlockDictChildValue == NULL) {
+      Result = FALSE;
       goto DONE_ERROR;
     }
 
@@ -310,36 +254,292 @@ DONE_ERROR:
   return Result;
 }
 
+STATIC
+VOID
+InternalSiftChunkIndex (
+  IN OUT OC_APPLE_DISK_IMAGE_CHUNK_INDEX  *Chunks,
+  IN     UINT32                           Root,
+  IN     UINT32                           Count
+  )
+{
+  UINT32                          Child;
+  OC_APPLE_DISK_IMAGE_CHUNK_INDEX Entry;
+
+  while ((Child = 2 * Root + 1) < Count) {
+    if ((Child + 1 < Count)
+     && (Chunks[Child].SectorNumber < Chunks[Child + 1].SectorNumber)) {
+      ++Child;
+    }
+
+    if (Chunks[Root].SectorNumber >= Chunks[Child].SectorNumber) {
+      break;
+    }
+
+    CopyMem (&Entry, &Chunks[Root], sizeof (Entry));
+    CopyMem (&Chunks[Root], &Chunks[Child], sizeof (Entry));
+    CopyMem (&Chunks[Child], &Entry, sizeof (Entry));
+    Root = Child;
+  }
+}
+
+STATIC
+VOID
+InternalSortChunkIndex (
+  IN OUT OC_APPLE_DISK_IMAGE_CHUNK_INDEX  *Chunks,
+  IN     UINT32                           Count
+  )
+{
+  UINT32                          Index;
+  OC_APPLE_DISK_IMAGE_CHUNK_INDEX Entry;
+
+  //
+  // Blocks are normally stored in sector order, avoid sorting then.
+  //
+  for (Index = 1; Index < Count; ++Index) {
+    if (Chunks[Index - 1].SectorNumber > Chunks[Index].SectorNumber) {
+      break;
+    }
+  }
+
+  if (Index >= Count) {
+    return;
+  }
+
+  for (Index = Count / 2; Index > 0; --Index) {
+    InternalSiftChunkIndex (Chunks, Index - 1, Count);
+  }
+
+  for (Index = Count - 1; Index > 0; --Index) {
+    CopyMem (&Entry, &Chunks[0], sizeof (Entry));
+    CopyMem (&Chunks[0], &Chunks[Index], sizeof (Entry));
+    CopyMem (&Chunks[Index], &Entry, sizeof (Entry));
+    InternalSiftChunkIndex (Chunks, 0, Index);
+  }
+}
+
 BOOLEAN
-InternalGetBlockChunk (
-  IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN  UINT64                       Lba,
-  OUT APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
-  OUT APPLE_DISK_IMAGE_CHUNK       **Chunk
+InternalBuildChunkIndex (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context
   )
 {
-  UINT32                      BlockIndex;
-  UINT32                      ChunkIndex;
-  APPLE_DISK_IMAGE_BLOCK_DATA *BlockData;
-  APPLE_DISK_IMAGE_CHUNK      *BlockChunk;
+  BOOLEAN                         Result;
+  UINT32                          BlockIndex;
+  UINT32                          ChunkIndex;
+  UINT32                          ChunkCount;
+  UINT32                          ChunksSize;
+  APPLE_DISK_IMAGE_BLOCK_DATA     *BlockData;
+  APPLE_DISK_IMAGE_CHUNK          *BlockChunk;
+  OC_APPLE_DISK_IMAGE_CHUNK_INDEX *Chunks;
+
+  ChunkCount = 0;
+
+  for (BlockIndex = 0; BlockIndex < Context->BlockCount; ++BlockIndex) {
+    Result = OcOverflowAddU32 (
+               ChunkCount,
+               Context->Blocks[BlockIndex]->ChunkCount,
+               &ChunkCount
+               );
+    if (Result) {
+      return FALSE;
+    }
+  }
+
+  Result = OcOverflowMulU32 (ChunkCount, sizeof (*Chunks), &ChunksSize);
+  if (Result) {
+    return FALSE;
+  }
+
+  Chunks = NULL;
+  if (ChunksSize > 0) {
+    Chunks = AllocatePool (ChunksSize);
+    if (Chunks == NULL) {
+      return FALSE;
+    }
+  }
+
+  //
+  // Empty chunks (comments, terminators) can never be looked up.
+  //
+  ChunkCount = 0;
 
   for (BlockIndex = 0; BlockIndex < Context->BlockCount; ++BlockIndex) {
     BlockData = Context->Blocks[BlockIndex];
 
-    if ((Lba >= BlockData->SectorNumber)
-     && (Lba < (BlockData->SectorNumber + BlockData->SectorCount))) {
-      for (ChunkIndex = 0; ChunkIndex < BlockData->ChunkCount; ++ChunkIndex) {
-        BlockChunk = &BlockData->Chunks[ChunkIndex];
+    for (ChunkIndex = 0; ChunkIndex < BlockData->ChunkCount; ++ChunkIndex) {
+      BlockChunk = &BlockData->Chunks[ChunkIndex];
 
-        if ((Lba >= DMG_SECTOR_START_ABS (BlockData, BlockChunk))
-         && (Lba < (DMG_SECTOR_START_ABS (BlockData, BlockChunk) + BlockChunk->SectorCount))) {
-          *Data  = BlockData;
-          *Chunk = BlockChunk;
-          return TRUE;
+      if (BlockChunk->SectorCount == 0) {
+        continue;
+      }
+
+      Chunks[ChunkCount].SectorNumber = DMG_SECTOR_START_ABS (BlockData, BlockChunk);
+      Chunks[ChunkCount].SectorCount  = BlockChunk->SectorCount;
+      Chunks[ChunkCount].Block        = BlockData;
+      Chunks[ChunkCount].Chunk        = BlockChunk;
+      ++ChunkCount;
+    }
+  }
+
+  InternalSortChunkIndex (Chunks, ChunkCount);
+
+  Context->ChunkCount = ChunkCount;
+  Context->LastChunk  = 0;
+  Context->Chunks     = Chunks;
+
+  return TRUE;
+}
+
+STATIC
+BOOLEAN
+InternalChunkIndexHasLba (
+  IN CONST OC_APPLE_DISK_IMAGE_CHUNK_INDEX  *Entry,
+  IN UINT64                                 Lba
+  )
+{
+  return (Lba >= Entry->SectorNumber)
+      && ((Lba - Entry->SectorNumber) < Entry->SectorCount);
+}
+
+BOOLEAN
+InternalGetBlockChunk (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINT64                       Lba,
+  OUT    APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
+  OUT    APPLE_DISK_IMAGE_CHUNK       **Chunk
+  )
+{
+  UINT32                          Index;
+  UINT32                          Start;
+  UINT32                          End;
+  OC_APPLE_DISK_IMAGE_CHUNK_INDEX *Entry;
+
+  if (Context->ChunkCount == 0) {
+    return FALSE;
+  }
+
+  //
+  // Sequential reads either stay within the last chunk or move to the next one.
+  //
+  Index = Context->LastChunk;
+  if (!InternalChunkIndexHasLba (&Context->Chunks[Index], Lba)) {
+    ++Index;
+    if ((Index >= Context->ChunkCount)
+     || !InternalChunkIndexHasLba (&Context->Chunks[Index], Lba)) {
+      //
+      // Find the last chunk starting at or before Lba.
+      //
+      Start = 0;
+      End   = Context->ChunkCount;
+      while (Start < End) {
+        Index = Start + (End - Start) / 2;
+        if (Context->Chunks[Index].SectorNumber <= Lba) {
+          Start = Index + 1;
+        } else {
+          End = Index;
         }
       }
+
+      if (Start == 0) {
+        return FALSE;
+      }
+
+      Index = Start - 1;
+      if (!InternalChunkIndexHasLba (&Context->Chunks[Index], Lba)) {
+        return FALSE;
+      }
+    }
+  }
+
+  Entry              = &Context->Chunks[Index];
+  Context->LastChunk = Index;
+  *Data              = Entry->Block;
+  *Chunk             = Entry->Chunk;
+
+  return TRUE;
+}
+
+UINT8 *
+InternalGetCachedChunk (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT   *Context,
+  IN     CONST APPLE_DISK_IMAGE_CHUNK  *Chunk
+  )
+{
+  LIST_ENTRY                       *Link;
+  OC_APPLE_DISK_IMAGE_CACHED_CHUNK *CachedChunk;
+
+  for (
+    Link = GetFirstNode (&Context->ChunkCache);
+    !IsNull (&Context->ChunkCache, Link);
+    Link = GetNextNode (&Context->ChunkCache, Link)
+    ) {
+    CachedChunk = OC_APPLE_DISK_IMAGE_CACHED_CHUNK_FROM_LINK (Link);
+
+    if (CachedChunk->Chunk == Chunk) {
+      if (Link != GetFirstNode (&Context->ChunkCache)) {
+        RemoveEntryList (Link);
+        InsertHeadList (&Context->ChunkCache, Link);
+      }
+
+      ++Context->ChunkCacheHits;
+      return CachedChunk->Data;
     }
   }
 
-  return FALSE;
+  ++Context->ChunkCacheMisses;
+  return NULL;
+}
+
+BOOLEAN
+InternalCacheChunk (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT   *Context,
+  IN     CONST APPLE_DISK_IMAGE_CHUNK  *Chunk,
+  IN     UINT8                         *Data,
+  IN     UINTN                         DataSize
+  )
+{
+  OC_APPLE_DISK_IMAGE_CACHED_CHUNK *CachedChunk;
+
+  if (DataSize > Context->ChunkCacheBudget) {
+    return FALSE;
+  }
+
+  CachedChunk = AllocatePool (sizeof (*CachedChunk));
+  if (CachedChunk == NULL) {
+    return FALSE;
+  }
+
+  InternalTrimChunkCache (Context, Context->ChunkCacheBudget - DataSize);
+
+  CachedChunk->Signature = OC_APPLE_DISK_IMAGE_CACHED_CHUNK_SIGNATURE;
+  CachedChunk->Chunk     = Chunk;
+  CachedChunk->DataSize  = DataSize;
+  CachedChunk->Data      = Data;
+
+  InsertHeadList (&Context->ChunkCache, &CachedChunk->Link);
+  Context->ChunkCacheSize += DataSize;
+
+  return TRUE;
+}
+
+VOID
+InternalTrimChunkCache (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Budget
+  )
+{
+  LIST_ENTRY                       *Link;
+  OC_APPLE_DISK_IMAGE_CACHED_CHUNK *CachedChunk;
+
+  while (Context->ChunkCacheSize > Budget) {
+    ASSERT (!IsListEmpty (&Context->ChunkCache));
+
+    Link        = GetPreviousNode (&Context->ChunkCache, &Context->ChunkCache);
+    CachedChunk = OC_APPLE_DISK_IMAGE_CACHED_CHUNK_FROM_LINK (Link);
+
+    RemoveEntryList (Link);
+    Context->ChunkCacheSize -= CachedChunk->DataSize;
+
+    FreePool (CachedChunk->Data);
+    FreePool (CachedChunk);
+  }
 }
@@ -26,6 +26,28 @@
 #define DMG_PLIST_ID                 "ID"
 #define DMG_PLIST_NAME               "Name"
 
+#define OC_APPLE_DISK_IMAGE_CACHED_CHUNK_SIGNATURE  \
+  SIGNATURE_32('D','m','g','C')
+
+#define OC_APPLE_DISK_IMAGE_CACHED_CHUNK_FROM_LINK(This)  \
+  CR (                                                    \
+    (This),                                               \
+    OC_APPLE_DISK_IMAGE_CACHED_CHUNK,                     \
+    Link,                                                 \
+    OC_APPLE_DISK_IMAGE_CACHED_CHUNK_SIGNATURE            \
+    )
+
+//
+// Decompressed chunk cache entry.
+//
+typedef struct {
+  UINT32                        Signature;
+  LIST_ENTRY                    Link;
+  CONST APPLE_DISK_IMAGE_CHUNK  *Chunk;
+  UINTN                         DataSize;
+  UINT8                         *Data;
+} OC_APPLE_DISK_IMAGE_CACHED_CHUNK;
+
 BOOLEAN
 InternalParsePlist (
   IN  CHAR8                        *Plist,
@@ -36,12 +58,69 @@ InternalParsePlist (
   OUT APPLE_DISK_IMAGE_BLOCK_DATA  ***Blocks
   );
 
+/**
+  Build sorted chunk index of all disk image blocks.
+
+  @param[in,out] Context  Disk image context with blocks.
+
+  @return  TRUE on success.
+**/
+BOOLEAN
+InternalBuildChunkIndex (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context
+  );
+
 BOOLEAN
 InternalGetBlockChunk (
-  IN  OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
-  IN  UINT64                       Lba,
-  OUT APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
-  OUT APPLE_DISK_IMAGE_CHUNK       **Chunk
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINT64                       Lba,
+  OUT    APPLE_DISK_IMAGE_BLOCK_DATA  **Data,
+  OUT    APPLE_DISK_IMAGE_CHUNK       **Chunk
+  );
+
+/**
+  Lookup decompressed chunk in cache and mark it most recently used.
+
+  @param[in,out] Context  Disk image context.
+  @param[in]     Chunk    Chunk to lookup.
+
+  @return  decompressed chunk data or NULL.
+**/
+UINT8 *
+InternalGetCachedChunk (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT   *Context,
+  IN     CONST APPLE_DISK_IMAGE_CHUNK  *Chunk
+  );
+
+/**
+  Insert decompressed chunk into cache, evicting least recently used chunks.
+  On success the cache takes ownership of Data.
+
+  @param[in,out] Context   Disk image context.
+  @param[in]     Chunk     Decompressed chunk.
+  @param[in]     Data      Pool allocated chunk data.
+  @param[in]     DataSize  Chunk data size.
+
+  @return  TRUE when Data was cached.
+**/
+BOOLEAN
+InternalCacheChunk (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT   *Context,
+  IN     CONST APPLE_DISK_IMAGE_CHUNK  *Chunk,
+  IN     UINT8                         *Data,
+  IN     UINTN                         DataSize
+  );
+
+/**
+  Evict least recently used chunks until cache fits Budget.
+
+  @param[in,out] Context  Disk image context.
+  @param[in]     Budget   Cache size in bytes to fit.
+**/
+VOID
+InternalTrimChunkCache (
+  IN OUT OC_APPLE_DISK_IMAGE_CONTEXT  *Context,
+  IN     UINTN                        Budget
   );
 
 #endif // APPLE_DISK_IMAGE_LIB_INTERNAL_H
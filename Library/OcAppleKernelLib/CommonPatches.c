@@ -31,19 +31,6 @@ mAppleIntelCPUPowerManagementPatchReplace[] = {
   0x90, 0x90                        // nop nop
 };
 
-STATIC
-PATCHER_GENERIC_PATCH
-mAppleIntelCPUPowerManagementPatch = {
-  .Base        = NULL,
-  .Find        = mAppleIntelCPUPowerManagementPatchFind,
-  .Mask        = NULL,
-  .Replace     = mAppleIntelCPUPowerManagementPatchReplace,
-  .ReplaceMask = NULL,
-  .Size        = sizeof (mAppleIntelCPUPowerManagementPatchFind),
-  .Count       = 0,
-  .Skip        = 0
-};
-
 STATIC
 UINT8
 mAppleIntelCPUPowerManagementPatch2Find[] = {
@@ -78,15 +65,27 @@ mAppleIntelCPUPowerManagementPatch2ReplaceMask[] = {
 
 STATIC
 PATCHER_GENERIC_PATCH
-mAppleIntelCPUPowerManagementPatch2 = {
-  .Base        = NULL,
-  .Find        = mAppleIntelCPUPowerManagementPatch2Find,
-  .Mask        = mAppleIntelCPUPowerManagementPatch2FindMask,
-  .Replace     = mAppleIntelCPUPowerManagementPatch2Replace,
-  .ReplaceMask = mAppleIntelCPUPowerManagementPatch2ReplaceMask,
-  .Size        = sizeof (mAppleIntelCPUPowerManagementPatch2Find),
-  .Count       = 0,
-  .Skip        = 0
+mAppleIntelCPUPowerManagementPatches[] = {
+  {
+    .Base        = NULL,
+    .Find        = mAppleIntelCPUPowerManagementPatchFind,
+    .Mask        = NULL,
+    .Replace     = mAppleIntelCPUPowerManagementPatchReplace,
+    .ReplaceMask = NULL,
+    .Size        = sizeof (mAppleIntelCPUPowerManagementPatchFind),
+    .Count       = 0,
+    .Skip        = 0
+  },
+  {
+    .Base        = NULL,
+    .Find        = mAppleIntelCPUPowerManagementPatch2Find,
+    .Mask        = mAppleIntelCPUPowerManagementPatch2FindMask,
+    .Replace     = mAppleIntelCPUPowerManagementPatch2Replace,
+    .ReplaceMask = mAppleIntelCPUPowerManagementPatch2ReplaceMask,
+    .Size        = sizeof (mAppleIntelCPUPowerManagementPatch2Find),
+    .Count       = 0,
+    .Skip        = 0
+  }
 };
 
 RETURN_STATUS
@@ -95,8 +94,9 @@ PatchAppleCpuPmCfgLock (
   )
 {
   RETURN_STATUS       Status;
-  RETURN_STATUS       Status2;
+  RETURN_STATUS       Results[ARRAY_SIZE (mAppleIntelCPUPowerManagementPatches)];
   PATCHER_CONTEXT     Patcher;
+  UINT32              Index;
 
   Status = PatcherInitContextFromPrelinked (
     &Patcher,
@@ -105,23 +105,24 @@ PatchAppleCpuPmCfgLock (
     );
 
   if (!RETURN_ERROR (Status)) {
-    Status = PatcherApplyGenericPatch (&Patcher, &mAppleIntelCPUPowerManagementPatch);
-    if (RETURN_ERROR (Status)) {
-      DEBUG ((DEBUG_INFO, "Failed to apply patch com.apple.driver.AppleIntelCPUPowerManagement - %r\n", Status));
-    } else {
-      DEBUG ((DEBUG_INFO, "Patch success com.apple.driver.AppleIntelCPUPowerManagement\n"));
-    }
-    Status2 = PatcherApplyGenericPatch (&Patcher, &mAppleIntelCPUPowerManagementPatch2);
-    if (RETURN_ERROR (Status2)) {
-      DEBUG ((DEBUG_INFO, "Failed to apply patch com.apple.driver.AppleIntelCPUPowerManagement - %r\n", Status2));
-    } else {
-      DEBUG ((DEBUG_INFO, "Patch success com.apple.driver.AppleIntelCPUPowerManagement\n"));
+    Status = PatcherApplyGenericPatches (
+      &Patcher,
+      mAppleIntelCPUPowerManagementPatches,
+      ARRAY_SIZE (mAppleIntelCPUPowerManagementPatches),
+      Results
+      );
+    for (Index = 0; Index < ARRAY_SIZE (Results); ++Index) {
+      if (RETURN_ERROR (Results[Index])) {
+        DEBUG ((DEBUG_INFO, "Failed to apply patch com.apple.driver.AppleIntelCPUPowerManagement - %r\n", Results[Index]));
+      } else {
+        DEBUG ((DEBUG_INFO, "Patch success com.apple.driver.AppleIntelCPUPowerManagement\n"));
+      }
     }
   } else {
     DEBUG ((DEBUG_INFO, "Failed to find com.apple.driver.AppleIntelCPUPowerManagement - %r\n", Status));
   }
 
-  return RETURN_ERROR (Status) ? Status : Status2;
+  return Status;
 }
 
 #pragma pack(push, 1)
@@ -19,6 +19,7 @@
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcAppleKernelLib.h>
 #include <Library/OcMachoLib.h>
 #include <Library/OcMiscLib.h>
@@ -180,6 +181,105 @@ PatcherApplyGenericPatch (
   return RETURN_NOT_FOUND;
 }
 
+RETURN_STATUS
+PatcherApplyGenericPatches (
+  IN OUT PATCHER_CONTEXT        *Context,
+  IN     PATCHER_GENERIC_PATCH  *Patches,
+  IN     UINT32                 PatchCount,
+     OUT RETURN_STATUS          *Results  OPTIONAL
+  )
+{
+  RETURN_STATUS    Status;
+  RETURN_STATUS    PatchStatus;
+  PATTERN_PATCH    *Patterns;
+  BOOLEAN          *Enabled;
+  UINT32           *ReplaceCounts;
+  PATTERN_MATCHER  Matcher;
+  UINT32           Index;
+  UINT32           PatternCount;
+
+  Status        = RETURN_SUCCESS;
+  PatternCount  = 0;
+  Patterns      = NULL;
+  Enabled       = NULL;
+  ReplaceCounts = NULL;
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    if (Patches[Index].Base == NULL && Patches[Index].Find != NULL) {
+      ++PatternCount;
+    }
+  }
+
+  //
+  // Matching several patterns at once needs scratch memory. When it is not
+  // available or not worth it fall back to applying the patches one by one.
+  //
+  if (PatternCount > 1) {
+    Patterns      = AllocatePool (PatchCount * (sizeof (*Patterns) + sizeof (*Enabled) + sizeof (*ReplaceCounts)));
+    if (Patterns != NULL) {
+      ReplaceCounts = (UINT32 *) &Patterns[PatchCount];
+      Enabled       = (BOOLEAN *) &ReplaceCounts[PatchCount];
+
+      for (Index = 0; Index < PatchCount; ++Index) {
+        Patterns[Index].Pattern     = Patches[Index].Find;
+        Patterns[Index].PatternMask = Patches[Index].Mask;
+        Patterns[Index].Replace     = Patches[Index].Replace;
+        Patterns[Index].ReplaceMask = Patches[Index].ReplaceMask;
+        Patterns[Index].PatternSize = Patches[Index].Size;
+        Patterns[Index].Count       = Patches[Index].Count;
+        Patterns[Index].Skip        = Patches[Index].Skip;
+        Patterns[Index].Limit       = Patches[Index].Limit;
+        Enabled[Index]              = Patches[Index].Base == NULL && Patches[Index].Find != NULL;
+      }
+
+      if (!RETURN_ERROR (PatternMatcherInit (&Matcher, Patterns, PatchCount))) {
+        ApplyPatches (
+          &Matcher,
+          (UINT8 *)MachoGetMachHeader64 (&Context->MachContext),
+          MachoGetFileSize (&Context->MachContext),
+          Enabled,
+          ReplaceCounts
+          );
+        PatternMatcherFree (&Matcher);
+      } else {
+        FreePool (Patterns);
+        Patterns = NULL;
+      }
+    }
+  }
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    if (Patterns != NULL && Enabled[Index]) {
+      if (ReplaceCounts[Index] > 0 && Patches[Index].Count > 0 && ReplaceCounts[Index] != Patches[Index].Count) {
+        DEBUG ((
+          DEBUG_INFO,
+          "Performed only %u replacements out of %u\n",
+          ReplaceCounts[Index],
+          Patches[Index].Count
+          ));
+      }
+
+      PatchStatus = ReplaceCounts[Index] > 0 ? RETURN_SUCCESS : RETURN_NOT_FOUND;
+    } else {
+      PatchStatus = PatcherApplyGenericPatch (Context, &Patches[Index]);
+    }
+
+    if (Results != NULL) {
+      Results[Index] = PatchStatus;
+    }
+
+    if (RETURN_ERROR (PatchStatus)) {
+      Status = PatchStatus;
+    }
+  }
+
+  if (Patterns != NULL) {
+    FreePool (Patterns);
+  }
+
+  return Status;
+}
+
 RETURN_STATUS
 PatcherBlockKext (
   IN OUT PATCHER_CONTEXT        *Context
@@ -24,6 +24,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcAppleKernelLib.h>
 #include <Library/OcGuardLib.h>
 #include <Library/OcMachoLib.h>
+#include <Library/OcStringLib.h>
 
 #include "PrelinkedInternal.h"
 
@@ -34,12 +35,56 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 // Symbols
 //
 
+/**
+  Find symbol by name in kext LinkedSymbolHash.
+
+  @param[in] Kext               Kext with LinkedSymbolHash.
+  @param[in] LookupValue        Symbol name.
+  @param[in] LookupValueLength  Symbol name length.
+  @param[in] LookupValueHash    Symbol name hash.
+
+  @return  first symbol with matching name or NULL.
+**/
+STATIC
+CONST PRELINKED_KEXT_SYMBOL *
+InternalOcGetSymbolHashName (
+  IN PRELINKED_KEXT                   *Kext,
+  IN CONST CHAR8                      *LookupValue,
+  IN UINT32                           LookupValueLength,
+  IN UINT32                           LookupValueHash
+  )
+{
+  CONST PRELINKED_KEXT_SYMBOL_HASH  *SymbolHash;
+  CONST PRELINKED_KEXT_SYMBOL       *Symbol;
+  UINT32                            Mask;
+  UINT32                            Slot;
+
+  SymbolHash = Kext->LinkedSymbolHash;
+  Mask       = Kext->LinkedSymbolHashSize - 1;
+  Slot       = LookupValueHash & Mask;
+
+  while (SymbolHash[Slot].Index != 0) {
+    if (SymbolHash[Slot].Hash == LookupValueHash) {
+      Symbol = &Kext->LinkedSymbolTable[SymbolHash[Slot].Index - 1];
+      if (Symbol->Length == LookupValueLength
+        && CompareMem (Symbol->Name, LookupValue, LookupValueLength) == 0) {
+        return Symbol;
+      }
+    }
+
+    Slot = (Slot + 1) & Mask;
+  }
+
+  return NULL;
+}
+
 STATIC
 CONST PRELINKED_KEXT_SYMBOL *
 InternalOcGetSymbolWorkerName (
   IN PRELINKED_KEXT                   *Kext,
   IN CONST CHAR8                      *LookupValue,
   IN UINT32                           LookupValueLength,
+  IN UINT32                           LookupValueHash,
   IN OC_GET_SYMBOL_LEVEL              SymbolLevel
   )
 {
@@ -63,6 +108,26 @@ InternalOcGetSymbolWorkerName (
   }
 
   SymbolsEnd = &Symbols[NumSymbols];
+
+  if (Kext->LinkedSymbolHash != NULL) {
+    //
+    // Matches outside of the requested range are treated as misses.
+    // As C++-ness is a property of the name, this only happens for
+    // C symbols looked up in OcGetSymbolOnlyCxx mode.
+    //
+    SymbolsEnd = InternalOcGetSymbolHashName (
+      Kext,
+      LookupValue,
+      LookupValueLength,
+      LookupValueHash
+      );
+    if (SymbolsEnd != NULL && SymbolsEnd >= Symbols) {
+      return SymbolsEnd;
+    }
+
+    SymbolsEnd = Symbols;
+  }
+
   while (Symbols < SymbolsEnd) {
     //
     // Symbol names often start and end similarly due to C++ mangling (e.g. __ZN).
@@ -100,6 +165,7 @@ InternalOcGetSymbolWorkerName (
                  Dependency,
                  LookupValue,
                  LookupValueLength,
+                 LookupValueHash,
                  OcGetSymbolOnlyCxx
                  );
       if (Symbols != NULL) {
@@ -111,6 +177,55 @@ InternalOcGetSymbolWorkerName (
   return NULL;
 }
 
+/**
+  Find symbol by value in kext LinkedSymbolValues.
+
+  @param[in] Kext         Kext with LinkedSymbolValues.
+  @param[in] LookupValue  Symbol value.
+  @param[in] MinIndex     Lowest LinkedSymbolTable index to consider.
+
+  @return  lowest index symbol with matching value or NULL.
+**/
+STATIC
+CONST PRELINKED_KEXT_SYMBOL *
+InternalOcGetSymbolSortedValue (
+  IN PRELINKED_KEXT                   *Kext,
+  IN UINT64                           LookupValue,
+  IN UINT32                           MinIndex
+  )
+{
+  CONST PRELINKED_KEXT_SYMBOL_VALUE  *SymbolValues;
+  UINT32                             Low;
+  UINT32                             High;
+  UINT32                             Middle;
+
+  SymbolValues = Kext->LinkedSymbolValues;
+  Low          = 0;
+  High         = Kext->NumberOfSymbols;
+
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (SymbolValues[Middle].Value < LookupValue) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  //
+  // Symbols with equal values are ordered by index.
+  //
+  while (Low < Kext->NumberOfSymbols && SymbolValues[Low].Value == LookupValue) {
+    if (SymbolValues[Low].Index >= MinIndex) {
+      return &Kext->LinkedSymbolTable[SymbolValues[Low].Index];
+    }
+
+    ++Low;
+  }
+
+  return NULL;
+}
+
 STATIC
 CONST PRELINKED_KEXT_SYMBOL *
 InternalOcGetSymbolWorkerValue (
@@ -137,20 +252,40 @@ InternalOcGetSymbolWorkerValue (
     NumSymbols = Kext->NumberOfCxxSymbols;
     Symbols    = &Kext->LinkedSymbolTable[(Kext->NumberOfSymbols - Kext->NumberOfCxxSymbols) & ~15ULL];
   }
-  //
-  // WARN! Hot path! Do not change this code unless you have decent profiling data.
-  // We are not allowed to use SIMD in UEFI, but we can still do better with larger iteration.
-  // Up to 15 C symbols extra may get parsed, but it is fine, as they will not match.
-  // Increasing the iteration block to more than 16 no longer pays off.
-  // Note, lower loop is not on hot path.
-  //
-  SymbolsEnd = &Symbols[NumSymbols & ~15ULL];
-  while (Symbols < SymbolsEnd) {
-    #define MATCH(X) if (Symbols[X].Value == LookupValue) { return &Symbols[X]; }
-    MATCH (0) MATCH (1) MATCH (2)  MATCH (3)  MATCH (4)  MATCH (5)  MATCH (6)  MATCH (7)
-    MATCH (8) MATCH (9) MATCH (10) MATCH (11) MATCH (12) MATCH (13) MATCH (14) MATCH (15)
-    #undef MATCH
-    Symbols += 16;
+
+  if (Kext->LinkedSymbolValues != NULL) {
+    Symbols = InternalOcGetSymbolSortedValue (
+      Kext,
+      LookupValue,
+      Kext->NumberOfSymbols - NumSymbols
+      );
+    if (Symbols != NULL) {
+      return Symbols;
+    }
+  } else {
+    //
+    // WARN! Hot path! Do not change this code unless you have decent profiling data.
+    // We are not allowed to use SIMD in UEFI, but we can still do better with larger iteration.
+    // Up to 15 C symbols extra may get parsed, but it is fine, as they will not match.
+    // Increasing the iteration block to more than 16 no longer pays off.
+    // Note, lower loop is not on hot path.
+    //
+    SymbolsEnd = &Symbols[NumSymbols & ~15ULL];
+    while (Symbols < SymbolsEnd) {
+      #define MATCH(X) if (Symbols[X].Value == LookupValue) { return &Symbols[X]; }
+      MATCH (0) MATCH (1) MATCH (2)  MATCH (3)  MATCH (4)  MATCH (5)  MATCH (6)  MATCH (7)
+      MATCH (8) MATCH (9) MATCH (10) MATCH (11) MATCH (12) MATCH (13) MATCH (14) MATCH (15)
+      #undef MATCH
+      Symbols += 16;
+    }
+
+    SymbolsEnd = &Kext->LinkedSymbolTable[Kext->NumberOfSymbols];
+    while (Symbols < SymbolsEnd) {
+      if (Symbols->Value == LookupValue) {
+        return Symbols;
+      }
+      ++Symbols;
+    }
   }
 
   if (SymbolLevel != OcGetSymbolFirstLevel) {
@@ -191,9 +326,10 @@ InternalOcGetSymbolName (
   PRELINKED_KEXT              *Dependency;
   UINT32                      Index;
   UINT32                      LookupValueLength;
+  UINT32                      LookupValueHash;
 
   Symbol = NULL;
-  LookupValueLength = (UINT32)AsciiStrLen (LookupValue);
+  LookupValueHash = AsciiStrHash (LookupValue, &LookupValueLength);
 
   //
   // Such symbols are illegit, but InternalOcGetSymbolWorkerName assumes Length > 0.
@@ -207,6 +343,7 @@ InternalOcGetSymbolName (
       Kext,
       LookupValue,
       LookupValueLength,
+      LookupValueHash,
       SymbolLevel
       );
   } else {
@@ -220,6 +357,7 @@ InternalOcGetSymbolName (
                  Dependency,
                  LookupValue,
                  LookupValueLength,
+                 LookupValueHash,
                  SymbolLevel
                  );
       if (Symbol != NULL) {
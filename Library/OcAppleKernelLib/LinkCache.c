@@ -0,0 +1,501 @@
+/** @file
+  Persistent kext link cache.
+
+  Copyright (C) 2019, vit9696. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Uefi.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcAppleKernelLib.h>
+#include <Library/OcCryptoLib.h>
+#include <Library/OcFileLib.h>
+#include <Library/OcMachoLib.h>
+#include <Library/OcStorageLib.h>
+
+#include "PrelinkedInternal.h"
+
+/**
+  Validate link cache entry layout.
+
+  @param[in] Entry      Entry data.
+  @param[in] EntrySize  Available entry data size.
+
+  @return  entry size or 0 on failure.
+**/
+STATIC
+UINT32
+InternalLinkCacheEntrySize (
+  IN CONST UINT8  *Entry,
+  IN UINT32       EntrySize
+  )
+{
+  PRELINKED_LINK_CACHE_ENTRY  EntryHeader;
+  PRELINKED_LINK_CACHE_RUN    Run;
+  UINT32                      Offset;
+  UINT32                      Index;
+
+  if (EntrySize < sizeof (EntryHeader)) {
+    return 0;
+  }
+
+  CopyMem (&EntryHeader, Entry, sizeof (EntryHeader));
+  if (EntryHeader.Size < sizeof (EntryHeader)
+    || EntryHeader.Size > EntrySize
+    || EntryHeader.LinkedSize > EntryHeader.ImageSize) {
+    return 0;
+  }
+
+  Offset = sizeof (EntryHeader);
+  for (Index = 0; Index < EntryHeader.NumberOfRuns; ++Index) {
+    if (EntryHeader.Size - Offset < sizeof (Run)) {
+      return 0;
+    }
+
+    CopyMem (&Run, &Entry[Offset], sizeof (Run));
+    Offset += sizeof (Run);
+
+    if (EntryHeader.Size - Offset < Run.Size
+      || Run.Offset > EntryHeader.ImageSize
+      || Run.Size > EntryHeader.ImageSize - Run.Offset) {
+      return 0;
+    }
+
+    Offset += Run.Size;
+  }
+
+  if (Offset != EntryHeader.Size) {
+    return 0;
+  }
+
+  return EntryHeader.Size;
+}
+
+/**
+  Validate link cache file.
+
+  @param[in]  LinkCache  Link cache.
+  @param[in]  Cache      Cache file data.
+  @param[in]  CacheSize  Cache file size.
+  @param[out] Count      Number of cache entries.
+
+  @return  TRUE for valid cache matching current kernel.
+**/
+STATIC
+BOOLEAN
+InternalLinkCacheValidate (
+  IN  PRELINKED_LINK_CACHE  *LinkCache,
+  IN  CONST UINT8           *Cache,
+  IN  UINT32                CacheSize,
+  OUT UINT32                *Count
+  )
+{
+  PRELINKED_LINK_CACHE_HEADER  Header;
+  UINT32                       Offset;
+  UINT32                       EntrySize;
+  UINT32                       Index;
+
+  if (CacheSize < sizeof (Header)) {
+    return FALSE;
+  }
+
+  CopyMem (&Header, Cache, sizeof (Header));
+  if (Header.Signature != PRELINKED_LINK_CACHE_SIGNATURE
+    || Header.Version != PRELINKED_LINK_CACHE_VERSION
+    || Header.LinkerVersion != PRELINKED_LINKER_VERSION
+    || Header.Size < sizeof (Header)
+    || Header.Size > CacheSize
+    || CompareMem (Header.KernelUuid, LinkCache->KernelUuid, sizeof (Header.KernelUuid)) != 0) {
+    return FALSE;
+  }
+
+  Offset = sizeof (Header);
+  for (Index = 0; Index < Header.NumberOfEntries; ++Index) {
+    EntrySize = InternalLinkCacheEntrySize (&Cache[Offset], Header.Size - Offset);
+    if (EntrySize == 0) {
+      return FALSE;
+    }
+
+    Offset += EntrySize;
+  }
+
+  *Count = Header.NumberOfEntries;
+  return TRUE;
+}
+
+/**
+  Reserve space for new link cache entries.
+
+  @param[in,out] LinkCache  Link cache.
+  @param[in]     Size       Size to reserve.
+
+  @return  reserved space or NULL.
+**/
+STATIC
+UINT8 *
+InternalLinkCacheReserve (
+  IN OUT PRELINKED_LINK_CACHE  *LinkCache,
+  IN     UINT32                Size
+  )
+{
+  UINT8   *NewEntries;
+  UINT32  NewSize;
+  UINT32  NewAllocSize;
+
+  if (Size > PRELINKED_LINK_CACHE_MAX_SIZE - LinkCache->EntriesSize) {
+    return NULL;
+  }
+
+  NewSize = LinkCache->EntriesSize + Size;
+
+  if (NewSize > LinkCache->EntriesAllocSize) {
+    NewAllocSize = MAX (LinkCache->EntriesAllocSize * 2, BASE_64KB);
+    while (NewAllocSize < NewSize) {
+      NewAllocSize *= 2;
+    }
+
+    NewEntries = AllocatePool (NewAllocSize);
+    if (NewEntries == NULL) {
+      return NULL;
+    }
+
+    if (LinkCache->Entries != NULL) {
+      CopyMem (NewEntries, LinkCache->Entries, LinkCache->EntriesSize);
+      FreePool (LinkCache->Entries);
+    }
+
+    LinkCache->Entries          = NewEntries;
+    LinkCache->EntriesAllocSize = NewAllocSize;
+  }
+
+  LinkCache->EntriesSize = NewSize;
+  return &LinkCache->Entries[NewSize - Size];
+}
+
+VOID
+InternalLinkCacheDigest (
+  IN  PRELINKED_LINK_CACHE  *LinkCache,
+  IN  CONST CHAR8           *InfoPlist,
+  IN  UINT32                InfoPlistSize,
+  IN  CONST UINT8           *Executable,
+  IN  UINT32                ExecutableSize,
+  IN  UINT64                LoadAddress,
+  OUT UINT8                 *Digest
+  )
+{
+  SHA256_CONTEXT  Context;
+
+  //
+  // Chaining previous injection digest makes the result depend on
+  // the kernel and all kexts injected before this one.
+  //
+  Sha256Init (&Context);
+  Sha256Update (&Context, LinkCache->Digest, sizeof (LinkCache->Digest));
+  Sha256Update (&Context, (CONST UINT8 *) &LoadAddress, sizeof (LoadAddress));
+  Sha256Update (&Context, (CONST UINT8 *) &InfoPlistSize, sizeof (InfoPlistSize));
+  Sha256Update (&Context, (CONST UINT8 *) InfoPlist, InfoPlistSize);
+  Sha256Update (&Context, (CONST UINT8 *) &ExecutableSize, sizeof (ExecutableSize));
+  Sha256Update (&Context, Executable, ExecutableSize);
+  Sha256Final (&Context, Digest);
+}
+
+BOOLEAN
+InternalLinkCacheReplay (
+  IN OUT PRELINKED_LINK_CACHE  *LinkCache,
+  IN     CONST UINT8           *Digest,
+  IN OUT UINT8                 *Image,
+  IN     UINT32                ImageSize,
+  OUT    UINT32                *LinkedSize
+  )
+{
+  PRELINKED_LINK_CACHE_ENTRY  Entry;
+  PRELINKED_LINK_CACHE_RUN    Run;
+  CONST UINT8                 *Walker;
+  UINT8                       *NewEntry;
+  UINT32                      Offset;
+  UINT32                      Index;
+
+  Walker = NULL;
+  Offset = sizeof (PRELINKED_LINK_CACHE_HEADER);
+  for (Index = 0; Index < LinkCache->CacheCount; ++Index) {
+    CopyMem (&Entry, &LinkCache->Cache[Offset], sizeof (Entry));
+    if (CompareMem (Entry.Digest, Digest, sizeof (Entry.Digest)) == 0) {
+      Walker = &LinkCache->Cache[Offset];
+      break;
+    }
+
+    Offset += Entry.Size;
+  }
+
+  //
+  // Run bounds are validated against ImageSize at load time.
+  //
+  if (Walker == NULL || Entry.ImageSize != ImageSize) {
+    ++LinkCache->Misses;
+    return FALSE;
+  }
+
+  //
+  // Carry the entry over to the next cache first, so that a failure
+  // does not leave Image partially linked.
+  //
+  NewEntry = InternalLinkCacheReserve (LinkCache, Entry.Size);
+  if (NewEntry == NULL) {
+    ++LinkCache->Misses;
+    return FALSE;
+  }
+
+  CopyMem (NewEntry, Walker, Entry.Size);
+  ++LinkCache->EntriesCount;
+
+  Walker += sizeof (Entry);
+  for (Index = 0; Index < Entry.NumberOfRuns; ++Index) {
+    CopyMem (&Run, Walker, sizeof (Run));
+    Walker += sizeof (Run);
+    CopyMem (&Image[Run.Offset], Walker, Run.Size);
+    Walker += Run.Size;
+  }
+
+  *LinkedSize = Entry.LinkedSize;
+  ++LinkCache->Hits;
+  return TRUE;
+}
+
+VOID
+InternalLinkCacheRecord (
+  IN OUT PRELINKED_LINK_CACHE  *LinkCache,
+  IN     CONST UINT8           *Digest,
+  IN     CONST UINT8           *Original,
+  IN     CONST UINT8           *Image,
+  IN     UINT32                ImageSize,
+  IN     UINT32                LinkedSize
+  )
+{
+  PRELINKED_LINK_CACHE_ENTRY  Entry;
+  PRELINKED_LINK_CACHE_RUN    Run;
+  UINT8                       *Data;
+  UINT32                      EntryOffset;
+  UINT32                      Index;
+  UINT32                      End;
+
+  EntryOffset = LinkCache->EntriesSize;
+
+  CopyMem (Entry.Digest, Digest, sizeof (Entry.Digest));
+  Entry.ImageSize    = ImageSize;
+  Entry.LinkedSize   = LinkedSize;
+  Entry.NumberOfRuns = 0;
+
+  if (InternalLinkCacheReserve (LinkCache, sizeof (Entry)) == NULL) {
+    return;
+  }
+
+  Index = 0;
+  while (Index < ImageSize) {
+    if (Original[Index] == Image[Index]) {
+      ++Index;
+      continue;
+    }
+
+    //
+    // Merge changed bytes separated by short equal ranges.
+    //
+    Run.Offset = Index;
+    End        = Index + 1;
+    for (++Index; Index < ImageSize && Index - End < PRELINKED_LINK_CACHE_RUN_GAP; ++Index) {
+      if (Original[Index] != Image[Index]) {
+        End = Index + 1;
+      }
+    }
+
+    Run.Size = End - Run.Offset;
+    Data     = InternalLinkCacheReserve (LinkCache, sizeof (Run) + Run.Size);
+    if (Data == NULL) {
+      LinkCache->EntriesSize = EntryOffset;
+      return;
+    }
+
+    CopyMem (Data, &Run, sizeof (Run));
+    CopyMem (Data + sizeof (Run), &Image[Run.Offset], Run.Size);
+    ++Entry.NumberOfRuns;
+    Index = End;
+  }
+
+  Entry.Size = LinkCache->EntriesSize - EntryOffset;
+  CopyMem (&LinkCache->Entries[EntryOffset], &Entry, sizeof (Entry));
+  ++LinkCache->EntriesCount;
+}
+
+VOID
+InternalFreeLinkCache (
+  IN OUT PRELINKED_CONTEXT  *Context
+  )
+{
+  PRELINKED_LINK_CACHE  *LinkCache;
+
+  LinkCache = Context->LinkCache;
+  if (LinkCache == NULL) {
+    return;
+  }
+
+  if (LinkCache->Cache != NULL) {
+    FreePool (LinkCache->Cache);
+  }
+
+  if (LinkCache->Entries != NULL) {
+    FreePool (LinkCache->Entries);
+  }
+
+  FreePool (LinkCache);
+  Context->LinkCache = NULL;
+}
+
+RETURN_STATUS
+PrelinkedLinkCacheLoad (
+  IN OUT PRELINKED_CONTEXT   *Context,
+  IN     OC_STORAGE_CONTEXT  *Storage,
+  IN     CONST CHAR16        *FileName
+  )
+{
+  PRELINKED_LINK_CACHE  *LinkCache;
+  MACH_UUID_COMMAND     *Uuid;
+  SHA256_CONTEXT        ShaContext;
+  UINT8                 *Cache;
+  UINT32                CacheSize;
+
+  ASSERT (Context->LinkCache == NULL);
+
+  //
+  // Link cache is written at runtime and thus can never be in the vault.
+  // Cached runs are copied to kext images as is, so never trust them
+  // when the storage is expected to be verified.
+  //
+  if (Storage->HasVault) {
+    DEBUG ((DEBUG_INFO, "OCK: Link cache is not supported with vault\n"));
+    return RETURN_UNSUPPORTED;
+  }
+
+  Uuid = MachoGetUuid64 (&Context->PrelinkedMachContext);
+  if (Uuid == NULL) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  LinkCache = AllocateZeroPool (sizeof (*LinkCache));
+  if (LinkCache == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  CopyMem (LinkCache->KernelUuid, Uuid->Uuid, sizeof (LinkCache->KernelUuid));
+
+  //
+  // Kernel UUID does not change when prelinkedkernel is rebuilt with different kexts,
+  // so also bind the injection chain to the prelinked kext list.
+  //
+  Sha256Init (&ShaContext);
+  Sha256Update (&ShaContext, LinkCache->KernelUuid, sizeof (LinkCache->KernelUuid));
+  Sha256Update (
+    &ShaContext,
+    &Context->Prelinked[Context->PrelinkedInfoSection->Offset],
+    (UINTN) Context->PrelinkedInfoSection->Size
+    );
+  Sha256Final (&ShaContext, LinkCache->Digest);
+
+  Context->LinkCache = LinkCache;
+
+  Cache = OcStorageReadFileUnicode (Storage, FileName, &CacheSize);
+  if (Cache == NULL) {
+    DEBUG ((DEBUG_INFO, "OCK: No link cache %s\n", FileName));
+    return RETURN_SUCCESS;
+  }
+
+  if (CacheSize > PRELINKED_LINK_CACHE_MAX_SIZE
+    || !InternalLinkCacheValidate (LinkCache, Cache, CacheSize, &LinkCache->CacheCount)) {
+    DEBUG ((DEBUG_INFO, "OCK: Ignoring invalid link cache %s of %u bytes\n", FileName, CacheSize));
+    FreePool (Cache);
+    return RETURN_SUCCESS;
+  }
+
+  LinkCache->Cache     = Cache;
+  LinkCache->CacheSize = CacheSize;
+
+  DEBUG ((DEBUG_INFO, "OCK: Loaded link cache %s with %u entries\n", FileName, LinkCache->CacheCount));
+
+  return RETURN_SUCCESS;
+}
+
+RETURN_STATUS
+PrelinkedLinkCacheSave (
+  IN OUT PRELINKED_CONTEXT   *Context,
+  IN     OC_STORAGE_CONTEXT  *Storage,
+  IN     CONST CHAR16        *FileName
+  )
+{
+  EFI_STATUS                   Status;
+  PRELINKED_LINK_CACHE         *LinkCache;
+  PRELINKED_LINK_CACHE_HEADER  Header;
+  UINT8                        *Cache;
+  UINT32                       CacheSize;
+
+  LinkCache = Context->LinkCache;
+  if (LinkCache == NULL) {
+    return RETURN_NOT_STARTED;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCK: Link cache %u hits %u misses, %u/%u entries\n",
+    LinkCache->Hits,
+    LinkCache->Misses,
+    LinkCache->EntriesCount,
+    LinkCache->CacheCount
+    ));
+
+  if (LinkCache->Misses == 0 && LinkCache->EntriesCount == LinkCache->CacheCount) {
+    return RETURN_SUCCESS;
+  }
+
+  if (Storage->StorageRoot == NULL) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  CacheSize = sizeof (Header) + LinkCache->EntriesSize;
+  Cache     = AllocatePool (CacheSize);
+  if (Cache == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  Header.Signature       = PRELINKED_LINK_CACHE_SIGNATURE;
+  Header.Version         = PRELINKED_LINK_CACHE_VERSION;
+  Header.LinkerVersion   = PRELINKED_LINKER_VERSION;
+  Header.NumberOfEntries = LinkCache->EntriesCount;
+  Header.Size            = CacheSize;
+  CopyMem (Header.KernelUuid, LinkCache->KernelUuid, sizeof (Header.KernelUuid));
+
+  CopyMem (Cache, &Header, sizeof (Header));
+  if (LinkCache->EntriesSize > 0) {
+    CopyMem (&Cache[sizeof (Header)], LinkCache->Entries, LinkCache->EntriesSize);
+  }
+
+  //
+  // SetFileData does not truncate existing files, stale data past Header.Size is ignored.
+  //
+  Status = SetFileData (Storage->StorageRoot, FileName, Cache, CacheSize);
+
+  FreePool (Cache);
+
+  DEBUG ((DEBUG_INFO, "OCK: Saved link cache %s of %u bytes - %r\n", FileName, CacheSize, Status));
+
+  return Status;
+}
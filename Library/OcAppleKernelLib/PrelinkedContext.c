@@ -33,10 +33,7 @@ PrelinkedFindLastLoadAddress (
   )
 {
   UINT32       KextCount;
-  UINT32       FieldIndex;
-  UINT32       FieldCount;
   XML_NODE     *LastKext;
-  CONST CHAR8  *KextPlistKey;
   XML_NODE     *KextPlistValue;
   UINT64       LoadAddress;
   UINT64       LoadSize;
@@ -57,26 +54,16 @@ PrelinkedFindLastLoadAddress (
   LoadAddress = 0;
   LoadSize = 0;
 
-  FieldCount = PlistDictChildren (LastKext);
-  for (FieldIndex = 0; FieldIndex < FieldCount; ++FieldIndex) {
-    KextPlistKey = PlistKeyValue (PlistDictChild (LastKext, FieldIndex, &KextPlistValue));
-    if (KextPlistKey == NULL) {
-      continue;
-    }
-
-    if (LoadAddress == 0 && AsciiStrCmp (KextPlistKey, PRELINK_INFO_EXECUTABLE_LOAD_ADDR_KEY) == 0) {
-      if (!PlistIntegerValue (KextPlistValue, &LoadAddress, sizeof (LoadAddress), TRUE)) {
-        return 0;
-      }
-    } else if (LoadSize == 0 && AsciiStrCmp (KextPlistKey, PRELINK_INFO_EXECUTABLE_SIZE_KEY) == 0) {
-      if (!PlistIntegerValue (KextPlistValue, &LoadSize, sizeof (LoadSize), TRUE)) {
-        return 0;
-      }
-    }
+  KextPlistValue = PlistDictFind (LastKext, PRELINK_INFO_EXECUTABLE_LOAD_ADDR_KEY);
+  if (KextPlistValue != NULL
+    && !PlistIntegerValue (KextPlistValue, &LoadAddress, sizeof (LoadAddress), TRUE)) {
+    return 0;
+  }
 
-    if (LoadSize != 0 && LoadAddress != 0) {
-      break;
-    }
+  KextPlistValue = PlistDictFind (LastKext, PRELINK_INFO_EXECUTABLE_SIZE_KEY);
+  if (KextPlistValue != NULL
+    && !PlistIntegerValue (KextPlistValue, &LoadSize, sizeof (LoadSize), TRUE)) {
+    return 0;
   }
 
   if (OcOverflowAddU64 (LoadAddress, LoadSize, &LoadAddress)) {
@@ -143,9 +130,6 @@ PrelinkedContextInit (
   )
 {
   XML_NODE     *PrelinkedInfoRoot;
-  CONST CHAR8  *PrelinkedInfoRootKey;
-  UINT32       PrelinkedInfoRootIndex;
-  UINT32       PrelinkedInfoRootCount;
 
   ASSERT (Context != NULL);
   ASSERT (Prelinked != NULL);
@@ -234,7 +218,10 @@ PrelinkedContextInit (
     return RETURN_OUT_OF_RESOURCES;
   }
 
-  Context->PrelinkedInfoDocument = XmlDocumentParse (Context->PrelinkedInfo, (UINT32)Context->PrelinkedInfoSection->Size, TRUE);
+  //
+  // Only a few kext dictionaries are ever accessed, parse the rest on demand.
+  //
+  Context->PrelinkedInfoDocument = XmlDocumentParseLazy (Context->PrelinkedInfo, (UINT32)Context->PrelinkedInfoSection->Size, TRUE);
   if (Context->PrelinkedInfoDocument == NULL) {
     PrelinkedContextFree (Context);
     return RETURN_INVALID_PARAMETER;
@@ -246,21 +233,18 @@ PrelinkedContextInit (
     return RETURN_INVALID_PARAMETER;
   }
 
-  PrelinkedInfoRootCount = PlistDictChildren (PrelinkedInfoRoot);
-  for (PrelinkedInfoRootIndex = 0; PrelinkedInfoRootIndex < PrelinkedInfoRootCount; ++PrelinkedInfoRootIndex) {
-    PrelinkedInfoRootKey = PlistKeyValue (PlistDictChild (PrelinkedInfoRoot, PrelinkedInfoRootIndex, &Context->KextList));
-    if (PrelinkedInfoRootKey == NULL) {
-      continue;
-    }
-
-    if (AsciiStrCmp (PrelinkedInfoRootKey, PRELINK_INFO_DICTIONARY_KEY) == 0) {
-      if (PlistNodeCast (Context->KextList, PLIST_NODE_TYPE_ARRAY) != NULL) {
-        Context->PrelinkedLastLoadAddress = PrelinkedFindLastLoadAddress (Context->KextList);
-        if (Context->PrelinkedLastLoadAddress != 0) {
-          return RETURN_SUCCESS;
-        }
-      }
-      break;
+  Context->KextList = PlistNodeCast (
+    PlistDictFind (PrelinkedInfoRoot, PRELINK_INFO_DICTIONARY_KEY),
+    PLIST_NODE_TYPE_ARRAY
+    );
+  if (Context->KextList != NULL) {
+    Context->PrelinkedLastLoadAddress = PrelinkedFindLastLoadAddress (Context->KextList);
+    //
+    // Malformed dictionaries read as empty, reject them before anything relies on them.
+    //
+    if (Context->PrelinkedLastLoadAddress != 0
+      && !XmlDocumentLazyFailed (Context->PrelinkedInfoDocument)) {
+      return RETURN_SUCCESS;
     }
   }
 
@@ -277,6 +261,9 @@ PrelinkedContextFree (
   LIST_ENTRY      *Link;
   PRELINKED_KEXT  *Kext;
 
+  InternalFreePrelinkedKextIndex (Context);
+  InternalFreeLinkCache (Context);
+
   if (Context->PrelinkedInfoDocument != NULL) {
     XmlDocumentFree (Context->PrelinkedInfoDocument);
     Context->PrelinkedInfoDocument = NULL;
@@ -397,23 +384,37 @@ PrelinkedInjectComplete (
   IN OUT PRELINKED_CONTEXT  *Context
   )
 {
-  CHAR8       *ExportedInfo;
   UINT32      ExportedInfoSize;
   UINT32      NewSize;
 
-  ExportedInfo = XmlDocumentExport (Context->PrelinkedInfoDocument, &ExportedInfoSize, 0);
-  if (ExportedInfo == NULL) {
-    return RETURN_OUT_OF_RESOURCES;
+  //
+  // Some kext dictionary could not be parsed on access, do not write it back as empty.
+  //
+  if (XmlDocumentLazyFailed (Context->PrelinkedInfoDocument)) {
+    return RETURN_COMPROMISED_DATA;
   }
 
   //
-  // Include \0 terminator.
+  // Ensure the aligned export with \0 terminator fits before writing anything.
   //
-  ExportedInfoSize++;
-
-  if (OcOverflowAddU32 (Context->PrelinkedSize, MACHO_ALIGN (ExportedInfoSize), &NewSize)
+  if (!XmlDocumentExportSize (Context->PrelinkedInfoDocument, &ExportedInfoSize, 0)
+    || OcOverflowAddU32 (ExportedInfoSize, 1, &ExportedInfoSize)
+    || ExportedInfoSize > Context->PrelinkedAllocSize - Context->PrelinkedSize
+    || OcOverflowAddU32 (Context->PrelinkedSize, MACHO_ALIGN (ExportedInfoSize), &NewSize)
     || NewSize > Context->PrelinkedAllocSize) {
-    FreePool (ExportedInfo);
+    return RETURN_BUFFER_TOO_SMALL;
+  }
+
+  //
+  // Export straight into the free space after the last segment.
+  //
+  if (!XmlDocumentExportBuffer (
+    Context->PrelinkedInfoDocument,
+    (CHAR8 *) &Context->Prelinked[Context->PrelinkedSize],
+    ExportedInfoSize,
+    NULL,
+    0
+    )) {
     return RETURN_BUFFER_TOO_SMALL;
   }
 
@@ -425,12 +426,6 @@ PrelinkedInjectComplete (
   Context->PrelinkedInfoSection->Size           = ExportedInfoSize;
   Context->PrelinkedInfoSection->Offset         = Context->PrelinkedSize;
 
-  CopyMem (
-    &Context->Prelinked[Context->PrelinkedSize],
-    ExportedInfo,
-    ExportedInfoSize
-    );
-
   ZeroMem (
     &Context->Prelinked[Context->PrelinkedSize + ExportedInfoSize],
     MACHO_ALIGN (ExportedInfoSize) - ExportedInfoSize
@@ -439,8 +434,6 @@ PrelinkedInjectComplete (
   Context->PrelinkedLastAddress += MACHO_ALIGN (ExportedInfoSize);
   Context->PrelinkedSize        += MACHO_ALIGN (ExportedInfoSize);
 
-  FreePool (ExportedInfo);
-
   return RETURN_SUCCESS;
 }
 
@@ -501,21 +494,24 @@ PrelinkedInjectKext (
   CHAR8             *TmpInfoPlist;
   CHAR8             *NewInfoPlist;
   OC_MACHO_CONTEXT  ExecutableContext;
-  CONST CHAR8       *TmpKeyValue;
-  UINT32            FieldCount;
-  UINT32            FieldIndex;
   UINT32            NewInfoPlistSize;
   UINT32            NewPrelinkedSize;
   UINT32            AlignedExecutableSize;
   BOOLEAN           Failed;
   UINT64            KmodAddress;
   PRELINKED_KEXT    *PrelinkedKext;
+  PRELINKED_LINK_CACHE  *LinkCache;
+  UINT8             LinkDigest[SHA256_DIGEST_SIZE];
+  UINT8             *LinkOriginal;
+  UINT32            LinkedSize;
+  BOOLEAN           Linked;
   CHAR8             ExecutableSourceAddrStr[24];
   CHAR8             ExecutableSizeStr[24];
   CHAR8             ExecutableLoadAddrStr[24];
   CHAR8             KmodInfoStr[24];
 
   PrelinkedKext = NULL;
+  LinkCache     = Context->LinkCache;
 
   ASSERT (InfoPlistSize > 0);
 
@@ -524,6 +520,19 @@ PrelinkedInjectKext (
   //
   if (Executable != NULL) {
     ASSERT (ExecutableSize > 0);
+
+    if (LinkCache != NULL) {
+      InternalLinkCacheDigest (
+        LinkCache,
+        InfoPlist,
+        InfoPlistSize,
+        Executable,
+        ExecutableSize,
+        Context->PrelinkedLastLoadAddress,
+        LinkDigest
+        );
+    }
+
     if (!MachoInitializeContext (&ExecutableContext, (UINT8 *)Executable, ExecutableSize)) {
       DEBUG ((DEBUG_INFO, "OCK: Injected kext %a/%a is not a supported executable\n", BundlePath, ExecutablePath));
       return RETURN_INVALID_PARAMETER;
@@ -586,20 +595,10 @@ PrelinkedInjectKext (
   // code in debug mode to diagnose it.
   //
   DEBUG_CODE_BEGIN ();
-  if (Executable == NULL) {
-    FieldCount = PlistDictChildren (InfoPlistRoot);
-    for (FieldIndex = 0; FieldIndex < FieldCount; ++FieldIndex) {
-      TmpKeyValue = PlistKeyValue (PlistDictChild (InfoPlistRoot, FieldIndex, NULL));
-      if (TmpKeyValue == NULL) {
-        continue;
-      }
-
-      if (AsciiStrCmp (TmpKeyValue, INFO_BUNDLE_EXECUTABLE_KEY) == 0) {
-        DEBUG ((DEBUG_ERROR, "OCK: Plist-only kext has %a key\n", INFO_BUNDLE_EXECUTABLE_KEY));
-        ASSERT (FALSE);
-        CpuDeadLoop ();
-      }
-    }
+  if (Executable == NULL && PlistDictFind (InfoPlistRoot, INFO_BUNDLE_EXECUTABLE_KEY) != NULL) {
+    DEBUG ((DEBUG_ERROR, "OCK: Plist-only kext has %a key\n", INFO_BUNDLE_EXECUTABLE_KEY));
+    ASSERT (FALSE);
+    CpuDeadLoop ();
   }
   DEBUG_CODE_END ();
 
@@ -630,20 +629,63 @@ PrelinkedInjectKext (
   }
 
   if (Executable != NULL) {
+    Linked       = FALSE;
+    LinkOriginal = NULL;
+
+    if (LinkCache != NULL) {
+      Linked = InternalLinkCacheReplay (
+        LinkCache,
+        LinkDigest,
+        &Context->Prelinked[Context->PrelinkedSize],
+        ExecutableSize,
+        &LinkedSize
+        );
+
+      if (Linked) {
+        DEBUG ((DEBUG_INFO, "OCK: Replaying cached link of %a\n", BundlePath));
+        if (!MachoInitializeContext (&ExecutableContext, &Context->Prelinked[Context->PrelinkedSize], LinkedSize)) {
+          XmlDocumentFree (InfoPlistDocument);
+          FreePool (TmpInfoPlist);
+          return RETURN_INVALID_PARAMETER;
+        }
+      } else {
+        //
+        // Keep unlinked image to record the changes made by linking.
+        //
+        LinkOriginal = AllocateCopyPool (ExecutableSize, &Context->Prelinked[Context->PrelinkedSize]);
+      }
+    }
+
     PrelinkedKext = InternalLinkPrelinkedKext (
       Context,
       &ExecutableContext,
       InfoPlistRoot,
       Context->PrelinkedLastLoadAddress,
-      KmodAddress
+      KmodAddress,
+      Linked
       );
 
     if (PrelinkedKext == NULL) {
+      if (LinkOriginal != NULL) {
+        FreePool (LinkOriginal);
+      }
       XmlDocumentFree (InfoPlistDocument);
       FreePool (TmpInfoPlist);
       return RETURN_INVALID_PARAMETER;
     }
 
+    if (LinkOriginal != NULL) {
+      InternalLinkCacheRecord (
+        LinkCache,
+        LinkDigest,
+        LinkOriginal,
+        &Context->Prelinked[Context->PrelinkedSize],
+        ExecutableSize,
+        MachoGetFileSize (&PrelinkedKext->Context.MachContext)
+        );
+      FreePool (LinkOriginal);
+    }
+
     //
     // XNU assumes that load size and source size are same, so we should append
     // whatever is bigger to all sizes.
@@ -692,6 +734,14 @@ PrelinkedInjectKext (
   //
   if (PrelinkedKext != NULL) {
     InsertTailList (&Context->PrelinkedKexts, &PrelinkedKext->Link);
+    InternalIndexPrelinkedKext (Context, PrelinkedKext);
+
+    //
+    // Later kexts may link against this one, so chain its digest.
+    //
+    if (LinkCache != NULL) {
+      CopyMem (LinkCache->Digest, LinkDigest, sizeof (LinkCache->Digest));
+    }
   }
 
   return RETURN_SUCCESS;
@@ -19,6 +19,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <IndustryStandard/AppleMachoImage.h>
 
 #include <Library/OcAppleKernelLib.h>
+#include <Library/OcCryptoLib.h>
 #include <Library/OcMachoLib.h>
 #include <Library/OcXmlLib.h>
 
@@ -36,8 +37,19 @@ typedef struct {
   UINT64       Value;  ///< value of this symbol (or stab offset)
   CONST CHAR8  *Name;  ///< name of this symbol
   UINT32       Length;
+  UINT32       Hash;   ///< AsciiStrHash of the name
 } PRELINKED_KEXT_SYMBOL;
 
+typedef struct {
+  UINT32       Hash;   ///< hash of the symbol name
+  UINT32       Index;  ///< LinkedSymbolTable index + 1, 0 for free slots
+} PRELINKED_KEXT_SYMBOL_HASH;
+
+typedef struct {
+  UINT64       Value;  ///< value of the symbol
+  UINT32       Index;  ///< LinkedSymbolTable index
+} PRELINKED_KEXT_SYMBOL_VALUE;
+
 typedef struct {
   CONST CHAR8 *Name;    ///< The symbol's name.
   UINT64      Address;  ///< The symbol's address.
@@ -85,6 +97,11 @@ struct PRELINKED_KEXT_ {
   //
   PRELINKED_KEXT           *Dependencies[MAX_KEXT_DEPEDENCIES];
   //
+  // Dependencies have their symbol tables and vtables built.
+  // Not set for kexts linked from link cache until they become a dependency.
+  //
+  BOOLEAN                  DependenciesScanned;
+  //
   // Linkedit segment reference.
   //
   MACH_SEGMENT_COMMAND_64  *LinkEditSegment;
@@ -110,6 +127,20 @@ struct PRELINKED_KEXT_ {
   //
   PRELINKED_KEXT_SYMBOL    *LinkedSymbolTable;
   //
+  // Open addressing name hash table for LinkedSymbolTable.
+  // May be NULL when there was not enough memory.
+  //
+  PRELINKED_KEXT_SYMBOL_HASH  *LinkedSymbolHash;
+  //
+  // Number of LinkedSymbolHash slots, power of two.
+  //
+  UINT32                   LinkedSymbolHashSize;
+  //
+  // LinkedSymbolTable indices sorted by symbol value and then by index.
+  // Contains NumberOfSymbols entries, may be NULL when there was not enough memory.
+  //
+  PRELINKED_KEXT_SYMBOL_VALUE  *LinkedSymbolValues;
+  //
   // A flag set during dependency walk BFS to avoid going through the same path.
   //
   BOOLEAN                  Processed;
@@ -123,6 +154,141 @@ struct PRELINKED_KEXT_ {
   PRELINKED_VTABLE         *LinkedVtables;
 };
 
+//
+// Kext identifier index entry used for quick kext lookup.
+//
+typedef struct {
+  //
+  // Identifier hash.
+  //
+  UINT32                   Hash;
+  //
+  // Kext CFBundleIdentifier or NULL for unused slots.
+  //
+  CONST CHAR8              *Identifier;
+  //
+  // Kext plist in KextList or NULL for injected kexts.
+  //
+  XML_NODE                 *KextPlist;
+  //
+  // Cached PRELINKED_KEXT or NULL when not created yet.
+  //
+  PRELINKED_KEXT           *Kext;
+} PRELINKED_KEXT_INDEX_ENTRY;
+
+//
+// Minimal number of kext index slots.
+//
+#define PRELINKED_KEXT_INDEX_MIN_SIZE  256U
+
+//
+// Link cache file signature and version.
+//
+#define PRELINKED_LINK_CACHE_SIGNATURE  SIGNATURE_32 ('O', 'C', 'L', 'C')
+#define PRELINKED_LINK_CACHE_VERSION    1U
+
+//
+// Linker version stored in link cache files.
+// Must be bumped with every change affecting linked kext images.
+//
+#define PRELINKED_LINKER_VERSION        1U
+
+//
+// Maximum link cache file size.
+//
+#define PRELINKED_LINK_CACHE_MAX_SIZE   (32U * 1024U * 1024U)
+
+//
+// Equal bytes between changed ranges merged into one run.
+// Matches run header size, so merging never makes the cache bigger.
+//
+#define PRELINKED_LINK_CACHE_RUN_GAP    8U
+
+#pragma pack(push, 1)
+
+//
+// Link cache file header, followed by NumberOfEntries entries.
+//
+typedef struct {
+  UINT32                   Signature;
+  UINT32                   Version;
+  //
+  // PRELINKED_LINKER_VERSION the cache was made with.
+  //
+  UINT32                   LinkerVersion;
+  UINT8                    KernelUuid[16];
+  UINT32                   NumberOfEntries;
+  //
+  // Cache size including this header.
+  //
+  UINT32                   Size;
+} PRELINKED_LINK_CACHE_HEADER;
+
+//
+// Link cache entry, followed by NumberOfRuns runs.
+//
+typedef struct {
+  //
+  // Injection digest, see InternalLinkCacheDigest.
+  //
+  UINT8                    Digest[SHA256_DIGEST_SIZE];
+  //
+  // Expanded executable size before linking.
+  //
+  UINT32                   ImageSize;
+  //
+  // Mach-O size after linking.
+  //
+  UINT32                   LinkedSize;
+  UINT32                   NumberOfRuns;
+  //
+  // Entry size including this header.
+  //
+  UINT32                   Size;
+} PRELINKED_LINK_CACHE_ENTRY;
+
+//
+// Link cache run of changed bytes, followed by Size bytes of linked data.
+//
+typedef struct {
+  UINT32                   Offset;
+  UINT32                   Size;
+} PRELINKED_LINK_CACHE_RUN;
+
+#pragma pack(pop)
+
+//
+// Link cache state referenced by PRELINKED_CONTEXT.
+//
+typedef struct {
+  //
+  // UUID of the kernel the cache is made for.
+  //
+  UINT8                    KernelUuid[16];
+  //
+  // Digest of the current injection chain.
+  //
+  UINT8                    Digest[SHA256_DIGEST_SIZE];
+  //
+  // Loaded cache entries or NULL.
+  //
+  UINT8                    *Cache;
+  UINT32                   CacheSize;
+  UINT32                   CacheCount;
+  //
+  // Entries used in this session, written by PrelinkedLinkCacheSave.
+  //
+  UINT8                    *Entries;
+  UINT32                   EntriesSize;
+  UINT32                   EntriesAllocSize;
+  UINT32                   EntriesCount;
+  //
+  // Statistics.
+  //
+  UINT32                   Hits;
+  UINT32                   Misses;
+} PRELINKED_LINK_CACHE;
+
 //
 // PRELINKED_KEXT signature for list identification.
 //
@@ -167,6 +333,42 @@ InternalCachedPrelinkedKext (
   IN     CONST CHAR8        *Identifier
   );
 
+/**
+  Build kext identifier index from PRELINKED_CONTEXT KextList.
+  Called on first identifier lookup, as it parses every kext dictionary.
+  Failure is not fatal, lookups fall back to linear scanning.
+
+  @param[in,out] Prelinked  Prelinked context with KextList.
+
+  @return  EFI_SUCCESS on success.
+**/
+RETURN_STATUS
+InternalBuildPrelinkedKextIndex (
+  IN OUT PRELINKED_CONTEXT  *Prelinked
+  );
+
+/**
+  Register cached PRELINKED_KEXT in kext identifier index.
+
+  @param[in,out] Prelinked  Prelinked context.
+  @param[in]     Kext       Kext inserted into PrelinkedKexts.
+**/
+VOID
+InternalIndexPrelinkedKext (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     PRELINKED_KEXT     *Kext
+  );
+
+/**
+  Free kext identifier index.
+
+  @param[in,out] Prelinked  Prelinked context.
+**/
+VOID
+InternalFreePrelinkedKextIndex (
+  IN OUT PRELINKED_CONTEXT  *Prelinked
+  );
+
 /**
   Gets cached kernel PRELINKED_KEXT from PRELINKED_CONTEXT.
 **/
@@ -202,6 +404,7 @@ InternalUnlockContextKexts (
   @param[in]     PlistRoot       Current kext info.plist.
   @param[in]     LoadAddress     Kext load address.
   @param[in]     KmodAddress     Kext kmod address.
+  @param[in]     Linked          Executable is already linked, e.g. from link cache.
 
   @return  prelinked kext to be inserted into PRELINKED_CONTEXT.
 **/
@@ -211,7 +414,80 @@ InternalLinkPrelinkedKext (
   IN OUT OC_MACHO_CONTEXT   *Executable,
   IN     XML_NODE           *PlistRoot,
   IN     UINT64             LoadAddress,
-  IN     UINT64             KmodAddress
+  IN     UINT64             KmodAddress,
+  IN     BOOLEAN            Linked
+  );
+
+/**
+  Compute link cache digest of kext injection.
+
+  @param[in]  LinkCache       Link cache.
+  @param[in]  InfoPlist       Kext Info.plist.
+  @param[in]  InfoPlistSize   Kext Info.plist size.
+  @param[in]  Executable      Kext executable.
+  @param[in]  ExecutableSize  Kext executable size.
+  @param[in]  LoadAddress     Kext load address.
+  @param[out] Digest          Resulting digest.
+**/
+VOID
+InternalLinkCacheDigest (
+  IN  PRELINKED_LINK_CACHE  *LinkCache,
+  IN  CONST CHAR8           *InfoPlist,
+  IN  UINT32                InfoPlistSize,
+  IN  CONST UINT8           *Executable,
+  IN  UINT32                ExecutableSize,
+  IN  UINT64                LoadAddress,
+  OUT UINT8                 *Digest
+  );
+
+/**
+  Replay cached link results over expanded executable.
+
+  @param[in,out] LinkCache   Link cache.
+  @param[in]     Digest      Link cache digest.
+  @param[in,out] Image       Expanded executable.
+  @param[in]     ImageSize   Expanded executable size.
+  @param[out]    LinkedSize  Linked Mach-O size.
+
+  @return  TRUE when Image was linked from the cache.
+**/
+BOOLEAN
+InternalLinkCacheReplay (
+  IN OUT PRELINKED_LINK_CACHE  *LinkCache,
+  IN     CONST UINT8           *Digest,
+  IN OUT UINT8                 *Image,
+  IN     UINT32                ImageSize,
+  OUT    UINT32                *LinkedSize
+  );
+
+/**
+  Record link results in the cache.
+
+  @param[in,out] LinkCache   Link cache.
+  @param[in]     Digest      Link cache digest.
+  @param[in]     Original    Expanded executable before linking.
+  @param[in]     Image       Linked executable.
+  @param[in]     ImageSize   Expanded executable size.
+  @param[in]     LinkedSize  Linked Mach-O size.
+**/
+VOID
+InternalLinkCacheRecord (
+  IN OUT PRELINKED_LINK_CACHE  *LinkCache,
+  IN     CONST UINT8           *Digest,
+  IN     CONST UINT8           *Original,
+  IN     CONST UINT8           *Image,
+  IN     UINT32                ImageSize,
+  IN     UINT32                LinkedSize
+  );
+
+/**
+  Free link cache.
+
+  @param[in,out] Context  Prelinked context.
+**/
+VOID
+InternalFreeLinkCache (
+  IN OUT PRELINKED_CONTEXT  *Context
   );
 
 #define KXLD_WEAK_TEST_SYMBOL  "_gOSKextUnresolved"
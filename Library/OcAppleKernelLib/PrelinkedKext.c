@@ -20,7 +20,9 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcAppleKernelLib.h>
 #include <Library/OcMachoLib.h>
+#include <Library/OcStringLib.h>
 #include <Library/OcXmlLib.h>
+#include <Library/TimerLib.h>
 
 #include "PrelinkedInternal.h"
 
@@ -42,9 +44,6 @@ InternalCreatePrelinkedKext (
   )
 {
   PRELINKED_KEXT  *NewKext;
-  UINT32          FieldIndex;
-  UINT32          FieldCount;
-  CONST CHAR8     *KextPlistKey;
   XML_NODE        *KextPlistValue;
   CONST CHAR8     *KextIdentifier;
   XML_NODE        *BundleLibraries;
@@ -68,60 +67,70 @@ InternalCreatePrelinkedKext (
 
   Found       = Identifier == NULL;
 
-  FieldCount = PlistDictChildren (KextPlist);
-  for (FieldIndex = 0; FieldIndex < FieldCount; ++FieldIndex) {
-    KextPlistKey = PlistKeyValue (PlistDictChild (KextPlist, FieldIndex, &KextPlistValue));
-    if (KextPlistKey == NULL) {
-      continue;
+  //
+  // Present fields with malformed values invalidate the whole kext.
+  //
+  KextPlistValue = PlistDictFind (KextPlist, INFO_BUNDLE_IDENTIFIER_KEY);
+  if (KextPlistValue != NULL) {
+    if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_STRING) == NULL) {
+      return NULL;
+    }
+    KextIdentifier = XmlNodeContent (KextPlistValue);
+    if (!Found && KextIdentifier != NULL && AsciiStrCmp (KextIdentifier, Identifier) == 0) {
+      Found = TRUE;
     }
+  }
 
-    if (KextIdentifier == NULL && AsciiStrCmp (KextPlistKey, INFO_BUNDLE_IDENTIFIER_KEY) == 0) {
-      KextIdentifier = XmlNodeContent (KextPlistValue);
-      if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_STRING) == NULL || KextIdentifier == NULL) {
-        break;
-      }
-      if (!Found && AsciiStrCmp (KextIdentifier, Identifier) == 0) {
-        Found = TRUE;
-      }
-    } else if (BundleLibraries == NULL && AsciiStrCmp (KextPlistKey, INFO_BUNDLE_LIBRARIES_KEY) == 0) {
-      if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_DICT) == NULL) {
-        break;
-      }
-      BundleLibraries = KextPlistValue;
-    } else if (BundleLibraries64 == NULL && AsciiStrCmp (KextPlistKey, INFO_BUNDLE_LIBRARIES_64_KEY) == 0) {
-      if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_DICT) == NULL) {
-        break;
-      }
-      BundleLibraries64 = BundleLibraries = KextPlistValue;
-    } else if (CompatibleVersion == NULL && AsciiStrCmp (KextPlistKey, INFO_BUNDLE_COMPATIBLE_VERSION_KEY) == 0) {
-      if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_STRING) == NULL) {
-        break;
-      }
-      CompatibleVersion = XmlNodeContent (KextPlistValue);
-      if (CompatibleVersion == NULL) {
-        break;
-      }
-    } else if (Prelinked != NULL && VirtualBase == 0 && AsciiStrCmp (KextPlistKey, PRELINK_INFO_EXECUTABLE_LOAD_ADDR_KEY) == 0) {
-      if (!PlistIntegerValue (KextPlistValue, &VirtualBase, sizeof (VirtualBase), TRUE)) {
-        break;
-      }
-    } else if (Prelinked != NULL && VirtualKmod == 0 && AsciiStrCmp (KextPlistKey, PRELINK_INFO_KMOD_INFO_KEY) == 0) {
-      if (!PlistIntegerValue (KextPlistValue, &VirtualKmod, sizeof (VirtualKmod), TRUE)) {
-        break;
-      }
-    } else if (Prelinked != NULL && SourceBase == 0 && AsciiStrCmp (KextPlistKey, PRELINK_INFO_EXECUTABLE_SOURCE_ADDR_KEY) == 0) {
-      if (!PlistIntegerValue (KextPlistValue, &SourceBase, sizeof (SourceBase), TRUE)) {
-        break;
-      }
-    } else if (Prelinked != NULL && SourceSize == 0 && AsciiStrCmp (KextPlistKey, PRELINK_INFO_EXECUTABLE_SIZE_KEY) == 0) {
-      if (!PlistIntegerValue (KextPlistValue, &SourceSize, sizeof (SourceSize), TRUE)) {
-        break;
+  KextPlistValue = PlistDictFind (KextPlist, INFO_BUNDLE_LIBRARIES_64_KEY);
+  if (KextPlistValue != NULL) {
+    BundleLibraries64 = BundleLibraries = PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_DICT);
+    if (BundleLibraries64 == NULL) {
+      return NULL;
+    }
+  } else {
+    KextPlistValue = PlistDictFind (KextPlist, INFO_BUNDLE_LIBRARIES_KEY);
+    if (KextPlistValue != NULL) {
+      BundleLibraries = PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_DICT);
+      if (BundleLibraries == NULL) {
+        return NULL;
       }
     }
+  }
 
-    if (KextIdentifier != NULL && BundleLibraries64 != NULL && CompatibleVersion != NULL
-      && (Prelinked == NULL || (Prelinked != NULL && VirtualBase != 0 && VirtualKmod != 0 && SourceBase != 0 && SourceSize != 0))) {
-      break;
+  KextPlistValue = PlistDictFind (KextPlist, INFO_BUNDLE_COMPATIBLE_VERSION_KEY);
+  if (KextPlistValue != NULL) {
+    if (PlistNodeCast (KextPlistValue, PLIST_NODE_TYPE_STRING) == NULL) {
+      return NULL;
+    }
+    CompatibleVersion = XmlNodeContent (KextPlistValue);
+    if (CompatibleVersion == NULL) {
+      return NULL;
+    }
+  }
+
+  if (Prelinked != NULL) {
+    KextPlistValue = PlistDictFind (KextPlist, PRELINK_INFO_EXECUTABLE_LOAD_ADDR_KEY);
+    if (KextPlistValue != NULL
+      && !PlistIntegerValue (KextPlistValue, &VirtualBase, sizeof (VirtualBase), TRUE)) {
+      return NULL;
+    }
+
+    KextPlistValue = PlistDictFind (KextPlist, PRELINK_INFO_KMOD_INFO_KEY);
+    if (KextPlistValue != NULL
+      && !PlistIntegerValue (KextPlistValue, &VirtualKmod, sizeof (VirtualKmod), TRUE)) {
+      return NULL;
+    }
+
+    KextPlistValue = PlistDictFind (KextPlist, PRELINK_INFO_EXECUTABLE_SOURCE_ADDR_KEY);
+    if (KextPlistValue != NULL
+      && !PlistIntegerValue (KextPlistValue, &SourceBase, sizeof (SourceBase), TRUE)) {
+      return NULL;
+    }
+
+    KextPlistValue = PlistDictFind (KextPlist, PRELINK_INFO_EXECUTABLE_SIZE_KEY);
+    if (KextPlistValue != NULL
+      && !PlistIntegerValue (KextPlistValue, &SourceSize, sizeof (SourceSize), TRUE)) {
+      return NULL;
     }
   }
 
@@ -203,6 +212,166 @@ InternalScanCurrentPrelinkedKext (
   return RETURN_SUCCESS;
 }
 
+/**
+  Build name hash table for kext LinkedSymbolTable.
+  On allocation failure symbol lookup falls back to linear scanning.
+
+  @param[in,out] Kext  Kext with LinkedSymbolTable.
+**/
+STATIC
+VOID
+InternalScanBuildLinkedSymbolHash (
+  IN OUT PRELINKED_KEXT  *Kext
+  )
+{
+  PRELINKED_KEXT_SYMBOL_HASH  *SymbolHash;
+  UINT32                      HashSize;
+  UINT32                      Mask;
+  UINT32                      Slot;
+  UINT32                      Index;
+
+  HashSize = 16;
+  while (HashSize < Kext->NumberOfSymbols * 2 && HashSize < BIT31) {
+    HashSize *= 2;
+  }
+
+  SymbolHash = AllocateZeroPool (HashSize * sizeof (*SymbolHash));
+  if (SymbolHash == NULL) {
+    DEBUG ((DEBUG_INFO, "OCK: No memory for %u symbol hash of %a\n", Kext->NumberOfSymbols, Kext->Identifier));
+    return;
+  }
+
+  //
+  // Symbols are inserted in table order, so that linear probing returns
+  // the first of duplicate symbols just like linear scanning does.
+  //
+  Mask = HashSize - 1;
+  for (Index = 0; Index < Kext->NumberOfSymbols; ++Index) {
+    Slot = Kext->LinkedSymbolTable[Index].Hash & Mask;
+    while (SymbolHash[Slot].Index != 0) {
+      Slot = (Slot + 1) & Mask;
+    }
+
+    SymbolHash[Slot].Hash  = Kext->LinkedSymbolTable[Index].Hash;
+    SymbolHash[Slot].Index = Index + 1;
+  }
+
+  Kext->LinkedSymbolHash     = SymbolHash;
+  Kext->LinkedSymbolHashSize = HashSize;
+}
+
+STATIC
+BOOLEAN
+InternalSymbolValueIsLess (
+  IN CONST PRELINKED_KEXT_SYMBOL_VALUE  *First,
+  IN CONST PRELINKED_KEXT_SYMBOL_VALUE  *Second
+  )
+{
+  return First->Value < Second->Value
+    || (First->Value == Second->Value && First->Index < Second->Index);
+}
+
+/**
+  Sift down heap element for InternalSortSymbolValues.
+
+  @param[in,out] Values  Heap of symbol values.
+  @param[in]     Root    Element to sift down.
+  @param[in]     Count   Number of heap elements.
+**/
+STATIC
+VOID
+InternalSiftSymbolValue (
+  IN OUT PRELINKED_KEXT_SYMBOL_VALUE  *Values,
+  IN     UINT32                       Root,
+  IN     UINT32                       Count
+  )
+{
+  PRELINKED_KEXT_SYMBOL_VALUE  Element;
+  UINT32                       Child;
+
+  CopyMem (&Element, &Values[Root], sizeof (Element));
+
+  while (Root < Count / 2) {
+    Child = 2 * Root + 1;
+    if (Child + 1 < Count && InternalSymbolValueIsLess (&Values[Child], &Values[Child + 1])) {
+      ++Child;
+    }
+
+    if (!InternalSymbolValueIsLess (&Element, &Values[Child])) {
+      break;
+    }
+
+    CopyMem (&Values[Root], &Values[Child], sizeof (Element));
+    Root = Child;
+  }
+
+  CopyMem (&Values[Root], &Element, sizeof (Element));
+}
+
+/**
+  Sort symbol values in place with heap sort, which needs no extra memory
+  and no recursion.
+
+  @param[in,out] Values  Symbol values.
+  @param[in]     Count   Number of symbol values.
+**/
+STATIC
+VOID
+InternalSortSymbolValues (
+  IN OUT PRELINKED_KEXT_SYMBOL_VALUE  *Values,
+  IN     UINT32                       Count
+  )
+{
+  PRELINKED_KEXT_SYMBOL_VALUE  Element;
+  UINT32                       Index;
+
+  for (Index = Count / 2; Index > 0; --Index) {
+    InternalSiftSymbolValue (Values, Index - 1, Count);
+  }
+
+  for (Index = Count; Index > 1; --Index) {
+    CopyMem (&Element, &Values[0], sizeof (Element));
+    CopyMem (&Values[0], &Values[Index - 1], sizeof (Element));
+    CopyMem (&Values[Index - 1], &Element, sizeof (Element));
+    InternalSiftSymbolValue (Values, 0, Index - 1);
+  }
+}
+
+/**
+  Build value sorted index for kext LinkedSymbolTable.
+  On allocation failure symbol lookup falls back to linear scanning.
+
+  @param[in,out] Kext  Kext with LinkedSymbolTable.
+**/
+STATIC
+VOID
+InternalScanBuildLinkedSymbolValues (
+  IN OUT PRELINKED_KEXT  *Kext
+  )
+{
+  PRELINKED_KEXT_SYMBOL_VALUE  *SymbolValues;
+  UINT32                       Index;
+
+  if (Kext->NumberOfSymbols == 0) {
+    return;
+  }
+
+  SymbolValues = AllocatePool (Kext->NumberOfSymbols * sizeof (*SymbolValues));
+  if (SymbolValues == NULL) {
+    DEBUG ((DEBUG_INFO, "OCK: No memory for %u symbol values of %a\n", Kext->NumberOfSymbols, Kext->Identifier));
+    return;
+  }
+
+  for (Index = 0; Index < Kext->NumberOfSymbols; ++Index) {
+    SymbolValues[Index].Value = Kext->LinkedSymbolTable[Index].Value;
+    SymbolValues[Index].Index = Index;
+  }
+
+  InternalSortSymbolValues (SymbolValues, Kext->NumberOfSymbols);
+
+  Kext->LinkedSymbolValues = SymbolValues;
+}
+
 STATIC
 RETURN_STATUS
 InternalScanBuildLinkedSymbolTable (
@@ -294,12 +463,12 @@ InternalScanBuildLinkedSymbolTable (
     if (!Result) {
       WalkerBottom->Value  = Symbol->Value;
       WalkerBottom->Name   = Kext->StringTable + Symbol->UnifiedName.StringIndex;
-      WalkerBottom->Length = (UINT32)AsciiStrLen (WalkerBottom->Name);
+      WalkerBottom->Hash   = AsciiStrHash (WalkerBottom->Name, &WalkerBottom->Length);
       ++WalkerBottom;
     } else {
       WalkerTop->Value  = Symbol->Value;
       WalkerTop->Name   = Kext->StringTable + Symbol->UnifiedName.StringIndex;
-      WalkerTop->Length = (UINT32)AsciiStrLen (WalkerTop->Name);
+      WalkerTop->Hash   = AsciiStrHash (WalkerTop->Name, &WalkerTop->Length);
       --WalkerTop;
 
       ++NumCxxSymbols;
@@ -321,6 +490,9 @@ InternalScanBuildLinkedSymbolTable (
   Kext->NumberOfCxxSymbols = NumCxxSymbols;
   Kext->LinkedSymbolTable  = SymbolTable;
 
+  InternalScanBuildLinkedSymbolHash (Kext);
+  InternalScanBuildLinkedSymbolValues (Kext);
+
   return RETURN_SUCCESS;
 }
 
@@ -444,18 +616,29 @@ STATIC
 RETURN_STATUS
 InternalInsertPrelinkedKextDependency (
   IN OUT PRELINKED_KEXT     *Kext,
-  IN OUT PRELINKED_CONTEXT  *Context,
   IN     UINT32             DependencyIndex,
   IN OUT PRELINKED_KEXT     *DependencyKext
   )
 {
-  RETURN_STATUS  Status;
-
   if (DependencyIndex >= ARRAY_SIZE (Kext->Dependencies)) {
     DEBUG ((DEBUG_INFO, "Kext %a has more than %u or more dependencies!", Kext->Identifier, DependencyIndex));
     return RETURN_OUT_OF_RESOURCES;
   }
 
+  Kext->Dependencies[DependencyIndex] = DependencyKext;
+
+  return RETURN_SUCCESS;
+}
+
+STATIC
+RETURN_STATUS
+InternalScanPrelinkedKextDependency (
+  IN OUT PRELINKED_CONTEXT  *Context,
+  IN OUT PRELINKED_KEXT     *DependencyKext
+  )
+{
+  RETURN_STATUS  Status;
+
   Status = InternalScanPrelinkedKext (DependencyKext, Context);
   if (RETURN_ERROR (Status)) {
     return Status;
@@ -474,12 +657,98 @@ InternalInsertPrelinkedKextDependency (
     return Status;
   }
 
-  Status = InternalScanBuildLinkedVtables (DependencyKext, Context);
-  if (RETURN_ERROR (Status)) {
-    return Status;
+  return InternalScanBuildLinkedVtables (DependencyKext, Context);
+}
+
+/**
+  Resolve PRELINKED_KEXT dependencies from BundleLibraries without scanning them.
+
+  @param[in,out] Kext     Kext to resolve dependencies for.
+  @param[in,out] Context  Prelinked context.
+
+  @return  RETURN_SUCCESS on success.
+**/
+STATIC
+RETURN_STATUS
+InternalResolvePrelinkedKextDependencies (
+  IN OUT PRELINKED_KEXT     *Kext,
+  IN OUT PRELINKED_CONTEXT  *Context
+  )
+{
+  RETURN_STATUS   Status;
+  UINT32          FieldCount;
+  UINT32          FieldIndex;
+  UINT32          DependencyIndex;
+  CONST CHAR8     *DependencyId;
+  PRELINKED_KEXT  *DependencyKext;
+
+  //
+  // Always add kernel dependency.
+  //
+  DependencyKext = InternalCachedPrelinkedKernel (Context);
+  if (DependencyKext == NULL) {
+    return RETURN_NOT_FOUND;
   }
 
-  Kext->Dependencies[DependencyIndex] = DependencyKext;
+  if (DependencyKext != Kext) {
+    Status = InternalInsertPrelinkedKextDependency (Kext, 0, DependencyKext);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  if (Kext->BundleLibraries != NULL) {
+    DependencyIndex = 1;
+    FieldCount = PlistDictChildren (Kext->BundleLibraries);
+
+    for (FieldIndex = 0; FieldIndex < FieldCount; ++FieldIndex) {
+      DependencyId = PlistKeyValue (PlistDictChild (Kext->BundleLibraries, FieldIndex, NULL));
+      if (DependencyId == NULL) {
+        continue;
+      }
+
+      //
+      // We still need to add KPI dependencies, as they may have indirect symbols,
+      // which are not present in kernel (e.g. _IOLockLock).
+      //
+      DependencyKext = InternalCachedPrelinkedKext (Context, DependencyId);
+      if (DependencyKext == NULL) {
+        DEBUG ((DEBUG_INFO, "Dependency %a was not found for kext %a\n", DependencyId, Kext->Identifier));
+        //
+        // Some kexts, notably VoodooPS2 forks, link against IOHIDSystem.kext, which is a plist-only
+        // dummy, macOS does not add to the prelinkedkernel. This cannot succeed as /S/L/E directory
+        // is not accessible (and can be encrypted). Normally kext's Info.plist is to be fixed, but
+        // we also put a hack here to let some common kexts work.
+        //
+        if (AsciiStrCmp (DependencyId, "com.apple.iokit.IOHIDSystem") == 0) {
+          DependencyKext = InternalCachedPrelinkedKext (Context, "com.apple.iokit.IOHIDFamily");
+          DEBUG ((
+            DEBUG_WARN,
+            "Dependency %a fallback to %a %a. Please fix your kext!\n",
+            DependencyId,
+            "com.apple.iokit.IOHIDSystem",
+            DependencyKext != NULL ? "succeeded" : "failed"
+            ));
+        }
+        if (DependencyKext == NULL) {
+          return RETURN_NOT_FOUND;
+        }
+      }
+
+      Status = InternalInsertPrelinkedKextDependency (Kext, DependencyIndex, DependencyKext);
+      if (RETURN_ERROR (Status)) {
+        return Status;
+      }
+
+      ++DependencyIndex;
+    }
+
+    //
+    // We do not need this anymore.
+    // Additionally it may point to invalid memory on prelinked kexts.
+    //
+    Kext->BundleLibraries = NULL;
+  }
 
   return RETURN_SUCCESS;
 }
@@ -511,6 +780,16 @@ InternalFreePrelinkedKext (
     Kext->LinkedSymbolTable = NULL;
   }
 
+  if (Kext->LinkedSymbolHash != NULL) {
+    FreePool (Kext->LinkedSymbolHash);
+    Kext->LinkedSymbolHash = NULL;
+  }
+
+  if (Kext->LinkedSymbolValues != NULL) {
+    FreePool (Kext->LinkedSymbolValues);
+    Kext->LinkedSymbolValues = NULL;
+  }
+
   if (Kext->LinkedVtables != NULL) {
     FreePool (Kext->LinkedVtables);
     Kext->LinkedVtables = NULL;
@@ -519,17 +798,283 @@ InternalFreePrelinkedKext (
   FreePool (Kext);
 }
 
+/**
+  Find kext index slot for identifier.
+
+  @param[in] Prelinked   Prelinked context with valid KextIndex.
+  @param[in] Identifier  Kext identifier.
+  @param[in] Hash        Kext identifier hash.
+
+  @return  slot with matching identifier or first free slot.
+**/
+STATIC
+PRELINKED_KEXT_INDEX_ENTRY *
+InternalFindPrelinkedKextIndexSlot (
+  IN PRELINKED_CONTEXT  *Prelinked,
+  IN CONST CHAR8        *Identifier,
+  IN UINT32             Hash
+  )
+{
+  PRELINKED_KEXT_INDEX_ENTRY  *Entries;
+  UINT32                      Mask;
+  UINT32                      Slot;
+
+  Entries = Prelinked->KextIndex;
+  Mask    = Prelinked->KextIndexSize - 1;
+  Slot    = Hash & Mask;
+
+  //
+  // Load factor is kept below 3/4, so there always is a free slot.
+  //
+  while (Entries[Slot].Identifier != NULL) {
+    if (Entries[Slot].Hash == Hash && AsciiStrCmp (Entries[Slot].Identifier, Identifier) == 0) {
+      return &Entries[Slot];
+    }
+
+    Slot = (Slot + 1) & Mask;
+  }
+
+  return &Entries[Slot];
+}
+
+/**
+  Insert kext into kext index. Earlier entries take precedence,
+  matching linear lookup order. Drops the index on allocation failure.
+
+  @param[in,out] Prelinked   Prelinked context.
+  @param[in]     Identifier  Kext identifier.
+  @param[in]     KextPlist   Kext plist or NULL.
+  @param[in]     Kext        Cached kext or NULL.
+**/
+STATIC
+VOID
+InternalInsertPrelinkedKextIndex (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     CONST CHAR8        *Identifier,
+  IN     XML_NODE           *KextPlist  OPTIONAL,
+  IN     PRELINKED_KEXT     *Kext       OPTIONAL
+  )
+{
+  PRELINKED_KEXT_INDEX_ENTRY  *OldEntries;
+  PRELINKED_KEXT_INDEX_ENTRY  *Entry;
+  UINT32                      OldSize;
+  UINT32                      Index;
+  UINT32                      Hash;
+
+  if (Prelinked->KextIndex == NULL) {
+    return;
+  }
+
+  //
+  // Grow twice once load factor reaches 3/4.
+  //
+  if ((Prelinked->KextIndexCount + 1) * 4 > Prelinked->KextIndexSize * 3) {
+    OldEntries = Prelinked->KextIndex;
+    OldSize    = Prelinked->KextIndexSize;
+
+    Prelinked->KextIndex = AllocateZeroPool (2 * OldSize * sizeof (*OldEntries));
+    if (Prelinked->KextIndex == NULL) {
+      DEBUG ((DEBUG_INFO, "OCK: Failed to grow kext index, dropping\n"));
+      FreePool (OldEntries);
+      Prelinked->KextIndexSize  = 0;
+      Prelinked->KextIndexCount = 0;
+      return;
+    }
+
+    Prelinked->KextIndexSize = 2 * OldSize;
+    for (Index = 0; Index < OldSize; ++Index) {
+      if (OldEntries[Index].Identifier != NULL) {
+        Entry = InternalFindPrelinkedKextIndexSlot (
+          Prelinked,
+          OldEntries[Index].Identifier,
+          OldEntries[Index].Hash
+          );
+        CopyMem (Entry, &OldEntries[Index], sizeof (*Entry));
+      }
+    }
+
+    FreePool (OldEntries);
+  }
+
+  Hash  = AsciiStrHash (Identifier, NULL);
+  Entry = InternalFindPrelinkedKextIndexSlot (Prelinked, Identifier, Hash);
+
+  if (Entry->Identifier == NULL) {
+    Entry->Hash       = Hash;
+    Entry->Identifier = Identifier;
+    Entry->KextPlist  = KextPlist;
+    ++Prelinked->KextIndexCount;
+  }
+
+  if (Entry->Kext == NULL) {
+    Entry->Kext = Kext;
+  }
+}
+
+/**
+  Obtain kext identifier from kext plist.
+
+  @param[in] KextPlist  Kext plist dictionary.
+
+  @return  kext identifier or NULL.
+**/
+STATIC
+CONST CHAR8 *
+InternalGetPrelinkedKextIdentifier (
+  IN XML_NODE  *KextPlist
+  )
+{
+  XML_NODE  *KextPlistValue;
+
+  KextPlistValue = PlistNodeCast (
+    PlistDictFind (KextPlist, INFO_BUNDLE_IDENTIFIER_KEY),
+    PLIST_NODE_TYPE_STRING
+    );
+  if (KextPlistValue == NULL) {
+    return NULL;
+  }
+
+  return XmlNodeContent (KextPlistValue);
+}
+
+RETURN_STATUS
+InternalBuildPrelinkedKextIndex (
+  IN OUT PRELINKED_CONTEXT  *Prelinked
+  )
+{
+  LIST_ENTRY   *Kext;
+  XML_NODE     *KextPlist;
+  CONST CHAR8  *Identifier;
+  UINT32       Index;
+  UINT32       KextCount;
+  UINT32       IndexSize;
+  UINT64       StartTime;
+
+  ASSERT (Prelinked->KextIndex == NULL);
+
+  StartTime = GetPerformanceCounter ();
+
+  KextCount = XmlNodeChildren (Prelinked->KextList);
+  IndexSize = PRELINKED_KEXT_INDEX_MIN_SIZE;
+  while (IndexSize < KextCount * 2 && IndexSize < BIT31) {
+    IndexSize *= 2;
+  }
+
+  Prelinked->KextIndex = AllocateZeroPool (IndexSize * sizeof (PRELINKED_KEXT_INDEX_ENTRY));
+  if (Prelinked->KextIndex == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  Prelinked->KextIndexSize  = IndexSize;
+  Prelinked->KextIndexCount = 0;
+
+  //
+  // Kernel pseudo kext and other already cached kexts go first.
+  //
+  Kext = GetFirstNode (&Prelinked->PrelinkedKexts);
+  while (!IsNull (&Prelinked->PrelinkedKexts, Kext)) {
+    InternalIndexPrelinkedKext (Prelinked, GET_PRELINKED_KEXT_FROM_LINK (Kext));
+    Kext = GetNextNode (&Prelinked->PrelinkedKexts, Kext);
+  }
+
+  for (Index = 0; Index < KextCount; ++Index) {
+    KextPlist = PlistNodeCast (XmlNodeChild (Prelinked->KextList, Index), PLIST_NODE_TYPE_DICT);
+    if (KextPlist == NULL) {
+      continue;
+    }
+
+    Identifier = InternalGetPrelinkedKextIdentifier (KextPlist);
+    if (Identifier != NULL) {
+      InternalInsertPrelinkedKextIndex (Prelinked, Identifier, KextPlist, NULL);
+    }
+  }
+
+  if (Prelinked->KextIndex == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "OCK: Built kext index of %u/%u entries for %u kexts in %Lu us\n",
+    Prelinked->KextIndexCount,
+    Prelinked->KextIndexSize,
+    KextCount,
+    DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter () - StartTime), 1000)
+    ));
+
+  return RETURN_SUCCESS;
+}
+
+VOID
+InternalIndexPrelinkedKext (
+  IN OUT PRELINKED_CONTEXT  *Prelinked,
+  IN     PRELINKED_KEXT     *Kext
+  )
+{
+  InternalInsertPrelinkedKextIndex (Prelinked, Kext->Identifier, NULL, Kext);
+}
+
+VOID
+InternalFreePrelinkedKextIndex (
+  IN OUT PRELINKED_CONTEXT  *Prelinked
+  )
+{
+  if (Prelinked->KextIndex != NULL) {
+    FreePool (Prelinked->KextIndex);
+    Prelinked->KextIndex = NULL;
+  }
+
+  Prelinked->KextIndexSize  = 0;
+  Prelinked->KextIndexCount = 0;
+  Prelinked->KextIndexBuilt = FALSE;
+}
+
 PRELINKED_KEXT *
 InternalCachedPrelinkedKext (
   IN OUT PRELINKED_CONTEXT  *Prelinked,
   IN     CONST CHAR8        *Identifier
   )
 {
-  PRELINKED_KEXT  *NewKext;
-  LIST_ENTRY      *Kext;
-  UINT32          Index;
-  UINT32          KextCount;
-  XML_NODE        *KextPlist;
+  PRELINKED_KEXT              *NewKext;
+  LIST_ENTRY                  *Kext;
+  UINT32                      Index;
+  UINT32                      KextCount;
+  XML_NODE                    *KextPlist;
+  PRELINKED_KEXT_INDEX_ENTRY  *Entry;
+
+  //
+  // Reading every identifier materialises all lazily parsed kext dictionaries,
+  // so only pay for it once something actually needs a lookup.
+  //
+  if (!Prelinked->KextIndexBuilt) {
+    Prelinked->KextIndexBuilt = TRUE;
+    InternalBuildPrelinkedKextIndex (Prelinked);
+  }
+
+  //
+  // Use the index when available, it covers both cached and real entries.
+  //
+  if (Prelinked->KextIndex != NULL) {
+    Entry = InternalFindPrelinkedKextIndexSlot (
+      Prelinked,
+      Identifier,
+      AsciiStrHash (Identifier, NULL)
+      );
+
+    if (Entry->Kext != NULL || Entry->KextPlist == NULL) {
+      return Entry->Kext;
+    }
+
+    NewKext = InternalCreatePrelinkedKext (Prelinked, Entry->KextPlist, Identifier);
+    if (NewKext == NULL) {
+      return NULL;
+    }
+
+    InsertTailList (&Prelinked->PrelinkedKexts, &NewKext->Link);
+    Entry->Kext = NewKext;
+
+    return NewKext;
+  }
 
   //
   // Find cached entry if any.
@@ -627,12 +1172,8 @@ InternalScanPrelinkedKext (
   IN OUT PRELINKED_CONTEXT  *Context
   )
 {
-  RETURN_STATUS      Status;
-  UINT32          FieldCount;
-  UINT32          FieldIndex;
+  RETURN_STATUS   Status;
   UINT32          DependencyIndex;
-  CONST CHAR8     *DependencyId;
-  PRELINKED_KEXT  *DependencyKext;
 
   Status = InternalScanCurrentPrelinkedKext (Kext);
   if (RETURN_ERROR (Status)) {
@@ -647,72 +1188,24 @@ InternalScanPrelinkedKext (
     Context->LinkBufferSize = (UINT32)Kext->LinkEditSegment->FileSize;
   }
 
-  //
-  // Always add kernel dependency.
-  //
-  DependencyKext = InternalCachedPrelinkedKernel (Context);
-  if (DependencyKext == NULL) {
-    return RETURN_NOT_FOUND;
-  }
-
-  if (DependencyKext != Kext) {
-    Status = InternalInsertPrelinkedKextDependency (Kext, Context, 0, DependencyKext);
+  if (!Kext->DependenciesScanned) {
+    Status = InternalResolvePrelinkedKextDependencies (Kext, Context);
     if (RETURN_ERROR (Status)) {
       return Status;
     }
-  }
 
-  if (Kext->BundleLibraries != NULL) {
-    DependencyIndex = 1;
-    FieldCount = PlistDictChildren (Kext->BundleLibraries);
-
-    for (FieldIndex = 0; FieldIndex < FieldCount; ++FieldIndex) {
-      DependencyId = PlistKeyValue (PlistDictChild (Kext->BundleLibraries, FieldIndex, NULL));
-      if (DependencyId == NULL) {
-        continue;
-      }
-
-      //
-      // We still need to add KPI dependencies, as they may have indirect symbols,
-      // which are not present in kernel (e.g. _IOLockLock).
-      //
-      DependencyKext = InternalCachedPrelinkedKext (Context, DependencyId);
-      if (DependencyKext == NULL) {
-        DEBUG ((DEBUG_INFO, "Dependency %a was not found for kext %a\n", DependencyId, Kext->Identifier));
-        //
-        // Some kexts, notably VoodooPS2 forks, link against IOHIDSystem.kext, which is a plist-only
-        // dummy, macOS does not add to the prelinkedkernel. This cannot succeed as /S/L/E directory
-        // is not accessible (and can be encrypted). Normally kext's Info.plist is to be fixed, but
-        // we also put a hack here to let some common kexts work.
-        //
-        if (AsciiStrCmp (DependencyId, "com.apple.iokit.IOHIDSystem") == 0) {
-          DependencyKext = InternalCachedPrelinkedKext (Context, "com.apple.iokit.IOHIDFamily");
-          DEBUG ((
-            DEBUG_WARN,
-            "Dependency %a fallback to %a %a. Please fix your kext!\n",
-            DependencyId,
-            "com.apple.iokit.IOHIDSystem",
-            DependencyKext != NULL ? "succeeded" : "failed"
-            ));
-        }
-        if (DependencyKext == NULL) {
-          return RETURN_NOT_FOUND;
-        }
+    for (DependencyIndex = 0; DependencyIndex < ARRAY_SIZE (Kext->Dependencies); ++DependencyIndex) {
+      if (Kext->Dependencies[DependencyIndex] == NULL) {
+        break;
       }
 
-      Status = InternalInsertPrelinkedKextDependency (Kext, Context, DependencyIndex, DependencyKext);
+      Status = InternalScanPrelinkedKextDependency (Context, Kext->Dependencies[DependencyIndex]);
       if (RETURN_ERROR (Status)) {
         return Status;
       }
-
-      ++DependencyIndex;
     }
 
-    //
-    // We do not need this anymore.
-    // Additionally it may point to invalid memory on prelinked kexts.
-    //
-    Kext->BundleLibraries = NULL;
+    Kext->DependenciesScanned = TRUE;
   }
 
   //
@@ -746,7 +1239,8 @@ InternalLinkPrelinkedKext (
   IN OUT OC_MACHO_CONTEXT   *Executable,
   IN     XML_NODE           *PlistRoot,
   IN     UINT64             LoadAddress,
-  IN     UINT64             KmodAddress
+  IN     UINT64             KmodAddress,
+  IN     BOOLEAN            Linked
   )
 {
   RETURN_STATUS      Status;
@@ -757,7 +1251,16 @@ InternalLinkPrelinkedKext (
     return NULL;
   }
 
-  Status = InternalScanPrelinkedKext (Kext, Context);
+  //
+  // Cached links do not need dependency symbols or vtables, only remember
+  // the dependencies for kexts linking against this one later.
+  //
+  if (Linked) {
+    Status = InternalResolvePrelinkedKextDependencies (Kext, Context);
+  } else {
+    Status = InternalScanPrelinkedKext (Kext, Context);
+  }
+
   if (RETURN_ERROR (Status)) {
     InternalFreePrelinkedKext (Kext);
     return NULL;
@@ -801,11 +1304,13 @@ InternalLinkPrelinkedKext (
   Kext->Context.VirtualBase = LoadAddress;
   Kext->Context.VirtualKmod = KmodAddress;
 
-  Status = InternalPrelinkKext64 (Context, Kext, LoadAddress);
+  if (!Linked) {
+    Status = InternalPrelinkKext64 (Context, Kext, LoadAddress);
 
-  if (RETURN_ERROR (Status)) {
-    InternalFreePrelinkedKext (Kext);
-    return NULL;
+    if (RETURN_ERROR (Status)) {
+      InternalFreePrelinkedKext (Kext);
+      return NULL;
+    }
   }
 
   Kext->SymbolTable     = NULL;
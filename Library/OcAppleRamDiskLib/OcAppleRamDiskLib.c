@@ -313,7 +313,7 @@ OcAppleRamDiskRead (
     ) {
     Extent = &ExtentTable->Extents[Index];
 
-    if (Offset >= CurrentOffset) {
+    if (Offset >= CurrentOffset && Offset - CurrentOffset < Extent->Length) {
       LocalOffset = (Offset - CurrentOffset);
       LocalSize   = (UINTN)MIN ((Extent->Length - LocalOffset), Size);
       CopyMem (
@@ -366,7 +366,7 @@ OcAppleRamDiskWrite (
     ) {
     Extent = &ExtentTable->Extents[Index];
 
-    if (Offset >= CurrentOffset) {
+    if (Offset >= CurrentOffset && Offset - CurrentOffset < Extent->Length) {
       LocalOffset = (Offset - CurrentOffset);
       LocalSize   = (UINTN)MIN ((Extent->Length - LocalOffset), Size);
       CopyMem (
@@ -388,6 +388,113 @@ OcAppleRamDiskWrite (
   return FALSE;
 }
 
+VOID
+OcAppleRamDiskInitializeIndex (
+  OUT OC_APPLE_RAM_DISK_INDEX            *Index,
+  IN  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable
+  )
+{
+  UINT32  ExtentIndex;
+
+  ASSERT (Index != NULL);
+  ASSERT (ExtentTable != NULL);
+  INTERNAL_ASSERT_EXTENT_TABLE_VALID (ExtentTable);
+
+  Index->ExtentTable = ExtentTable;
+  Index->Offsets[0]  = 0;
+
+  for (ExtentIndex = 0; ExtentIndex < ExtentTable->ExtentCount; ++ExtentIndex) {
+    Index->Offsets[ExtentIndex + 1] = Index->Offsets[ExtentIndex]
+      + ExtentTable->Extents[ExtentIndex].Length;
+  }
+}
+
+/**
+  Find extent containing RAM disk offset.
+
+  @param[in] Index   Extent index.
+  @param[in] Offset  Offset in RAM disk, must be below RAM disk size.
+
+  @retval Extent index.
+**/
+STATIC
+UINT32
+InternalFindExtent (
+  IN CONST OC_APPLE_RAM_DISK_INDEX  *Index,
+  IN UINT64                         Offset
+  )
+{
+  UINT32  Low;
+  UINT32  High;
+  UINT32  Middle;
+
+  //
+  // Find the last extent starting at or before Offset,
+  // which also skips any empty extents.
+  //
+  Low  = 0;
+  High = Index->ExtentTable->ExtentCount - 1;
+
+  while (Low < High) {
+    Middle = (Low + High + 1) / 2;
+    if (Index->Offsets[Middle] <= Offset) {
+      Low = Middle;
+    } else {
+      High = Middle - 1;
+    }
+  }
+
+  return Low;
+}
+
+UINTN
+OcAppleRamDiskMap (
+  IN     CONST OC_APPLE_RAM_DISK_INDEX  *Index,
+  IN     UINT64                         Offset,
+  IN     UINTN                          Size,
+  OUT    OC_APPLE_RAM_DISK_SEGMENT      *Segments,
+  IN OUT UINT32                         *SegmentCount
+  )
+{
+  CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable;
+  UINT32                             ExtentIndex;
+  UINT32                             Count;
+  UINT64                             LocalOffset;
+  UINTN                              LocalSize;
+  UINTN                              MappedSize;
+
+  ASSERT (Index != NULL);
+  ASSERT (Segments != NULL);
+  ASSERT (SegmentCount != NULL);
+  ASSERT (*SegmentCount > 0);
+
+  ExtentTable = Index->ExtentTable;
+  MappedSize  = 0;
+  Count       = 0;
+
+  if (Offset < Index->Offsets[ExtentTable->ExtentCount]) {
+    ExtentIndex = InternalFindExtent (Index, Offset);
+    LocalOffset = Offset - Index->Offsets[ExtentIndex];
+
+    while (Size > 0 && Count < *SegmentCount && ExtentIndex < ExtentTable->ExtentCount) {
+      LocalSize = (UINTN) MIN (ExtentTable->Extents[ExtentIndex].Length - LocalOffset, Size);
+      if (LocalSize > 0) {
+        Segments[Count].Data = (VOID *)(UINTN) (ExtentTable->Extents[ExtentIndex].Start + LocalOffset);
+        Segments[Count].Size = LocalSize;
+        ++Count;
+      }
+
+      Size       -= LocalSize;
+      MappedSize += LocalSize;
+      LocalOffset = 0;
+      ++ExtentIndex;
+    }
+  }
+
+  *SegmentCount = Count;
+  return MappedSize;
+}
+
 BOOLEAN
 OcAppleRamDiskLoadFile (
   IN CONST APPLE_RAM_DISK_EXTENT_TABLE  *ExtentTable,
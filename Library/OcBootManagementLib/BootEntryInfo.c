@@ -75,9 +75,6 @@ GetAppleRecoveryNameFromPlist (
 {
   XML_DOCUMENT        *Document;
   XML_NODE            *RootDict;
-  UINT32              DictSize;
-  UINT32              Index;
-  CONST CHAR8         *CurrentKey;
   XML_NODE            *CurrentValue;
   CONST CHAR8         *Version;
   CHAR16              *RecoveryName;
@@ -98,27 +95,17 @@ GetAppleRecoveryNameFromPlist (
 
   RecoveryName = NULL;
 
-  DictSize = PlistDictChildren (RootDict);
-  for (Index = 0; Index < DictSize; Index++) {
-    CurrentKey = PlistKeyValue (PlistDictChild (RootDict, Index, &CurrentValue));
-
-    if (CurrentKey == NULL || AsciiStrCmp (CurrentKey, "ProductUserVisibleVersion") != 0) {
-      continue;
-    }
-
-    if (PlistNodeCast (CurrentValue, PLIST_NODE_TYPE_STRING) != NULL) {
-      Version = XmlNodeContent (CurrentValue);
-      if (Version != NULL) {
-        RecoveryNameSize = L_STR_SIZE(L"Recovery ") + AsciiStrLen (Version) * sizeof (CHAR16);
-        RecoveryName = AllocatePool (RecoveryNameSize);
-        if (RecoveryName != NULL) {
-          UnicodeSPrint (RecoveryName, RecoveryNameSize, L"Recovery %a", Version);
-          UnicodeFilterString (RecoveryName, TRUE);
-        }
+  CurrentValue = PlistNodeCast (PlistDictFind (RootDict, "ProductUserVisibleVersion"), PLIST_NODE_TYPE_STRING);
+  if (CurrentValue != NULL) {
+    Version = XmlNodeContent (CurrentValue);
+    if (Version != NULL) {
+      RecoveryNameSize = L_STR_SIZE(L"Recovery ") + AsciiStrLen (Version) * sizeof (CHAR16);
+      RecoveryName = AllocatePool (RecoveryNameSize);
+      if (RecoveryName != NULL) {
+        UnicodeSPrint (RecoveryName, RecoveryNameSize, L"Recovery %a", Version);
+        UnicodeFilterString (RecoveryName, TRUE);
       }
     }
-
-    break;
   }
 
   XmlDocumentFree (Document);
@@ -16,6 +16,8 @@
 
 #include <Guid/FileInfo.h>
 
+#include <Protocol/MpService.h>
+
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DevicePathLib.h>
@@ -120,8 +122,10 @@ InternalGetDiskImageBootFile (
 {
   EFI_DEVICE_PATH_PROTOCOL       *DevPath;
 
+  EFI_STATUS                     Status;
   BOOLEAN                        Result;
   OC_APPLE_CHUNKLIST_CONTEXT     ChunklistContext;
+  EFI_MP_SERVICES_PROTOCOL       *MpServices;
 
   CONST EFI_DEVICE_PATH_PROTOCOL *DmgDevicePath;
   UINTN                          DmgDevicePathSize;
@@ -130,6 +134,19 @@ InternalGetDiskImageBootFile (
   ASSERT (BootPolicy != NULL);
   ASSERT (DmgFileSize > 0);
 
+  //
+  // Chunk hashing and decompression of large reads are spread across
+  // all processors when MP services exist.
+  //
+  Status = gBS->LocateProtocol (
+                  &gEfiMpServiceProtocolGuid,
+                  NULL,
+                  (VOID **) &MpServices
+                  );
+  if (EFI_ERROR (Status)) {
+    MpServices = NULL;
+  }
+
   if (ChunklistBuffer == NULL) {
     if ((Policy & OC_LOAD_REQUIRE_APPLE_SIGN) != 0) {
       return NULL;
@@ -172,7 +189,8 @@ InternalGetDiskImageBootFile (
 
     Result = OcAppleDiskImageVerifyData (
                Context->DmgContext,
-               &ChunklistContext
+               &ChunklistContext,
+               MpServices
                );
     if (!Result) {
       //
@@ -183,6 +201,8 @@ InternalGetDiskImageBootFile (
     }
   }
 
+  OcAppleDiskImageSetMpServices (Context->DmgContext, MpServices);
+
   Context->BlockIoHandle = OcAppleDiskImageInstallBlockIo (
                              Context->DmgContext,
                              DmgFileSize,
@@ -16,6 +16,7 @@
 
 #include <Protocol/AppleBootPolicy.h>
 #include <Protocol/LoadedImage.h>
+#include <Protocol/OcLog.h>
 #include <Protocol/SimpleTextOut.h>
 
 #include <Library/BaseLib.h>
@@ -572,6 +573,7 @@ OcRunSimpleBootPicker (
   EFI_HANDLE                  BooterHandle;
   UINT32                      DefaultEntry;
   INTERNAL_DMG_LOAD_CONTEXT   DmgLoadContext;
+  OC_LOG_PROTOCOL             *OcLog;
 
   AppleBootPolicy = OcAppleBootPolicyInstallProtocol (FALSE);
   if (AppleBootPolicy == NULL) {
@@ -652,6 +654,14 @@ OcRunSimpleBootPicker (
         &DmgLoadContext
         );
       if (!EFI_ERROR (Status)) {
+        //
+        // The loader may exit boot services, write buffered log while file I/O is possible.
+        //
+        Status = gBS->LocateProtocol (&gOcLogProtocolGuid, NULL, (VOID **) &OcLog);
+        if (!EFI_ERROR (Status)) {
+          OcLog->SaveLog (OcLog, 0, NULL);
+        }
+
         Status = StartImage (Chosen, BooterHandle, NULL, NULL);
         if (EFI_ERROR (Status)) {
           DEBUG ((DEBUG_ERROR, "StartImage failed - %r\n", Status));
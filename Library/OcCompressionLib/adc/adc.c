@@ -0,0 +1,102 @@
+/** @file
+  Copyright (C) 2019, vit9696. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Base.h>
+
+#include <Library/BaseMemoryLib.h>
+#include <Library/OcCompressionLib.h>
+
+//
+// Apple Data Compression is a simple LZ77 variant used by legacy dmg images.
+// Every opcode is one of:
+//   1xxxxxxx                    - (x + 1) literal bytes follow.
+//   01xxxxxx yyyyyyyy yyyyyyyy  - copy (x + 4) bytes from distance (y + 1).
+//   00xxxxyy yyyyyyyy           - copy (x + 3) bytes from distance (y + 1).
+//
+#define ADC_PLAIN_FLAG        0x80U
+#define ADC_THREE_BYTE_FLAG   0x40U
+
+UINTN
+DecompressADC (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  )
+{
+  UINTN  SrcIndex;
+  UINTN  DstIndex;
+  UINTN  Length;
+  UINTN  Distance;
+  UINTN  Index;
+  UINT8  Opcode;
+
+  if (DstLen > OC_COMPRESSION_MAX_LENGTH || SrcLen > OC_COMPRESSION_MAX_LENGTH) {
+    return 0;
+  }
+
+  SrcIndex = 0;
+  DstIndex = 0;
+
+  while (SrcIndex < SrcLen) {
+    Opcode = Src[SrcIndex++];
+
+    if ((Opcode & ADC_PLAIN_FLAG) != 0) {
+      Length = (Opcode & ~ADC_PLAIN_FLAG) + 1U;
+      if (Length > SrcLen - SrcIndex || Length > DstLen - DstIndex) {
+        return 0;
+      }
+
+      CopyMem (&Dst[DstIndex], &Src[SrcIndex], Length);
+      SrcIndex += Length;
+      DstIndex += Length;
+      continue;
+    }
+
+    if ((Opcode & ADC_THREE_BYTE_FLAG) != 0) {
+      if (SrcLen - SrcIndex < 2) {
+        return 0;
+      }
+
+      Length   = (Opcode & 0x3FU) + 4U;
+      Distance = ((UINTN) Src[SrcIndex] << 8U) | Src[SrcIndex + 1];
+      SrcIndex += 2;
+    } else {
+      if (SrcLen - SrcIndex < 1) {
+        return 0;
+      }
+
+      Length   = ((Opcode >> 2U) & 0x0FU) + 3U;
+      Distance = ((UINTN) (Opcode & 0x03U) << 8U) | Src[SrcIndex];
+      SrcIndex += 1;
+    }
+
+    ++Distance;
+
+    if (Distance > DstIndex || Length > DstLen - DstIndex) {
+      return 0;
+    }
+
+    //
+    // Matches may overlap the data they produce, so copy byte by byte.
+    //
+    for (Index = 0; Index < Length; ++Index) {
+      Dst[DstIndex + Index] = Dst[DstIndex + Index - Distance];
+    }
+
+    DstIndex += Length;
+  }
+
+  return DstIndex;
+}
@@ -0,0 +1,530 @@
+/** @file
+  Copyright (C) 2019, vit9696. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Base.h>
+
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+
+//
+// Minimal bzip2 stream decoder sufficient for dmg chunks.
+// Every block is decoded as Huffman -> MTF/RLE2 -> inverse BWT -> RLE1,
+// and both block and stream CRCs are validated.
+//
+#define BZIP2_BLOCK_UNIT       100000U
+#define BZIP2_MAX_GROUPS       6U
+#define BZIP2_MIN_GROUPS       2U
+#define BZIP2_MAX_ALPHA_SIZE   258U
+#define BZIP2_MAX_CODE_LENGTH  20U
+#define BZIP2_GROUP_SIZE       50U
+#define BZIP2_MAX_SELECTORS    (2U + (9U * BZIP2_BLOCK_UNIT) / BZIP2_GROUP_SIZE)
+#define BZIP2_RUN_A            0U
+#define BZIP2_RUN_B            1U
+
+#define BZIP2_BLOCK_MAGIC_HI   0x314159U
+#define BZIP2_BLOCK_MAGIC_LO   0x265359U
+#define BZIP2_END_MAGIC_HI     0x177245U
+#define BZIP2_END_MAGIC_LO     0x385090U
+
+typedef struct {
+  CONST UINT8  *Src;
+  UINTN        SrcLen;
+  UINTN        SrcIndex;
+  UINT64       Bits;
+  UINT32       BitCount;
+  BOOLEAN      Error;
+} BZIP2_BIT_READER;
+
+typedef struct {
+  UINT8   Length[BZIP2_MAX_ALPHA_SIZE];
+  UINT16  Symbol[BZIP2_MAX_ALPHA_SIZE];
+  UINT32  Count[BZIP2_MAX_CODE_LENGTH + 1];
+  UINT32  First[BZIP2_MAX_CODE_LENGTH + 1];
+  UINT32  Offset[BZIP2_MAX_CODE_LENGTH + 1];
+  UINT32  MinLength;
+} BZIP2_HUFFMAN_TABLE;
+
+typedef struct {
+  BZIP2_BIT_READER     Reader;
+  BZIP2_HUFFMAN_TABLE  Tables[BZIP2_MAX_GROUPS];
+  UINT8                Selectors[BZIP2_MAX_SELECTORS];
+  UINT8                SeqToUnseq[256];
+  UINT32               Unzftab[256];
+  UINT32               CrcTable[256];
+  UINT32               *Tt;
+  UINT32               BlockSizeMax;
+} BZIP2_DECODER;
+
+STATIC
+UINT32
+InternalBzip2ReadBits (
+  IN OUT BZIP2_BIT_READER  *Reader,
+  IN     UINT32            Count
+  )
+{
+  if (Count == 0 || Count > 32) {
+    Reader->Error = TRUE;
+    return 0;
+  }
+
+  while (Reader->BitCount < Count) {
+    if (Reader->SrcIndex >= Reader->SrcLen) {
+      Reader->Error = TRUE;
+      return 0;
+    }
+
+    Reader->Bits      = (Reader->Bits << 8U) | Reader->Src[Reader->SrcIndex++];
+    Reader->BitCount += 8;
+  }
+
+  Reader->BitCount -= Count;
+  return (UINT32) ((Reader->Bits >> Reader->BitCount) & ((1ULL << Count) - 1U));
+}
+
+STATIC
+BOOLEAN
+InternalBzip2BuildTable (
+  IN OUT BZIP2_HUFFMAN_TABLE  *Table,
+  IN     UINT32               AlphaSize
+  )
+{
+  UINT32  Index;
+  UINT32  Length;
+  UINT32  Code;
+  UINT32  Offset;
+
+  ZeroMem (Table->Count, sizeof (Table->Count));
+
+  for (Index = 0; Index < AlphaSize; ++Index) {
+    ++Table->Count[Table->Length[Index]];
+  }
+
+  //
+  // Canonical code assignment, rejecting oversubscribed tables.
+  //
+  Code   = 0;
+  Offset = 0;
+  Table->MinLength = 0;
+  for (Length = 1; Length <= BZIP2_MAX_CODE_LENGTH; ++Length) {
+    Table->First[Length]  = Code;
+    Table->Offset[Length] = Offset;
+    if (Table->Count[Length] > (1U << Length) - Code) {
+      return FALSE;
+    }
+
+    if (Table->MinLength == 0 && Table->Count[Length] > 0) {
+      Table->MinLength = Length;
+    }
+
+    Code    = (Code + Table->Count[Length]) << 1U;
+    Offset += Table->Count[Length];
+  }
+
+  if (Table->MinLength == 0) {
+    return FALSE;
+  }
+
+  Offset = 0;
+  for (Length = 1; Length <= BZIP2_MAX_CODE_LENGTH; ++Length) {
+    for (Index = 0; Index < AlphaSize; ++Index) {
+      if (Table->Length[Index] == Length) {
+        Table->Symbol[Offset++] = (UINT16) Index;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+STATIC
+UINT32
+InternalBzip2DecodeSymbol (
+  IN OUT BZIP2_BIT_READER     *Reader,
+  IN     BZIP2_HUFFMAN_TABLE  *Table
+  )
+{
+  UINT32  Length;
+  UINT32  Code;
+
+  Length = Table->MinLength;
+  Code   = InternalBzip2ReadBits (Reader, Length);
+
+  while (Code - Table->First[Length] >= Table->Count[Length]) {
+    if (Length == BZIP2_MAX_CODE_LENGTH) {
+      Reader->Error = TRUE;
+      return 0;
+    }
+
+    Code = (Code << 1U) | InternalBzip2ReadBits (Reader, 1);
+    ++Length;
+  }
+
+  return Table->Symbol[Table->Offset[Length] + Code - Table->First[Length]];
+}
+
+/**
+  Read block tables and decode block symbols into Tt low bytes.
+
+  @return  Decoded byte count, 0 on error.
+**/
+STATIC
+UINT32
+InternalBzip2ReadBlock (
+  IN OUT BZIP2_DECODER  *Decoder,
+  OUT    UINT32         *OrigPtr
+  )
+{
+  BZIP2_BIT_READER     *Reader;
+  BZIP2_HUFFMAN_TABLE  *Table;
+  UINT8                MtfList[256];
+  UINT8                GroupMtf[BZIP2_MAX_GROUPS];
+  UINT32               InUse16;
+  UINT32               InUseCount;
+  UINT32               AlphaSize;
+  UINT32               GroupCount;
+  UINT32               SelectorCount;
+  UINT32               Index;
+  UINT32               Index2;
+  UINT32               Value;
+  UINT32               Length;
+  UINT32               Symbol;
+  UINT32               EndOfBlock;
+  UINT32               GroupIndex;
+  UINT32               GroupLeft;
+  UINT32               BlockLength;
+  UINT32               RunLength;
+  UINT32               RunWeight;
+  UINT8                Byte;
+
+  Reader = &Decoder->Reader;
+
+  //
+  // Randomised blocks are deprecated since bzip2 0.9.5.
+  //
+  if (InternalBzip2ReadBits (Reader, 1) != 0) {
+    return 0;
+  }
+
+  *OrigPtr = InternalBzip2ReadBits (Reader, 24);
+
+  InUse16    = InternalBzip2ReadBits (Reader, 16);
+  InUseCount = 0;
+  for (Index = 0; Index < 16; ++Index) {
+    if ((InUse16 & (0x8000U >> Index)) != 0) {
+      Value = InternalBzip2ReadBits (Reader, 16);
+      for (Index2 = 0; Index2 < 16; ++Index2) {
+        if ((Value & (0x8000U >> Index2)) != 0) {
+          Decoder->SeqToUnseq[InUseCount++] = (UINT8) (Index * 16 + Index2);
+        }
+      }
+    }
+  }
+
+  if (Reader->Error || InUseCount == 0) {
+    return 0;
+  }
+
+  AlphaSize = InUseCount + 2;
+
+  GroupCount    = InternalBzip2ReadBits (Reader, 3);
+  SelectorCount = InternalBzip2ReadBits (Reader, 15);
+  if (GroupCount < BZIP2_MIN_GROUPS || GroupCount > BZIP2_MAX_GROUPS
+    || SelectorCount == 0 || SelectorCount > BZIP2_MAX_SELECTORS) {
+    return 0;
+  }
+
+  for (Index = 0; Index < GroupCount; ++Index) {
+    GroupMtf[Index] = (UINT8) Index;
+  }
+
+  for (Index = 0; Index < SelectorCount; ++Index) {
+    Value = 0;
+    while (InternalBzip2ReadBits (Reader, 1) != 0) {
+      if (++Value >= GroupCount || Reader->Error) {
+        return 0;
+      }
+    }
+
+    Byte = GroupMtf[Value];
+    for (; Value > 0; --Value) {
+      GroupMtf[Value] = GroupMtf[Value - 1];
+    }
+    GroupMtf[0] = Byte;
+    Decoder->Selectors[Index] = Byte;
+  }
+
+  for (Index = 0; Index < GroupCount; ++Index) {
+    Table  = &Decoder->Tables[Index];
+    Length = InternalBzip2ReadBits (Reader, 5);
+    for (Index2 = 0; Index2 < AlphaSize; ++Index2) {
+      while (TRUE) {
+        if (Length < 1 || Length > BZIP2_MAX_CODE_LENGTH || Reader->Error) {
+          return 0;
+        }
+
+        if (InternalBzip2ReadBits (Reader, 1) == 0) {
+          break;
+        }
+
+        if (InternalBzip2ReadBits (Reader, 1) == 0) {
+          ++Length;
+        } else {
+          --Length;
+        }
+      }
+
+      Table->Length[Index2] = (UINT8) Length;
+    }
+
+    if (!InternalBzip2BuildTable (Table, AlphaSize)) {
+      return 0;
+    }
+  }
+
+  //
+  // Decode Huffman symbols, undoing RLE2 and MTF on the fly.
+  //
+  for (Index = 0; Index < 256; ++Index) {
+    MtfList[Index]           = (UINT8) Index;
+    Decoder->Unzftab[Index] = 0;
+  }
+
+  EndOfBlock  = InUseCount + 1;
+  GroupIndex  = 0;
+  GroupLeft   = 0;
+  BlockLength = 0;
+  RunLength   = 0;
+  RunWeight   = 1;
+  Table       = NULL;
+
+  while (TRUE) {
+    if (GroupLeft == 0) {
+      if (GroupIndex >= SelectorCount) {
+        return 0;
+      }
+
+      Table     = &Decoder->Tables[Decoder->Selectors[GroupIndex++]];
+      GroupLeft = BZIP2_GROUP_SIZE;
+    }
+
+    --GroupLeft;
+    Symbol = InternalBzip2DecodeSymbol (Reader, Table);
+    if (Reader->Error) {
+      return 0;
+    }
+
+    if (Symbol == BZIP2_RUN_A || Symbol == BZIP2_RUN_B) {
+      if (RunWeight > Decoder->BlockSizeMax) {
+        return 0;
+      }
+
+      RunLength += RunWeight << Symbol;
+      RunWeight <<= 1U;
+      if (RunLength > Decoder->BlockSizeMax) {
+        return 0;
+      }
+      continue;
+    }
+
+    if (RunLength > 0) {
+      if (RunLength > Decoder->BlockSizeMax - BlockLength) {
+        return 0;
+      }
+
+      Byte = Decoder->SeqToUnseq[MtfList[0]];
+      Decoder->Unzftab[Byte] += RunLength;
+      while (RunLength > 0) {
+        Decoder->Tt[BlockLength++] = Byte;
+        --RunLength;
+      }
+      RunWeight = 1;
+    }
+
+    if (Symbol == EndOfBlock) {
+      break;
+    }
+
+    if (BlockLength >= Decoder->BlockSizeMax) {
+      return 0;
+    }
+
+    Value = Symbol - 1;
+    Byte  = MtfList[Value];
+    for (; Value > 0; --Value) {
+      MtfList[Value] = MtfList[Value - 1];
+    }
+    MtfList[0] = Byte;
+
+    Byte = Decoder->SeqToUnseq[Byte];
+    ++Decoder->Unzftab[Byte];
+    Decoder->Tt[BlockLength++] = Byte;
+  }
+
+  if (*OrigPtr >= BlockLength) {
+    return 0;
+  }
+
+  return BlockLength;
+}
+
+UINTN
+DecompressBZIP2 (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  )
+{
+  BZIP2_DECODER  *Decoder;
+  UINTN          DstIndex;
+  UINT32         Index;
+  UINT32         Value;
+  UINT32         Crc;
+  UINT32         BlockCrc;
+  UINT32         CombinedCrc;
+  UINT32         OrigPtr;
+  UINT32         BlockLength;
+  UINT32         Position;
+  UINT32         Cumulative[256];
+  UINT32         Run;
+  UINT32         Last;
+  UINT8          Byte;
+  BOOLEAN        Success;
+
+  if (DstLen > OC_COMPRESSION_MAX_LENGTH || SrcLen > OC_COMPRESSION_MAX_LENGTH
+    || SrcLen < 4 || Src[0] != 'B' || Src[1] != 'Z' || Src[2] != 'h'
+    || Src[3] < '1' || Src[3] > '9') {
+    return 0;
+  }
+
+  Decoder = AllocatePool (sizeof (*Decoder));
+  if (Decoder == NULL) {
+    return 0;
+  }
+
+  Decoder->BlockSizeMax = (Src[3] - '0') * BZIP2_BLOCK_UNIT;
+  Decoder->Tt           = AllocatePool (Decoder->BlockSizeMax * sizeof (UINT32));
+  if (Decoder->Tt == NULL) {
+    FreePool (Decoder);
+    return 0;
+  }
+
+  for (Index = 0; Index < 256; ++Index) {
+    Value = Index << 24U;
+    for (Position = 0; Position < 8; ++Position) {
+      Value = (Value & BIT31) != 0 ? (Value << 1U) ^ 0x04C11DB7U : Value << 1U;
+    }
+    Decoder->CrcTable[Index] = Value;
+  }
+
+  ZeroMem (&Decoder->Reader, sizeof (Decoder->Reader));
+  Decoder->Reader.Src      = Src;
+  Decoder->Reader.SrcLen   = SrcLen;
+  Decoder->Reader.SrcIndex = 4;
+
+  DstIndex    = 0;
+  CombinedCrc = 0;
+  Success     = FALSE;
+
+  while (TRUE) {
+    Value = InternalBzip2ReadBits (&Decoder->Reader, 24);
+    Index = InternalBzip2ReadBits (&Decoder->Reader, 24);
+    if (Decoder->Reader.Error) {
+      break;
+    }
+
+    if (Value == BZIP2_END_MAGIC_HI && Index == BZIP2_END_MAGIC_LO) {
+      Value   = InternalBzip2ReadBits (&Decoder->Reader, 32);
+      Success = !Decoder->Reader.Error && Value == CombinedCrc;
+      break;
+    }
+
+    if (Value != BZIP2_BLOCK_MAGIC_HI || Index != BZIP2_BLOCK_MAGIC_LO) {
+      break;
+    }
+
+    BlockCrc    = InternalBzip2ReadBits (&Decoder->Reader, 32);
+    BlockLength = InternalBzip2ReadBlock (Decoder, &OrigPtr);
+    if (BlockLength == 0) {
+      break;
+    }
+
+    //
+    // Inverse BWT: link every position to its successor in the upper bits.
+    //
+    Value = 0;
+    for (Index = 0; Index < 256; ++Index) {
+      Cumulative[Index] = Value;
+      Value += Decoder->Unzftab[Index];
+    }
+
+    for (Index = 0; Index < BlockLength; ++Index) {
+      Byte = (UINT8) Decoder->Tt[Index];
+      Decoder->Tt[Cumulative[Byte]++] |= Index << 8U;
+    }
+
+    //
+    // Walk the chain undoing RLE1 (4 equal bytes followed by repeat count).
+    //
+    Crc      = MAX_UINT32;
+    Position = Decoder->Tt[OrigPtr] >> 8U;
+    Run      = 0;
+    Last     = MAX_UINT32;
+    for (Index = 0; Index < BlockLength; ++Index) {
+      Position = Decoder->Tt[Position];
+      Byte     = (UINT8) Position;
+      Position >>= 8U;
+
+      if (Run == 4) {
+        if (Byte > DstLen - DstIndex) {
+          break;
+        }
+
+        for (Run = 0; Run < Byte; ++Run) {
+          Dst[DstIndex++] = (UINT8) Last;
+          Crc = (Crc << 8U) ^ Decoder->CrcTable[(Crc >> 24U) ^ Last];
+        }
+
+        Run = 0;
+        continue;
+      }
+
+      if (Byte != Last) {
+        Last = Byte;
+        Run  = 1;
+      } else {
+        ++Run;
+      }
+
+      if (DstIndex >= DstLen) {
+        break;
+      }
+
+      Dst[DstIndex++] = Byte;
+      Crc = (Crc << 8U) ^ Decoder->CrcTable[(Crc >> 24U) ^ Byte];
+    }
+
+    if (Index != BlockLength || ~Crc != BlockCrc) {
+      break;
+    }
+
+    CombinedCrc = ((CombinedCrc << 1U) | (CombinedCrc >> 31U)) ^ BlockCrc;
+  }
+
+  FreePool (Decoder->Tt);
+  FreePool (Decoder);
+
+  return Success ? DstIndex : 0;
+}
@@ -0,0 +1,794 @@
+/** @file
+  Copyright (C) 2019, vit9696. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Base.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/OcCompressionLib.h>
+
+#include "../lzvn/lzvn.h"
+
+//
+// LZFSE stream is a sequence of blocks terminated by end-of-stream block.
+// Compressed blocks contain literals and (L, M, D) triples, each encoded
+// with its own finite state entropy (tANS) coder. LZVN blocks are decoded
+// with the LZVN decoder, and matches may cross block boundaries.
+//
+#define LZFSE_ENDOFSTREAM_BLOCK_MAGIC     0x24787662U ///< bvx$
+#define LZFSE_UNCOMPRESSED_BLOCK_MAGIC    0x2D787662U ///< bvx-
+#define LZFSE_COMPRESSEDV1_BLOCK_MAGIC    0x31787662U ///< bvx1
+#define LZFSE_COMPRESSEDV2_BLOCK_MAGIC    0x32787662U ///< bvx2
+#define LZFSE_COMPRESSEDLZVN_BLOCK_MAGIC  0x6E787662U ///< bvxn
+
+#define LZFSE_ENCODE_L_SYMBOLS        20U
+#define LZFSE_ENCODE_M_SYMBOLS        20U
+#define LZFSE_ENCODE_D_SYMBOLS        64U
+#define LZFSE_ENCODE_LITERAL_SYMBOLS  256U
+#define LZFSE_ENCODE_SYMBOLS          (LZFSE_ENCODE_L_SYMBOLS + LZFSE_ENCODE_M_SYMBOLS \
+  + LZFSE_ENCODE_D_SYMBOLS + LZFSE_ENCODE_LITERAL_SYMBOLS)
+
+#define LZFSE_ENCODE_L_STATES         64U
+#define LZFSE_ENCODE_M_STATES         64U
+#define LZFSE_ENCODE_D_STATES         256U
+#define LZFSE_ENCODE_LITERAL_STATES   1024U
+
+#define LZFSE_MATCHES_PER_BLOCK       10000U
+#define LZFSE_LITERALS_PER_BLOCK      (4U * LZFSE_MATCHES_PER_BLOCK)
+
+///
+/// Header sizes. V1 size includes tail padding of the reference structure.
+///
+#define LZFSE_UNCOMPRESSED_HEADER_SIZE  8U
+#define LZFSE_LZVN_HEADER_SIZE          12U
+#define LZFSE_V1_HEADER_SIZE            772U
+#define LZFSE_V2_HEADER_SIZE            32U
+
+typedef struct {
+  INT8    Bits;
+  UINT8   Symbol;
+  INT16   Delta;
+} LZFSE_DECODER_ENTRY;
+
+typedef struct {
+  UINT8   TotalBits;
+  UINT8   ValueBits;
+  INT16   Delta;
+  INT32   ValueBase;
+} LZFSE_VALUE_DECODER_ENTRY;
+
+typedef struct {
+  UINT64       Accum;
+  INT32        AccumBits;
+  CONST UINT8  *Start;
+  CONST UINT8  *Current;
+  BOOLEAN      Error;
+} LZFSE_BIT_READER;
+
+typedef struct {
+  UINT32  RawBytes;
+  UINT32  Literals;
+  UINT32  Matches;
+  UINT32  LiteralPayloadBytes;
+  UINT32  LmdPayloadBytes;
+  INT32   LiteralBits;
+  INT32   LmdBits;
+  UINT16  LiteralState[4];
+  UINT16  LState;
+  UINT16  MState;
+  UINT16  DState;
+  UINT16  Freq[LZFSE_ENCODE_SYMBOLS];
+} LZFSE_BLOCK_HEADER;
+
+typedef struct {
+  LZFSE_BLOCK_HEADER         Header;
+  LZFSE_DECODER_ENTRY        LiteralDecoder[LZFSE_ENCODE_LITERAL_STATES];
+  LZFSE_VALUE_DECODER_ENTRY  LDecoder[LZFSE_ENCODE_L_STATES];
+  LZFSE_VALUE_DECODER_ENTRY  MDecoder[LZFSE_ENCODE_M_STATES];
+  LZFSE_VALUE_DECODER_ENTRY  DDecoder[LZFSE_ENCODE_D_STATES];
+  UINT8                      Literals[LZFSE_LITERALS_PER_BLOCK + 4];
+} LZFSE_DECODER;
+
+STATIC CONST UINT8 mLzfseLExtraBits[LZFSE_ENCODE_L_SYMBOLS] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3, 5, 8
+};
+
+STATIC CONST INT32 mLzfseLBaseValue[LZFSE_ENCODE_L_SYMBOLS] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20, 28, 60
+};
+
+STATIC CONST UINT8 mLzfseMExtraBits[LZFSE_ENCODE_M_SYMBOLS] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 5, 8, 11
+};
+
+STATIC CONST INT32 mLzfseMBaseValue[LZFSE_ENCODE_M_SYMBOLS] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 24, 56, 312
+};
+
+STATIC CONST UINT8 mLzfseDExtraBits[LZFSE_ENCODE_D_SYMBOLS] = {
+  0,  0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,  3,
+  4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,
+  8,  8,  8,  8,  9,  9,  9,  9,  10, 10, 10, 10, 11, 11, 11, 11,
+  12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15
+};
+
+STATIC CONST INT32 mLzfseDBaseValue[LZFSE_ENCODE_D_SYMBOLS] = {
+  0,      1,      2,      3,     4,     6,     8,     10,    12,    16,
+  20,     24,     28,     36,    44,    52,    60,    76,    92,    108,
+  124,    156,    188,    220,   252,   316,   380,   444,   508,   636,
+  764,    892,    1020,   1276,  1532,  1788,  2044,  2556,  3068,  3580,
+  4092,   5116,   6140,   7164,  8188,  10236, 12284, 14332, 16380, 20476,
+  24572,  28668,  32764,  40956, 49148, 57340, 65532, 81916, 98300, 114684,
+  131068, 163836, 196604, 229372
+};
+
+STATIC CONST UINT8 mLzfseFreqBits[32] = {
+  2, 3, 2, 5, 2, 3, 2, 8, 2, 3, 2, 5, 2, 3, 2, 14,
+  2, 3, 2, 5, 2, 3, 2, 8, 2, 3, 2, 5, 2, 3, 2, 14
+};
+
+STATIC CONST UINT8 mLzfseFreqValue[32] = {
+  0, 2, 1, 4, 0, 3, 1, 0, 0, 2, 1, 5, 0, 3, 1, 0,
+  0, 2, 1, 6, 0, 3, 1, 0, 0, 2, 1, 7, 0, 3, 1, 0
+};
+
+STATIC
+UINT32
+InternalLzfseLog2 (
+  IN UINT32  Value
+  )
+{
+  UINT32  Result;
+
+  Result = 0;
+  while (Value > 1) {
+    Value >>= 1U;
+    ++Result;
+  }
+
+  return Result;
+}
+
+/**
+  Build FSE decoder table, every state gets a symbol, bit count and
+  state delta, so that next state is Delta + ReadBits (Bits).
+**/
+STATIC
+BOOLEAN
+InternalLzfseBuildTable (
+  IN  UINT32               StateCount,
+  IN  UINT32               SymbolCount,
+  IN  CONST UINT16         *Freq,
+  OUT LZFSE_DECODER_ENTRY  *Table
+  )
+{
+  UINT32  StateLog;
+  UINT32  Symbol;
+  UINT32  Frequency;
+  UINT32  Total;
+  UINT32  Bits;
+  UINT32  Threshold;
+  UINT32  Index;
+
+  StateLog = InternalLzfseLog2 (StateCount);
+  Total    = 0;
+
+  for (Symbol = 0; Symbol < SymbolCount; ++Symbol) {
+    Frequency = Freq[Symbol];
+    if (Frequency == 0) {
+      continue;
+    }
+
+    if (Frequency > StateCount - Total) {
+      return FALSE;
+    }
+
+    Total    += Frequency;
+    Bits      = StateLog - InternalLzfseLog2 (Frequency);
+    Threshold = ((2 * StateCount) >> Bits) - Frequency;
+
+    for (Index = 0; Index < Frequency; ++Index, ++Table) {
+      Table->Symbol = (UINT8) Symbol;
+      if (Index < Threshold) {
+        Table->Bits  = (INT8) Bits;
+        Table->Delta = (INT16) (((Frequency + Index) << Bits) - StateCount);
+      } else {
+        Table->Bits  = (INT8) (Bits - 1);
+        Table->Delta = (INT16) ((Index - Threshold) << (Bits - 1));
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+STATIC
+BOOLEAN
+InternalLzfseBuildValueTable (
+  IN  UINT32                     StateCount,
+  IN  UINT32                     SymbolCount,
+  IN  CONST UINT16               *Freq,
+  IN  CONST UINT8                *ExtraBits,
+  IN  CONST INT32                *BaseValue,
+  OUT LZFSE_VALUE_DECODER_ENTRY  *Table
+  )
+{
+  LZFSE_DECODER_ENTRY  Entries[LZFSE_ENCODE_D_STATES];
+  UINT32               Index;
+
+  if (StateCount > ARRAY_SIZE (Entries)) {
+    return FALSE;
+  }
+
+  //
+  // Frequencies may not add up to StateCount, leave other states zeroed.
+  //
+  ZeroMem (Entries, sizeof (Entries));
+
+  if (!InternalLzfseBuildTable (StateCount, SymbolCount, Freq, Entries)) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < StateCount; ++Index) {
+    Table[Index].ValueBits = ExtraBits[Entries[Index].Symbol];
+    Table[Index].TotalBits = (UINT8) (Entries[Index].Bits + Table[Index].ValueBits);
+    Table[Index].Delta     = Entries[Index].Delta;
+    Table[Index].ValueBase = BaseValue[Entries[Index].Symbol];
+  }
+
+  return TRUE;
+}
+
+/**
+  Initialise backward bit stream ending at Reader->Current.
+  Bits is the amount of unused bits in the last byte as a non-positive number.
+**/
+STATIC
+BOOLEAN
+InternalLzfseInitReader (
+  IN OUT LZFSE_BIT_READER  *Reader,
+  IN     INT32             Bits
+  )
+{
+  UINT32  Count;
+  UINT32  Index;
+
+  Count = Bits != 0 ? 8 : 7;
+  if ((UINTN) (Reader->Current - Reader->Start) < Count) {
+    return FALSE;
+  }
+
+  Reader->Current  -= Count;
+  Reader->Accum     = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    Reader->Accum |= LShiftU64 (Reader->Current[Index], Index * 8);
+  }
+
+  Reader->AccumBits = (INT32) (Count * 8) + Bits;
+  Reader->Error     = FALSE;
+
+  return Reader->AccumBits >= 56 && Reader->AccumBits < 64
+    && RShiftU64 (Reader->Accum, Reader->AccumBits) == 0;
+}
+
+/**
+  Refill the stream with whole bytes, so that at least 56 bits are available.
+**/
+STATIC
+BOOLEAN
+InternalLzfseFlushReader (
+  IN OUT LZFSE_BIT_READER  *Reader
+  )
+{
+  UINT32  Bits;
+  UINT32  Count;
+  UINT32  Index;
+  UINT64  Incoming;
+
+  if (Reader->Error) {
+    return FALSE;
+  }
+
+  Bits  = (UINT32) (63 - Reader->AccumBits) & ~7U;
+  Count = Bits / 8;
+
+  if ((UINTN) (Reader->Current - Reader->Start) < Count) {
+    return FALSE;
+  }
+
+  Reader->Current -= Count;
+  Incoming = 0;
+  for (Index = 0; Index < Count; ++Index) {
+    Incoming |= LShiftU64 (Reader->Current[Index], Index * 8);
+  }
+
+  Reader->Accum      = LShiftU64 (Reader->Accum, Bits) | Incoming;
+  Reader->AccumBits += (INT32) Bits;
+
+  return TRUE;
+}
+
+STATIC
+UINT32
+InternalLzfsePull (
+  IN OUT LZFSE_BIT_READER  *Reader,
+  IN     UINT32            Bits
+  )
+{
+  UINT64  Result;
+
+  //
+  // Malformed tables may ask for more bits than were flushed,
+  // the failure is reported by the next flush or at block end.
+  //
+  if ((INT32) Bits > Reader->AccumBits) {
+    Reader->Error = TRUE;
+    return 0;
+  }
+
+  Reader->AccumBits -= (INT32) Bits;
+  Result        = RShiftU64 (Reader->Accum, (UINTN) Reader->AccumBits);
+  Reader->Accum &= LShiftU64 (1, (UINTN) Reader->AccumBits) - 1;
+
+  return (UINT32) Result;
+}
+
+STATIC
+UINT8
+InternalLzfseDecode (
+  IN OUT UINT16                     *State,
+  IN     CONST LZFSE_DECODER_ENTRY  *Table,
+  IN OUT LZFSE_BIT_READER           *Reader
+  )
+{
+  CONST LZFSE_DECODER_ENTRY  *Entry;
+
+  Entry  = &Table[*State];
+  *State = (UINT16) (Entry->Delta + (INT32) InternalLzfsePull (Reader, (UINT32) Entry->Bits));
+  return Entry->Symbol;
+}
+
+STATIC
+INT32
+InternalLzfseDecodeValue (
+  IN OUT UINT16                           *State,
+  IN     CONST LZFSE_VALUE_DECODER_ENTRY  *Table,
+  IN OUT LZFSE_BIT_READER                 *Reader
+  )
+{
+  CONST LZFSE_VALUE_DECODER_ENTRY  *Entry;
+  UINT32                           Bits;
+
+  Entry  = &Table[*State];
+  Bits   = InternalLzfsePull (Reader, Entry->TotalBits);
+  *State = (UINT16) (Entry->Delta + (INT32) (Bits >> Entry->ValueBits));
+  return Entry->ValueBase + (INT32) (Bits & ((1U << Entry->ValueBits) - 1U));
+}
+
+/**
+  Parse V1 (uncompressed) compressed block header.
+**/
+STATIC
+BOOLEAN
+InternalLzfseParseHeaderV1 (
+  IN  CONST UINT8         *Src,
+  IN  UINTN               SrcLen,
+  OUT LZFSE_BLOCK_HEADER  *Header,
+  OUT UINT32              *HeaderSize
+  )
+{
+  UINT32  Index;
+
+  if (SrcLen < LZFSE_V1_HEADER_SIZE) {
+    return FALSE;
+  }
+
+  Header->RawBytes            = ReadUnaligned32 ((CONST UINT32 *) (Src + 4));
+  Header->Literals            = ReadUnaligned32 ((CONST UINT32 *) (Src + 12));
+  Header->Matches             = ReadUnaligned32 ((CONST UINT32 *) (Src + 16));
+  Header->LiteralPayloadBytes = ReadUnaligned32 ((CONST UINT32 *) (Src + 20));
+  Header->LmdPayloadBytes     = ReadUnaligned32 ((CONST UINT32 *) (Src + 24));
+  Header->LiteralBits         = (INT32) ReadUnaligned32 ((CONST UINT32 *) (Src + 28));
+  for (Index = 0; Index < ARRAY_SIZE (Header->LiteralState); ++Index) {
+    Header->LiteralState[Index] = ReadUnaligned16 ((CONST UINT16 *) (Src + 32) + Index);
+  }
+  Header->LmdBits             = (INT32) ReadUnaligned32 ((CONST UINT32 *) (Src + 40));
+  Header->LState              = ReadUnaligned16 ((CONST UINT16 *) (Src + 44));
+  Header->MState              = ReadUnaligned16 ((CONST UINT16 *) (Src + 46));
+  Header->DState              = ReadUnaligned16 ((CONST UINT16 *) (Src + 48));
+  for (Index = 0; Index < LZFSE_ENCODE_SYMBOLS; ++Index) {
+    Header->Freq[Index] = ReadUnaligned16 ((CONST UINT16 *) (Src + 50) + Index);
+  }
+
+  if (ReadUnaligned32 ((CONST UINT32 *) (Src + 8))
+    != (UINT64) Header->LiteralPayloadBytes + Header->LmdPayloadBytes) {
+    return FALSE;
+  }
+
+  *HeaderSize = LZFSE_V1_HEADER_SIZE;
+  return TRUE;
+}
+
+/**
+  Parse V2 compressed block header with packed fields and
+  variable length frequency tables.
+**/
+STATIC
+BOOLEAN
+InternalLzfseParseHeaderV2 (
+  IN  CONST UINT8         *Src,
+  IN  UINTN               SrcLen,
+  OUT LZFSE_BLOCK_HEADER  *Header,
+  OUT UINT32              *HeaderSize
+  )
+{
+  UINT64       Fields[3];
+  UINT32       Index;
+  UINT32       Accum;
+  UINT32       AccumBits;
+  UINT32       Bits;
+  UINT32       Size;
+  CONST UINT8  *FreqSrc;
+  CONST UINT8  *FreqEnd;
+
+  if (SrcLen < LZFSE_V2_HEADER_SIZE) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (Fields); ++Index) {
+    Fields[Index] = ReadUnaligned64 ((CONST UINT64 *) (Src + 8) + Index);
+  }
+
+  Header->RawBytes            = ReadUnaligned32 ((CONST UINT32 *) (Src + 4));
+  Header->Literals            = (UINT32) Fields[0] & 0xFFFFFU;
+  Header->LiteralPayloadBytes = (UINT32) RShiftU64 (Fields[0], 20) & 0xFFFFFU;
+  Header->Matches             = (UINT32) RShiftU64 (Fields[0], 40) & 0xFFFFFU;
+  Header->LiteralBits         = (INT32) (RShiftU64 (Fields[0], 60) & 0x7U) - 7;
+  for (Index = 0; Index < ARRAY_SIZE (Header->LiteralState); ++Index) {
+    Header->LiteralState[Index] = (UINT16) (RShiftU64 (Fields[1], Index * 10) & 0x3FFU);
+  }
+  Header->LmdPayloadBytes     = (UINT32) RShiftU64 (Fields[1], 40) & 0xFFFFFU;
+  Header->LmdBits             = (INT32) (RShiftU64 (Fields[1], 60) & 0x7U) - 7;
+  Size                        = (UINT32) Fields[2];
+  Header->LState              = (UINT16) (RShiftU64 (Fields[2], 32) & 0x3FFU);
+  Header->MState              = (UINT16) (RShiftU64 (Fields[2], 42) & 0x3FFU);
+  Header->DState              = (UINT16) (RShiftU64 (Fields[2], 52) & 0x3FFU);
+
+  if (Size < LZFSE_V2_HEADER_SIZE || Size > SrcLen) {
+    return FALSE;
+  }
+
+  ZeroMem (Header->Freq, sizeof (Header->Freq));
+
+  //
+  // Frequency tables are omitted when header has no extra bytes.
+  //
+  if (Size > LZFSE_V2_HEADER_SIZE) {
+    FreqSrc   = Src + LZFSE_V2_HEADER_SIZE;
+    FreqEnd   = Src + Size;
+    Accum     = 0;
+    AccumBits = 0;
+
+    for (Index = 0; Index < LZFSE_ENCODE_SYMBOLS; ++Index) {
+      while (FreqSrc < FreqEnd && AccumBits + 8 <= 32) {
+        Accum     |= (UINT32) *FreqSrc++ << AccumBits;
+        AccumBits += 8;
+      }
+
+      Bits = mLzfseFreqBits[Accum & 0x1FU];
+      if (Bits > AccumBits) {
+        return FALSE;
+      }
+
+      if (Bits == 8) {
+        Header->Freq[Index] = (UINT16) (8 + ((Accum >> 4U) & 0xFU));
+      } else if (Bits == 14) {
+        Header->Freq[Index] = (UINT16) (24 + ((Accum >> 4U) & 0x3FFU));
+      } else {
+        Header->Freq[Index] = mLzfseFreqValue[Accum & 0x1FU];
+      }
+
+      Accum     >>= Bits;
+      AccumBits  -= Bits;
+    }
+
+    if (AccumBits >= 8 || FreqSrc != FreqEnd) {
+      return FALSE;
+    }
+  }
+
+  *HeaderSize = Size;
+  return TRUE;
+}
+
+/**
+  Decode compressed block payload into Dst.
+
+  @return  TRUE on success.
+**/
+STATIC
+BOOLEAN
+InternalLzfseDecodeBlock (
+  IN OUT LZFSE_DECODER  *Decoder,
+  IN     CONST UINT8    *Payload,
+  IN     UINT8          *DstBegin,
+  IN     UINT8          *Dst
+  )
+{
+  LZFSE_BLOCK_HEADER  *Header;
+  LZFSE_BIT_READER    Reader;
+  UINT16              States[4];
+  UINT16              LState;
+  UINT16              MState;
+  UINT16              DState;
+  UINT32              Index;
+  UINT32              Remaining;
+  UINT8               *Literal;
+  UINT8               *LiteralEnd;
+  INT32               L;
+  INT32               M;
+  INT32               D;
+  INT32               NewD;
+
+  Header = &Decoder->Header;
+
+  //
+  // Corrupted streams may reach unused states, keep them within the table.
+  //
+  ZeroMem (Decoder->LiteralDecoder, sizeof (Decoder->LiteralDecoder));
+
+  if (!InternalLzfseBuildTable (
+    LZFSE_ENCODE_LITERAL_STATES,
+    LZFSE_ENCODE_LITERAL_SYMBOLS,
+    &Header->Freq[LZFSE_ENCODE_L_SYMBOLS + LZFSE_ENCODE_M_SYMBOLS + LZFSE_ENCODE_D_SYMBOLS],
+    Decoder->LiteralDecoder
+    )
+    || !InternalLzfseBuildValueTable (
+    LZFSE_ENCODE_L_STATES,
+    LZFSE_ENCODE_L_SYMBOLS,
+    &Header->Freq[0],
+    mLzfseLExtraBits,
+    mLzfseLBaseValue,
+    Decoder->LDecoder
+    )
+    || !InternalLzfseBuildValueTable (
+    LZFSE_ENCODE_M_STATES,
+    LZFSE_ENCODE_M_SYMBOLS,
+    &Header->Freq[LZFSE_ENCODE_L_SYMBOLS],
+    mLzfseMExtraBits,
+    mLzfseMBaseValue,
+    Decoder->MDecoder
+    )
+    || !InternalLzfseBuildValueTable (
+    LZFSE_ENCODE_D_STATES,
+    LZFSE_ENCODE_D_SYMBOLS,
+    &Header->Freq[LZFSE_ENCODE_L_SYMBOLS + LZFSE_ENCODE_M_SYMBOLS],
+    mLzfseDExtraBits,
+    mLzfseDBaseValue,
+    Decoder->DDecoder
+    )) {
+    return FALSE;
+  }
+
+  //
+  // Literals are decoded by four interleaved streams.
+  //
+  Reader.Start   = Payload;
+  Reader.Current = Payload + Header->LiteralPayloadBytes;
+  if (!InternalLzfseInitReader (&Reader, Header->LiteralBits)) {
+    return FALSE;
+  }
+
+  CopyMem (States, Header->LiteralState, sizeof (States));
+  for (Index = 0; Index < Header->Literals; Index += 4) {
+    if (!InternalLzfseFlushReader (&Reader)) {
+      return FALSE;
+    }
+
+    Decoder->Literals[Index + 0] = InternalLzfseDecode (&States[0], Decoder->LiteralDecoder, &Reader);
+    Decoder->Literals[Index + 1] = InternalLzfseDecode (&States[1], Decoder->LiteralDecoder, &Reader);
+    Decoder->Literals[Index + 2] = InternalLzfseDecode (&States[2], Decoder->LiteralDecoder, &Reader);
+    Decoder->Literals[Index + 3] = InternalLzfseDecode (&States[3], Decoder->LiteralDecoder, &Reader);
+  }
+
+  if (Reader.Error) {
+    return FALSE;
+  }
+
+  //
+  // Now expand (L, M, D) triples.
+  //
+  Reader.Start   = Payload + Header->LiteralPayloadBytes;
+  Reader.Current = Reader.Start + Header->LmdPayloadBytes;
+  if (!InternalLzfseInitReader (&Reader, Header->LmdBits)) {
+    return FALSE;
+  }
+
+  Literal    = Decoder->Literals;
+  LiteralEnd = Decoder->Literals + Header->Literals;
+  Remaining  = Header->RawBytes;
+  LState     = Header->LState;
+  MState     = Header->MState;
+  DState     = Header->DState;
+  D          = -1;
+
+  for (Index = 0; Index < Header->Matches; ++Index) {
+    if (!InternalLzfseFlushReader (&Reader)) {
+      return FALSE;
+    }
+
+    L    = InternalLzfseDecodeValue (&LState, Decoder->LDecoder, &Reader);
+    M    = InternalLzfseDecodeValue (&MState, Decoder->MDecoder, &Reader);
+    NewD = InternalLzfseDecodeValue (&DState, Decoder->DDecoder, &Reader);
+    if (NewD != 0) {
+      D = NewD;
+    }
+
+    if ((UINT32) L > (UINTN) (LiteralEnd - Literal)
+      || (UINT32) L + (UINT32) M > Remaining
+      || (UINT32) D > (UINTN) (Dst + L - DstBegin)) {
+      return FALSE;
+    }
+
+    CopyMem (Dst, Literal, (UINTN) L);
+    Dst       += L;
+    Literal   += L;
+    Remaining -= (UINT32) (L + M);
+
+    //
+    // Matches may overlap the data they produce, so copy byte by byte.
+    //
+    for (; M > 0; --M, ++Dst) {
+      *Dst = *(Dst - D);
+    }
+  }
+
+  return !Reader.Error && Remaining == 0;
+}
+
+UINTN
+DecompressLZFSE (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  *Src,
+  IN  UINTN        SrcLen
+  )
+{
+  LZFSE_DECODER       *Decoder;
+  LZFSE_BLOCK_HEADER  *Header;
+  UINTN               DstIndex;
+  UINT32              Magic;
+  UINT32              RawBytes;
+  UINT32              PayloadBytes;
+  UINT32              HeaderSize;
+  BOOLEAN             Success;
+
+  if (DstLen > OC_COMPRESSION_MAX_LENGTH || SrcLen > OC_COMPRESSION_MAX_LENGTH) {
+    return 0;
+  }
+
+  Decoder  = NULL;
+  DstIndex = 0;
+  Success  = FALSE;
+
+  while (SrcLen >= sizeof (UINT32)) {
+    Magic = ReadUnaligned32 ((CONST UINT32 *) Src);
+
+    if (Magic == LZFSE_ENDOFSTREAM_BLOCK_MAGIC) {
+      Success = TRUE;
+      break;
+    }
+
+    if (Magic == LZFSE_UNCOMPRESSED_BLOCK_MAGIC) {
+      if (SrcLen < LZFSE_UNCOMPRESSED_HEADER_SIZE) {
+        break;
+      }
+
+      RawBytes = ReadUnaligned32 ((CONST UINT32 *) (Src + 4));
+      if (RawBytes > SrcLen - LZFSE_UNCOMPRESSED_HEADER_SIZE || RawBytes > DstLen - DstIndex) {
+        break;
+      }
+
+      CopyMem (&Dst[DstIndex], Src + LZFSE_UNCOMPRESSED_HEADER_SIZE, RawBytes);
+      DstIndex += RawBytes;
+      Src      += LZFSE_UNCOMPRESSED_HEADER_SIZE + RawBytes;
+      SrcLen   -= LZFSE_UNCOMPRESSED_HEADER_SIZE + RawBytes;
+      continue;
+    }
+
+    if (Magic == LZFSE_COMPRESSEDLZVN_BLOCK_MAGIC) {
+      if (SrcLen < LZFSE_LZVN_HEADER_SIZE) {
+        break;
+      }
+
+      RawBytes     = ReadUnaligned32 ((CONST UINT32 *) (Src + 4));
+      PayloadBytes = ReadUnaligned32 ((CONST UINT32 *) (Src + 8));
+      if (PayloadBytes > SrcLen - LZFSE_LZVN_HEADER_SIZE || RawBytes > DstLen - DstIndex) {
+        break;
+      }
+
+      if (RawBytes > 0
+        && lzvn_decode_continued (
+          Dst,
+          &Dst[DstIndex],
+          RawBytes,
+          Src + LZFSE_LZVN_HEADER_SIZE,
+          PayloadBytes
+          ) != RawBytes) {
+        break;
+      }
+
+      DstIndex += RawBytes;
+      Src      += LZFSE_LZVN_HEADER_SIZE + PayloadBytes;
+      SrcLen   -= LZFSE_LZVN_HEADER_SIZE + PayloadBytes;
+      continue;
+    }
+
+    if (Magic != LZFSE_COMPRESSEDV1_BLOCK_MAGIC && Magic != LZFSE_COMPRESSEDV2_BLOCK_MAGIC) {
+      break;
+    }
+
+    if (Decoder == NULL) {
+      Decoder = AllocatePool (sizeof (*Decoder));
+      if (Decoder == NULL) {
+        break;
+      }
+    }
+
+    Header = &Decoder->Header;
+
+    if (Magic == LZFSE_COMPRESSEDV1_BLOCK_MAGIC) {
+      Success = InternalLzfseParseHeaderV1 (Src, SrcLen, Header, &HeaderSize);
+    } else {
+      Success = InternalLzfseParseHeaderV2 (Src, SrcLen, Header, &HeaderSize);
+    }
+
+    if (!Success
+      || Header->Literals > LZFSE_LITERALS_PER_BLOCK
+      || Header->Matches > LZFSE_MATCHES_PER_BLOCK
+      || Header->LiteralBits > 0 || Header->LiteralBits < -7
+      || Header->LmdBits > 0 || Header->LmdBits < -7
+      || Header->LiteralState[0] >= LZFSE_ENCODE_LITERAL_STATES
+      || Header->LiteralState[1] >= LZFSE_ENCODE_LITERAL_STATES
+      || Header->LiteralState[2] >= LZFSE_ENCODE_LITERAL_STATES
+      || Header->LiteralState[3] >= LZFSE_ENCODE_LITERAL_STATES
+      || Header->LState >= LZFSE_ENCODE_L_STATES
+      || Header->MState >= LZFSE_ENCODE_M_STATES
+      || Header->DState >= LZFSE_ENCODE_D_STATES
+      || Header->RawBytes > DstLen - DstIndex
+      || Header->LiteralPayloadBytes > SrcLen - HeaderSize
+      || Header->LmdPayloadBytes > SrcLen - HeaderSize - Header->LiteralPayloadBytes) {
+      Success = FALSE;
+      break;
+    }
+
+    Success = InternalLzfseDecodeBlock (Decoder, Src + HeaderSize, Dst, &Dst[DstIndex]);
+    if (!Success) {
+      break;
+    }
+
+    PayloadBytes = HeaderSize + Header->LiteralPayloadBytes + Header->LmdPayloadBytes;
+    DstIndex    += Header->RawBytes;
+    Src         += PayloadBytes;
+    SrcLen      -= PayloadBytes;
+    Success      = FALSE;
+  }
+
+  if (Decoder != NULL) {
+    FreePool (Decoder);
+  }
+
+  return Success ? DstIndex : 0;
+}
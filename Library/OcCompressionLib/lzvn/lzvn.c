@@ -843,3 +843,37 @@ size_t lzvn_decode_buffer(unsigned char *dst, size_t dst_size,
   // This is how much we decompressed
   return dstate.dst - dst;
 }
+
+size_t lzvn_decode_continued(unsigned char *dst_begin, unsigned char *dst,
+                             size_t dst_size, const unsigned char *src,
+                             size_t src_size) {
+  // Init LZVN decoder state with matches allowed to reach back to dst_begin
+  lzvn_decoder_state dstate;
+
+  if (dst_size > OC_COMPRESSION_MAX_LENGTH || src_size > OC_COMPRESSION_MAX_LENGTH
+    || dst < dst_begin) {
+    return 0;
+  }
+
+  memset(&dstate, 0x00, sizeof(dstate));
+  dstate.src = src;
+  dstate.src_end = src + src_size;
+
+  dstate.dst_begin = dst_begin;
+  dstate.dst = dst;
+  dstate.dst_end = dst + dst_size;
+
+  dstate.d_prev = 0;
+  dstate.end_of_stream = 0;
+
+  // Run LZVN decoder
+  lzvn_decode(&dstate);
+
+  // Stream must be terminated with an end-of-stream opcode
+  if (!dstate.end_of_stream) {
+    return 0;
+  }
+
+  // This is how much we decompressed
+  return dstate.dst - dst;
+}
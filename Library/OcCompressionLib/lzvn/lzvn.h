@@ -42,4 +42,26 @@ typedef UINTN uintmax_t;
 #define memset(Dst, Value, Size) SetMem ((Dst), (Size), (UINT8)(Value))
 #define memcpy(Dst, Src, Size) CopyMem ((Dst), (Src), (Size))
 
+/**
+  Decompress LZVN stream into dst, allowing matches to reference
+  already decompressed data starting from dst_begin.
+  Used for LZVN blocks embedded into LZFSE streams.
+
+  @param[in]   dst_begin   Start of previously decompressed data.
+  @param[out]  dst         Destination buffer, not below dst_begin.
+  @param[in]   dst_size    Destination buffer size.
+  @param[in]   src         Source buffer.
+  @param[in]   src_size    Source buffer size.
+
+  @return  DecompressedLen on success otherwise 0.
+**/
+size_t
+lzvn_decode_continued (
+  unsigned char        *dst_begin,
+  unsigned char        *dst,
+  size_t               dst_size,
+  const unsigned char  *src,
+  size_t               src_size
+  );
+
 #endif /* LZVN_H */
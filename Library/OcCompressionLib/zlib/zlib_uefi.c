@@ -13,9 +13,26 @@
 **/
 
 #include "zutil.h"
+#include "inftrees.h"
+#include "inflate.h"
 
 #include <Library/MemoryAllocationLib.h>
 #include <Library/OcCompressionLib.h>
+#include <Library/OcGuardLib.h>
+
+//
+// Inflate allocates its state and then its window.
+//
+OC_GLOBAL_STATIC_ASSERT (
+  ALIGN_VALUE (sizeof (struct inflate_state), sizeof (UINT64)) + (1U << MAX_WBITS)
+    <= OC_INFLATE_SCRATCH_SIZE,
+  "OC_INFLATE_SCRATCH_SIZE is too small for inflate state and window"
+  );
+
+typedef struct {
+  UINT8  *Buffer;
+  UINTN  Used;
+} ZLIB_SCRATCH;
 
 voidpf ZLIB_INTERNAL zcalloc (opaque, items, size)
     voidpf opaque;
@@ -36,6 +53,43 @@ void ZLIB_INTERNAL zcfree (opaque, ptr)
 
 #ifndef OC_USE_SSH_ZLIB
 
+STATIC
+voidpf
+ZlibScratchAlloc (
+  voidpf    opaque,
+  unsigned  items,
+  unsigned  size
+  )
+{
+  ZLIB_SCRATCH  *Scratch;
+  UINTN         Length;
+  voidpf        Memory;
+
+  Scratch = opaque;
+  Length  = ALIGN_VALUE ((UINTN) items * size, sizeof (UINT64));
+  if (Length > OC_INFLATE_SCRATCH_SIZE - Scratch->Used) {
+    return Z_NULL;
+  }
+
+  Memory         = Scratch->Buffer + Scratch->Used;
+  Scratch->Used += Length;
+  return Memory;
+}
+
+STATIC
+void
+ZlibScratchFree (
+  voidpf  opaque,
+  voidpf  ptr
+  )
+{
+  //
+  // Scratch memory is owned by the caller.
+  //
+  (void) opaque;
+  (void) ptr;
+}
+
 UINT8 *
 CompressZLIB (
   OUT UINT8        *Dst,
@@ -78,4 +132,97 @@ DecompressZLIB (
   return 0;
 }
 
+UINTN
+DecompressZLIBRange (
+  OUT UINT8        *Dst,
+  IN  UINTN        DstOffset,
+  IN  UINTN        DstLen,
+  IN  CONST UINT8  **Src,
+  IN  CONST UINTN  *SrcLen,
+  IN  UINTN        SrcCount,
+  IN  VOID         *Scratch  OPTIONAL
+  )
+{
+  z_stream      Stream;
+  ZLIB_SCRATCH  ScratchContext;
+  int           Result;
+  UINTN         Index;
+  UINTN         Skip;
+  UINTN         Produced;
+  UINTN         Written;
+
+  if (DstLen == 0 || DstLen > OC_COMPRESSION_MAX_LENGTH || DstOffset > OC_COMPRESSION_MAX_LENGTH) {
+    return 0;
+  }
+
+  Stream.next_in  = Z_NULL;
+  Stream.avail_in = 0;
+  Stream.zalloc   = Z_NULL;
+  Stream.zfree    = Z_NULL;
+  Stream.opaque   = Z_NULL;
+
+  if (Scratch != NULL) {
+    ScratchContext.Buffer = Scratch;
+    ScratchContext.Used   = 0;
+    Stream.zalloc         = ZlibScratchAlloc;
+    Stream.zfree          = ZlibScratchFree;
+    Stream.opaque         = &ScratchContext;
+  }
+
+  if (inflateInit (&Stream) != Z_OK) {
+    return 0;
+  }
+
+  Index    = 0;
+  Skip     = DstOffset;
+  Produced = 0;
+
+  while (Produced < DstLen) {
+    if (Stream.avail_in == 0) {
+      if (Index == SrcCount || SrcLen[Index] > OC_COMPRESSION_MAX_LENGTH) {
+        break;
+      }
+
+      Stream.next_in  = (Bytef *) Src[Index];
+      Stream.avail_in = (uInt) SrcLen[Index];
+      ++Index;
+      continue;
+    }
+
+    //
+    // Leading data is inflated over the destination buffer, as inflate
+    // keeps its own window for back references.
+    //
+    if (Skip > 0) {
+      Stream.next_out  = Dst;
+      Stream.avail_out = (uInt) (Skip < DstLen ? Skip : DstLen);
+    } else {
+      Stream.next_out  = Dst + Produced;
+      Stream.avail_out = (uInt) (DstLen - Produced);
+    }
+
+    Written = Stream.avail_out;
+    Result  = inflate (&Stream, Z_NO_FLUSH);
+    Written -= Stream.avail_out;
+
+    if (Skip > 0) {
+      Skip -= Written;
+    } else {
+      Produced += Written;
+    }
+
+    if (Result != Z_OK) {
+      break;
+    }
+  }
+
+  inflateEnd (&Stream);
+
+  if (Produced != DstLen) {
+    return 0;
+  }
+
+  return DstLen;
+}
+
 #endif // OC_USE_SSH_ZLIB
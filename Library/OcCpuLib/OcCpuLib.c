@@ -788,6 +788,7 @@ OcCpuScanProcessor (
   CPUID_VERSION_INFO_EBX  CpuidVerEbx;
   CPUID_VERSION_INFO_ECX  CpuidVerEcx;
   CPUID_VERSION_INFO_EDX  CpuidVerEdx;
+  UINT32                  MaxId;
 
   ASSERT (Cpu != NULL);
 
@@ -796,7 +797,7 @@ OcCpuScanProcessor (
   //
   // Get vendor CPUID 0x00000000
   //
-  AsmCpuid (CPUID_SIGNATURE, &CpuidEax, &Cpu->Vendor[0], &Cpu->Vendor[2], &Cpu->Vendor[1]);
+  AsmCpuid (CPUID_SIGNATURE, &MaxId, &Cpu->Vendor[0], &Cpu->Vendor[2], &Cpu->Vendor[1]);
 
   //
   // Get extended CPUID 0x80000000
@@ -863,6 +864,21 @@ OcCpuScanProcessor (
     }
   }
 
+  //
+  // Get structured extended feature flags CPUID 0x00000007
+  //
+  if (MaxId >= CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS) {
+    AsmCpuidEx (
+      CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS,
+      CPUID_STRUCTURED_EXTENDED_FEATURE_FLAGS_SUB_LEAF_INFO,
+      NULL,
+      &CpuidEbx,
+      &CpuidEcx,
+      NULL
+      );
+    Cpu->ExtFeatures = (((UINT64) CpuidEcx) << 32ULL) | CpuidEbx;
+  }
+
   DEBUG ((DEBUG_INFO, "%a %a\n", "Found", Cpu->BrandString));
 
   DEBUG ((
@@ -0,0 +1,77 @@
+/** @file
+
+OcCryptoLib
+
+Copyright (c) 2019, vit9696
+
+All rights reserved.
+
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Library/DebugLib.h>
+#include <Library/OcCpuLib.h>
+#include <Library/OcCryptoLib.h>
+
+#include "CryptoInternal.h"
+
+#if defined (MDE_CPU_X64)
+STATIC
+VOID
+EFIAPI
+AesCbcDecryptBlocksNi (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockCount
+  )
+{
+  AesNiCbcDecrypt (Context->InvRoundKey, Context->Rounds, Context->Iv, Data, BlockCount);
+}
+
+STATIC
+VOID
+EFIAPI
+AesCtrXcryptBlocksNi (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockCount
+  )
+{
+  AesNiCtrXcrypt (Context->RoundKey, Context->Rounds, Context->Iv, Data, BlockCount);
+}
+#endif
+
+VOID
+OcCryptoInitAcceleration (
+  IN UINT64  Features,
+  IN UINT64  ExtFeatures
+  )
+{
+#if defined (MDE_CPU_X64)
+  //
+  // SHA extensions rely on SSSE3 byte shuffles and SSE4.1 blends.
+  //
+  if ((ExtFeatures & OC_CPU_EXT_FEATURE_SHA) != 0
+    && (Features & (OC_CPU_FEATURE_SSSE3 | OC_CPU_FEATURE_SSE4_1))
+      == (OC_CPU_FEATURE_SSSE3 | OC_CPU_FEATURE_SSE4_1)) {
+    DEBUG ((DEBUG_INFO, "OCCR: Using SHA extensions for SHA-256\n"));
+    gSha256TransformBlocks = Sha256TransformBlocksNi;
+  }
+
+  //
+  // AES-NI round keys share the byte layout of the portable schedule.
+  //
+  if ((Features & OC_CPU_FEATURE_AES) != 0) {
+    DEBUG ((DEBUG_INFO, "OCCR: Using AES-NI for AES CBC and CTR\n"));
+    gAesCbcDecryptBlocks = AesCbcDecryptBlocksNi;
+    gAesCtrXcryptBlocks  = AesCtrXcryptBlocksNi;
+  }
+#endif
+}
@@ -0,0 +1,130 @@
+/** @file
+
+OcCryptoLib
+
+Copyright (c) 2019, vit9696
+
+All rights reserved.
+
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef OC_CRYPTO_INTERNAL_H
+#define OC_CRYPTO_INTERNAL_H
+
+/**
+  Transform consecutive 64-byte SHA-256 message blocks.
+
+  @param[in,out] State       SHA-256 state words.
+  @param[in]     Data        Message blocks.
+  @param[in]     BlockCount  Number of message blocks.
+**/
+typedef
+VOID
+(EFIAPI *SHA256_TRANSFORM_BLOCKS) (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockCount
+  );
+
+//
+// Active SHA-256 block transform, portable unless acceleration is enabled.
+//
+extern SHA256_TRANSFORM_BLOCKS  gSha256TransformBlocks;
+
+VOID
+EFIAPI
+Sha256TransformBlocksGeneric (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockCount
+  );
+
+VOID
+EFIAPI
+Sha256TransformBlocksNi (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  Decrypt consecutive AES blocks in CBC mode, updating context IV.
+
+  @param[in,out] Context     AES context.
+  @param[in,out] Data        Blocks to decrypt in place.
+  @param[in]     BlockCount  Number of blocks.
+**/
+typedef
+VOID
+(EFIAPI *AES_CBC_DECRYPT_BLOCKS) (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  Encrypt or decrypt consecutive AES blocks in CTR mode, updating context IV.
+
+  @param[in,out] Context     AES context.
+  @param[in,out] Data        Blocks to process in place.
+  @param[in]     BlockCount  Number of blocks.
+**/
+typedef
+VOID
+(EFIAPI *AES_CTR_XCRYPT_BLOCKS) (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockCount
+  );
+
+//
+// Active AES block routines, portable unless acceleration is enabled.
+//
+extern AES_CBC_DECRYPT_BLOCKS  gAesCbcDecryptBlocks;
+extern AES_CTR_XCRYPT_BLOCKS   gAesCtrXcryptBlocks;
+
+VOID
+EFIAPI
+AesCbcDecryptBlocksGeneric (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockCount
+  );
+
+VOID
+EFIAPI
+AesCtrXcryptBlocksGeneric (
+  IN OUT AES_CONTEXT  *Context,
+  IN OUT UINT8        *Data,
+  IN     UINTN        BlockCount
+  );
+
+VOID
+EFIAPI
+AesNiCbcDecrypt (
+  IN     CONST UINT32  *InvRoundKey,
+  IN     UINT32        Rounds,
+  IN OUT UINT8         *Iv,
+  IN OUT UINT8         *Data,
+  IN     UINTN         BlockCount
+  );
+
+VOID
+EFIAPI
+AesNiCtrXcrypt (
+  IN     CONST UINT32  *RoundKey,
+  IN     UINT32        Rounds,
+  IN OUT UINT8         *Iv,
+  IN OUT UINT8         *Data,
+  IN     UINTN         BlockCount
+  );
+
+#endif // OC_CRYPTO_INTERNAL_H
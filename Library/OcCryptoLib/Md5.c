@@ -59,8 +59,8 @@ Md5Transform (
   // on output (in md5_final()).
   //
   for (Index1 = 0, Index2 = 0; Index1 < 16; ++Index1, Index2 += 4) {
-    M[Index1] = (Data[Index2]) + (Data[Index2 + 1] << 8)
-                + (Data[Index2 + 2] << 16) + (Data[Index2 + 3] << 24);
+    M[Index1] = ((UINT32) Data[Index2]) | ((UINT32) Data[Index2 + 1] << 8)
+                | ((UINT32) Data[Index2 + 2] << 16) | ((UINT32) Data[Index2 + 3] << 24);
   }
   A = Ctx->State[0];
   B = Ctx->State[1];
@@ -161,16 +161,43 @@ Md5Update (
   UINTN        Len
   )
 {
-  UINTN Index;
-
-  for (Index = 0; Index < Len; ++Index) {
-    Ctx->Data[Ctx->DataLen] = Data[Index];
-    Ctx->DataLen++;
-    if (Ctx->DataLen == 64) {
-      Md5Transform (Ctx, Ctx->Data);
-      Ctx->BitLen += 512;
-      Ctx->DataLen = 0;
+  UINTN  Fill;
+
+  //
+  // Complete buffered block first.
+  //
+  if (Ctx->DataLen > 0) {
+    Fill = 64 - Ctx->DataLen;
+    if (Len < Fill) {
+      CopyMem (Ctx->Data + Ctx->DataLen, Data, Len);
+      Ctx->DataLen += (UINT32) Len;
+      return;
     }
+
+    CopyMem (Ctx->Data + Ctx->DataLen, Data, Fill);
+    Md5Transform (Ctx, Ctx->Data);
+    Ctx->BitLen += 512;
+    Ctx->DataLen = 0;
+    Data += Fill;
+    Len  -= Fill;
+  }
+
+  //
+  // Transform full blocks directly from caller buffer.
+  //
+  while (Len >= 64) {
+    Md5Transform (Ctx, Data);
+    Ctx->BitLen += 512;
+    Data += 64;
+    Len  -= 64;
+  }
+
+  //
+  // Buffer the remainder.
+  //
+  if (Len > 0) {
+    CopyMem (Ctx->Data, Data, Len);
+    Ctx->DataLen = (UINT32) Len;
   }
 }
 
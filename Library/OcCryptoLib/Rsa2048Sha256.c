@@ -45,43 +45,46 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
   PS: octet string consisting of {Length(RSA Key) - Length(T) - 3} 0xFF
  **/
-#define PKCS_PAD_SIZE (CONFIG_RSA_KEY_SIZE - SHA256_DIGEST_SIZE)
-
 STATIC  UINT8 mSha256Tail[] = {
   0x00, 0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60,
   0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01,
   0x05, 0x00, 0x04, 0x20
 };
 
-UINT64
-Mula32 (
-  UINT32  A,
-  UINT32  B,
-  UINT32  C
-  )
-{
-  UINT64 Ret = A;
+//
+// Use 64-bit limbs when the compiler provides a double width product.
+// Supported key sizes are multiples of 64 bits, so on little endian targets
+// pre-processed 32-bit key words are laid out the same way as either limb.
+//
+#if defined (MDE_CPU_X64) && (defined (__GNUC__) || defined (__clang__))
+typedef UINT64             RSA_WORD;
+typedef unsigned __int128  RSA_DWORD;
+#else
+typedef UINT32             RSA_WORD;
+typedef UINT64             RSA_DWORD;
+#endif
 
-  Ret *= B;
-  Ret += C;
-  return Ret;
-}
+#define RSA_WORD_BITS  (sizeof (RSA_WORD) * 8)
+#define RSA_MAX_WORDS  (RSA_MAX_KEY_SIZE / sizeof (RSA_WORD))
 
-UINT64
-Mulaa32 (
-  UINT32  A,
-  UINT32  B,
-  UINT32  C,
-  UINT32  D
-  )
-{
-  UINT64 Ret = A;
+//
+// Montgomery parameters derived from a pre-processed public key.
+//
+typedef struct RSA_MONT_CONTEXT_ {
+  UINT32    NumWords;
+  RSA_WORD  N0Inv;
+  RSA_WORD  N[RSA_MAX_WORDS];
+  RSA_WORD  Rr[RSA_MAX_WORDS];
+} RSA_MONT_CONTEXT;
 
-  Ret *= B;
-  Ret += C;
-  Ret += D;
-  return Ret;
-}
+//
+// Recently used keys. Verifying vault, images, and chunklists during one boot
+// normally involves just a few of them.
+//
+#define RSA_MONT_CACHE_SIZE 4
+
+STATIC RSA_MONT_CONTEXT  mRsaMontCache[RSA_MONT_CACHE_SIZE];
+STATIC UINT32            mRsaMontCacheNext;
 
 //
 //  A[] -= Mod
@@ -89,16 +92,19 @@ Mulaa32 (
 STATIC
 VOID
 SubMod (
-  RSA_PUBLIC_KEY  *Key,
-  UINT32          *A
+  CONST RSA_MONT_CONTEXT  *Context,
+  RSA_WORD                *A
   )
 {
-  INT64  B     = 0;
-  UINT32 Index = 0;
-  for (Index = 0; Index < RSANUMWORDS; ++Index) {
-    B += (UINT64) A[Index] - Key->N[Index];
-    A[Index] = (UINT32) B;
-    B >>= 32;
+  RSA_DWORD  Diff;
+  RSA_WORD   Borrow;
+  UINT32     Index;
+
+  Borrow = 0;
+  for (Index = 0; Index < Context->NumWords; ++Index) {
+    Diff     = (RSA_DWORD) A[Index] - Context->N[Index] - Borrow;
+    A[Index] = (RSA_WORD) Diff;
+    Borrow   = (RSA_WORD) (Diff >> RSA_WORD_BITS) & 1U;
   }
 }
 
@@ -106,158 +112,225 @@ SubMod (
 // Return A[] >= Mod
 //
 STATIC
-INT32
+BOOLEAN
 GeMod (
-  RSA_PUBLIC_KEY  *Key,
-  CONST UINT32    *A
+  CONST RSA_MONT_CONTEXT  *Context,
+  CONST RSA_WORD          *A
   )
 {
-  UINT32 Index = 0;
+  UINT32  Index;
 
-  for (Index = RSANUMWORDS; Index;) {
+  for (Index = Context->NumWords; Index > 0;) {
     --Index;
-    if (A[Index] < Key->N[Index])
-      return 0;
-    if (A[Index] > Key->N[Index])
-      return 1;
+    if (A[Index] < Context->N[Index]) {
+      return FALSE;
+    }
+    if (A[Index] > Context->N[Index]) {
+      return TRUE;
+    }
   }
-  return 1;
+
+  return TRUE;
 }
 
 //
-// Montgomery c[] += a * b[] / R % mod
+// Montgomery C[] = A[] * B[] / R % mod, C may alias A or B.
+// Multiplication and reduction are interleaved word by word,
+// inputs must be below mod.
 //
 STATIC
 VOID
-MontMulAdd (
-  RSA_PUBLIC_KEY  *Key,
-  UINT32          *C,
-  UINT32          Aa,
-  UINT32          *Bb
+MontMul (
+  CONST RSA_MONT_CONTEXT  *Context,
+  RSA_WORD                *C,
+  CONST RSA_WORD          *A,
+  CONST RSA_WORD          *B
   )
 {
-  UINT64 A,B;
-  UINT32 D0, Index;
-
-  A = Mula32 (Aa, Bb[0], C[0]);
-  D0 = (UINT32) A * Key->N0Inv;
-  B = Mula32 (D0, Key->N[0], (UINT32) A);
-
-  for (Index = 1; Index < RSANUMWORDS; ++Index) {
-    A = Mulaa32 (Aa, Bb[Index], C[Index], (UINT32) (A >> 32));
-    B = Mulaa32 (D0, Key->N[Index], (UINT32) A, (UINT32) (B >> 32));
-    C[Index - 1] = (UINT32) B;
+  RSA_WORD   T[RSA_MAX_WORDS + 1];
+  RSA_DWORD  Product;
+  RSA_DWORD  Reduced;
+  RSA_WORD   Ai;
+  RSA_WORD   M;
+  UINT32     NumWords;
+  UINT32     Index;
+  UINT32     Index2;
+
+  NumWords = Context->NumWords;
+  ZeroMem (T, (NumWords + 1) * sizeof (RSA_WORD));
+
+  for (Index = 0; Index < NumWords; ++Index) {
+    //
+    // T[] = (T[] + Ai * B[] + M * N[]) / 2^RSA_WORD_BITS,
+    // with M chosen to make the lowest word zero.
+    //
+    Ai      = A[Index];
+    Product = (RSA_DWORD) Ai * B[0] + T[0];
+    M       = (RSA_WORD) Product * Context->N0Inv;
+    Reduced = (RSA_DWORD) M * Context->N[0] + (RSA_WORD) Product;
+
+    for (Index2 = 1; Index2 < NumWords; ++Index2) {
+      Product       = (RSA_DWORD) Ai * B[Index2] + T[Index2] + (RSA_WORD) (Product >> RSA_WORD_BITS);
+      Reduced       = (RSA_DWORD) M * Context->N[Index2] + (RSA_WORD) Product + (RSA_WORD) (Reduced >> RSA_WORD_BITS);
+      T[Index2 - 1] = (RSA_WORD) Reduced;
+    }
+
+    Product = (RSA_DWORD) T[NumWords]
+      + (RSA_WORD) (Product >> RSA_WORD_BITS)
+      + (RSA_WORD) (Reduced >> RSA_WORD_BITS);
+    T[NumWords - 1] = (RSA_WORD) Product;
+    T[NumWords]     = (RSA_WORD) (Product >> RSA_WORD_BITS);
   }
 
-  A = (A >> 32) + (B >> 32);
-  C[Index - 1] = (UINT32) A;
-
-  if (A >> 32) {
-    SubMod (Key, C);
+  //
+  // Result is below 2 * mod, one subtraction is enough.
+  //
+  if (T[NumWords] != 0 || GeMod (Context, T)) {
+    SubMod (Context, T);
   }
+
+  CopyMem (C, T, NumWords * sizeof (RSA_WORD));
 }
 
-//
-// Montgomery c[] = a[] * b[] / R % mod
-//
+/**
+  Find Montgomery parameters for the key in cache or compute them.
+
+  @param Key        Pre-processed public key.
+
+  @return Montgomery parameters or NULL for unsupported keys.
+ **/
 STATIC
-VOID
-MontMul (
-  RSA_PUBLIC_KEY  *Key,
-  UINT32          *C,
-  UINT32          *A,
-  UINT32          *B
+CONST RSA_MONT_CONTEXT *
+GetMontContext (
+  CONST RSA_PUBLIC_KEY  *Key
   )
 {
-  UINT32 Index;
+  RSA_MONT_CONTEXT  *Context;
+  CONST UINT32      *Rr;
+  UINT32            KeySize;
+  UINT32            NumWords;
+  UINT32            Index;
+  RSA_WORD          Inverse;
+
+  KeySize = RsaGetKeySize (Key);
+  if (KeySize == 0) {
+    return NULL;
+  }
+
+  NumWords = KeySize / sizeof (RSA_WORD);
+  Rr       = Key->N + Key->Size;
 
-  ZeroMem (C, CONFIG_RSA_KEY_SIZE);
+  for (Index = 0; Index < RSA_MONT_CACHE_SIZE; ++Index) {
+    Context = &mRsaMontCache[Index];
+    if (Context->NumWords == NumWords
+      && CompareMem (Context->N, Key->N, KeySize) == 0
+      && CompareMem (Context->Rr, Rr, KeySize) == 0) {
+      return Context;
+    }
+  }
+
+  //
+  // Montgomery reduction requires odd modulus.
+  //
+  if ((Key->N[0] & 1U) == 0) {
+    return NULL;
+  }
+
+  Context = &mRsaMontCache[mRsaMontCacheNext];
+  mRsaMontCacheNext = (mRsaMontCacheNext + 1) % RSA_MONT_CACHE_SIZE;
+
+  Context->NumWords = NumWords;
+  CopyMem (Context->N, Key->N, KeySize);
+  CopyMem (Context->Rr, Rr, KeySize);
+
+  //
+  // N0Inv = -1 / N[0] mod 2^RSA_WORD_BITS. N[0] is its own inverse modulo 8,
+  // and each Newton iteration doubles the amount of correct bits.
+  //
+  Inverse = Context->N[0];
+  for (Index = 3; Index < RSA_WORD_BITS; Index *= 2) {
+    Inverse *= 2 - Context->N[0] * Inverse;
+  }
+  Context->N0Inv = (RSA_WORD) 0 - Inverse;
 
-  for (Index = 0; Index < RSANUMWORDS; ++Index)
-    MontMulAdd (Key, C, A[Index], B);
+  return Context;
 }
 
 /**
-  In-place public exponentiation.
-  Exponent depends on the configuration (65537 (default), or 3).
+  In-place public exponentiation with exponent 65537.
 
-  @param Key        Key to use in signing
-  @param InOut      Input and output big-endian byte array
+  @param Context    Montgomery parameters of the key.
+  @param InOut      Input and output big-endian byte array.
+
+  @return FALSE when input is not below modulus.
  **/
 STATIC
-VOID
+BOOLEAN
 ModPow (
-  RSA_PUBLIC_KEY  *Key,
-  UINT8           *InOut
+  CONST RSA_MONT_CONTEXT  *Context,
+  UINT8                   *InOut
   )
 {
-  UINT32 *A     = NULL;
-  UINT32 *Ar    = NULL;
-  UINT32 *Aar   = NULL;
-  UINT32 *Aaa   = NULL;
-  INT32  Index  = 0;
-  UINT32 Tmp    = 0;
-
-  UINT32 Workbuf32[RSANUMWORDS * 3];
-
-  A = Workbuf32;
-  Ar = A + RSANUMWORDS;
-  Aar = Ar + RSANUMWORDS;
-
-  //
-  // Re-use location
-  //
-  Aaa = Aar;
+  RSA_WORD  A[RSA_MAX_WORDS];
+  RSA_WORD  Ar[RSA_MAX_WORDS];
+  RSA_WORD  Tmp;
+  UINT8     *Ptr;
+  UINT32    Index;
+  UINT32    Index2;
 
   //
   // Convert from big endian byte array to little endian word array
   //
-  for (Index = 0; Index < (INT32) RSANUMWORDS; ++Index) {
-    Tmp =
-      ((UINT32)InOut[((RSANUMWORDS - 1 - Index) * 4) + 0] << 24) |
-      ((UINT32)InOut[((RSANUMWORDS - 1 - Index) * 4) + 1] << 16) |
-      ((UINT32)InOut[((RSANUMWORDS - 1 - Index) * 4) + 2] << 8) |
-      ((UINT32)InOut[((RSANUMWORDS - 1 - Index) * 4) + 3] << 0);
+  Ptr = InOut + Context->NumWords * sizeof (RSA_WORD);
+  for (Index = 0; Index < Context->NumWords; ++Index) {
+    Tmp = 0;
+    Ptr -= sizeof (RSA_WORD);
+    for (Index2 = 0; Index2 < sizeof (RSA_WORD); ++Index2) {
+      Tmp = (Tmp << 8U) | Ptr[Index2];
+    }
     A[Index] = Tmp;
   }
 
-  MontMul (Key, Ar, A, Key->Rr);
+  if (GeMod (Context, A)) {
+    return FALSE;
+  }
+
+  MontMul (Context, Ar, A, Context->Rr);
   //
   // Exponent 65537
   //
-  for (Index = 0; Index < 16; Index += 2) {
-    MontMul (Key, Aar, Ar, Ar);
-    MontMul (Key, Ar, Aar, Aar);
-  }
-  MontMul (Key, Aaa, Ar, A);
-
-  if (GeMod (Key, Aaa)){
-    SubMod (Key, Aaa);
+  for (Index = 0; Index < 16; ++Index) {
+    MontMul (Context, Ar, Ar, Ar);
   }
+  MontMul (Context, A, Ar, A);
 
   //
   // Convert to bigendian byte array
   //
-  for (Index = (INT32) RSANUMWORDS - 1; Index >= 0; --Index) {
-    Tmp = Aaa[Index];
-
-    *InOut++ = (UINT8) (Tmp >> 24);
-    *InOut++ = (UINT8) (Tmp >> 16);
-    *InOut++ = (UINT8) (Tmp >>  8);
-    *InOut++ = (UINT8) (Tmp >>  0);
+  for (Index = Context->NumWords; Index > 0;) {
+    --Index;
+    Tmp = A[Index];
+    for (Index2 = sizeof (RSA_WORD); Index2 > 0;) {
+      --Index2;
+      *InOut++ = (UINT8) (Tmp >> (Index2 * 8U));
+    }
   }
+
+  return TRUE;
 }
 
 /**
  * Check PKCS#1 padding bytes
  *
- * @param sig  Signature to verify
+ * @param Sig      Signature to verify
+ * @param SigSize  Signature size
  * @return 0 if the padding is correct.
  */
 STATIC
 INT32
 CheckPadding (
-  UINT8  *Sig
+  UINT8   *Sig,
+  UINT32  SigSize
   )
 {
   UINT8   *Ptr   = NULL;
@@ -273,7 +346,7 @@ CheckPadding (
   //
   // Then 0xff bytes until the tail
   //
-  for (Index = 0; Index < PKCS_PAD_SIZE - sizeof (mSha256Tail) - 2; Index++)
+  for (Index = 0; Index < SigSize - SHA256_DIGEST_SIZE - sizeof (mSha256Tail) - 2; Index++)
     Result |= *Ptr++ ^ 0xff;
   //
   // Check the tail
@@ -282,12 +355,27 @@ CheckPadding (
   return Result != 0;
 }
 
+UINT32
+RsaGetKeySize (
+  CONST RSA_PUBLIC_KEY  *Key
+  )
+{
+  switch (Key->Size) {
+    case 2048 / 32:
+    case 3072 / 32:
+    case 4096 / 32:
+      return Key->Size * sizeof (UINT32);
+    default:
+      return 0;
+  }
+}
+
 /**
   Verify a SHA256WithRSA PKCS#1 v1.5 signature against an expected
   SHA256 hash.
 
   @param Key         RSA public key
-  @param Signature   RSA signature
+  @param Signature   RSA signature of RsaGetKeySize bytes
   @param Sha256      SHA-256 digest of the content to verify
 
   @return FALSE on failure, TRUE on success.
@@ -299,29 +387,40 @@ RsaVerify (
   UINT8           *Sha256
   )
 {
-  UINT8 Buf[CONFIG_RSA_KEY_SIZE];
+  CONST RSA_MONT_CONTEXT  *Context;
+  UINT8                   Buf[RSA_MAX_KEY_SIZE];
+  UINT32                  KeySize;
+
+  Context = GetMontContext (Key);
+  if (Context == NULL) {
+    return FALSE;
+  }
+
+  KeySize = Context->NumWords * sizeof (RSA_WORD);
 
   //
   // Copy input to local workspace
   //
-  CopyMem (Buf, Signature, CONFIG_RSA_KEY_SIZE);
+  CopyMem (Buf, Signature, KeySize);
 
   //
   // In-place exponentiation
   //
-  ModPow (Key, Buf);
+  if (!ModPow (Context, Buf)) {
+    return FALSE;
+  }
 
   //
   // Check the PKCS#1 padding
   //
-  if (CheckPadding (Buf) != 0) {
+  if (CheckPadding (Buf, KeySize) != 0) {
     return FALSE;
   }
 
   //
   // Check the digest
   //
-  if (CompareMem (Buf + PKCS_PAD_SIZE, Sha256, SHA256_DIGEST_SIZE) != 0) {
+  if (CompareMem (Buf + KeySize - SHA256_DIGEST_SIZE, Sha256, SHA256_DIGEST_SIZE) != 0) {
     return FALSE;
   }
 
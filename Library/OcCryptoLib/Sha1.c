@@ -30,7 +30,29 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/BaseMemoryLib.h>
 #include <Library/OcCryptoLib.h>
 
-#define ROTLEFT(a, b) ((a << b) | (a >> (32 - b)))
+#define ROTLEFT(a, b) (((a) << (b)) | ((a) >> (32 - (b))))
+
+//
+// Load big endian 32-bit word, compilers turn this into a single swapped load.
+//
+#define LOAD32H(p) \
+  (((UINT32)(p)[0] << 24) | ((UINT32)(p)[1] << 16) | ((UINT32)(p)[2] << 8) | ((UINT32)(p)[3]))
+
+//
+// Message schedule is kept in a 16 word circular buffer.
+//
+#define SCHEDULE(i) \
+  (M[(i) & 15] = ROTLEFT (M[((i) - 3) & 15] ^ M[((i) - 8) & 15] ^ M[((i) - 14) & 15] ^ M[(i) & 15], 1))
+
+#define F0(b, c, d) (((b) & (c)) ^ (~(b) & (d)))
+#define F1(b, c, d) ((b) ^ (c) ^ (d))
+#define F2(b, c, d) (((b) & (c)) ^ ((b) & (d)) ^ ((c) & (d)))
+
+#define ROUND(a, b, c, d, e, f, k, w) \
+  do { \
+    (e) += ROTLEFT (a, 5) + f (b, c, d) + (k) + (w); \
+    (b)  = ROTLEFT (b, 30); \
+  } while (0)
 
 VOID
 Sha1Transform (
@@ -38,16 +60,10 @@ Sha1Transform (
   CONST UINT8  *Data
   )
 {
-  UINT32 A, B, C, D, E, Index1, Index2, T, M[80];
+  UINT32 A, B, C, D, E, Index, M[16];
 
-  for (Index1 = 0, Index2 = 0; Index1 < 16; ++Index1, Index2 += 4) {
-    M[Index1] = (Data[Index2] << 24) + (Data[Index2 + 1] << 16)
-                + (Data[Index2 + 2] << 8) + (Data[Index2 + 3]);
-  }
-
-  for ( ; Index1 < 80; ++Index1) {
-    M[Index1] = (M[Index1 - 3] ^ M[Index1 - 8] ^ M[Index1 - 14] ^ M[Index1 - 16]);
-    M[Index1] = (M[Index1] << 1) | (M[Index1] >> 31);
+  for (Index = 0; Index < 16; ++Index) {
+    M[Index] = LOAD32H (Data + Index * 4);
   }
 
   A = Ctx->State[0];
@@ -56,37 +72,41 @@ Sha1Transform (
   D = Ctx->State[3];
   E = Ctx->State[4];
 
-  for (Index1 = 0; Index1 < 20; ++Index1) {
-    T = ROTLEFT (A, 5) + ((B & C) ^ (~B & D)) + E + Ctx->K[0] + M[Index1];
-    E = D;
-    D = C;
-    C = ROTLEFT (B, 30);
-    B = A;
-    A = T;
+  for (Index = 0; Index < 15; Index += 5) {
+    ROUND (A, B, C, D, E, F0, Ctx->K[0], M[Index + 0]);
+    ROUND (E, A, B, C, D, F0, Ctx->K[0], M[Index + 1]);
+    ROUND (D, E, A, B, C, F0, Ctx->K[0], M[Index + 2]);
+    ROUND (C, D, E, A, B, F0, Ctx->K[0], M[Index + 3]);
+    ROUND (B, C, D, E, A, F0, Ctx->K[0], M[Index + 4]);
   }
-  for ( ; Index1 < 40; ++Index1) {
-    T = ROTLEFT (A, 5) + (B ^ C ^ D) + E + Ctx->K[1] + M[Index1];
-    E = D;
-    D = C;
-    C = ROTLEFT (B, 30);
-    B = A;
-    A = T;
+  ROUND (A, B, C, D, E, F0, Ctx->K[0], M[15]);
+  ROUND (E, A, B, C, D, F0, Ctx->K[0], SCHEDULE (16));
+  ROUND (D, E, A, B, C, F0, Ctx->K[0], SCHEDULE (17));
+  ROUND (C, D, E, A, B, F0, Ctx->K[0], SCHEDULE (18));
+  ROUND (B, C, D, E, A, F0, Ctx->K[0], SCHEDULE (19));
+
+  for (Index = 20; Index < 40; Index += 5) {
+    ROUND (A, B, C, D, E, F1, Ctx->K[1], SCHEDULE (Index + 0));
+    ROUND (E, A, B, C, D, F1, Ctx->K[1], SCHEDULE (Index + 1));
+    ROUND (D, E, A, B, C, F1, Ctx->K[1], SCHEDULE (Index + 2));
+    ROUND (C, D, E, A, B, F1, Ctx->K[1], SCHEDULE (Index + 3));
+    ROUND (B, C, D, E, A, F1, Ctx->K[1], SCHEDULE (Index + 4));
   }
-  for ( ; Index1 < 60; ++Index1) {
-    T = ROTLEFT (A, 5) + ((B & C) ^ (B & D) ^ (C & D))  + E + Ctx->K[2] + M[Index1];
-    E = D;
-    D = C;
-    C = ROTLEFT (B, 30);
-    B = A;
-    A = T;
+
+  for ( ; Index < 60; Index += 5) {
+    ROUND (A, B, C, D, E, F2, Ctx->K[2], SCHEDULE (Index + 0));
+    ROUND (E, A, B, C, D, F2, Ctx->K[2], SCHEDULE (Index + 1));
+    ROUND (D, E, A, B, C, F2, Ctx->K[2], SCHEDULE (Index + 2));
+    ROUND (C, D, E, A, B, F2, Ctx->K[2], SCHEDULE (Index + 3));
+    ROUND (B, C, D, E, A, F2, Ctx->K[2], SCHEDULE (Index + 4));
   }
-  for ( ; Index1 < 80; ++Index1) {
-    T = ROTLEFT (A, 5) + (B ^ C ^ D) + E + Ctx->K[3] + M[Index1];
-    E = D;
-    D = C;
-    C = ROTLEFT (B, 30);
-    B = A;
-    A = T;
+
+  for ( ; Index < 80; Index += 5) {
+    ROUND (A, B, C, D, E, F1, Ctx->K[3], SCHEDULE (Index + 0));
+    ROUND (E, A, B, C, D, F1, Ctx->K[3], SCHEDULE (Index + 1));
+    ROUND (D, E, A, B, C, F1, Ctx->K[3], SCHEDULE (Index + 2));
+    ROUND (C, D, E, A, B, F1, Ctx->K[3], SCHEDULE (Index + 3));
+    ROUND (B, C, D, E, A, F1, Ctx->K[3], SCHEDULE (Index + 4));
   }
 
   Ctx->State[0] += A;
@@ -121,16 +141,43 @@ Sha1Update (
   UINTN        Len
   )
 {
-  UINTN Index = 0;
-
-  for (Index = 0; Index < Len; ++Index) {
-    Ctx->Data[Ctx->DataLen] = Data[Index];
-    Ctx->DataLen++;
-    if (Ctx->DataLen == 64) {
-      Sha1Transform (Ctx, Ctx->Data);
-      Ctx->BitLen += 512;
-      Ctx->DataLen = 0;
+  UINTN  Fill;
+
+  //
+  // Complete buffered block first.
+  //
+  if (Ctx->DataLen > 0) {
+    Fill = 64 - Ctx->DataLen;
+    if (Len < Fill) {
+      CopyMem (Ctx->Data + Ctx->DataLen, Data, Len);
+      Ctx->DataLen += (UINT32) Len;
+      return;
     }
+
+    CopyMem (Ctx->Data + Ctx->DataLen, Data, Fill);
+    Sha1Transform (Ctx, Ctx->Data);
+    Ctx->BitLen += 512;
+    Ctx->DataLen = 0;
+    Data += Fill;
+    Len  -= Fill;
+  }
+
+  //
+  // Transform full blocks directly from caller buffer.
+  //
+  while (Len >= 64) {
+    Sha1Transform (Ctx, Data);
+    Ctx->BitLen += 512;
+    Data += 64;
+    Len  -= 64;
+  }
+
+  //
+  // Buffer the remainder.
+  //
+  if (Len > 0) {
+    CopyMem (Ctx->Data, Data, Len);
+    Ctx->DataLen = (UINT32) Len;
   }
 }
 
@@ -36,6 +36,8 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Library/OcCryptoLib.h>
 
+#include "CryptoInternal.h"
+
 #define ROTLEFT(a, b) (((a) << (b)) | ((a) >> (32-(b))))
 #define ROTRIGHT(a, b) (((a) >> (b)) | ((a) << (32-(b))))
 #define CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
@@ -56,50 +58,92 @@ STATIC CONST UINT32 K[64] = {
   0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
 };
 
+//
+// Load big endian 32-bit word, compilers turn this into a single swapped load.
+//
+#define LOAD32H(p) \
+  (((UINT32)(p)[0] << 24) | ((UINT32)(p)[1] << 16) | ((UINT32)(p)[2] << 8) | ((UINT32)(p)[3]))
+
+//
+// Message schedule is kept in a 16 word circular buffer.
+//
+#define SCHEDULE(i) \
+  (M[(i) & 15] += SIG1 (M[((i) - 2) & 15]) + M[((i) - 7) & 15] + SIG0 (M[((i) - 15) & 15]))
+
+#define ROUND(a, b, c, d, e, f, g, h, i, w) \
+  do { \
+    T1 = (h) + EP1 (e) + CH (e, f, g) + K[i] + (w); \
+    (d) += T1; \
+    (h) = T1 + EP0 (a) + MAJ (a, b, c); \
+  } while (0)
+
+VOID
+EFIAPI
+Sha256TransformBlocksGeneric (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockCount
+  )
+{
+  UINT32 A, B, C, D, E, F, G, H, Index, T1;
+  UINT32 M[16];
+
+  for (; BlockCount > 0; BlockCount--, Data += 64) {
+    for (Index = 0; Index < 16; Index++) {
+      M[Index] = LOAD32H (Data + Index * 4);
+    }
+
+    A = State[0];
+    B = State[1];
+    C = State[2];
+    D = State[3];
+    E = State[4];
+    F = State[5];
+    G = State[6];
+    H = State[7];
+
+    for (Index = 0; Index < 16; Index += 8) {
+      ROUND (A, B, C, D, E, F, G, H, Index + 0, M[0 + Index]);
+      ROUND (H, A, B, C, D, E, F, G, Index + 1, M[1 + Index]);
+      ROUND (G, H, A, B, C, D, E, F, Index + 2, M[2 + Index]);
+      ROUND (F, G, H, A, B, C, D, E, Index + 3, M[3 + Index]);
+      ROUND (E, F, G, H, A, B, C, D, Index + 4, M[4 + Index]);
+      ROUND (D, E, F, G, H, A, B, C, Index + 5, M[5 + Index]);
+      ROUND (C, D, E, F, G, H, A, B, Index + 6, M[6 + Index]);
+      ROUND (B, C, D, E, F, G, H, A, Index + 7, M[7 + Index]);
+    }
+
+    for ( ; Index < 64; Index += 8) {
+      ROUND (A, B, C, D, E, F, G, H, Index + 0, SCHEDULE (Index + 0));
+      ROUND (H, A, B, C, D, E, F, G, Index + 1, SCHEDULE (Index + 1));
+      ROUND (G, H, A, B, C, D, E, F, Index + 2, SCHEDULE (Index + 2));
+      ROUND (F, G, H, A, B, C, D, E, Index + 3, SCHEDULE (Index + 3));
+      ROUND (E, F, G, H, A, B, C, D, Index + 4, SCHEDULE (Index + 4));
+      ROUND (D, E, F, G, H, A, B, C, Index + 5, SCHEDULE (Index + 5));
+      ROUND (C, D, E, F, G, H, A, B, Index + 6, SCHEDULE (Index + 6));
+      ROUND (B, C, D, E, F, G, H, A, Index + 7, SCHEDULE (Index + 7));
+    }
+
+    State[0] += A;
+    State[1] += B;
+    State[2] += C;
+    State[3] += D;
+    State[4] += E;
+    State[5] += F;
+    State[6] += G;
+    State[7] += H;
+  }
+}
+
+SHA256_TRANSFORM_BLOCKS  gSha256TransformBlocks = Sha256TransformBlocksGeneric;
+
 VOID
 Sha256Transform (
   SHA256_CONTEXT  *Context,
   CONST UINT8     *Data
   )
 {
-  UINT32 A, B, C, D, E, F, G, H, Index1, Index2, T1, T2;
-  UINT32 M[64];
-
-  for (Index1 = 0, Index2 = 0; Index1 < 16; Index1++, Index2 += 4)
-    M[Index1] = ((UINT32)Data[Index2] << 24) | ((UINT32)Data[Index2 + 1] << 16) | ((UINT32)Data[Index2 + 2] << 8) | ((UINT32)Data[Index2 + 3]);
-  for ( ; Index1 < 64; Index1++)
-    M[Index1] = SIG1 (M[Index1 - 2]) + M[Index1 - 7] + SIG0 (M[Index1 - 15]) + M[Index1 - 16];
-
-  A = Context->State[0];
-  B = Context->State[1];
-  C = Context->State[2];
-  D = Context->State[3];
-  E = Context->State[4];
-  F = Context->State[5];
-  G = Context->State[6];
-  H = Context->State[7];
-
-  for (Index1 = 0; Index1 < 64; Index1++) {
-    T1 = H + EP1 (E) + CH (E, F, G) + K[Index1] + M[Index1];
-    T2 = EP0 (A) + MAJ (A, B, C);
-    H = G;
-    G = F;
-    F = E;
-    E = D + T1;
-    D = C;
-    C = B;
-    B = A;
-    A = T1 + T2;
-  }
-
-  Context->State[0] += A;
-  Context->State[1] += B;
-  Context->State[2] += C;
-  Context->State[3] += D;
-  Context->State[4] += E;
-  Context->State[5] += F;
-  Context->State[6] += G;
-  Context->State[7] += H;
+  gSha256TransformBlocks (Context->State, Data, 1);
 }
 
 VOID
@@ -126,16 +170,43 @@ Sha256Update (
   UINTN          Len
   )
 {
-  UINT32 Index;
-
-  for (Index = 0; Index < Len; Index++) {
-    Context->Data[Context->DataLen] = Data[Index];
-    Context->DataLen++;
-    if (Context->DataLen == 64) {
-      Sha256Transform (Context, Context->Data);
-      Context->BitLen += 512;
-      Context->DataLen = 0;
+  UINTN  Fill;
+
+  //
+  // Complete buffered block first.
+  //
+  if (Context->DataLen > 0) {
+    Fill = 64 - Context->DataLen;
+    if (Len < Fill) {
+      CopyMem (Context->Data + Context->DataLen, Data, Len);
+      Context->DataLen += (UINT32) Len;
+      return;
     }
+
+    CopyMem (Context->Data + Context->DataLen, Data, Fill);
+    Sha256Transform (Context, Context->Data);
+    Context->BitLen += 512;
+    Context->DataLen = 0;
+    Data += Fill;
+    Len  -= Fill;
+  }
+
+  //
+  // Transform full blocks directly from caller buffer.
+  //
+  if (Len >= 64) {
+    gSha256TransformBlocks (Context->State, Data, Len / 64);
+    Context->BitLen += (UINT64) (Len / 64) * 512;
+    Data += Len & ~(UINTN) 63;
+    Len  &= 63;
+  }
+
+  //
+  // Buffer the remainder.
+  //
+  if (Len > 0) {
+    CopyMem (Context->Data, Data, Len);
+    Context->DataLen = (UINT32) Len;
   }
 }
 
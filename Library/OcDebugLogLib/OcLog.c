@@ -96,6 +96,151 @@ GetTiming  (
   return Private->TimingTxt;
 }
 
+/**
+  Write pending part of the log buffer to the log file.
+  The log file always has AsciiBufferSize bytes, so new data is written
+  in place at its offset in the buffer.
+
+  @param[in] OcLog  This protocol.
+**/
+STATIC
+VOID
+OcLogFlushFile (
+  IN OC_LOG_PROTOCOL  *OcLog
+  )
+{
+  EFI_STATUS          Status;
+  OC_LOG_PRIVATE_DATA *Private;
+  EFI_TPL             OldTpl;
+  EFI_FILE_PROTOCOL   *File;
+  UINTN               Length;
+  UINTN               WrittenSize;
+
+  Private = OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (OcLog);
+
+  if (OcLog->FileSystem == NULL
+    || Private->FileFlushing
+    || Private->AsciiBufferFlushed >= Private->AsciiBufferLength) {
+    return;
+  }
+
+  //
+  // File I/O is not allowed above TPL_CALLBACK, defer to the timer then.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  gBS->RestoreTPL (OldTpl);
+  if (OldTpl > TPL_CALLBACK) {
+    return;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  Private->FileFlushing = TRUE;
+
+  Length = Private->AsciiBufferLength;
+
+  Status = OcLog->FileSystem->Open (
+    OcLog->FileSystem,
+    &File,
+    OcLog->FilePath,
+    EFI_FILE_MODE_CREATE | EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE,
+    0
+    );
+  if (!EFI_ERROR (Status)) {
+    Status = File->SetPosition (File, Private->AsciiBufferFlushed);
+    if (!EFI_ERROR (Status)) {
+      WrittenSize = Length - Private->AsciiBufferFlushed;
+      Status = File->Write (
+        File,
+        &WrittenSize,
+        &Private->AsciiBuffer[Private->AsciiBufferFlushed]
+        );
+      if (!EFI_ERROR (Status)) {
+        Private->AsciiBufferFlushed += WrittenSize;
+      }
+    }
+
+    File->Close (File);
+  }
+
+  Private->FileFlushing = FALSE;
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+  Periodically flush buffered log file.
+
+  @param[in] Event    Timer event.
+  @param[in] Context  This protocol.
+**/
+STATIC
+VOID
+EFIAPI
+OcLogFlushFileTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  OC_LOG_PROTOCOL  *OcLog;
+
+  OcLog = Context;
+
+  if ((OcLog->Options & (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) == (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) {
+    OcLogFlushFile (OcLog);
+  }
+}
+
+/**
+  Flush buffered log file when the platform is about to boot.
+  This is the last point file I/O is known to be safe at.
+
+  @param[in] Event    Ready to boot event.
+  @param[in] Context  This protocol.
+**/
+STATIC
+VOID
+EFIAPI
+OcLogReadyToBoot (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  OC_LOG_PROTOCOL  *OcLog;
+
+  OcLog = Context;
+
+  if ((OcLog->Options & (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) == (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) {
+    OcLogFlushFile (OcLog);
+  }
+}
+
+/**
+  Stop file logging when leaving boot services.
+  No file I/O is allowed here, pending buffered data is dropped.
+
+  @param[in] Event    Exit boot services event.
+  @param[in] Context  This protocol.
+**/
+STATIC
+VOID
+EFIAPI
+OcLogExitBootServices (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  OC_LOG_PROTOCOL      *OcLog;
+  OC_LOG_PRIVATE_DATA  *Private;
+
+  OcLog   = Context;
+  Private = OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (OcLog);
+
+  if (Private->FileFlushEvent != NULL) {
+    gBS->SetTimer (Private->FileFlushEvent, TimerCancel, 0);
+  }
+
+  OcLog->Options &= ~(OC_LOG_FILE | OC_LOG_FILE_BUFFERED);
+}
+
 EFI_STATUS
 EFIAPI
 OcLogAddEntry  (
@@ -237,23 +382,47 @@ OcLogAddEntry  (
     // Write to internal buffer.
     //
 
-    Status = AsciiStrCatS (Private->AsciiBuffer, Private->AsciiBufferSize, Private->TimingTxt);
-    if (!EFI_ERROR (Status)) {
-      Status = AsciiStrCatS (Private->AsciiBuffer, Private->AsciiBufferSize, Private->LineBuffer);
+    if (Private->AsciiBufferSize - Private->AsciiBufferLength > TimingLength + LineLength) {
+      CopyMem (
+        &Private->AsciiBuffer[Private->AsciiBufferLength],
+        Private->TimingTxt,
+        TimingLength
+        );
+      Private->AsciiBufferLength += TimingLength;
+      CopyMem (
+        &Private->AsciiBuffer[Private->AsciiBufferLength],
+        Private->LineBuffer,
+        LineLength + 1
+        );
+      Private->AsciiBufferLength += LineLength;
+      Status = EFI_SUCCESS;
+    } else {
+      Status = EFI_BUFFER_TOO_SMALL;
     }
 
     //
     // Write to a file.
-    // Always overwriting file completely is most reliable.
-    // I know it is slow, but fixed size write is more reliable with broken FAT32 driver.
     //
     if ((OcLog->Options & OC_LOG_FILE) != 0 && OcLog->FileSystem != NULL) {
-      SetFileData (
-        OcLog->FileSystem,
-        OcLog->FilePath,
-        Private->AsciiBuffer,
-        (UINT32) Private->AsciiBufferSize
-        );
+      if ((OcLog->Options & OC_LOG_FILE_BUFFERED) != 0) {
+        //
+        // Only write new data in batches, the rest is flushed by the timer.
+        //
+        if (Private->AsciiBufferLength - Private->AsciiBufferFlushed >= OC_LOG_FILE_FLUSH_SIZE) {
+          OcLogFlushFile (OcLog);
+        }
+      } else {
+        //
+        // Always overwriting file completely is most reliable.
+        // I know it is slow, but fixed size write is more reliable with broken FAT32 driver.
+        //
+        SetFileData (
+          OcLog->FileSystem,
+          OcLog->FilePath,
+          Private->AsciiBuffer,
+          (UINT32) Private->AsciiBufferSize
+          );
+      }
     }
 
     //
@@ -341,13 +510,17 @@ OcLogGetLog  (
 }
 
 /**
-  Save the current log
+  Save the current log.
+  Only writing pending buffered data to the configured log file
+  is supported, i.e. NonVolatile must be 0 and FilePath NULL.
 
   @param[in] This         This protocol.
   @param[in] NonVolatile  Variable.
   @param[in] FilePath     Filepath to save the log, optional.
 
-  @retval EFI_SUCCESS  The log was saved successfully.
+  @retval EFI_SUCCESS    The log was saved successfully.
+  @retval EFI_NOT_READY  The log could not be written at current TPL.
+  @retval EFI_NOT_FOUND  Buffered file logging is not enabled.
 **/
 EFI_STATUS
 EFIAPI
@@ -357,7 +530,22 @@ OcLogSaveLog (
   IN EFI_DEVICE_PATH_PROTOCOL  *FilePath OPTIONAL
   )
 {
-  return EFI_NOT_FOUND;
+  OC_LOG_PRIVATE_DATA  *Private;
+
+  if (NonVolatile != 0 || FilePath != NULL
+    || (This->Options & (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) != (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)
+    || This->FileSystem == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  OcLogFlushFile (This);
+
+  Private = OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (This);
+  if (Private->AsciiBufferFlushed < Private->AsciiBufferLength) {
+    return EFI_NOT_READY;
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -376,6 +564,73 @@ OcLogResetTimers (
   return EFI_SUCCESS;
 }
 
+/**
+  Start or stop periodic flushing of buffered log file.
+
+  @param[in] OcLog  This protocol.
+**/
+STATIC
+VOID
+OcLogConfigureFileFlush (
+  IN OC_LOG_PROTOCOL  *OcLog
+  )
+{
+  EFI_STATUS          Status;
+  OC_LOG_PRIVATE_DATA *Private;
+
+  Private = OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (OcLog);
+
+  if ((OcLog->Options & (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) != (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)
+    || OcLog->FileSystem == NULL) {
+    if (Private->FileFlushEvent != NULL) {
+      gBS->SetTimer (Private->FileFlushEvent, TimerCancel, 0);
+    }
+    return;
+  }
+
+  if (Private->FileFlushEvent == NULL) {
+    Status = gBS->CreateEvent (
+      EVT_TIMER | EVT_NOTIFY_SIGNAL,
+      TPL_CALLBACK,
+      OcLogFlushFileTimer,
+      OcLog,
+      &Private->FileFlushEvent
+      );
+    if (EFI_ERROR (Status)) {
+      Private->FileFlushEvent = NULL;
+    }
+  }
+
+  if (Private->ReadyToBootEvent == NULL) {
+    Status = EfiCreateEventReadyToBootEx (
+      TPL_CALLBACK,
+      OcLogReadyToBoot,
+      OcLog,
+      &Private->ReadyToBootEvent
+      );
+    if (EFI_ERROR (Status)) {
+      Private->ReadyToBootEvent = NULL;
+    }
+  }
+
+  if (Private->ExitBootServicesEvent == NULL) {
+    Status = gBS->CreateEvent (
+      EVT_SIGNAL_EXIT_BOOT_SERVICES,
+      TPL_CALLBACK,
+      OcLogExitBootServices,
+      OcLog,
+      &Private->ExitBootServicesEvent
+      );
+    if (EFI_ERROR (Status)) {
+      Private->ExitBootServicesEvent = NULL;
+    }
+  }
+
+  if (Private->FileFlushEvent != NULL) {
+    gBS->SetTimer (Private->FileFlushEvent, TimerPeriodic, OC_LOG_FILE_FLUSH_PERIOD);
+  }
+}
+
 /**
   Install or update the OcLog protocol with specified options.
 
@@ -441,6 +696,9 @@ OcConfigureLogProtocol (
     //
 
     if (OcLog->FileSystem != NULL) {
+      if ((OcLog->Options & (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) == (OC_LOG_FILE | OC_LOG_FILE_BUFFERED)) {
+        OcLogFlushFile (OcLog);
+      }
       OcLog->FileSystem->Close (OcLog->FileSystem);
     }
 
@@ -492,16 +750,22 @@ OcConfigureLogProtocol (
 
   if (LogRoot != NULL) {
     if (!EFI_ERROR (Status)) {
+      Private = OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (OcLog);
       SetFileData (
         LogRoot,
         LogPath,
-        OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (OcLog)->AsciiBuffer,
-        (UINT32) OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS (OcLog)->AsciiBufferSize
+        Private->AsciiBuffer,
+        (UINT32) Private->AsciiBufferSize
         );
+      Private->AsciiBufferFlushed = Private->AsciiBufferLength;
     } else {
       LogRoot->Close (LogRoot);
     }
   }
 
+  if (!EFI_ERROR (Status)) {
+    OcLogConfigureFileFlush (OcLog);
+  }
+
   return Status;
 }
@@ -24,6 +24,13 @@
 #define OC_LOG_FILE_PATH_BUFFER_SIZE  256
 #define OC_LOG_TIMING_BUFFER_SIZE     64
 
+//
+// Buffered file log is flushed once this much data is pending,
+// and periodically with this timer period (in 100ns units).
+//
+#define OC_LOG_FILE_FLUSH_SIZE        BASE_4KB
+#define OC_LOG_FILE_FLUSH_PERIOD      EFI_TIMER_PERIOD_SECONDS (1)
+
 #define OC_LOG_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('O', 'C', 'L', 'G')
 
 #define OC_LOG_PRIVATE_DATA_FROM_OC_LOG_THIS(a) \
@@ -39,6 +46,12 @@ typedef struct {
   CHAR16                 UnicodeLineBuffer[OC_LOG_LINE_BUFFER_SIZE];
   CHAR8                  AsciiBuffer[OC_LOG_BUFFER_SIZE];
   UINTN                  AsciiBufferSize;
+  UINTN                  AsciiBufferLength;
+  UINTN                  AsciiBufferFlushed;
+  BOOLEAN                FileFlushing;
+  EFI_EVENT              FileFlushEvent;
+  EFI_EVENT              ReadyToBootEvent;
+  EFI_EVENT              ExitBootServicesEvent;
   CHAR8                  NvramBuffer[OC_LOG_NVRAM_BUFFER_SIZE];
   UINTN                  NvramBufferSize;
   UINT32                 LogCounter;
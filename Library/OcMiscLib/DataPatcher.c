@@ -15,8 +15,128 @@
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/OcMiscLib.h>
 
+/**
+  Compare data against masked pattern eight bytes at a time.
+
+  @param[in] Data         Data to compare, at least Size bytes.
+  @param[in] Pattern      Pattern bytes.
+  @param[in] PatternMask  Pattern mask bytes.
+  @param[in] Size         Number of bytes to compare.
+
+  @return  TRUE when (Data & PatternMask) == Pattern.
+**/
+STATIC
+BOOLEAN
+InternalMaskedMatch (
+  IN CONST UINT8   *Data,
+  IN CONST UINT8   *Pattern,
+  IN CONST UINT8   *PatternMask,
+  IN UINT32        Size
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index + sizeof (UINT64) <= Size; Index += sizeof (UINT64)) {
+    if ((ReadUnaligned64 ((CONST UINT64 *) &Data[Index])
+      & ReadUnaligned64 ((CONST UINT64 *) &PatternMask[Index]))
+      != ReadUnaligned64 ((CONST UINT64 *) &Pattern[Index])) {
+      return FALSE;
+    }
+  }
+
+  for (; Index < Size; ++Index) {
+    if ((Data[Index] & PatternMask[Index]) != Pattern[Index]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Find unmasked pattern, checking first and last pattern bytes
+  before comparing the whole pattern.
+
+  @param[in] Pattern      Pattern bytes.
+  @param[in] PatternSize  Pattern size, non-zero.
+  @param[in] Data         Data to search in.
+  @param[in] DataSize     Data size.
+  @param[in] DataOff      Offset to start at.
+
+  @return  pattern offset or -1.
+**/
+STATIC
+INT32
+InternalFindPatternUnmasked (
+  IN CONST UINT8   *Pattern,
+  IN CONST UINT32  PatternSize,
+  IN CONST UINT8   *Data,
+  IN UINT32        DataSize,
+  IN UINT32        DataOff
+  )
+{
+  UINT8  First;
+  UINT8  Last;
+
+  First = Pattern[0];
+  Last  = Pattern[PatternSize - 1];
+
+  while (DataOff + PatternSize < DataSize) {
+    if (Data[DataOff] == First
+      && Data[DataOff + PatternSize - 1] == Last
+      && CompareMem (&Data[DataOff], Pattern, PatternSize) == 0) {
+      return (INT32) DataOff;
+    }
+    ++DataOff;
+  }
+
+  return -1;
+}
+
+/**
+  Find masked pattern, filtering by the first masked byte before
+  performing word-wise comparison.
+
+  @param[in] Pattern      Pattern bytes.
+  @param[in] PatternMask  Pattern mask bytes.
+  @param[in] PatternSize  Pattern size, non-zero.
+  @param[in] Data         Data to search in.
+  @param[in] DataSize     Data size.
+  @param[in] DataOff      Offset to start at.
+
+  @return  pattern offset or -1.
+**/
+STATIC
+INT32
+InternalFindPatternMasked (
+  IN CONST UINT8   *Pattern,
+  IN CONST UINT8   *PatternMask,
+  IN CONST UINT32  PatternSize,
+  IN CONST UINT8   *Data,
+  IN UINT32        DataSize,
+  IN UINT32        DataOff
+  )
+{
+  UINT8  First;
+  UINT8  FirstMask;
+
+  First     = Pattern[0];
+  FirstMask = PatternMask[0];
+
+  while (DataOff + PatternSize < DataSize) {
+    if ((Data[DataOff] & FirstMask) == First
+      && InternalMaskedMatch (&Data[DataOff], Pattern, PatternMask, PatternSize)) {
+      return (INT32) DataOff;
+    }
+    ++DataOff;
+  }
+
+  return -1;
+}
+
 INT32
 FindPattern (
   IN CONST UINT8   *Pattern,
@@ -27,8 +147,7 @@ FindPattern (
   IN INT32         DataOff
   )
 {
-  BOOLEAN  Matches;
-  UINT32   Index;
+  UINT32  Index;
 
   ASSERT (DataOff >= 0);
 
@@ -36,23 +155,32 @@ FindPattern (
     return -1;
   }
 
-  while (DataOff + PatternSize < DataSize) {
-    Matches = TRUE;
+  //
+  // Masks consisting of 0xFF bytes only are a common way to write
+  // unmasked patterns, they are handled by the faster unmasked path.
+  //
+  if (PatternMask != NULL) {
     for (Index = 0; Index < PatternSize; ++Index) {
-      if ((PatternMask == NULL && Data[DataOff + Index] != Pattern[Index])
-      || (PatternMask != NULL && (Data[DataOff + Index] & PatternMask[Index]) != Pattern[Index])) {
-        Matches = FALSE;
-        break;
+      if (PatternMask[Index] != MAX_UINT8) {
+        return InternalFindPatternMasked (
+          Pattern,
+          PatternMask,
+          PatternSize,
+          Data,
+          DataSize,
+          (UINT32) DataOff
+          );
       }
     }
-
-    if (Matches) {
-      return DataOff;
-    }
-    ++DataOff;
   }
 
-  return -1;
+  return InternalFindPatternUnmasked (
+    Pattern,
+    PatternSize,
+    Data,
+    DataSize,
+    (UINT32) DataOff
+    );
 }
 
 UINT32
@@ -115,3 +243,266 @@ ApplyPatch (
 
   return ReplaceCount;
 }
+
+/**
+  Check whether the byte may start a match of the patch.
+
+  @param[in] Patch  Patch to check.
+  @param[in] Byte   First data byte.
+
+  @return  TRUE when the byte matches the first pattern byte.
+**/
+STATIC
+BOOLEAN
+PatternFirstByteMatches (
+  IN CONST PATTERN_PATCH  *Patch,
+  IN UINT8                Byte
+  )
+{
+  if (Patch->PatternMask != NULL) {
+    Byte &= Patch->PatternMask[0];
+  }
+
+  return Byte == Patch->Pattern[0];
+}
+
+RETURN_STATUS
+PatternMatcherInit (
+  OUT PATTERN_MATCHER      *Matcher,
+  IN  CONST PATTERN_PATCH  *Patches,
+  IN  UINT32               PatchCount
+  )
+{
+  UINT32  Index;
+  UINT32  Byte;
+  UINT32  TotalCount;
+  UINTN   BucketSize;
+  UINTN   StatesSize;
+  UINT32  *Starts;
+
+  ASSERT (Matcher != NULL);
+  ASSERT (Patches != NULL || PatchCount == 0);
+
+  ZeroMem (Matcher, sizeof (*Matcher));
+
+  //
+  // Count bucket entries first. Masked patterns may start with any
+  // of several byte values and thus occupy multiple buckets.
+  //
+  TotalCount = 0;
+  for (Index = 0; Index < PatchCount; ++Index) {
+    if (Patches[Index].PatternSize == 0) {
+      continue;
+    }
+
+    if (Patches[Index].PatternMask == NULL) {
+      ++TotalCount;
+      continue;
+    }
+
+    for (Byte = 0; Byte <= MAX_UINT8; ++Byte) {
+      if (PatternFirstByteMatches (&Patches[Index], (UINT8) Byte)) {
+        ++TotalCount;
+      }
+    }
+  }
+
+  BucketSize = (MAX_UINT8 + 2 + (UINTN) TotalCount) * sizeof (UINT32);
+  StatesSize = (UINTN) PatchCount * sizeof (PATTERN_PATCH_STATE);
+
+  Starts = AllocatePool (BucketSize + StatesSize);
+  if (Starts == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  Matcher->Patches       = Patches;
+  Matcher->PatchCount    = PatchCount;
+  Matcher->BucketStarts  = Starts;
+  Matcher->BucketIndices = &Starts[MAX_UINT8 + 2];
+  Matcher->States        = (PATTERN_PATCH_STATE *) ((UINT8 *) Starts + BucketSize);
+
+  //
+  // Fill buckets in byte order, keeping patch indices ascending
+  // within every bucket to preserve patch application order.
+  //
+  TotalCount = 0;
+  for (Byte = 0; Byte <= MAX_UINT8; ++Byte) {
+    Starts[Byte] = TotalCount;
+    for (Index = 0; Index < PatchCount; ++Index) {
+      if (Patches[Index].PatternSize > 0
+        && PatternFirstByteMatches (&Patches[Index], (UINT8) Byte)) {
+        Matcher->BucketIndices[TotalCount] = Index;
+        ++TotalCount;
+      }
+    }
+  }
+  Starts[MAX_UINT8 + 1] = TotalCount;
+
+  return RETURN_SUCCESS;
+}
+
+VOID
+PatternMatcherFree (
+  IN OUT PATTERN_MATCHER  *Matcher
+  )
+{
+  ASSERT (Matcher != NULL);
+
+  if (Matcher->BucketStarts != NULL) {
+    FreePool (Matcher->BucketStarts);
+  }
+
+  ZeroMem (Matcher, sizeof (*Matcher));
+}
+
+UINT32
+ApplyPatches (
+  IN OUT PATTERN_MATCHER  *Matcher,
+  IN OUT UINT8            *Data,
+  IN     UINT32           DataSize,
+  IN     CONST BOOLEAN    *Enabled        OPTIONAL,
+     OUT UINT32           *ReplaceCounts  OPTIONAL
+  )
+{
+  CONST PATTERN_PATCH  *Patch;
+  PATTERN_PATCH_STATE  *State;
+  UINT32               Index;
+  UINT32               ActiveCount;
+  UINT32               TotalCount;
+  UINT32               DataOff;
+  UINT32               Bucket;
+  UINT32               BucketEnd;
+  UINT32               MinIndex;
+  UINT32               ByteIndex;
+  UINT8                Byte;
+  BOOLEAN              Matches;
+
+  ASSERT (Matcher != NULL);
+  ASSERT (Data != NULL);
+
+  ActiveCount = 0;
+  TotalCount  = 0;
+
+  for (Index = 0; Index < Matcher->PatchCount; ++Index) {
+    Patch = &Matcher->Patches[Index];
+    State = &Matcher->States[Index];
+
+    State->Count   = Patch->Count;
+    State->Skip    = Patch->Skip;
+    State->NextOff = 0;
+    State->End     = DataSize;
+    if (Patch->Limit > 0 && Patch->Limit < DataSize) {
+      State->End = Patch->Limit;
+    }
+
+    State->Done = Patch->PatternSize == 0
+      || (Enabled != NULL && !Enabled[Index])
+      || State->End <= Patch->PatternSize;
+
+    if (!State->Done) {
+      ++ActiveCount;
+    }
+
+    if (ReplaceCounts != NULL) {
+      ReplaceCounts[Index] = 0;
+    }
+  }
+
+  for (DataOff = 0; DataOff < DataSize && ActiveCount > 0; ++DataOff) {
+    Byte      = Data[DataOff];
+    Bucket    = Matcher->BucketStarts[Byte];
+    BucketEnd = Matcher->BucketStarts[Byte + 1];
+    MinIndex  = 0;
+
+    while (Bucket < BucketEnd) {
+      Index = Matcher->BucketIndices[Bucket];
+      ++Bucket;
+
+      State = &Matcher->States[Index];
+      if (Index < MinIndex || State->Done || DataOff < State->NextOff) {
+        continue;
+      }
+
+      Patch = &Matcher->Patches[Index];
+
+      //
+      // Same bound as FindPattern uses, the area is exhausted for this patch.
+      //
+      if (DataOff + Patch->PatternSize >= State->End) {
+        State->Done = TRUE;
+        --ActiveCount;
+        continue;
+      }
+
+      if (Patch->PatternMask == NULL) {
+        Matches = CompareMem (
+          &Data[DataOff + 1],
+          &Patch->Pattern[1],
+          Patch->PatternSize - 1
+          ) == 0;
+      } else {
+        Matches = InternalMaskedMatch (
+          &Data[DataOff + 1],
+          &Patch->Pattern[1],
+          &Patch->PatternMask[1],
+          Patch->PatternSize - 1
+          );
+      }
+
+      if (!Matches) {
+        continue;
+      }
+
+      State->NextOff = DataOff + Patch->PatternSize;
+
+      //
+      // Skip this finding if requested.
+      //
+      if (State->Skip > 0) {
+        --State->Skip;
+        continue;
+      }
+
+      //
+      // Perform replacement.
+      //
+      if (Patch->ReplaceMask == NULL) {
+        CopyMem (&Data[DataOff], Patch->Replace, Patch->PatternSize);
+      } else {
+        for (ByteIndex = 0; ByteIndex < Patch->PatternSize; ++ByteIndex) {
+          Data[DataOff + ByteIndex] = (Data[DataOff + ByteIndex] & ~Patch->ReplaceMask[ByteIndex])
+            | (Patch->Replace[ByteIndex] & Patch->ReplaceMask[ByteIndex]);
+        }
+      }
+
+      ++TotalCount;
+      if (ReplaceCounts != NULL) {
+        ++ReplaceCounts[Index];
+      }
+
+      //
+      // Check replace count if requested.
+      //
+      if (State->Count > 0) {
+        --State->Count;
+        if (State->Count == 0) {
+          State->Done = TRUE;
+          --ActiveCount;
+        }
+      }
+
+      //
+      // Replacement may have changed the first byte, continue with
+      // the following patches from the bucket of the new byte.
+      //
+      if (Data[DataOff] != Byte) {
+        Byte      = Data[DataOff];
+        Bucket    = Matcher->BucketStarts[Byte];
+        BucketEnd = Matcher->BucketStarts[Byte + 1];
+        MinIndex  = Index + 1;
+      }
+    }
+  }
+
+  return TotalCount;
+}
@@ -50,6 +50,50 @@ mVaultSchema = {
 };
 
 
+STATIC
+VOID
+OcStorageBuildVaultIndex (
+  IN OUT OC_STORAGE_CONTEXT  *Context
+  )
+{
+  UINT32                  Index;
+  UINT32                  Size;
+  UINT32                  Slot;
+  UINT32                  Hash;
+  OC_STORAGE_VAULT_INDEX  *VaultIndex;
+
+  //
+  // Keep the table at most half full for short probe sequences.
+  //
+  Size = 16;
+  while (Size / 2 < Context->Vault.Files.Count) {
+    if (Size > MAX_UINT32 / 2 / sizeof (*VaultIndex)) {
+      return;
+    }
+    Size *= 2;
+  }
+
+  VaultIndex = AllocateZeroPool (Size * sizeof (*VaultIndex));
+  if (VaultIndex == NULL) {
+    DEBUG ((DEBUG_INFO, "OCS: Vault index allocation failure, using slow lookup\n"));
+    return;
+  }
+
+  for (Index = 0; Index < Context->Vault.Files.Count; ++Index) {
+    Hash = AsciiStrHash (OC_BLOB_GET (Context->Vault.Files.Keys[Index]), NULL);
+    Slot = Hash & (Size - 1);
+    while (VaultIndex[Slot].Index != 0) {
+      Slot = (Slot + 1) & (Size - 1);
+    }
+
+    VaultIndex[Slot].Hash  = Hash;
+    VaultIndex[Slot].Index = Index + 1;
+  }
+
+  Context->VaultIndex     = VaultIndex;
+  Context->VaultIndexSize = Size;
+}
+
 STATIC
 EFI_STATUS
 OcStorageInitializeVault (
@@ -103,9 +147,38 @@ OcStorageInitializeVault (
 
   Context->HasVault = TRUE;
 
+  OcStorageBuildVaultIndex (Context);
+
   return EFI_SUCCESS;
 }
 
+STATIC
+BOOLEAN
+OcStorageMatchVaultPath (
+  IN OC_STORAGE_CONTEXT  *Context,
+  IN UINT32              Index,
+  IN CONST CHAR16        *Filename,
+  IN UINTN               FilenameSize
+  )
+{
+  UINTN              StrIndex;
+  CHAR8              *VaultFilePath;
+
+  if (Context->Vault.Files.Keys[Index]->Size != (UINT32) FilenameSize) {
+    return FALSE;
+  }
+
+  VaultFilePath = OC_BLOB_GET (Context->Vault.Files.Keys[Index]);
+
+  for (StrIndex = 0; StrIndex < FilenameSize; ++StrIndex) {
+    if (Filename[StrIndex] != VaultFilePath[StrIndex]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 STATIC
 UINT8 *
 OcStorageGetDigest (
@@ -114,30 +187,35 @@ OcStorageGetDigest (
   )
 {
   UINT32             Index;
-  UINTN              StrIndex;
-  CHAR8              *VaultFilePath;
+  UINT32             Hash;
+  UINT32             Slot;
+  UINT32             FilenameLength;
   UINTN              FilenameSize;
 
   if (!Context->HasVault) {
     return NULL;
   }
 
-  FilenameSize = StrLen (Filename) + 1;
+  Hash         = UnicodeStrHash (Filename, &FilenameLength);
+  FilenameSize = (UINTN) FilenameLength + 1;
 
-  for (Index = 0; Index < Context->Vault.Files.Count; ++Index) {
-    if (Context->Vault.Files.Keys[Index]->Size != (UINT32) FilenameSize) {
-      continue;
-    }
-
-    VaultFilePath = OC_BLOB_GET (Context->Vault.Files.Keys[Index]);
-
-    for (StrIndex = 0; StrIndex < FilenameSize; ++StrIndex) {
-      if (Filename[StrIndex] != VaultFilePath[StrIndex]) {
-        break;
+  if (Context->VaultIndex != NULL) {
+    Slot = Hash & (Context->VaultIndexSize - 1);
+    while (Context->VaultIndex[Slot].Index != 0) {
+      Index = Context->VaultIndex[Slot].Index - 1;
+      if (Context->VaultIndex[Slot].Hash == Hash
+        && OcStorageMatchVaultPath (Context, Index, Filename, FilenameSize)) {
+        return &Context->Vault.Files.Values[Index]->Hash[0];
       }
+
+      Slot = (Slot + 1) & (Context->VaultIndexSize - 1);
     }
 
-    if (StrIndex == FilenameSize) {
+    return NULL;
+  }
+
+  for (Index = 0; Index < Context->Vault.Files.Count; ++Index) {
+    if (OcStorageMatchVaultPath (Context, Index, Filename, FilenameSize)) {
       return &Context->Vault.Files.Values[Index]->Hash[0];
     }
   }
@@ -197,12 +275,12 @@ OcStorageInitFromFs (
       return EFI_SECURITY_VIOLATION;
     }
 
-    if (DataSize != CONFIG_RSA_KEY_SIZE) {
+    if (DataSize != RsaGetKeySize (StorageKey)) {
       DEBUG ((
         DEBUG_ERROR,
         "OCS: Vault signature size mismatch: %u vs %u\n",
         DataSize,
-        CONFIG_RSA_KEY_SIZE
+        RsaGetKeySize (StorageKey)
         ));
       FreePool (Signature);
       OcStorageFree (Context);
@@ -250,6 +328,12 @@ OcStorageFree (
     OC_STORAGE_VAULT_DESTRUCT (&Context->Vault, sizeof (Context->Vault));
     Context->HasVault = FALSE;
   }
+
+  if (Context->VaultIndex != NULL) {
+    FreePool (Context->VaultIndex);
+    Context->VaultIndex     = NULL;
+    Context->VaultIndexSize = 0;
+  }
 }
 
 VOID *
@@ -130,3 +130,32 @@ AsciiUint64ToLowerHex (
   return TRUE;
 }
 
+/** Calculate 32-bit FNV-1a hash of a null terminated ascii string.
+
+  @param[in]  String  Ascii string to hash.
+  @param[out] Length  String length, optional.
+
+  @retval  String hash value.
+**/
+UINT32
+AsciiStrHash (
+  IN  CONST CHAR8  *String,
+  OUT UINT32       *Length  OPTIONAL
+  )
+{
+  UINT32  Hash;
+  UINT32  Index;
+
+  ASSERT (String != NULL);
+
+  Hash = 0x811C9DC5U;
+  for (Index = 0; String[Index] != '\0'; ++Index) {
+    Hash = (Hash ^ (UINT8) String[Index]) * 0x01000193U;
+  }
+
+  if (Length != NULL) {
+    *Length = Index;
+  }
+
+  return Hash;
+}
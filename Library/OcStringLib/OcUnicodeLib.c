@@ -200,6 +200,29 @@ UnicodeUefiSlashes (
   }
 }
 
+UINT32
+UnicodeStrHash (
+  IN  CONST CHAR16  *String,
+  OUT UINT32        *Length  OPTIONAL
+  )
+{
+  UINT32  Hash;
+  UINT32  Index;
+
+  ASSERT (String != NULL);
+
+  Hash = 0x811C9DC5U;
+  for (Index = 0; String[Index] != L'\0'; ++Index) {
+    Hash = (Hash ^ (UINT8) String[Index]) * 0x01000193U;
+  }
+
+  if (Length != NULL) {
+    *Length = Index;
+  }
+
+  return Hash;
+}
+
 VOID
 UnicodeFilterString (
   IN OUT CHAR16   *String,
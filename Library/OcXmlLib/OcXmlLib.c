@@ -48,19 +48,54 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/OcStringLib.h>
 
 //
-// Minimal extra allocation size during export.
+// Arena chunk size limits. Chunks grow twice each time up to the maximum,
+// allocations not fitting into a chunk of the current size get a dedicated one.
 //
-#define XML_EXPORT_MIN_ALLOCATION_SIZE 4096
+#define XML_ARENA_MIN_CHUNK_SIZE (64U * 1024U)
+#define XML_ARENA_MAX_CHUNK_SIZE (1024U * 1024U)
+
+//
+// Dictionaries with fewer pairs are searched linearly by PlistDictFind.
+//
+#define XML_DICT_INDEX_MIN_PAIRS 8U
+
+//
+// Binary plist (bplist00) layout. The file starts with the signature and
+// ends with a fixed size trailer pointing to the object offset table.
+// Object markers hold the type in the high nibble and the size or count
+// in the low nibble, XML_BPLIST_COUNT_INTEGER means an integer follows.
+//
+#define XML_BPLIST_SIGNATURE       "bplist00"
+#define XML_BPLIST_TRAILER_SIZE    32U
+#define XML_BPLIST_COUNT_INTEGER   0x0FU
+
+#define XML_BPLIST_MARKER_FALSE    0x08U
+#define XML_BPLIST_MARKER_TRUE     0x09U
+#define XML_BPLIST_MARKER_DATE     0x33U
+
+#define XML_BPLIST_TYPE_SIMPLE     0x00U
+#define XML_BPLIST_TYPE_INTEGER    0x10U
+#define XML_BPLIST_TYPE_REAL       0x20U
+#define XML_BPLIST_TYPE_DATE       0x30U
+#define XML_BPLIST_TYPE_DATA       0x40U
+#define XML_BPLIST_TYPE_ASCII      0x50U
+#define XML_BPLIST_TYPE_UNICODE    0x60U
+#define XML_BPLIST_TYPE_ARRAY      0xA0U
+#define XML_BPLIST_TYPE_DICT       0xD0U
 
 struct XML_NODE_LIST_;
 struct XML_PARSER_;
+struct XML_ARENA_CHUNK_;
 
 typedef struct XML_NODE_LIST_ XML_NODE_LIST;
 typedef struct XML_PARSER_ XML_PARSER;
+typedef struct XML_ARENA_CHUNK_ XML_ARENA_CHUNK;
 
 //
 // An XML_NODE will always contain a tag name and possibly a list of
 // children or text content.
+// In binary plist documents LazyStart is the object index, and LazyEnd
+// stays non-zero until children of arrays and dictionaries are created.
 //
 struct XML_NODE_ {
   CONST CHAR8    *Name;
@@ -68,12 +103,32 @@ struct XML_NODE_ {
   CONST CHAR8    *Content;
   XML_NODE       *Real;
   XML_NODE_LIST  *Children;
+  XML_DOCUMENT   *Document;
+  UINT32         LazyStart;
+  UINT32         LazyEnd;
 };
 
+//
+// Dictionary key hash table slot, Pair is 1-based and 0 for empty slots.
+//
+typedef struct {
+  UINT32        Hash;
+  UINT32        Pair;
+} XML_DICT_ENTRY;
+
+//
+// Open addressing dictionary key index built by PlistDictFind.
+//
+typedef struct {
+  UINT32          Mask;
+  XML_DICT_ENTRY  Entries[];
+} XML_DICT_INDEX;
+
 struct XML_NODE_LIST_ {
-  UINT32    NodeCount;
-  UINT32    AllocCount;
-  XML_NODE  *NodeList[];
+  UINT32          NodeCount;
+  UINT32          AllocCount;
+  XML_DICT_INDEX  *KeyIndex;
+  XML_NODE        *NodeList[];
 };
 
 typedef struct {
@@ -82,6 +137,46 @@ typedef struct {
   XML_NODE      **RefList;
 } XML_REFLIST;
 
+//
+// Buffer range found while skipping lazy node children.
+//
+typedef struct {
+  UINT32        Start;
+  UINT32        End;
+  XML_NODE      *Node;
+} XML_RANGE;
+
+//
+// Ranges sorted by Start.
+//
+typedef struct {
+  UINT32        Count;
+  UINT32        AllocCount;
+  XML_RANGE     *Ranges;
+} XML_RANGE_LIST;
+
+//
+// Page chunk header, allocations follow it.
+//
+struct XML_ARENA_CHUNK_ {
+  XML_ARENA_CHUNK  *Next;
+  UINTN            Pages;
+};
+
+//
+// Bump allocator for nodes, child lists, and references.
+// Everything is released at once with the document.
+//
+typedef struct {
+  XML_ARENA_CHUNK  *Chunks;
+  UINT8            *Current;
+  UINTN            Left;
+  UINTN            ChunkSize;
+  UINT32           Allocations;
+  UINT32           AllocatedSize;
+  UINT32           AllocatedPages;
+} XML_ARENA;
+
 //
 // An XML_DOCUMENT simply contains the root node and the underlying buffer.
 //
@@ -91,18 +186,44 @@ struct XML_DOCUMENT_ {
     UINT32      Length;
   } Buffer;
 
-  XML_NODE      *Root;
-  XML_REFLIST   References;
+  XML_NODE          *Root;
+  XML_REFLIST       References;
+  XML_ARENA         Arena;
+  //
+  // Nodes parsed while skipping, the buffer is modified within [Start, End).
+  //
+  XML_RANGE_LIST    Parsed;
+  //
+  // Children of nodes seen while skipping, [Start, End) is parsed on access.
+  //
+  XML_RANGE_LIST    Skipped;
+  BOOLEAN           WithRefs;
+  BOOLEAN           Lazy;
+  //
+  // Some lazy node failed to parse its children, export is refused.
+  //
+  BOOLEAN           LazyFailed;
+  //
+  // Binary plist object table. Levels holds the nest level of arrays and
+  // dictionaries with created nodes, so that each is only referenced once.
+  //
+  BOOLEAN           Binary;
+  UINT8             OffsetSize;
+  UINT8             RefSize;
+  UINT32            ObjectCount;
+  UINT32            OffsetTable;
+  UINT8             *Levels;
 };
 
 //
 // Parser context.
 //
 struct XML_PARSER_ {
-  CHAR8  *Buffer;
-  UINT32 Position;
-  UINT32 Length;
-  UINT32 Level;
+  XML_DOCUMENT  *Document;
+  CHAR8         *Buffer;
+  UINT32        Position;
+  UINT32        Length;
+  UINT32        Level;
 };
 
 //
@@ -171,12 +292,115 @@ XmlParseAttributeNumber (
   return TRUE;
 }
 
+//
+// Allocates memory from document arena, returned memory is 8-byte aligned.
+//
+STATIC
+VOID *
+XmlArenaAllocate (
+  XML_ARENA  *Arena,
+  UINT32     Size
+  )
+{
+  XML_ARENA_CHUNK  *Chunk;
+  UINTN            ChunkSize;
+  UINTN            Pages;
+  VOID             *Memory;
+
+  //
+  // Reject sizes wrapping on alignment or with chunk header.
+  //
+  if (Size > MAX_UINT32 - sizeof (XML_ARENA_CHUNK) - (sizeof (UINT64) - 1)) {
+    return NULL;
+  }
+
+  Size = ALIGN_VALUE (Size, sizeof (UINT64));
+
+  if (Size > Arena->Left) {
+    if (Arena->ChunkSize == 0) {
+      Arena->ChunkSize = XML_ARENA_MIN_CHUNK_SIZE;
+    }
+
+    ChunkSize = sizeof (XML_ARENA_CHUNK) + Size;
+    if (ChunkSize < Arena->ChunkSize) {
+      ChunkSize = Arena->ChunkSize;
+    }
+
+    Pages = EFI_SIZE_TO_PAGES (ChunkSize);
+    Chunk = AllocatePages (Pages);
+    if (Chunk == NULL) {
+      return NULL;
+    }
+
+    Chunk->Next    = Arena->Chunks;
+    Chunk->Pages   = Pages;
+    Arena->Chunks  = Chunk;
+    Arena->AllocatedPages += (UINT32) Pages;
+
+    Memory = Chunk + 1;
+    ChunkSize = EFI_PAGES_TO_SIZE (Pages) - sizeof (XML_ARENA_CHUNK) - Size;
+
+    //
+    // Keep allocating from the chunk with more room left, so that a dedicated
+    // chunk for a large child list does not waste the current one.
+    //
+    if (ChunkSize > Arena->Left) {
+      Arena->Current = (UINT8 *) Memory + Size;
+      Arena->Left    = ChunkSize;
+    }
+
+    if (Arena->ChunkSize < XML_ARENA_MAX_CHUNK_SIZE) {
+      Arena->ChunkSize *= 2;
+    }
+  } else {
+    Memory = Arena->Current;
+    Arena->Current += Size;
+    Arena->Left    -= Size;
+  }
+
+  Arena->Allocations++;
+  Arena->AllocatedSize += Size;
+
+  return Memory;
+}
+
+//
+// Frees all arena memory.
+//
+STATIC
+VOID
+XmlArenaFree (
+  XML_ARENA  *Arena
+  )
+{
+  XML_ARENA_CHUNK  *Chunk;
+  XML_ARENA_CHUNK  *Next;
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "OCXML: Arena had %u allocations of %u bytes in %u pages\n",
+    Arena->Allocations,
+    Arena->AllocatedSize,
+    Arena->AllocatedPages
+    ));
+
+  Chunk = Arena->Chunks;
+  while (Chunk != NULL) {
+    Next = Chunk->Next;
+    FreePages (Chunk, Chunk->Pages);
+    Chunk = Next;
+  }
+
+  ZeroMem (Arena, sizeof (*Arena));
+}
+
 //
 // Allocates the node with contents.
 //
 STATIC
 XML_NODE *
 XmlNodeCreate (
+  XML_DOCUMENT   *Document,
   CONST CHAR8    *Name,
   CONST CHAR8    *Attributes,
   CONST CHAR8    *Content,
@@ -186,7 +410,7 @@ XmlNodeCreate (
 {
   XML_NODE  *Node;
 
-  Node = AllocatePool (sizeof (XML_NODE));
+  Node = XmlArenaAllocate (&Document->Arena, sizeof (XML_NODE));
 
   if (Node != NULL) {
     Node->Name       = Name;
@@ -194,6 +418,9 @@ XmlNodeCreate (
     Node->Content    = Content;
     Node->Real       = Real;
     Node->Children   = Children;
+    Node->Document   = Document;
+    Node->LazyStart  = 0;
+    Node->LazyEnd    = 0;
   }
 
   return Node;
@@ -226,6 +453,7 @@ XmlNodeChildPush (
     if (NodeCount < XML_PARSER_NODE_COUNT && AllocCount > NodeCount) {
       Node->Children->NodeList[NodeCount] = Child;
       Node->Children->NodeCount++;
+      Node->Children->KeyIndex = NULL;
       return TRUE;
     }
   }
@@ -243,7 +471,8 @@ XmlNodeChildPush (
   //
   AllocCount *= 3;
 
-  NewList = (XML_NODE_LIST *) AllocatePool (
+  NewList = (XML_NODE_LIST *) XmlArenaAllocate (
+    &Node->Document->Arena,
     sizeof (XML_NODE_LIST) + sizeof (NewList->NodeList[0]) * AllocCount
     );
 
@@ -253,6 +482,7 @@ XmlNodeChildPush (
 
   NewList->NodeCount  = NodeCount + 1;
   NewList->AllocCount = AllocCount;
+  NewList->KeyIndex   = NULL;
 
   if (Node->Children != NULL) {
     CopyMem (
@@ -260,8 +490,6 @@ XmlNodeChildPush (
       &Node->Children->NodeList[0],
       sizeof (NewList->NodeList[0]) * NodeCount
       );
-
-    FreePool (Node->Children);
   }
 
   NewList->NodeList[NodeCount] = Child;
@@ -273,6 +501,7 @@ XmlNodeChildPush (
 STATIC
 BOOLEAN
 XmlPushReference (
+  XML_ARENA    *Arena,
   XML_REFLIST  *References,
   XML_NODE     *Node,
   UINT32       ReferenceNumber
@@ -290,18 +519,19 @@ XmlPushReference (
       return FALSE;
     }
 
-    NewReferences = AllocateZeroPool (NewRefAllocCount * sizeof (References->RefList[0]));
+    NewReferences = XmlArenaAllocate (Arena, NewRefAllocCount * sizeof (References->RefList[0]));
     if (NewReferences == NULL) {
       return FALSE;
     }
 
+    ZeroMem (NewReferences, NewRefAllocCount * sizeof (References->RefList[0]));
+
     if (References->RefList != NULL) {
       CopyMem (
         &NewReferences[0],
         &References->RefList[0],
         References->RefCount * sizeof (References->RefList[0])
         );
-      FreePool (References->RefList);
     }
 
     References->RefList       = NewReferences;
@@ -344,39 +574,6 @@ XmlNodeReal (
   return References->RefList[Number];
 }
 
-//
-// Frees the resources allocated by the node.
-//
-STATIC
-VOID
-XmlNodeFree (
-  XML_NODE  *Node
-  )
-{
-  UINT32  Index;
-
-  if (Node->Children != NULL) {
-    for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
-      XmlNodeFree (Node->Children->NodeList[Index]);
-    }
-    FreePool (Node->Children);
-  }
-
-  FreePool (Node);
-}
-
-STATIC
-VOID
-XmlFreeRefs (
-  XML_REFLIST  *References
-  )
-{
-  if (References->RefList != NULL) {
-    FreePool (References->RefList);
-    References->RefList = NULL;
-  }
-}
-
 //
 // Echos the parsers call stack for debugging purposes.
 //
@@ -537,6 +734,38 @@ XmlSkipWhitespace (
   }
 }
 
+//
+// Skips whitespace and control sequences, e.g. `<!DOCTYPE...>'.
+//
+STATIC
+VOID
+XmlSkipControl (
+  XML_PARSER  *Parser
+  )
+{
+  CHAR8  Current;
+
+  XmlSkipWhitespace (Parser);
+
+  while ('<' == XmlParserPeek (Parser, CURRENT_CHARACTER)) {
+    Current = XmlParserPeek (Parser, NEXT_CHARACTER);
+    if (Current != '?' && Current != '!') {
+      break;
+    }
+
+    //
+    // Skip the control sequence.
+    //
+    XmlParserConsume (Parser, 1);
+    do {
+      XmlParserConsume (Parser, 1);
+    } while (XmlParserPeek (Parser, CURRENT_CHARACTER) != '>' && Parser->Position < Parser->Length);
+    XmlParserConsume (Parser, 1);
+
+    XmlSkipWhitespace (Parser);
+  }
+}
+
 //
 // Parses the name out of the an XML tag's ending.
 //
@@ -649,47 +878,25 @@ XmlParseTagOpen (
   CONST CHAR8 **Attributes
   )
 {
-  CHAR8  Current;
-
   XML_PARSER_INFO (Parser, "tag_open");
 
-  do {
-    XmlSkipWhitespace (Parser);
-
-    //
-    // Consume `<'.
-    //
-    if ('<' != XmlParserPeek (Parser, CURRENT_CHARACTER)) {
-      XML_PARSER_ERROR (Parser, CURRENT_CHARACTER, "XmlParseTagOpen::expected opening tag");
-      return NULL;
-    }
-    XmlParserConsume (Parser, 1);
-
-    Current = XmlParserPeek (Parser, CURRENT_CHARACTER);
-
-    //
-    // This is closing tag, e.g. `</tag>', return.
-    //
-    if (Current == '/') {
-      return NULL;
-    }
-
-    //
-    // This is not a control sequence, e.g. `<!DOCTYPE...>', continue parsing tag.
-    //
-    if (Current != '?' && Current != '!') {
-      break;
-    }
+  XmlSkipControl (Parser);
 
-    //
-    // Skip the control sequence.
-    //
-    do {
-      XmlParserConsume (Parser, 1);
-    } while (XmlParserPeek (Parser, CURRENT_CHARACTER) != '>' && Parser->Position < Parser->Length);
-    XmlParserConsume (Parser, 1);
+  //
+  // Consume `<'.
+  //
+  if ('<' != XmlParserPeek (Parser, CURRENT_CHARACTER)) {
+    XML_PARSER_ERROR (Parser, CURRENT_CHARACTER, "XmlParseTagOpen::expected opening tag");
+    return NULL;
+  }
+  XmlParserConsume (Parser, 1);
 
-  } while (Parser->Position < Parser->Length);
+  //
+  // This is closing tag, e.g. `</tag>', return.
+  //
+  if ('/' == XmlParserPeek (Parser, CURRENT_CHARACTER)) {
+    return NULL;
+  }
 
   //
   // Consume tag name.
@@ -815,101 +1022,613 @@ XmlParseContent (
   return &Parser->Buffer[Start];
 }
 
+STATIC
+BOOLEAN
+XmlNodeParseLazy (
+  XML_NODE  *Node
+  );
+
 //
-// Prints to growing buffer always preserving one byte extra.
+// Finds the first range starting at or after Position.
 //
 STATIC
-VOID
-XmlBufferAppend (
-  CHAR8        **Buffer,
-  UINT32       *AllocSize,
-  UINT32       *CurrentSize,
-  CONST CHAR8  *Data,
-  UINT32       DataLength
+UINT32
+XmlRangeLowerBound (
+  XML_RANGE_LIST  *List,
+  UINT32          Position
   )
 {
-  CHAR8   *NewBuffer;
-  UINT32  NewSize;
+  UINT32  Low;
+  UINT32  High;
+  UINT32  Middle;
 
-  NewSize = *AllocSize;
+  Low  = 0;
+  High = List->Count;
 
-  if (NewSize - *CurrentSize <= DataLength) {
-    if (DataLength + 1 <= XML_EXPORT_MIN_ALLOCATION_SIZE) {
-      NewSize += XML_EXPORT_MIN_ALLOCATION_SIZE;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (List->Ranges[Middle].Start < Position) {
+      Low = Middle + 1;
     } else {
-      NewSize += DataLength + 1;
+      High = Middle;
+    }
+  }
+
+  return Low;
+}
+
+STATIC
+BOOLEAN
+XmlNodeExportSize (
+  XML_NODE  *Node,
+  UINT32    *Size,
+  UINT32    Skip
+  );
+
+STATIC
+VOID
+XmlNodeExportRecursive (
+  XML_NODE  *Node,
+  CHAR8     *Buffer,
+  UINT32    *CurrentSize,
+  UINT32    Skip
+  );
+
+//
+// Calculates the size of or prints lazy node children without parsing them.
+// Buffer contents are copied as is except for the nodes parsed while skipping.
+//
+STATIC
+BOOLEAN
+XmlNodeExportLazy (
+  XML_NODE  *Node,
+  CHAR8     *Buffer  OPTIONAL,
+  UINT32    *Size
+  )
+{
+  XML_DOCUMENT  *Document;
+  XML_RANGE     *Range;
+  UINT32        Position;
+  UINT32        End;
+  UINT32        Index;
+
+  Document = Node->Document;
+  Position = Node->LazyStart;
+  Index    = XmlRangeLowerBound (&Document->Parsed, Position);
+
+  while (TRUE) {
+    Range = NULL;
+    End   = Node->LazyEnd;
+
+    //
+    // Ranges nested into the already printed ones are skipped.
+    //
+    while (Index < Document->Parsed.Count && Document->Parsed.Ranges[Index].Start < Node->LazyEnd) {
+      if (Document->Parsed.Ranges[Index].Start >= Position) {
+        Range = &Document->Parsed.Ranges[Index];
+        End   = Range->Start;
+        ++Index;
+        break;
+      }
+      ++Index;
     }
 
-    NewBuffer = AllocatePool (NewSize);
-    if (NewBuffer == NULL) {
-      XML_USAGE_ERROR("XmlBufferAppend::failed to allocate");
-      return;
+    if (Buffer != NULL) {
+      CopyMem (&Buffer[*Size], &Document->Buffer.Buffer[Position], End - Position);
+      *Size += End - Position;
+    } else if (OcOverflowAddU32 (*Size, End - Position, Size)) {
+      return FALSE;
     }
 
-    CopyMem (NewBuffer, *Buffer, *CurrentSize);
-    FreePool (*Buffer);
-    *Buffer    = NewBuffer;
-    *AllocSize = NewSize;
-  }
+    if (Range == NULL) {
+      return TRUE;
+    }
 
-  CopyMem (&(*Buffer)[*CurrentSize], Data, DataLength);
-  *CurrentSize += DataLength;
+    if (Buffer != NULL) {
+      XmlNodeExportRecursive (Range->Node, Buffer, Size, 0);
+    } else if (!XmlNodeExportSize (Range->Node, Size, 0)) {
+      return FALSE;
+    }
+
+    Position = Range->End;
+  }
 }
 
 //
-// Prints node to growing buffer always preserving one byte extra.
+// Calculates exported node size without trailing \0.
 //
 STATIC
-VOID
-XmlNodeExportRecursive (
+BOOLEAN
+XmlNodeExportSize (
   XML_NODE  *Node,
-  CHAR8     **Buffer,
-  UINT32    *AllocSize,
-  UINT32    *CurrentSize,
+  UINT32    *Size,
   UINT32    Skip
   )
 {
   UINT32  Index;
+  UINT32  NodeSize;
   UINT32  NameLength;
 
   if (Skip != 0) {
+    if (!XmlNodeParseLazy (Node)) {
+      return FALSE;
+    }
+
     if (Node->Children != NULL) {
       for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
-        XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, AllocSize, CurrentSize, Skip - 1);
+        if (!XmlNodeExportSize (Node->Children->NodeList[Index], Size, Skip - 1)) {
+          return FALSE;
+        }
       }
     }
 
-    return;
+    return TRUE;
   }
 
-  NameLength = (UINT32)AsciiStrLen (Node->Name);
-
-  XmlBufferAppend (Buffer, AllocSize, CurrentSize, "<", L_STR_LEN ("<"));
-  XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Name, NameLength);
+  NameLength = (UINT32) AsciiStrLen (Node->Name);
 
-  if (Node->Attributes != NULL) {
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, " ", L_STR_LEN (" "));
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Attributes, (UINT32)AsciiStrLen (Node->Attributes));
+  //
+  // <Name Attributes>Content</Name> or <Name Attributes/>.
+  //
+  if (Node->Children != NULL || Node->Content != NULL || Node->LazyEnd != 0) {
+    NodeSize = L_STR_LEN ("<") + NameLength + L_STR_LEN (">")
+      + L_STR_LEN ("</") + NameLength + L_STR_LEN (">");
+  } else {
+    NodeSize = L_STR_LEN ("<") + NameLength + L_STR_LEN ("/>");
   }
 
-  if (Node->Children != NULL || Node->Content != NULL) {
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, ">", L_STR_LEN (">"));
+  if (OcOverflowAddU32 (*Size, NodeSize, Size)) {
+    return FALSE;
+  }
 
-    if (Node->Children != NULL) {
-      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
-        XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, AllocSize, CurrentSize, 0);
-      }
-    } else {
-      XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Content, (UINT32)AsciiStrLen (Node->Content));
-    }
+  if (Node->Attributes != NULL
+    && OcOverflowTriAddU32 (*Size, L_STR_LEN (" "), (UINT32) AsciiStrLen (Node->Attributes), Size)) {
+    return FALSE;
+  }
 
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, "</", L_STR_LEN ("</"));
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, Node->Name, NameLength);
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, ">", L_STR_LEN (">"));
-  } else {
-    XmlBufferAppend (Buffer, AllocSize, CurrentSize, "/>", L_STR_LEN ("/>"));
+  if (Node->LazyEnd != 0) {
+    return XmlNodeExportLazy (Node, NULL, Size);
   }
-}
+
+  if (Node->Children != NULL) {
+    for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
+      if (!XmlNodeExportSize (Node->Children->NodeList[Index], Size, 0)) {
+        return FALSE;
+      }
+    }
+  } else if (Node->Content != NULL
+    && OcOverflowAddU32 (*Size, (UINT32) AsciiStrLen (Node->Content), Size)) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+//
+// Prints to buffer previously sized by XmlNodeExportSize.
+//
+STATIC
+VOID
+XmlBufferAppend (
+  CHAR8        *Buffer,
+  UINT32       *CurrentSize,
+  CONST CHAR8  *Data,
+  UINT32       DataLength
+  )
+{
+  CopyMem (&Buffer[*CurrentSize], Data, DataLength);
+  *CurrentSize += DataLength;
+}
+
+//
+// Prints node to buffer previously sized by XmlNodeExportSize.
+//
+STATIC
+VOID
+XmlNodeExportRecursive (
+  XML_NODE  *Node,
+  CHAR8     *Buffer,
+  UINT32    *CurrentSize,
+  UINT32    Skip
+  )
+{
+  UINT32  Index;
+  UINT32  NameLength;
+
+  if (Skip != 0) {
+    if (Node->Children != NULL) {
+      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
+        XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, CurrentSize, Skip - 1);
+      }
+    }
+
+    return;
+  }
+
+  NameLength = (UINT32)AsciiStrLen (Node->Name);
+
+  XmlBufferAppend (Buffer, CurrentSize, "<", L_STR_LEN ("<"));
+  XmlBufferAppend (Buffer, CurrentSize, Node->Name, NameLength);
+
+  if (Node->Attributes != NULL) {
+    XmlBufferAppend (Buffer, CurrentSize, " ", L_STR_LEN (" "));
+    XmlBufferAppend (Buffer, CurrentSize, Node->Attributes, (UINT32)AsciiStrLen (Node->Attributes));
+  }
+
+  if (Node->Children != NULL || Node->Content != NULL || Node->LazyEnd != 0) {
+    XmlBufferAppend (Buffer, CurrentSize, ">", L_STR_LEN (">"));
+
+    if (Node->LazyEnd != 0) {
+      XmlNodeExportLazy (Node, Buffer, CurrentSize);
+    } else if (Node->Children != NULL) {
+      for (Index = 0; Index < Node->Children->NodeCount; ++Index) {
+        XmlNodeExportRecursive (Node->Children->NodeList[Index], Buffer, CurrentSize, 0);
+      }
+    } else {
+      XmlBufferAppend (Buffer, CurrentSize, Node->Content, (UINT32)AsciiStrLen (Node->Content));
+    }
+
+    XmlBufferAppend (Buffer, CurrentSize, "</", L_STR_LEN ("</"));
+    XmlBufferAppend (Buffer, CurrentSize, Node->Name, NameLength);
+    XmlBufferAppend (Buffer, CurrentSize, ">", L_STR_LEN (">"));
+  } else {
+    XmlBufferAppend (Buffer, CurrentSize, "/>", L_STR_LEN ("/>"));
+  }
+}
+
+STATIC
+XML_NODE *
+XmlParseNode (
+  XML_PARSER  *Parser,
+  XML_REFLIST *References
+  );
+
+//
+// Reserves a range starting at Start, the rest is filled when known.
+// Ranges must be pushed in ascending order.
+//
+STATIC
+BOOLEAN
+XmlRangePush (
+  XML_ARENA       *Arena,
+  XML_RANGE_LIST  *List,
+  UINT32          Start,
+  UINT32          *Index
+  )
+{
+  XML_RANGE  *NewRanges;
+  UINT32     NewAllocCount;
+  UINT32     NewSize;
+
+  ASSERT (List->Count == 0 || List->Ranges[List->Count - 1].Start < Start);
+
+  if (List->Count == List->AllocCount) {
+    if (List->AllocCount == 0) {
+      NewAllocCount = 64;
+    } else if (OcOverflowMulU32 (List->AllocCount, 2, &NewAllocCount)) {
+      return FALSE;
+    }
+
+    if (OcOverflowMulU32 (NewAllocCount, sizeof (XML_RANGE), &NewSize)) {
+      return FALSE;
+    }
+
+    NewRanges = XmlArenaAllocate (Arena, NewSize);
+    if (NewRanges == NULL) {
+      return FALSE;
+    }
+
+    if (List->Ranges != NULL) {
+      CopyMem (NewRanges, List->Ranges, List->Count * sizeof (XML_RANGE));
+    }
+
+    List->Ranges     = NewRanges;
+    List->AllocCount = NewAllocCount;
+  }
+
+  List->Ranges[List->Count].Start = Start;
+  List->Ranges[List->Count].End   = 0;
+  List->Ranges[List->Count].Node  = NULL;
+  *Index = List->Count++;
+
+  return TRUE;
+}
+
+//
+// Returns the node parsed while skipping at the current position and moves
+// past it, or NULL.
+//
+STATIC
+XML_NODE *
+XmlParsedNode (
+  XML_PARSER  *Parser
+  )
+{
+  XML_RANGE_LIST  *Parsed;
+  XML_RANGE       *Range;
+  UINT32          Index;
+
+  Parsed = &Parser->Document->Parsed;
+  Index  = XmlRangeLowerBound (Parsed, Parser->Position);
+
+  if (Index < Parsed->Count) {
+    Range = &Parsed->Ranges[Index];
+    if (Range->Start == Parser->Position && Range->Node != NULL) {
+      Parser->Position = Range->End;
+      return Range->Node;
+    }
+  }
+
+  return NULL;
+}
+
+//
+// Checks for ID attribute the same way XmlParseAttributeNumber does.
+//
+STATIC
+BOOLEAN
+XmlHasIdAttribute (
+  CONST CHAR8  *Attributes,
+  UINT32       Length
+  )
+{
+  UINT32  Index;
+
+  for (Index = 0; Index + L_STR_LEN ("ID=\"") <= Length; ++Index) {
+    if (CompareMem (&Attributes[Index], "ID=\"", L_STR_LEN ("ID=\"")) == 0) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+//
+// Skips node children without modifying the buffer and stops at the closing
+// tag of the node. Tag nesting is validated, contents are not.
+// Children ranges of all nested nodes are remembered, so that the buffer is
+// only scanned once. Nodes with an ID attribute are parsed right away to make
+// references known before any lazy node is accessed.
+//
+STATIC
+BOOLEAN
+XmlSkipChildren (
+  XML_PARSER   *Parser,
+  XML_REFLIST  *References
+  )
+{
+  XML_DOCUMENT     *Document;
+  XML_RANGE_LIST   *Parsed;
+  XML_RANGE_LIST   *Skipped;
+  XML_NODE         *Node;
+  CONST CHAR8      *Buffer;
+  CONST CHAR8      *Next;
+  UINT32           Position;
+  UINT32           TagStart;
+  UINT32           NameStart;
+  UINT32           NameLength;
+  UINT32           AttributesStart;
+  UINT32           Depth;
+  UINT32           Index;
+  UINT32           Cursor;
+  BOOLEAN          Closing;
+  BOOLEAN          SelfClosing;
+  UINT32           Names[XML_PARSER_NEST_LEVEL];
+  UINT32           NameLengths[XML_PARSER_NEST_LEVEL];
+  UINT32           Ranges[XML_PARSER_NEST_LEVEL];
+
+  Document = Parser->Document;
+  Parsed   = &Document->Parsed;
+  Skipped  = &Document->Skipped;
+  Buffer   = Parser->Buffer;
+  Position = Parser->Position;
+
+  //
+  // Children were already skipped as part of the parent.
+  //
+  Index = XmlRangeLowerBound (Skipped, Position);
+  if (Index < Skipped->Count && Skipped->Ranges[Index].Start == Position) {
+    ASSERT (Skipped->Ranges[Index].End != 0);
+    Parser->Position = Skipped->Ranges[Index].End;
+    return TRUE;
+  }
+
+  Depth  = 0;
+  Cursor = XmlRangeLowerBound (Parsed, Position);
+
+  while (TRUE) {
+    Next = ScanMem8 (&Buffer[Position], Parser->Length - Position, '<');
+    if (Next == NULL || Parser->Length - (UINT32) (Next - Buffer) < 2) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::unexpected end");
+      return FALSE;
+    }
+
+    TagStart = (UINT32) (Next - Buffer);
+    Position = TagStart + 1;
+
+    //
+    // Skip the control sequence.
+    //
+    if (Buffer[Position] == '?' || Buffer[Position] == '!') {
+      Next = ScanMem8 (&Buffer[Position], Parser->Length - Position, '>');
+      if (Next == NULL) {
+        XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::unterminated control");
+        return FALSE;
+      }
+
+      Position = (UINT32) (Next - Buffer) + 1;
+      continue;
+    }
+
+    Closing = Buffer[Position] == '/';
+    if (Closing) {
+      ++Position;
+    } else {
+      //
+      // Jump over the node parsed earlier, its contents are no longer valid.
+      //
+      while (Cursor < Parsed->Count && Parsed->Ranges[Cursor].Start < TagStart) {
+        ++Cursor;
+      }
+
+      if (Cursor < Parsed->Count && Parsed->Ranges[Cursor].Start == TagStart) {
+        Position = Parsed->Ranges[Cursor].End;
+        ++Cursor;
+        continue;
+      }
+    }
+
+    NameStart = Position;
+    while (Position < Parser->Length && Buffer[Position] != '>'
+      && Buffer[Position] != '/' && !IsAsciiSpace (Buffer[Position])) {
+      ++Position;
+    }
+
+    NameLength      = Position - NameStart;
+    AttributesStart = Position;
+    while (Position < Parser->Length && Buffer[Position] != '>' && Buffer[Position] != '/') {
+      ++Position;
+    }
+
+    if (NameLength == 0 || Position == Parser->Length) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::invalid tag");
+      return FALSE;
+    }
+
+    SelfClosing = Buffer[Position] == '/';
+    if (SelfClosing) {
+      ++Position;
+      if (Position == Parser->Length || Buffer[Position] != '>' || Closing) {
+        XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::invalid self closing tag");
+        return FALSE;
+      }
+    }
+
+    ++Position;
+
+    if (Closing) {
+      //
+      // Closing tag of the node itself is left to the caller.
+      //
+      if (Depth == 0) {
+        Parser->Position = TagStart;
+        return TRUE;
+      }
+
+      --Depth;
+      if (NameLengths[Depth] != NameLength
+        || CompareMem (&Buffer[Names[Depth]], &Buffer[NameStart], NameLength) != 0) {
+        XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::tag missmatch");
+        return FALSE;
+      }
+
+      if (Ranges[Depth] != MAX_UINT32) {
+        Skipped->Ranges[Ranges[Depth]].End = TagStart;
+      }
+
+      continue;
+    }
+
+    //
+    // Any opening tag means that its parent has children.
+    //
+    if (Parser->Level + Depth > XML_PARSER_NEST_LEVEL) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::level overflow");
+      return FALSE;
+    }
+
+    if (SelfClosing) {
+      continue;
+    }
+
+    if (References != NULL
+      && XmlHasIdAttribute (&Buffer[AttributesStart], Position - 1 - AttributesStart)) {
+      if (!XmlRangePush (&Document->Arena, Parsed, TagStart, &Index)) {
+        XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::parsed push fail");
+        return FALSE;
+      }
+
+      Parser->Position = TagStart;
+      Parser->Level   += Depth;
+      Node = XmlParseNode (Parser, References);
+      Parser->Level   -= Depth;
+
+      if (Node == NULL) {
+        return FALSE;
+      }
+
+      Parsed->Ranges[Index].End  = Parser->Position;
+      Parsed->Ranges[Index].Node = Node;
+      Position = Parser->Position;
+      Cursor   = Index + 1;
+      continue;
+    }
+
+    if (Depth == ARRAY_SIZE (Names)) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::level overflow");
+      return FALSE;
+    }
+
+    //
+    // Remember where children start the same way XmlParseNode does.
+    //
+    Names[Depth]       = NameStart;
+    NameLengths[Depth] = NameLength;
+    Ranges[Depth]      = MAX_UINT32;
+
+    while (Position < Parser->Length && IsAsciiSpace (Buffer[Position])) {
+      ++Position;
+    }
+
+    if (Parser->Length - Position >= 2 && Buffer[Position] == '<' && Buffer[Position + 1] != '/'
+      && !XmlRangePush (&Document->Arena, Skipped, Position, &Ranges[Depth])) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlSkipChildren::skipped push fail");
+      return FALSE;
+    }
+
+    ++Depth;
+  }
+}
+
+//
+// Parses child nodes till the closing tag of the parent.
+//
+STATIC
+BOOLEAN
+XmlParseChildren (
+  XML_PARSER   *Parser,
+  XML_REFLIST  *References,
+  XML_NODE     *Node,
+  BOOLEAN      *Unprefixed
+  )
+{
+  XML_NODE  *Child;
+
+  while ('/' != XmlParserPeek (Parser, NEXT_CHARACTER)) {
+
+    //
+    // Parse child node.
+    //
+    Child = XmlParseNode (Parser, References);
+    if (Child == NULL) {
+      if ('/' == XmlParserPeek (Parser, CURRENT_CHARACTER)) {
+        XML_PARSER_INFO (Parser, "child_end");
+        *Unprefixed = TRUE;
+        break;
+      }
+
+      XML_PARSER_ERROR (Parser, NEXT_CHARACTER, "XmlParseNode::child");
+      return FALSE;
+    }
+
+    if (!XmlNodeChildPush (Node, Child)) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::node push fail");
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
 
 //
 // Parses an XML fragment node.
@@ -937,12 +1656,10 @@ XmlParseNode (
   CONST CHAR8  *TagClose;
   CONST CHAR8  *Attributes;
   XML_NODE     *Node;
-  XML_NODE     *Child;
   UINT32       ReferenceNumber;
   BOOLEAN      IsReference;
   BOOLEAN      SelfClosing;
   BOOLEAN      Unprefixed;
-  BOOLEAN      HasChildren;
 
   XML_PARSER_INFO (Parser, "node");
 
@@ -951,6 +1668,18 @@ XmlParseNode (
   Unprefixed  = FALSE;
   IsReference = FALSE;
 
+  //
+  // Nodes parsed while skipping lazy node children are reused.
+  //
+  if (Parser->Document->Parsed.Count > 0) {
+    XmlSkipControl (Parser);
+
+    Node = XmlParsedNode (Parser);
+    if (Node != NULL) {
+      return Node;
+    }
+  }
+
   //
   // Parse open tag.
   //
@@ -964,7 +1693,14 @@ XmlParseNode (
 
   XmlSkipWhitespace (Parser);
 
-  Node = XmlNodeCreate (TagOpen, Attributes, NULL, XmlNodeReal (References, Attributes), NULL);
+  Node = XmlNodeCreate (
+    Parser->Document,
+    TagOpen,
+    Attributes,
+    NULL,
+    XmlNodeReal (References, Attributes),
+    NULL
+    );
   if (Node == NULL) {
     XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::node alloc fail");
     return NULL;
@@ -985,7 +1721,6 @@ XmlParseNode (
 
     if (Node->Content == NULL) {
       XML_PARSER_ERROR (Parser, 0, "XmlParseNode::content");
-      XmlNodeFree (Node);
       return NULL;
     }
 
@@ -1001,100 +1736,688 @@ XmlParseNode (
         );
     }
 
-    Unprefixed = TRUE;
+    Unprefixed = TRUE;
+
+  //
+  // Otherwise children are to be expected.
+  //
+  } else {
+    Parser->Level++;
+
+    if (Parser->Level > XML_PARSER_NEST_LEVEL) {
+      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::level overflow");
+      return NULL;
+    }
+
+    if (Parser->Document->Lazy && '/' != XmlParserPeek (Parser, NEXT_CHARACTER)) {
+      //
+      // Remember where children are and parse them on first access.
+      //
+      Node->LazyStart = Parser->Position;
+      if (!XmlSkipChildren (Parser, References)) {
+        XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::skip children");
+        return NULL;
+      }
+      Node->LazyEnd = Parser->Position;
+    } else if (!XmlParseChildren (Parser, References, Node, &Unprefixed)) {
+      return NULL;
+    }
+
+    Parser->Level--;
+
+    if (Node->Children == NULL && Node->LazyEnd == 0 && References != NULL && Attributes != NULL) {
+      IsReference = XmlParseAttributeNumber (
+        Node->Attributes,
+        "ID=\"",
+        L_STR_LEN ("ID=\""),
+        &ReferenceNumber
+        );
+    }
+  }
+
+  //
+  // Parse close tag.
+  //
+  TagClose = XmlParseTagClose (Parser, Unprefixed);
+  if (TagClose == NULL) {
+    XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::tag close");
+    return NULL;
+  }
+
+  //
+  // Close tag has to match open tag.
+  //
+  if (AsciiStrCmp (TagOpen, TagClose) != 0) {
+    XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::tag missmatch");
+    return NULL;
+  }
+
+  if (IsReference && !XmlPushReference (&Parser->Document->Arena, References, Node, ReferenceNumber)) {
+    XML_PARSER_ERROR (Parser, 0, "XmlParseNode::reference");
+    return NULL;
+  }
+
+  return Node;
+}
+
+//
+// Reads big endian unsigned integer of 1 to 8 bytes.
+//
+STATIC
+UINT64
+XmlBplistReadUint (
+  CONST UINT8  *Data,
+  UINT32       Size
+  )
+{
+  UINT64  Value;
+
+  Value = 0;
+  while (Size > 0) {
+    Value = LShiftU64 (Value, 8) | *Data;
+    ++Data;
+    --Size;
+  }
+
+  return Value;
+}
+
+//
+// Locates binary plist object and validates that it fits before the offset table.
+// Count is the element count for data, strings, arrays, and dictionaries,
+// and the low marker nibble for other objects.
+//
+STATIC
+BOOLEAN
+XmlBplistObject (
+  XML_DOCUMENT  *Document,
+  UINT32        Index,
+  UINT8         *Marker,
+  UINT32        *Count,
+  UINT32        *DataOffset
+  )
+{
+  CONST UINT8  *Buffer;
+  UINT64       Offset;
+  UINT64       Size;
+  UINT32       IntSize;
+  UINT8        Type;
+
+  if (Index >= Document->ObjectCount) {
+    return FALSE;
+  }
+
+  Buffer = (CONST UINT8 *) Document->Buffer.Buffer;
+  Offset = XmlBplistReadUint (
+    &Buffer[Document->OffsetTable + Index * Document->OffsetSize],
+    Document->OffsetSize
+    );
+
+  if (Offset < L_STR_LEN (XML_BPLIST_SIGNATURE) || Offset >= Document->OffsetTable) {
+    return FALSE;
+  }
+
+  *Marker = Buffer[Offset];
+  *Count  = *Marker & 0x0FU;
+  Type    = *Marker & 0xF0U;
+  ++Offset;
+
+  if (*Count == XML_BPLIST_COUNT_INTEGER
+    && (Type == XML_BPLIST_TYPE_DATA || Type == XML_BPLIST_TYPE_ASCII || Type == XML_BPLIST_TYPE_UNICODE
+      || Type == XML_BPLIST_TYPE_ARRAY || Type == XML_BPLIST_TYPE_DICT)) {
+    if (Offset >= Document->OffsetTable
+      || (Buffer[Offset] & 0xF0U) != XML_BPLIST_TYPE_INTEGER
+      || (Buffer[Offset] & 0x0FU) > 3) {
+      return FALSE;
+    }
+
+    IntSize = 1U << (Buffer[Offset] & 0x0FU);
+    ++Offset;
+    if (IntSize > Document->OffsetTable - Offset) {
+      return FALSE;
+    }
+
+    Size = XmlBplistReadUint (&Buffer[Offset], IntSize);
+    if (Size > Document->OffsetTable) {
+      return FALSE;
+    }
+
+    *Count  = (UINT32) Size;
+    Offset += IntSize;
+  }
+
+  switch (Type) {
+    case XML_BPLIST_TYPE_SIMPLE:
+      if (*Marker != XML_BPLIST_MARKER_FALSE && *Marker != XML_BPLIST_MARKER_TRUE) {
+        return FALSE;
+      }
+      Size = 0;
+      break;
+    case XML_BPLIST_TYPE_INTEGER:
+      if (*Count > 4) {
+        return FALSE;
+      }
+      Size = 1U << *Count;
+      break;
+    case XML_BPLIST_TYPE_REAL:
+      if (*Count != 2 && *Count != 3) {
+        return FALSE;
+      }
+      Size = 1U << *Count;
+      break;
+    case XML_BPLIST_TYPE_DATE:
+      if (*Marker != XML_BPLIST_MARKER_DATE) {
+        return FALSE;
+      }
+      Size = sizeof (UINT64);
+      break;
+    case XML_BPLIST_TYPE_DATA:
+    case XML_BPLIST_TYPE_ASCII:
+      Size = *Count;
+      break;
+    case XML_BPLIST_TYPE_UNICODE:
+      Size = (UINT64) *Count * sizeof (CHAR16);
+      break;
+    case XML_BPLIST_TYPE_ARRAY:
+      Size = (UINT64) *Count * Document->RefSize;
+      break;
+    case XML_BPLIST_TYPE_DICT:
+      Size = (UINT64) *Count * Document->RefSize * 2;
+      break;
+    default:
+      return FALSE;
+  }
+
+  if (Size > Document->OffsetTable - Offset) {
+    return FALSE;
+  }
+
+  *DataOffset = (UINT32) Offset;
+  return TRUE;
+}
+
+//
+// Creates node for binary plist object. Arrays and dictionaries may only be
+// referenced once, which rules out cycles, and are limited in nesting.
+//
+STATIC
+XML_NODE *
+XmlBplistNodeCreate (
+  XML_DOCUMENT  *Document,
+  UINT32        Index,
+  BOOLEAN       Key,
+  UINT8         Level
+  )
+{
+  XML_NODE     *Node;
+  CONST CHAR8  *Name;
+  UINT8        Marker;
+  UINT8        Type;
+  UINT32       Count;
+  UINT32       DataOffset;
+
+  if (!XmlBplistObject (Document, Index, &Marker, &Count, &DataOffset)) {
+    XML_USAGE_ERROR ("XmlBplistNodeCreate::invalid object");
+    return NULL;
+  }
+
+  Type = Marker & 0xF0U;
+
+  if (Key && Type != XML_BPLIST_TYPE_ASCII && Type != XML_BPLIST_TYPE_UNICODE) {
+    XML_USAGE_ERROR ("XmlBplistNodeCreate::key is not a string");
+    return NULL;
+  }
+
+  switch (Type) {
+    case XML_BPLIST_TYPE_SIMPLE:
+      Name = PlistNodeTypes[Marker == XML_BPLIST_MARKER_TRUE ? PLIST_NODE_TYPE_TRUE : PLIST_NODE_TYPE_FALSE];
+      break;
+    case XML_BPLIST_TYPE_INTEGER:
+      Name = PlistNodeTypes[PLIST_NODE_TYPE_INTEGER];
+      break;
+    case XML_BPLIST_TYPE_REAL:
+      Name = PlistNodeTypes[PLIST_NODE_TYPE_REAL];
+      break;
+    case XML_BPLIST_TYPE_DATE:
+      Name = PlistNodeTypes[PLIST_NODE_TYPE_DATE];
+      break;
+    case XML_BPLIST_TYPE_DATA:
+      Name = PlistNodeTypes[PLIST_NODE_TYPE_DATA];
+      break;
+    case XML_BPLIST_TYPE_ASCII:
+    case XML_BPLIST_TYPE_UNICODE:
+      Name = PlistNodeTypes[Key ? PLIST_NODE_TYPE_KEY : PLIST_NODE_TYPE_STRING];
+      break;
+    default:
+      Name = PlistNodeTypes[Type == XML_BPLIST_TYPE_ARRAY ? PLIST_NODE_TYPE_ARRAY : PLIST_NODE_TYPE_DICT];
+      if (Document->Levels[Index] != 0 || Level >= XML_PARSER_NEST_LEVEL) {
+        XML_USAGE_ERROR ("XmlBplistNodeCreate::container is shared or nested too deep");
+        return NULL;
+      }
+      Document->Levels[Index] = Level;
+      break;
+  }
+
+  Node = XmlNodeCreate (Document, Name, NULL, NULL, NULL, NULL);
+  if (Node == NULL) {
+    return NULL;
+  }
+
+  Node->LazyStart = Index;
+  if (Type == XML_BPLIST_TYPE_ARRAY || Type == XML_BPLIST_TYPE_DICT) {
+    Node->LazyEnd = 1;
+  }
+
+  return Node;
+}
+
+//
+// Creates binary plist array or dictionary children on first access.
+// Dictionary keys and values are interleaved like in XML plists.
+//
+STATIC
+BOOLEAN
+XmlBplistParseChildren (
+  XML_NODE  *Node
+  )
+{
+  XML_DOCUMENT   *Document;
+  XML_NODE_LIST  *Children;
+  CONST UINT8    *Refs;
+  UINT64         Ref;
+  UINT32         Index;
+  UINT32         Count;
+  UINT32         DataOffset;
+  UINT32         NodeCount;
+  UINT32         Child;
+  UINT32         RefIndex;
+  UINT8          Marker;
+  BOOLEAN        Dict;
+
+  Document      = Node->Document;
+  Index         = Node->LazyStart;
+  Node->LazyEnd = 0;
+
+  if (!XmlBplistObject (Document, Index, &Marker, &Count, &DataOffset)) {
+    return FALSE;
+  }
+
+  Dict      = (Marker & 0xF0U) == XML_BPLIST_TYPE_DICT;
+  NodeCount = Dict ? Count * 2 : Count;
+
+  if (NodeCount == 0) {
+    return TRUE;
+  }
+
+  if (NodeCount > XML_PARSER_NODE_COUNT) {
+    XML_USAGE_ERROR ("XmlBplistParseChildren::too many children");
+    return FALSE;
+  }
+
+  Children = XmlArenaAllocate (
+    &Document->Arena,
+    sizeof (XML_NODE_LIST) + sizeof (Children->NodeList[0]) * NodeCount
+    );
+  if (Children == NULL) {
+    return FALSE;
+  }
+
+  Children->NodeCount  = NodeCount;
+  Children->AllocCount = NodeCount;
+  Children->KeyIndex   = NULL;
+
+  Refs = (CONST UINT8 *) &Document->Buffer.Buffer[DataOffset];
+
+  for (Child = 0; Child < NodeCount; ++Child) {
+    if (Dict) {
+      RefIndex = Child / 2 + (Child % 2 == 0 ? 0 : Count);
+    } else {
+      RefIndex = Child;
+    }
+
+    Ref = XmlBplistReadUint (&Refs[RefIndex * Document->RefSize], Document->RefSize);
+    if (Ref >= Document->ObjectCount) {
+      XML_USAGE_ERROR ("XmlBplistParseChildren::invalid object reference");
+      return FALSE;
+    }
+
+    Children->NodeList[Child] = XmlBplistNodeCreate (
+      Document,
+      (UINT32) Ref,
+      Dict && Child % 2 == 0,
+      (UINT8) (Document->Levels[Index] + 1)
+      );
+    if (Children->NodeList[Child] == NULL) {
+      return FALSE;
+    }
+  }
+
+  Node->Children = Children;
+  return TRUE;
+}
+
+//
+// Obtains binary plist integer value, 128-bit integers are truncated.
+//
+STATIC
+BOOLEAN
+XmlBplistInteger (
+  XML_NODE  *Node,
+  UINT64    *Value
+  )
+{
+  UINT8   Marker;
+  UINT32  Count;
+  UINT32  DataOffset;
+  UINT32  Size;
+
+  if (!Node->Document->Binary
+    || !XmlBplistObject (Node->Document, Node->LazyStart, &Marker, &Count, &DataOffset)
+    || (Marker & 0xF0U) != XML_BPLIST_TYPE_INTEGER) {
+    return FALSE;
+  }
+
+  Size = 1U << Count;
+  if (Size > sizeof (UINT64)) {
+    DataOffset += Size - sizeof (UINT64);
+    Size        = sizeof (UINT64);
+  }
+
+  *Value = XmlBplistReadUint ((CONST UINT8 *) &Node->Document->Buffer.Buffer[DataOffset], Size);
+  return TRUE;
+}
+
+//
+// Obtains binary plist data contents in place.
+//
+STATIC
+BOOLEAN
+XmlBplistData (
+  XML_NODE     *Node,
+  CONST UINT8  **Data,
+  UINT32       *Size
+  )
+{
+  UINT8   Marker;
+  UINT32  Count;
+  UINT32  DataOffset;
+
+  if (!Node->Document->Binary
+    || !XmlBplistObject (Node->Document, Node->LazyStart, &Marker, &Count, &DataOffset)
+    || (Marker & 0xF0U) != XML_BPLIST_TYPE_DATA) {
+    return FALSE;
+  }
+
+  *Data = (CONST UINT8 *) &Node->Document->Buffer.Buffer[DataOffset];
+  *Size = Count;
+  return TRUE;
+}
+
+//
+// Converts binary plist string or integer to text content on first access.
+// Strings are converted from UTF-16 to UTF-8, integers are decimal.
+//
+STATIC
+CONST CHAR8 *
+XmlBplistNodeContent (
+  XML_NODE  *Node
+  )
+{
+  XML_DOCUMENT  *Document;
+  CONST UINT8   *Data;
+  CHAR8         *Content;
+  CHAR8         Digits[21];
+  UINT64        Value;
+  UINT32        CodePoint;
+  UINT32        Surrogate;
+  UINT32        Count;
+  UINT32        DataOffset;
+  UINT32        Index;
+  UINT32        Length;
+  UINT8         Marker;
+  BOOLEAN       Negative;
+
+  Document = Node->Document;
+
+  if (!XmlBplistObject (Document, Node->LazyStart, &Marker, &Count, &DataOffset)) {
+    return NULL;
+  }
+
+  Data = (CONST UINT8 *) &Document->Buffer.Buffer[DataOffset];
+
+  switch (Marker & 0xF0U) {
+    case XML_BPLIST_TYPE_ASCII:
+      //
+      // Empty strings have no content like in XML plists.
+      //
+      if (Count == 0) {
+        return NULL;
+      }
+
+      Content = XmlArenaAllocate (&Document->Arena, Count + 1);
+      if (Content == NULL) {
+        return NULL;
+      }
+      CopyMem (Content, Data, Count);
+      Content[Count] = '\0';
+      break;
+
+    case XML_BPLIST_TYPE_UNICODE:
+      if (Count == 0) {
+        return NULL;
+      }
+
+      //
+      // Each UTF-16 code unit takes at most 3 bytes in UTF-8.
+      //
+      if (OcOverflowMulAddU32 (Count, 3, 1, &Length)) {
+        return NULL;
+      }
+
+      Content = XmlArenaAllocate (&Document->Arena, Length);
+      if (Content == NULL) {
+        return NULL;
+      }
+
+      Length = 0;
+      for (Index = 0; Index < Count; ++Index) {
+        CodePoint = (UINT32) XmlBplistReadUint (&Data[Index * 2], 2);
+        if (CodePoint >= 0xD800U && CodePoint < 0xE000U) {
+          Surrogate = 0;
+          if (CodePoint < 0xDC00U && Index + 1 < Count) {
+            Surrogate = (UINT32) XmlBplistReadUint (&Data[(Index + 1) * 2], 2);
+          }
+
+          if (Surrogate >= 0xDC00U && Surrogate < 0xE000U) {
+            CodePoint = 0x10000U + ((CodePoint - 0xD800U) << 10U) + (Surrogate - 0xDC00U);
+            ++Index;
+          } else {
+            //
+            // Unpaired surrogates cannot be encoded in UTF-8, replace them with U+FFFD.
+            //
+            CodePoint = 0xFFFDU;
+          }
+        }
+
+        if (CodePoint < 0x80U) {
+          Content[Length++] = (CHAR8) CodePoint;
+        } else if (CodePoint < 0x800U) {
+          Content[Length++] = (CHAR8) (0xC0U | (CodePoint >> 6U));
+          Content[Length++] = (CHAR8) (0x80U | (CodePoint & 0x3FU));
+        } else if (CodePoint < 0x10000U) {
+          Content[Length++] = (CHAR8) (0xE0U | (CodePoint >> 12U));
+          Content[Length++] = (CHAR8) (0x80U | ((CodePoint >> 6U) & 0x3FU));
+          Content[Length++] = (CHAR8) (0x80U | (CodePoint & 0x3FU));
+        } else {
+          Content[Length++] = (CHAR8) (0xF0U | (CodePoint >> 18U));
+          Content[Length++] = (CHAR8) (0x80U | ((CodePoint >> 12U) & 0x3FU));
+          Content[Length++] = (CHAR8) (0x80U | ((CodePoint >> 6U) & 0x3FU));
+          Content[Length++] = (CHAR8) (0x80U | (CodePoint & 0x3FU));
+        }
+      }
+      Content[Length] = '\0';
+      break;
+
+    case XML_BPLIST_TYPE_INTEGER:
+      if (!XmlBplistInteger (Node, &Value)) {
+        return NULL;
+      }
+
+      //
+      // Only 64-bit integers are signed.
+      //
+      Negative = Count == 3 && (INT64) Value < 0;
+      if (Negative) {
+        Value = 0 - Value;
+      }
+
+      Length = ARRAY_SIZE (Digits);
+      do {
+        Digits[--Length] = (CHAR8) ('0' + (UINT32) ModU64x32 (Value, 10));
+        Value = DivU64x32 (Value, 10);
+      } while (Value != 0);
+
+      if (Negative) {
+        Digits[--Length] = '-';
+      }
+
+      Content = XmlArenaAllocate (&Document->Arena, ARRAY_SIZE (Digits) - Length + 1);
+      if (Content == NULL) {
+        return NULL;
+      }
+      CopyMem (Content, &Digits[Length], ARRAY_SIZE (Digits) - Length);
+      Content[ARRAY_SIZE (Digits) - Length] = '\0';
+      break;
+
+    default:
+      return NULL;
+  }
+
+  Node->Content = Content;
+  return Content;
+}
+
+//
+// Parses binary plist trailer and creates the top object node.
+//
+STATIC
+BOOLEAN
+XmlBplistParse (
+  XML_DOCUMENT  *Document
+  )
+{
+  CONST UINT8  *Trailer;
+  UINT32       Length;
+  UINT64       ObjectCount;
+  UINT64       TopObject;
+  UINT64       OffsetTable;
+
+  Length = Document->Buffer.Length;
+  if (Length <= L_STR_LEN (XML_BPLIST_SIGNATURE) + XML_BPLIST_TRAILER_SIZE) {
+    XML_USAGE_ERROR ("XmlBplistParse::buffer is too small");
+    return FALSE;
+  }
+
+  Length -= XML_BPLIST_TRAILER_SIZE;
 
   //
-  // Otherwise children are to be expected.
+  // Trailer: 6 unused bytes, offset size, reference size, and 64-bit
+  // object count, top object index, and offset table offset.
   //
-  } else {
-    Parser->Level++;
-
-    if (Parser->Level > XML_PARSER_NEST_LEVEL) {
-      XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::level overflow");
-      XmlNodeFree (Node);
-      return NULL;
-    }
+  Trailer     = (CONST UINT8 *) &Document->Buffer.Buffer[Length];
+  ObjectCount = XmlBplistReadUint (&Trailer[8], sizeof (UINT64));
+  TopObject   = XmlBplistReadUint (&Trailer[16], sizeof (UINT64));
+  OffsetTable = XmlBplistReadUint (&Trailer[24], sizeof (UINT64));
+
+  Document->OffsetSize = Trailer[6];
+  Document->RefSize    = Trailer[7];
+
+  if (Document->OffsetSize == 0 || Document->OffsetSize > sizeof (UINT64)
+    || Document->RefSize == 0 || Document->RefSize > sizeof (UINT64)
+    || OffsetTable <= L_STR_LEN (XML_BPLIST_SIGNATURE) || OffsetTable > Length
+    || ObjectCount == 0 || ObjectCount > (Length - OffsetTable) / Document->OffsetSize
+    || TopObject >= ObjectCount) {
+    XML_USAGE_ERROR ("XmlBplistParse::invalid trailer");
+    return FALSE;
+  }
 
-    HasChildren = FALSE;
+  Document->Binary      = TRUE;
+  Document->ObjectCount = (UINT32) ObjectCount;
+  Document->OffsetTable = (UINT32) OffsetTable;
 
-    while ('/' != XmlParserPeek (Parser, NEXT_CHARACTER)) {
+  Document->Levels = XmlArenaAllocate (&Document->Arena, Document->ObjectCount);
+  if (Document->Levels == NULL) {
+    return FALSE;
+  }
 
-      //
-      // Parse child node.
-      //
-      Child = XmlParseNode (Parser, References);
-      if (Child == NULL) {
-        if ('/' == XmlParserPeek (Parser, CURRENT_CHARACTER)) {
-          XML_PARSER_INFO (Parser, "child_end");
-          Unprefixed = TRUE;
-          break;
-        }
+  ZeroMem (Document->Levels, Document->ObjectCount);
 
-        XML_PARSER_ERROR (Parser, NEXT_CHARACTER, "XmlParseNode::child");
-        XmlNodeFree (Node);
-        return NULL;
-      }
+  Document->Root = XmlBplistNodeCreate (Document, (UINT32) TopObject, FALSE, 1);
+  return Document->Root != NULL;
+}
 
-      if (!XmlNodeChildPush (Node, Child)) {
-        XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::node push fail");
-        XmlNodeFree (Node);
-        XmlNodeFree (Child);
-        return NULL;
-      }
+//
+// Parses lazy node children on first access.
+//
+STATIC
+BOOLEAN
+XmlNodeParseLazy (
+  XML_NODE  *Node
+  )
+{
+  XML_DOCUMENT  *Document;
+  XML_PARSER    Parser;
+  BOOLEAN       Unprefixed;
 
-      HasChildren = TRUE;
-    }
+  if (Node->LazyEnd == 0) {
+    return TRUE;
+  }
 
-    Parser->Level--;
+  Document = Node->Document;
 
-    if (!HasChildren && References != NULL && Attributes != NULL) {
-      IsReference = XmlParseAttributeNumber (
-        Node->Attributes,
-        "ID=\"",
-        L_STR_LEN ("ID=\""),
-        &ReferenceNumber
-        );
+  if (Document->Binary) {
+    if (!XmlBplistParseChildren (Node)) {
+      XML_USAGE_ERROR ("XmlNodeParseLazy::failed to create binary children");
+      Document->LazyFailed = TRUE;
+      return FALSE;
     }
+    return TRUE;
   }
 
-  //
-  // Parse close tag.
-  //
-  TagClose = XmlParseTagClose (Parser, Unprefixed);
-  if (TagClose == NULL) {
-    XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::tag close");
-    XmlNodeFree (Node);
-    return NULL;
-  }
+  ZeroMem (&Parser, sizeof (Parser));
+  Parser.Document = Document;
+  Parser.Buffer   = Document->Buffer.Buffer;
+  Parser.Length   = Document->Buffer.Length;
+  Parser.Position = Node->LazyStart;
+  Parser.Level    = 1;
 
-  //
-  // Close tag has to match open tag.
-  //
-  if (AsciiStrCmp (TagOpen, TagClose) != 0) {
-    XML_PARSER_ERROR (Parser, NO_CHARACTER, "XmlParseNode::tag missmatch");
-    XmlNodeFree (Node);
-    return NULL;
-  }
+  Node->LazyEnd = 0;
+  Unprefixed    = FALSE;
 
-  if (IsReference && !XmlPushReference (References, Node, ReferenceNumber)) {
-    XML_PARSER_ERROR (Parser, 0, "XmlParseNode::reference");
-    XmlNodeFree (Node);
-    return NULL;
+  if (!XmlParseChildren (&Parser, Document->WithRefs ? &Document->References : NULL, Node, &Unprefixed)) {
+    //
+    // Partially parsed children cannot be parsed again, drop them.
+    //
+    XML_USAGE_ERROR ("XmlNodeParseLazy::failed to parse children");
+    Node->Children       = NULL;
+    Document->LazyFailed = TRUE;
+    return FALSE;
   }
 
-  return Node;
+  return TRUE;
 }
 
+STATIC
 XML_DOCUMENT *
-XmlDocumentParse (
+XmlDocumentParseInternal (
   CHAR8    *Buffer,
   UINT32   Length,
-  BOOLEAN  WithRefs
+  BOOLEAN  WithRefs,
+  BOOLEAN  Lazy
   )
 {
   XML_NODE      *Root;
   XML_DOCUMENT  *Document;
-  XML_REFLIST   References;
 
   //
   // Initialize parser.
@@ -1103,7 +2426,6 @@ XmlDocumentParse (
   ZeroMem (&Parser, sizeof (Parser));
   Parser.Buffer = Buffer;
   Parser.Length = Length;
-  ZeroMem (&References, sizeof (References));
 
   //
   // An empty buffer can never contain a valid document.
@@ -1113,33 +2435,129 @@ XmlDocumentParse (
     return NULL;
   }
 
+  //
+  // Nodes are allocated from the document arena, so create it first.
+  //
+  Document = AllocateZeroPool (sizeof (XML_DOCUMENT));
+
+  if (Document == NULL) {
+    XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::document allocation failed");
+    return NULL;
+  }
+
+  Document->Buffer.Buffer = Buffer;
+  Document->Buffer.Length = Length;
+  Document->WithRefs      = WithRefs;
+  Document->Lazy          = Lazy;
+  Parser.Document = Document;
+
+  if (Length >= L_STR_LEN (XML_BPLIST_SIGNATURE)
+    && CompareMem (Buffer, XML_BPLIST_SIGNATURE, L_STR_LEN (XML_BPLIST_SIGNATURE)) == 0) {
+    if (!XmlBplistParse (Document)) {
+      XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::parsing binary plist failed");
+      XmlDocumentFree (Document);
+      return NULL;
+    }
+
+    return Document;
+  }
+
   //
   // Parse the root node.
   //
-  Root = XmlParseNode (&Parser, WithRefs ? &References : NULL);
+  Root = XmlParseNode (&Parser, WithRefs ? &Document->References : NULL);
   if (Root == NULL) {
     XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::parsing document failed");
+    XmlDocumentFree (Document);
     return NULL;
   }
 
   //
   // Return parsed document.
   //
-  Document = AllocatePool (sizeof(XML_DOCUMENT));
+  Document->Root = Root;
 
-  if (Document == NULL) {
-    XML_PARSER_ERROR (&Parser, NO_CHARACTER, "XmlDocumentParse::document allocation failed");
-    XmlNodeFree (Root);
-    XmlFreeRefs (&References);
-    return NULL;
+  return Document;
+}
+
+XML_DOCUMENT *
+XmlDocumentParse (
+  CHAR8    *Buffer,
+  UINT32   Length,
+  BOOLEAN  WithRefs
+  )
+{
+  return XmlDocumentParseInternal (Buffer, Length, WithRefs, FALSE);
+}
+
+XML_DOCUMENT *
+XmlDocumentParseLazy (
+  CHAR8    *Buffer,
+  UINT32   Length,
+  BOOLEAN  WithRefs
+  )
+{
+  return XmlDocumentParseInternal (Buffer, Length, WithRefs, TRUE);
+}
+
+BOOLEAN
+XmlDocumentExportSize (
+  XML_DOCUMENT  *Document,
+  UINT32        *Length,
+  UINT32        Skip
+  )
+{
+  *Length = 0;
+
+  if (Document->Binary) {
+    XML_USAGE_ERROR ("XmlDocumentExportSize::binary plists cannot be exported");
+    return FALSE;
   }
 
-  Document->Buffer.Buffer = Buffer;
-  Document->Buffer.Length = Length;
-  Document->Root = Root;
-  CopyMem (&Document->References, &References, sizeof (References));
+  //
+  // Nodes with malformed children read as empty, do not export them as such.
+  //
+  if (Document->LazyFailed) {
+    XML_USAGE_ERROR ("XmlDocumentExportSize::lazy children failed to parse");
+    return FALSE;
+  }
 
-  return Document;
+  return XmlNodeExportSize (Document->Root, Length, Skip);
+}
+
+BOOLEAN
+XmlDocumentExportBuffer (
+  XML_DOCUMENT  *Document,
+  CHAR8         *Buffer,
+  UINT32        BufferSize,
+  UINT32        *Length,
+  UINT32        Skip
+  )
+{
+  UINT32  ExportSize;
+  UINT32  CurrentSize;
+
+  if (!XmlDocumentExportSize (Document, &ExportSize, Skip)) {
+    XML_USAGE_ERROR ("XmlDocumentExportBuffer::document is too large");
+    return FALSE;
+  }
+
+  if (Length != NULL) {
+    *Length = ExportSize;
+  }
+
+  if (ExportSize >= BufferSize) {
+    XML_USAGE_ERROR ("XmlDocumentExportBuffer::buffer is too small");
+    return FALSE;
+  }
+
+  CurrentSize = 0;
+  XmlNodeExportRecursive (Document->Root, Buffer, &CurrentSize, Skip);
+  ASSERT (CurrentSize == ExportSize);
+
+  Buffer[CurrentSize] = '\0';
+
+  return TRUE;
 }
 
 CHAR8 *
@@ -1150,28 +2568,26 @@ XmlDocumentExport (
   )
 {
   CHAR8   *Buffer;
+  UINT32  ExportSize;
   UINT32  AllocSize;
-  UINT32  CurrentSize;
 
-  AllocSize = Document->Buffer.Length + 1;
-  Buffer    = AllocatePool (AllocSize);
+  if (!XmlDocumentExportSize (Document, &ExportSize, Skip)
+    || OcOverflowAddU32 (ExportSize, 1, &AllocSize)) {
+    XML_USAGE_ERROR ("XmlDocumentExport::document is too large");
+    return NULL;
+  }
+
+  Buffer = AllocatePool (AllocSize);
   if (Buffer == NULL) {
     XML_USAGE_ERROR ("XmlDocumentExport::failed to allocate");
     return NULL;
   }
 
-  CurrentSize = 0;
-  XmlNodeExportRecursive (Document->Root, &Buffer, &AllocSize, &CurrentSize, Skip);
-
-  if (Length != NULL) {
-    *Length = CurrentSize;
+  if (!XmlDocumentExportBuffer (Document, Buffer, AllocSize, Length, Skip)) {
+    FreePool (Buffer);
+    return NULL;
   }
 
-  //
-  // XmlBufferAppend guarantees one more byte.
-  //
-  Buffer[CurrentSize] = '\0';
-
   return Buffer;
 }
 
@@ -1180,8 +2596,7 @@ XmlDocumentFree (
   XML_DOCUMENT  *Document
   )
 {
-  XmlNodeFree (Document->Root);
-  XmlFreeRefs (&Document->References);
+  XmlArenaFree (&Document->Arena);
   FreePool (Document);
 }
 
@@ -1193,6 +2608,14 @@ XmlDocumentRoot (
   return Document->Root;
 }
 
+BOOLEAN
+XmlDocumentLazyFailed (
+  XML_DOCUMENT  *Document
+  )
+{
+  return Document->LazyFailed;
+}
+
 CONST CHAR8 *
 XmlNodeName (
   XML_NODE  *Node
@@ -1206,7 +2629,15 @@ XmlNodeContent (
   XML_NODE  *Node
   )
 {
-  return Node->Real != NULL ? Node->Real->Content : Node->Content;
+  if (Node->Real != NULL) {
+    return Node->Real->Content;
+  }
+
+  if (Node->Content == NULL && Node->Document->Binary) {
+    return XmlBplistNodeContent (Node);
+  }
+
+  return Node->Content;
 }
 
 UINT32
@@ -1214,6 +2645,7 @@ XmlNodeChildren (
   XML_NODE  *Node
   )
 {
+  XmlNodeParseLazy (Node);
   return Node->Children ? Node->Children->NodeCount : 0;
 }
 
@@ -1223,6 +2655,7 @@ XmlNodeChild (
   UINT32    Child
   )
 {
+  XmlNodeParseLazy (Node);
   return Node->Children->NodeList[Child];
 }
 
@@ -1298,13 +2731,16 @@ XmlNodeAppend (
 {
   XML_NODE  *NewNode;
 
-  NewNode = XmlNodeCreate (Name, Attributes, Content, NULL, NULL);
+  if (!XmlNodeParseLazy (Node)) {
+    return NULL;
+  }
+
+  NewNode = XmlNodeCreate (Node->Document, Name, Attributes, Content, NULL, NULL);
   if (NewNode == NULL) {
     return NULL;
   }
 
   if (!XmlNodeChildPush (Node, NewNode)) {
-    XmlNodeFree (NewNode);
     return NULL;
   }
 
@@ -1341,6 +2777,10 @@ PlistDocumentRoot (
 
   Node = Document->Root;
 
+  if (Document->Binary) {
+    return Node;
+  }
+
   if (AsciiStrCmp (XmlNodeName (Node), "plist") != 0) {
     XML_USAGE_ERROR ("PlistDocumentRoot::not plist root");
     return NULL;
@@ -1385,7 +2825,10 @@ PlistNodeCast (
     case PLIST_NODE_TYPE_KEY:
     case PLIST_NODE_TYPE_INTEGER:
     case PLIST_NODE_TYPE_REAL:
-      if (XmlNodeContent (Node) == NULL) {
+      //
+      // Binary plist values are decoded on access.
+      //
+      if (!Node->Document->Binary && XmlNodeContent (Node) == NULL) {
         XML_USAGE_ERROR ("PlistNodeType::key or int have no content");
         return NULL;
       }
@@ -1440,6 +2883,131 @@ PlistKeyValue (
   return XmlNodeContent (Node);
 }
 
+//
+// Builds key index for dictionary children, first of duplicate keys wins.
+//
+STATIC
+XML_DICT_INDEX *
+XmlDictIndexBuild (
+  XML_NODE  *Node,
+  UINT32    PairCount
+  )
+{
+  XML_NODE_LIST   *Children;
+  XML_DICT_INDEX  *Index;
+  UINT32          Size;
+  UINT32          Pair;
+  UINT32          Hash;
+  UINT32          Slot;
+  CONST CHAR8     *Key;
+  CONST CHAR8     *SlotKey;
+
+  Children = Node->Children;
+
+  Size = 1;
+  while (Size < PairCount * 2) {
+    Size *= 2;
+  }
+
+  Index = XmlArenaAllocate (
+    &Node->Document->Arena,
+    sizeof (XML_DICT_INDEX) + sizeof (Index->Entries[0]) * Size
+    );
+  if (Index == NULL) {
+    return NULL;
+  }
+
+  Index->Mask = Size - 1;
+  ZeroMem (&Index->Entries[0], sizeof (Index->Entries[0]) * Size);
+
+  for (Pair = 0; Pair < PairCount; ++Pair) {
+    Key = PlistKeyValue (Children->NodeList[Pair * 2]);
+    if (Key == NULL) {
+      continue;
+    }
+
+    Hash = AsciiStrHash (Key, NULL);
+    Slot = Hash & Index->Mask;
+
+    while (Index->Entries[Slot].Pair != 0) {
+      if (Index->Entries[Slot].Hash == Hash) {
+        SlotKey = XmlNodeContent (Children->NodeList[(Index->Entries[Slot].Pair - 1) * 2]);
+        if (AsciiStrCmp (SlotKey, Key) == 0) {
+          break;
+        }
+      }
+
+      Slot = (Slot + 1) & Index->Mask;
+    }
+
+    if (Index->Entries[Slot].Pair == 0) {
+      Index->Entries[Slot].Hash = Hash;
+      Index->Entries[Slot].Pair = Pair + 1;
+    }
+  }
+
+  Children->KeyIndex = Index;
+  return Index;
+}
+
+XML_NODE *
+PlistDictFind (
+  XML_NODE     *Node,
+  CONST CHAR8  *Key
+  )
+{
+  XML_NODE_LIST   *Children;
+  XML_DICT_INDEX  *Index;
+  UINT32          PairCount;
+  UINT32          Pair;
+  UINT32          Hash;
+  UINT32          Slot;
+  CONST CHAR8     *ChildKey;
+
+  PairCount = PlistDictChildren (Node);
+  if (PairCount == 0) {
+    return NULL;
+  }
+
+  Children = Node->Children;
+  Index    = Children->KeyIndex;
+
+  if (Index == NULL && PairCount >= XML_DICT_INDEX_MIN_PAIRS) {
+    Index = XmlDictIndexBuild (Node, PairCount);
+  }
+
+  //
+  // Small dictionaries, or no memory for the index.
+  //
+  if (Index == NULL) {
+    for (Pair = 0; Pair < PairCount; ++Pair) {
+      ChildKey = PlistKeyValue (Children->NodeList[Pair * 2]);
+      if (ChildKey != NULL && AsciiStrCmp (ChildKey, Key) == 0) {
+        return Children->NodeList[Pair * 2 + 1];
+      }
+    }
+
+    return NULL;
+  }
+
+  Hash = AsciiStrHash (Key, NULL);
+  Slot = Hash & Index->Mask;
+
+  while (Index->Entries[Slot].Pair != 0) {
+    if (Index->Entries[Slot].Hash == Hash) {
+      Pair     = Index->Entries[Slot].Pair - 1;
+      ChildKey = XmlNodeContent (Children->NodeList[Pair * 2]);
+      if (AsciiStrCmp (ChildKey, Key) == 0) {
+        return Children->NodeList[Pair * 2 + 1];
+      }
+    }
+
+    Slot = (Slot + 1) & Index->Mask;
+  }
+
+  return NULL;
+}
+
 BOOLEAN
 PlistStringValue (
   XML_NODE  *Node,
@@ -1478,6 +3046,8 @@ PlistDataValue (
   )
 {
   CONST CHAR8    *Content;
+  CONST UINT8    *Data;
+  UINT32         DataSize;
   UINTN          Length;
   RETURN_STATUS  Result;
 
@@ -1485,6 +3055,17 @@ PlistDataValue (
     return FALSE;
   }
 
+  if (XmlBplistData (Node, &Data, &DataSize)) {
+    if (DataSize > *Size) {
+      *Size = 0;
+      return FALSE;
+    }
+
+    CopyMem (Buffer, Data, DataSize);
+    *Size = DataSize;
+    return TRUE;
+  }
+
   Content = XmlNodeContent (Node);
   if (Content == NULL) {
     *Size = 0;
@@ -1536,10 +3117,12 @@ PlistIntegerValue (
     return FALSE;
   }
 
-  if (Hex) {
-    Temp = AsciiStrHexToUint64 (XmlNodeContent (Node));
-  } else {
-    Temp = AsciiStrDecimalToUint64 (XmlNodeContent (Node));
+  if (!XmlBplistInteger (Node, &Temp)) {
+    if (Hex) {
+      Temp = AsciiStrHexToUint64 (XmlNodeContent (Node));
+    } else {
+      Temp = AsciiStrDecimalToUint64 (XmlNodeContent (Node));
+    }
   }
 
   switch (Size) {
@@ -1568,10 +3151,23 @@ PlistMetaDataValue (
   )
 {
   CONST CHAR8    *Content;
+  CONST UINT8    *Data;
+  UINT32         DataSize;
+  UINT64         Value;
   UINTN          Length;
   RETURN_STATUS  Result;
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_DATA) != NULL) {
+    if (XmlBplistData (Node, &Data, &DataSize)) {
+      if (DataSize > *Size) {
+        return FALSE;
+      }
+
+      CopyMem (Buffer, Data, DataSize);
+      *Size = DataSize;
+      return TRUE;
+    }
+
     Content = XmlNodeContent (Node);
     if (Content != NULL) {
 
@@ -1606,7 +3202,10 @@ PlistMetaDataValue (
   }
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_INTEGER) != NULL) {
-    *(UINT32 *) Buffer = (UINT32) AsciiStrDecimalToUint64 (XmlNodeContent (Node));
+    if (!XmlBplistInteger (Node, &Value)) {
+      Value = AsciiStrDecimalToUint64 (XmlNodeContent (Node));
+    }
+    *(UINT32 *) Buffer = (UINT32) Value;
     *Size = sizeof (UINT32);
     return TRUE;
   }
@@ -1655,11 +3254,16 @@ PlistDataSize (
   )
 {
   CONST CHAR8  *Content;
+  CONST UINT8  *Data;
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_DATA) == NULL) {
     return FALSE;
   }
 
+  if (XmlBplistData (Node, &Data, Size)) {
+    return TRUE;
+  }
+
   Content = XmlNodeContent (Node);
   if (Content != NULL) {
     *Size = (UINT32) AsciiStrLen (Content);
@@ -1677,8 +3281,13 @@ PlistMetaDataSize (
   )
 {
   CONST CHAR8  *Content;
+  CONST UINT8  *Data;
 
   if (PlistNodeCast (Node, PLIST_NODE_TYPE_DATA) != NULL) {
+    if (XmlBplistData (Node, &Data, Size)) {
+      return TRUE;
+    }
+
     Content = XmlNodeContent (Node);
     if (Content != NULL) {
       *Size = (UINT32) AsciiStrLen (Content);
@@ -88,6 +88,42 @@ HpetPatch = {
   .OemTableId = 0
 };
 
+STATIC UINT8 OsiPatchFind[] = {'_', 'O', 'S', 'I'};
+STATIC UINT8 OsiPatchReplace[] = {'X', 'O', 'S', 'I'};
+STATIC UINT8 EcPatchFind[] = {'E', 'C', '0', '_'};
+STATIC UINT8 EcPatchReplace[] = {'E', 'C', '_', '_'};
+STATIC
+OC_ACPI_PATCH
+BatchPatches[] = {
+  {
+    .Find    = OsiPatchFind,
+    .Replace = OsiPatchReplace,
+    .Mask    = NULL,
+    .ReplaceMask = NULL,
+    .Size    = sizeof (OsiPatchFind),
+    //
+    // Replace all occurrences in all tables.
+    //
+    .Count   = 0,
+    .Skip    = 0,
+    .TableSignature = 0,
+    .TableLength = 0,
+    .OemTableId = 0
+  },
+  {
+    .Find    = EcPatchFind,
+    .Replace = EcPatchReplace,
+    .Mask    = NULL,
+    .ReplaceMask = NULL,
+    .Size    = sizeof (EcPatchFind),
+    .Count   = 0,
+    .Skip    = 0,
+    .TableSignature = 0,
+    .TableLength = 0,
+    .OemTableId = 0
+  }
+};
+
 EFI_STATUS
 EFIAPI
 TestAcpi (
@@ -113,6 +149,8 @@ TestAcpi (
 
     AcpiApplyPatch (&Context, &HpetPatch);
 
+    AcpiApplyPatches (&Context, BatchPatches, ARRAY_SIZE (BatchPatches));
+
     AcpiRelocateRegions (&Context);
 
     AcpiNormalizeHeaders (&Context);
@@ -42,6 +42,14 @@ typedef struct AES_128_CTR_SAMPLE_ {
   UINT8  Key[CONFIG_AES_KEY_SIZE];
 } AES_128_CTR_SAMPLE;
 
+typedef struct AES_SAMPLE_ {
+  UINT32 KeySize;
+  UINT8  IV[AES_BLOCK_SIZE];
+  UINT8  PlainText[AES_SAMPLE_DATA_LEN];
+  UINT8  CipherText[AES_SAMPLE_DATA_LEN];
+  UINT8  Key[AES_256_KEY_SIZE];
+} AES_SAMPLE;
+
 typedef struct HASH_SAMPLE_ {
   UINT8  *PlainText;
   UINTN  PlainTextLen;
@@ -56,6 +64,16 @@ typedef struct RSA2048SHA256_SIGN_SAMPLE_ {
   UINT8 PublicKey[520];
 } RSA2048SHA256_SIGN_SAMPLE;
 
+typedef struct RSA3072SHA256_SIGN_SAMPLE_ {
+  UINT8 Signature[384];
+  UINT8 PublicKey[776];
+} RSA3072SHA256_SIGN_SAMPLE;
+
+typedef struct RSA4096SHA256_SIGN_SAMPLE_ {
+  UINT8 Signature[512];
+  UINT8 PublicKey[1032];
+} RSA4096SHA256_SIGN_SAMPLE;
+
 //
 // RSA2048SHA256
 // Signature
@@ -294,6 +312,492 @@ RSA2048SHA256_SIGN_SAMPLE Rsa2048Sha256Sample = {
   }
 };
 
+//
+// RSA3072SHA256
+// Signature of Rsa2048Sha256Sample data
+//
+RSA3072SHA256_SIGN_SAMPLE Rsa3072Sha256Sample = {
+  //
+  // Signature
+  //
+  {
+    0x18, 0x6b, 0xa3, 0xff, 0x93, 0xe1,
+    0x5f, 0x7a, 0x24, 0x35, 0x38, 0x9b,
+    0x31, 0xa6, 0x51, 0xda, 0x84, 0xc0,
+    0x96, 0x1a, 0xf7, 0x0e, 0x60, 0xbf,
+    0xd4, 0x47, 0x69, 0x2d, 0x9d, 0x0f,
+    0xda, 0x93, 0x3e, 0x13, 0x43, 0x94,
+    0x28, 0xa8, 0xbf, 0x95, 0x25, 0x5a,
+    0x4c, 0xd0, 0xff, 0xca, 0x0a, 0x3d,
+    0xae, 0x40, 0x00, 0x6c, 0x74, 0x2e,
+    0x56, 0xd0, 0x58, 0x1e, 0x03, 0xd5,
+    0x2d, 0xc3, 0x50, 0x5b, 0xf5, 0xe9,
+    0x60, 0xd2, 0x84, 0xf7, 0xe5, 0x23,
+    0x23, 0xc3, 0xc7, 0x4d, 0x88, 0xf6,
+    0xa2, 0xd4, 0x10, 0xf9, 0x7a, 0xf8,
+    0x85, 0xaf, 0x93, 0xd8, 0x33, 0x59,
+    0x4e, 0xdd, 0x6a, 0xf9, 0xf5, 0x6b,
+    0x73, 0xef, 0x1d, 0x41, 0x93, 0x95,
+    0x77, 0x7c, 0x70, 0x85, 0x7f, 0x7d,
+    0x24, 0xf2, 0x1d, 0x89, 0x49, 0xcd,
+    0x15, 0xa7, 0xa5, 0x66, 0x69, 0xbb,
+    0xdd, 0x94, 0x8e, 0x96, 0xf4, 0xd9,
+    0xff, 0x16, 0xa8, 0xdc, 0x08, 0xb6,
+    0x16, 0xad, 0x12, 0x31, 0x03, 0x93,
+    0x32, 0x58, 0x05, 0x13, 0xd4, 0x07,
+    0x4f, 0x82, 0xd5, 0xa8, 0x53, 0x4d,
+    0x45, 0x61, 0x25, 0x30, 0xa7, 0x2d,
+    0xc8, 0x24, 0x39, 0xf1, 0xdd, 0x63,
+    0xdd, 0xc3, 0xd0, 0x34, 0x0d, 0x80,
+    0xe8, 0xbb, 0x3f, 0xa9, 0x5b, 0x41,
+    0xd4, 0xf1, 0x04, 0x44, 0xae, 0xfa,
+    0xa3, 0xa6, 0xa8, 0xaa, 0x13, 0xfc,
+    0x7e, 0xfb, 0xa1, 0xb1, 0x1c, 0x32,
+    0x5c, 0xb8, 0xae, 0xb4, 0x12, 0x66,
+    0x31, 0x66, 0xa0, 0x26, 0x1a, 0x0d,
+    0x88, 0xbd, 0xed, 0x4f, 0x93, 0x7e,
+    0xb3, 0x04, 0xcc, 0x92, 0xac, 0xcf,
+    0x3a, 0x5c, 0x3c, 0x15, 0x7d, 0xee,
+    0x0f, 0xc3, 0x83, 0x46, 0xe0, 0xa0,
+    0xa8, 0x2b, 0xc4, 0x3c, 0xe9, 0x7e,
+    0x5d, 0x07, 0xae, 0x2a, 0x5d, 0x0d,
+    0x6e, 0x30, 0xaa, 0x26, 0x9b, 0x4c,
+    0x53, 0xbc, 0x2a, 0xb7, 0xae, 0x61,
+    0x35, 0x72, 0xb1, 0x61, 0xd4, 0xaf,
+    0xbf, 0x5e, 0x9d, 0x2b, 0xf3, 0x5f,
+    0x5f, 0x02, 0x12, 0xf8, 0x90, 0xd3,
+    0x3c, 0x46, 0x92, 0x64, 0x84, 0xcd,
+    0x5c, 0xe1, 0xd5, 0x7b, 0xa3, 0xbb,
+    0xb8, 0x88, 0x91, 0x2b, 0x78, 0xbb,
+    0xb8, 0x54, 0x5e, 0x65, 0x25, 0x62,
+    0x79, 0xb6, 0xc1, 0x1b, 0xae, 0x70,
+    0x2e, 0x48, 0x7a, 0x54, 0xac, 0xf5,
+    0x84, 0xf2, 0xf7, 0x7b, 0x20, 0xac,
+    0xe7, 0x4d, 0xa4, 0x2e, 0x1a, 0xba,
+    0xd3, 0x76, 0x9d, 0x44, 0x6d, 0xb6,
+    0x12, 0xaa, 0x12, 0x85, 0x1b, 0x61,
+    0xd0, 0xb8, 0x43, 0xf2, 0x01, 0xc5,
+    0xbe, 0x5a, 0xd2, 0x91, 0x6d, 0xdf,
+    0xab, 0xe9, 0xda, 0x9f, 0x9f, 0x1e,
+    0xa9, 0xb3, 0x3b, 0xac, 0x02, 0x85,
+    0xad, 0x23, 0xbb, 0x4c, 0x3c, 0x14,
+    0x2a, 0xf3, 0xd7, 0x30, 0x84, 0x96,
+    0x2c, 0x4c, 0x68, 0xec, 0x02, 0x3d,
+    0x11, 0x7a, 0x31, 0xd0, 0xce, 0x1d,
+    0x48, 0xf8, 0x7d, 0xc4, 0xc4, 0x47
+  },
+  //
+  // Public key
+  //
+  {
+    0x60, 0x00, 0x00, 0x00, 0x47, 0x44,
+    0x53, 0x17, 0x89, 0xda, 0x54, 0xa3,
+    0x25, 0xd4, 0x34, 0x89, 0x77, 0x02,
+    0x21, 0xe3, 0x94, 0xb9, 0x29, 0x96,
+    0x6a, 0xcc, 0x77, 0xb2, 0x7b, 0xad,
+    0x3a, 0xd9, 0x79, 0xe8, 0x6d, 0xf3,
+    0x6f, 0x41, 0xc2, 0x6e, 0x32, 0xde,
+    0x87, 0xe0, 0x01, 0x73, 0x42, 0x97,
+    0x89, 0x7f, 0x55, 0x0a, 0x7d, 0x24,
+    0x54, 0x7f, 0x5a, 0xa7, 0x76, 0xb6,
+    0xc6, 0x68, 0xa5, 0xf5, 0x48, 0x4e,
+    0xd7, 0x42, 0x35, 0x6b, 0x85, 0xa6,
+    0xb9, 0x4e, 0x15, 0x0a, 0x98, 0x9f,
+    0x5e, 0x71, 0xc8, 0xe1, 0x70, 0x10,
+    0xab, 0x3e, 0x84, 0xa9, 0xcf, 0x76,
+    0xf9, 0x33, 0x77, 0xc5, 0xb8, 0x52,
+    0x0e, 0xc6, 0xec, 0x89, 0x55, 0x3b,
+    0x1c, 0x7e, 0xd1, 0x78, 0xc0, 0x86,
+    0x3a, 0xb5, 0xcf, 0x60, 0x31, 0x5e,
+    0x02, 0x3a, 0xcf, 0x2b, 0x3f, 0x5e,
+    0x9b, 0x63, 0xcf, 0x76, 0x20, 0x82,
+    0x10, 0xb5, 0x02, 0xe5, 0xf0, 0x5f,
+    0x09, 0xc2, 0xe9, 0x85, 0xbc, 0x8b,
+    0xe0, 0x2b, 0x15, 0x0a, 0x61, 0x50,
+    0x98, 0x88, 0xa3, 0x03, 0x09, 0xe6,
+    0xdf, 0x51, 0xdd, 0x00, 0x7a, 0xd2,
+    0x8e, 0x8c, 0xc1, 0x04, 0xdc, 0x96,
+    0x42, 0xfc, 0x67, 0x61, 0xd0, 0xca,
+    0x10, 0x5b, 0x7d, 0xd3, 0xda, 0x58,
+    0x89, 0x71, 0x33, 0x15, 0x69, 0xd9,
+    0xde, 0x49, 0x72, 0x98, 0x11, 0x0c,
+    0x9a, 0x65, 0x35, 0x0e, 0x53, 0x18,
+    0x62, 0x47, 0x14, 0xb4, 0x11, 0xbb,
+    0x40, 0xb4, 0xa1, 0x70, 0x86, 0x08,
+    0x54, 0x37, 0x3a, 0x8b, 0x89, 0x83,
+    0xef, 0x16, 0x65, 0x9b, 0x32, 0x63,
+    0x8c, 0x9f, 0x20, 0xab, 0xab, 0x7f,
+    0xcc, 0x2a, 0xea, 0xf0, 0x97, 0x2e,
+    0x91, 0x04, 0xf2, 0x37, 0xe0, 0x60,
+    0xfe, 0x12, 0x25, 0xde, 0x77, 0x13,
+    0xcb, 0x67, 0xff, 0x9f, 0x44, 0x3c,
+    0x9a, 0x73, 0x7f, 0xab, 0x89, 0x67,
+    0x3a, 0x00, 0x7f, 0xd0, 0xe9, 0xe8,
+    0x26, 0x53, 0xca, 0xd4, 0x69, 0x78,
+    0xb4, 0x44, 0x39, 0x5e, 0xdd, 0xa0,
+    0x06, 0x17, 0xa8, 0x85, 0xa8, 0x66,
+    0x93, 0x11, 0x71, 0xcb, 0x6a, 0x02,
+    0x4c, 0xea, 0xfa, 0x37, 0x07, 0x8d,
+    0x1f, 0x77, 0x03, 0x98, 0xb9, 0x00,
+    0x8d, 0x14, 0x37, 0xfd, 0x86, 0x5c,
+    0x23, 0xa0, 0x16, 0x3a, 0x08, 0xb4,
+    0xd0, 0x5e, 0xd0, 0xc0, 0x98, 0xa1,
+    0x2e, 0x18, 0xed, 0x71, 0xd7, 0x18,
+    0x5a, 0x7b, 0x98, 0xfb, 0x07, 0x75,
+    0xea, 0xeb, 0x80, 0xcd, 0x5e, 0xe3,
+    0xcc, 0x21, 0x16, 0xaf, 0x89, 0x36,
+    0x7e, 0x41, 0x04, 0xd5, 0xdd, 0xe5,
+    0xfc, 0x2c, 0x1f, 0x4b, 0x81, 0xd0,
+    0xb3, 0xd9, 0x60, 0x48, 0xf8, 0x13,
+    0x96, 0xb0, 0x59, 0x8b, 0x55, 0x65,
+    0xed, 0xf6, 0x56, 0x90, 0x97, 0x9a,
+    0x4a, 0x9a, 0xf2, 0x28, 0x5f, 0x77,
+    0xf1, 0x64, 0x78, 0x60, 0x42, 0x48,
+    0x6c, 0x4d, 0x9f, 0x49, 0xf6, 0x7c,
+    0x70, 0x05, 0xca, 0xb9, 0x87, 0x67,
+    0x99, 0x9b, 0x0b, 0xe4, 0xd5, 0xd6,
+    0xc8, 0xed, 0xaa, 0xd8, 0x98, 0x25,
+    0x37, 0xdc, 0x3a, 0x1a, 0x29, 0x03,
+    0x11, 0xb0, 0xce, 0xc9, 0x9c, 0xd5,
+    0xa2, 0xbb, 0xb6, 0x9e, 0x20, 0xf9,
+    0x25, 0x6e, 0xf0, 0x6f, 0x22, 0x42,
+    0x97, 0xf5, 0xf6, 0xf3, 0x20, 0xde,
+    0xcc, 0xc5, 0x4e, 0x46, 0xe6, 0x19,
+    0xbb, 0xfc, 0x03, 0x46, 0xd1, 0xd5,
+    0xbc, 0x20, 0xa9, 0xe5, 0x5c, 0x31,
+    0xa6, 0x93, 0x42, 0x13, 0xde, 0xf7,
+    0x97, 0x76, 0x26, 0x19, 0x06, 0xe5,
+    0xcd, 0xc7, 0xe5, 0x8a, 0xa1, 0x75,
+    0x4d, 0x48, 0x43, 0xe1, 0xd7, 0x59,
+    0x35, 0xe5, 0x30, 0x83, 0x9c, 0xc2,
+    0x9b, 0xfc, 0x08, 0xe3, 0xe2, 0x36,
+    0x54, 0x84, 0x7f, 0x27, 0xdf, 0xa6,
+    0x58, 0x7c, 0x3d, 0xcc, 0x4a, 0x09,
+    0x0a, 0x2a, 0x63, 0x4f, 0x84, 0x9b,
+    0x05, 0x4f, 0xa8, 0xfa, 0x92, 0x45,
+    0x15, 0xe9, 0x71, 0x28, 0x17, 0x72,
+    0x6b, 0xa8, 0xc9, 0x3b, 0xdc, 0xbe,
+    0x4b, 0x77, 0xde, 0x2a, 0xd1, 0x60,
+    0xe3, 0x4a, 0x28, 0xcb, 0x6d, 0x1c,
+    0xdd, 0x91, 0x81, 0x77, 0x85, 0x15,
+    0xa3, 0x9b, 0xf9, 0x01, 0x5a, 0x44,
+    0x47, 0xe3, 0x54, 0xae, 0x09, 0xf8,
+    0x3a, 0xf4, 0x09, 0xee, 0xd7, 0x82,
+    0x78, 0x09, 0xf5, 0x6b, 0xcc, 0x35,
+    0x17, 0x11, 0xaf, 0x02, 0xfc, 0x47,
+    0xa7, 0x63, 0x1e, 0x8e, 0x02, 0x9f,
+    0x77, 0x0d, 0x72, 0x2e, 0x9e, 0xec,
+    0xf6, 0x65, 0xd8, 0x43, 0xe6, 0x79,
+    0x29, 0x91, 0xa7, 0xca, 0xd8, 0xe6,
+    0xfc, 0xfd, 0x76, 0x76, 0x2f, 0xc5,
+    0xc9, 0xe1, 0x2e, 0xea, 0x82, 0xdf,
+    0x26, 0x79, 0xcf, 0xbd, 0xcb, 0x47,
+    0x8e, 0x4c, 0xf6, 0x71, 0x4f, 0x64,
+    0x7f, 0xc6, 0x1f, 0xda, 0x70, 0x15,
+    0x33, 0x4b, 0xa5, 0xfb, 0x99, 0xf5,
+    0x5b, 0x89, 0x1e, 0x0f, 0x8c, 0xcb,
+    0xc8, 0x0c, 0xf7, 0xc1, 0x4b, 0xd4,
+    0xc0, 0x63, 0x40, 0x2d, 0x9b, 0x0e,
+    0x2c, 0x27, 0xdb, 0xd8, 0x37, 0x2c,
+    0xd4, 0x6d, 0x4b, 0x55, 0x6c, 0x27,
+    0xbd, 0xd1, 0x2e, 0xfa, 0xa6, 0x20,
+    0xac, 0x4a, 0xac, 0x4f, 0xcc, 0xd7,
+    0xc6, 0xc7, 0xb8, 0x31, 0x2c, 0x60,
+    0x9b, 0xd5, 0x5a, 0x5a, 0xcf, 0xf1,
+    0x6c, 0x5c, 0xc7, 0xdd, 0x73, 0x38,
+    0x1e, 0x2d, 0x96, 0x3f, 0x69, 0x59,
+    0x18, 0xf8, 0x03, 0xec, 0xb2, 0x71,
+    0x2b, 0xea, 0x07, 0xf3, 0x25, 0xb9,
+    0x60, 0x1e, 0xd9, 0xf8, 0x51, 0x8f,
+    0x19, 0x24, 0x7b, 0x84, 0x55, 0x85,
+    0x39, 0x4c, 0xd8, 0x44, 0x3c, 0x67,
+    0x9d, 0x7a, 0xf6, 0xf8, 0x05, 0xb1,
+    0x31, 0xc4, 0x87, 0xf9, 0x0c, 0xdb,
+    0x44, 0xea, 0xfa, 0x09, 0x7f, 0x11,
+    0x7c, 0xd7, 0x32, 0x82, 0x5b, 0xce,
+    0xc1, 0x2b, 0x89, 0xd0, 0xd8, 0x77,
+    0x4f, 0x58, 0xc8, 0xe8, 0xbf, 0xc0,
+    0x99, 0xf5, 0x8a, 0x99, 0xe6, 0x7d,
+    0x40, 0x79, 0xdd, 0x24, 0x9a, 0x8d,
+    0x48, 0x07
+  }
+};
+
+//
+// RSA4096SHA256
+// Signature of Rsa2048Sha256Sample data
+//
+RSA4096SHA256_SIGN_SAMPLE Rsa4096Sha256Sample = {
+  //
+  // Signature
+  //
+  {
+    0xad, 0x32, 0xf1, 0x9c, 0x38, 0x24,
+    0xc7, 0x14, 0x49, 0xd9, 0x1a, 0x65,
+    0x2a, 0x73, 0x93, 0x79, 0x6a, 0xd5,
+    0x24, 0xf1, 0x46, 0xc8, 0x85, 0xf2,
+    0xd9, 0x16, 0xb9, 0xde, 0x7c, 0xc7,
+    0xbb, 0xc6, 0x14, 0x5f, 0xc8, 0xe7,
+    0xf5, 0x95, 0x1c, 0x7c, 0xdf, 0x61,
+    0x68, 0xe3, 0xcf, 0xd6, 0x4b, 0xc4,
+    0xb7, 0xec, 0x13, 0x79, 0xba, 0x11,
+    0xd0, 0xae, 0xba, 0xbb, 0x8e, 0x25,
+    0x7b, 0x98, 0xbc, 0xe9, 0x4c, 0x98,
+    0xd5, 0x9e, 0xb5, 0xc3, 0x06, 0x22,
+    0x5f, 0x95, 0xf4, 0x5e, 0x40, 0x3a,
+    0xb5, 0xb6, 0x76, 0x4e, 0x01, 0x50,
+    0xf2, 0x19, 0xf5, 0xcc, 0xe9, 0xd5,
+    0xa8, 0x02, 0x0a, 0xe9, 0x58, 0x0c,
+    0xa5, 0x17, 0xdc, 0x32, 0xb0, 0x05,
+    0xa2, 0xa7, 0x9e, 0xf3, 0xa2, 0x42,
+    0xac, 0xfa, 0x64, 0x1c, 0xf3, 0x00,
+    0x81, 0xc1, 0x37, 0xd3, 0xb8, 0x40,
+    0xf1, 0x6b, 0x7f, 0xe0, 0x53, 0x8e,
+    0x5f, 0x17, 0x78, 0xf0, 0x16, 0xf0,
+    0x88, 0x3c, 0xec, 0x56, 0x8c, 0x40,
+    0x92, 0x61, 0x52, 0x32, 0x1b, 0x0a,
+    0xb8, 0x41, 0xcc, 0xcc, 0x5c, 0x32,
+    0x1b, 0x78, 0x14, 0xe0, 0x9c, 0xf9,
+    0x73, 0xbe, 0x02, 0x12, 0x5a, 0x50,
+    0xc5, 0xdc, 0xdf, 0x1d, 0xd4, 0x1b,
+    0x25, 0x81, 0x03, 0xe4, 0xa6, 0x9a,
+    0x38, 0xe9, 0x85, 0x71, 0x32, 0xf8,
+    0xeb, 0x6c, 0xc5, 0xaa, 0x0f, 0xf9,
+    0x89, 0xaf, 0xe3, 0x8f, 0x82, 0xd4,
+    0x49, 0x0f, 0x56, 0xf8, 0xc1, 0x27,
+    0xdf, 0xa2, 0x89, 0x48, 0xb3, 0x92,
+    0x0e, 0xe9, 0x39, 0x19, 0x66, 0xc9,
+    0x1c, 0x62, 0x31, 0x00, 0x52, 0xa4,
+    0x08, 0x74, 0x93, 0x9e, 0x8a, 0xb4,
+    0x76, 0x91, 0xee, 0x28, 0x29, 0x9d,
+    0x15, 0xe6, 0x06, 0xf4, 0xd6, 0x6b,
+    0xb2, 0xbb, 0x83, 0xe9, 0x72, 0x4e,
+    0x86, 0x45, 0x16, 0x58, 0x75, 0x6c,
+    0x43, 0x19, 0x60, 0x19, 0xf0, 0x35,
+    0x22, 0x8c, 0x5e, 0xc2, 0xb4, 0xec,
+    0x38, 0x0d, 0x3a, 0x96, 0x63, 0xd6,
+    0xbc, 0x89, 0x93, 0x3a, 0x19, 0xdf,
+    0xfb, 0xd0, 0xec, 0x45, 0x68, 0x99,
+    0x4a, 0x86, 0x74, 0x01, 0xa0, 0x93,
+    0x8a, 0x26, 0x9c, 0x5e, 0xad, 0x87,
+    0x9a, 0xfe, 0x70, 0x26, 0x69, 0x32,
+    0x9e, 0xa3, 0x93, 0x6f, 0xa0, 0x26,
+    0x21, 0x9b, 0x64, 0x4f, 0x2f, 0xa0,
+    0x44, 0x20, 0x0c, 0x80, 0x1b, 0xcf,
+    0x38, 0x55, 0xbd, 0xe4, 0xd6, 0x3e,
+    0x86, 0xe8, 0x70, 0xf3, 0xab, 0x99,
+    0x40, 0xcf, 0xd6, 0x46, 0x1a, 0xa9,
+    0xe4, 0x97, 0xc8, 0x3a, 0xdd, 0xe2,
+    0xc7, 0xd8, 0x28, 0xcb, 0x3d, 0xf1,
+    0x0e, 0x19, 0x6a, 0x65, 0x14, 0x34,
+    0x88, 0xc6, 0x9e, 0x00, 0x5c, 0x2a,
+    0x01, 0xbc, 0x23, 0x31, 0x80, 0x9f,
+    0x7d, 0xf0, 0xc2, 0x6d, 0xb0, 0x2f,
+    0xd5, 0x8f, 0x46, 0xd3, 0x5b, 0x8d,
+    0xa5, 0x99, 0x3f, 0x8d, 0xbf, 0xef,
+    0xf1, 0x66, 0xc9, 0xfb, 0xf5, 0x08,
+    0x57, 0xcd, 0x1d, 0xc4, 0x5b, 0x0f,
+    0xb6, 0x19, 0x08, 0x07, 0xfa, 0xa7,
+    0xba, 0x87, 0xa1, 0x11, 0xb6, 0xf0,
+    0x77, 0xc1, 0xd7, 0xf3, 0x77, 0x41,
+    0x31, 0xdc, 0xff, 0x16, 0xec, 0x5a,
+    0x3b, 0x64, 0x1f, 0x70, 0x1e, 0x02,
+    0x0f, 0xb6, 0xf3, 0x74, 0xf3, 0x5c,
+    0x81, 0x68, 0x57, 0xa9, 0x55, 0x8e,
+    0xc5, 0x72, 0x5c, 0x0e, 0x36, 0x21,
+    0x81, 0x43, 0x78, 0xb4, 0xef, 0x68,
+    0xfd, 0x47, 0x13, 0x6d, 0x93, 0xdd,
+    0xc9, 0x9b, 0xa8, 0x46, 0xe1, 0x4b,
+    0x9b, 0x8e, 0x16, 0xbf, 0x7b, 0x3b,
+    0x43, 0xe4, 0x93, 0x5e, 0xd4, 0x21,
+    0xda, 0x60, 0x4a, 0x5e, 0x6e, 0xe7,
+    0x88, 0x6c, 0xac, 0x74, 0x2a, 0x9f,
+    0xca, 0xfe, 0xe7, 0x06, 0xdf, 0x4f,
+    0x90, 0xf2, 0xdc, 0x33, 0xbe, 0x08,
+    0x43, 0xe7, 0xd7, 0xf3, 0x07, 0xf1,
+    0x10, 0xf3, 0x0e, 0xf4, 0x28, 0xa7,
+    0xa5, 0xaf, 0xa0, 0xc8, 0x20, 0xc7,
+    0x06, 0x0a
+  },
+  //
+  // Public key
+  //
+  {
+    0x80, 0x00, 0x00, 0x00, 0x6b, 0x12,
+    0x6c, 0x48, 0xbd, 0xf5, 0x42, 0xd1,
+    0xb2, 0x79, 0x1a, 0xa1, 0x03, 0x1b,
+    0x03, 0x5b, 0x33, 0x5a, 0xd3, 0xd3,
+    0xdd, 0x95, 0xd6, 0xca, 0xba, 0xe3,
+    0x34, 0x91, 0x70, 0x30, 0xdf, 0xcd,
+    0x29, 0x92, 0x5a, 0xfe, 0x6b, 0x18,
+    0xb5, 0x83, 0xc1, 0x67, 0x82, 0x38,
+    0xf2, 0x7f, 0x2e, 0x3d, 0x1a, 0x1b,
+    0xa6, 0x03, 0x37, 0x91, 0x3b, 0x85,
+    0xec, 0x81, 0x17, 0xff, 0xf4, 0x24,
+    0x98, 0x02, 0xa0, 0xc2, 0xa8, 0x45,
+    0xbb, 0x02, 0x07, 0x70, 0xaf, 0xb1,
+    0x94, 0xba, 0xa2, 0x6c, 0x81, 0x12,
+    0x8f, 0xd2, 0xcd, 0xd5, 0x91, 0xf0,
+    0x05, 0xdc, 0xc9, 0x67, 0xe1, 0x48,
+    0x8b, 0x24, 0x02, 0x3a, 0x0b, 0x03,
+    0x11, 0x23, 0x32, 0xfd, 0x92, 0xf0,
+    0x34, 0x52, 0xcf, 0x56, 0xc8, 0x2f,
+    0x8c, 0x3f, 0x18, 0x9b, 0xb2, 0x0c,
+    0xe8, 0xc0, 0xa5, 0xfa, 0x61, 0x62,
+    0x76, 0x40, 0x98, 0xeb, 0x4e, 0x91,
+    0x46, 0xd6, 0xe6, 0xa4, 0xa3, 0x95,
+    0xc0, 0xed, 0xef, 0x3f, 0xb3, 0x80,
+    0x4f, 0x65, 0x3a, 0x62, 0x2b, 0xcc,
+    0xd5, 0x9a, 0x68, 0xfd, 0x43, 0xcf,
+    0x43, 0xc7, 0xc4, 0xd8, 0x6e, 0x84,
+    0x24, 0x7e, 0x8d, 0xa3, 0x60, 0x8a,
+    0x65, 0xfc, 0x07, 0xf5, 0xc6, 0xc8,
+    0xd2, 0x55, 0x75, 0x91, 0x8b, 0x21,
+    0x9e, 0xbc, 0xd5, 0x44, 0xfd, 0xdd,
+    0x9b, 0x61, 0xf1, 0x88, 0x25, 0xda,
+    0x4e, 0xbc, 0xd0, 0x68, 0xa5, 0x15,
+    0xb8, 0x89, 0xe1, 0x08, 0x9d, 0xc4,
+    0x0a, 0xdc, 0x9e, 0xe1, 0xf9, 0x77,
+    0x12, 0xba, 0xab, 0x44, 0x75, 0xc4,
+    0x15, 0xa6, 0x10, 0xf2, 0xf4, 0x37,
+    0x52, 0xf7, 0x7c, 0x0c, 0x44, 0x4b,
+    0xbf, 0xe1, 0xf5, 0xf4, 0x74, 0xf9,
+    0xe2, 0x32, 0xcc, 0x3b, 0x7e, 0x82,
+    0xdb, 0x9c, 0x66, 0xaa, 0xb3, 0xb3,
+    0xac, 0xa4, 0x62, 0x62, 0xbb, 0x82,
+    0x58, 0x8d, 0x6f, 0x40, 0x93, 0xe1,
+    0xea, 0x8a, 0x74, 0x32, 0xe7, 0xcc,
+    0xc0, 0x25, 0x1f, 0x6b, 0xf0, 0x48,
+    0x1b, 0x46, 0x2b, 0x45, 0x44, 0xd1,
+    0xbd, 0x2c, 0x1a, 0x58, 0xb9, 0x23,
+    0xfd, 0x91, 0xb8, 0xa0, 0x30, 0x7b,
+    0xcc, 0x7c, 0xaf, 0x0b, 0x0a, 0x3f,
+    0x3a, 0x8e, 0x61, 0x33, 0x9c, 0xb3,
+    0x3b, 0xcb, 0x75, 0x4c, 0x21, 0xdf,
+    0xf8, 0xa4, 0x6a, 0x0b, 0xcb, 0x73,
+    0xec, 0x94, 0x17, 0x5d, 0xe5, 0xa7,
+    0x9f, 0x47, 0x10, 0x8b, 0x92, 0x0c,
+    0x6f, 0x4d, 0x0f, 0x5b, 0x65, 0x1f,
+    0x40, 0x40, 0xb6, 0xea, 0xde, 0x2d,
+    0xa3, 0xa3, 0xf2, 0x47, 0xd6, 0xbb,
+    0x91, 0xc2, 0x0e, 0xac, 0xba, 0xf2,
+    0x59, 0x45, 0xe8, 0x29, 0x30, 0xe1,
+    0x5a, 0xdc, 0x12, 0xe5, 0x7d, 0x13,
+    0xe0, 0xae, 0x35, 0x3a, 0xaa, 0xfe,
+    0x78, 0xaa, 0x39, 0x02, 0x3f, 0x17,
+    0x25, 0x5c, 0x87, 0xf1, 0x29, 0x22,
+    0x40, 0xdc, 0x24, 0xf9, 0xd8, 0x8b,
+    0xce, 0x78, 0xf7, 0x0c, 0x1a, 0x18,
+    0xad, 0x6d, 0x13, 0x22, 0xcd, 0xe0,
+    0x12, 0x98, 0x57, 0x62, 0x87, 0xd1,
+    0xc3, 0xf9, 0xe3, 0x9c, 0x48, 0x73,
+    0xf3, 0xe0, 0x3c, 0xc4, 0x1c, 0x91,
+    0xf8, 0xb5, 0xb6, 0xab, 0x21, 0xee,
+    0x6b, 0xd7, 0xf9, 0x4e, 0x0f, 0xfd,
+    0x05, 0xb2, 0x92, 0xf7, 0x69, 0x4f,
+    0x44, 0xb8, 0x56, 0x96, 0xad, 0xd9,
+    0xd5, 0xc7, 0xaa, 0x44, 0x51, 0x79,
+    0x7b, 0x4b, 0x0c, 0x2b, 0x26, 0x4a,
+    0x19, 0x67, 0xd4, 0x56, 0xe3, 0xdb,
+    0xc3, 0xc1, 0x55, 0x2a, 0xfc, 0x36,
+    0x5e, 0x5e, 0x3f, 0xc8, 0xdb, 0xbb,
+    0xba, 0xbd, 0xe9, 0x47, 0xfd, 0xab,
+    0x1a, 0x59, 0xaf, 0xf6, 0xdf, 0x2b,
+    0xdf, 0xc5, 0x3d, 0x62, 0x65, 0x98,
+    0x2d, 0x64, 0x45, 0x75, 0x83, 0x2a,
+    0x79, 0x1b, 0x47, 0x09, 0x89, 0x34,
+    0x14, 0x85, 0x2c, 0xfa, 0x34, 0x50,
+    0x60, 0x2d, 0x2b, 0xf8, 0x51, 0x0a,
+    0x4e, 0x8a, 0x84, 0x29, 0x58, 0xe2,
+    0xc3, 0xe4, 0x7e, 0xb5, 0x51, 0x3c,
+    0xf4, 0x5d, 0xc3, 0xfa, 0xd7, 0x87,
+    0x25, 0x1e, 0x9c, 0x13, 0x42, 0xd6,
+    0xd5, 0x27, 0xb6, 0xaa, 0x40, 0x80,
+    0x7d, 0xc8, 0xf3, 0x84, 0x3f, 0x76,
+    0xa6, 0x21, 0x71, 0xc4, 0xff, 0xd4,
+    0x4f, 0x57, 0xf5, 0x89, 0x7b, 0x21,
+    0xad, 0x45, 0x56, 0xc4, 0x1c, 0x32,
+    0x88, 0x49, 0x48, 0xe9, 0xac, 0xfc,
+    0xc7, 0x23, 0x08, 0xba, 0xf3, 0x34,
+    0x5f, 0xeb, 0xc8, 0x3e, 0x04, 0x1b,
+    0x7a, 0x12, 0x23, 0xe1, 0x56, 0x92,
+    0x59, 0xa1, 0x16, 0x75, 0xff, 0x59,
+    0x64, 0xf3, 0x17, 0xb4, 0x5f, 0x03,
+    0x67, 0x75, 0x3e, 0x65, 0xc5, 0x80,
+    0x64, 0xd7, 0xfb, 0x93, 0xaf, 0x10,
+    0x02, 0xb1, 0x81, 0x15, 0xc8, 0x16,
+    0x72, 0x29, 0x8e, 0x80, 0x7a, 0x36,
+    0x54, 0x64, 0x00, 0x27, 0x9e, 0x7b,
+    0xd0, 0xf3, 0xd7, 0xba, 0x85, 0x93,
+    0xda, 0x4c, 0xa4, 0x81, 0xcd, 0x20,
+    0x91, 0xd1, 0x08, 0x13, 0x62, 0x42,
+    0xd8, 0x8c, 0x80, 0x8b, 0xf4, 0x1f,
+    0x68, 0x0b, 0xb4, 0x00, 0x3a, 0xd6,
+    0x78, 0xb5, 0x73, 0xf7, 0x8f, 0x4d,
+    0xef, 0xd6, 0x16, 0xe6, 0xcb, 0xd9,
+    0x1c, 0xa6, 0xb9, 0xe1, 0x09, 0x74,
+    0xb0, 0x50, 0xff, 0x08, 0xc8, 0xba,
+    0x7d, 0x18, 0xe4, 0x83, 0xe9, 0xe9,
+    0xf4, 0xfe, 0x29, 0xae, 0x8c, 0x99,
+    0xb2, 0x24, 0x4a, 0xcf, 0x53, 0x51,
+    0x4b, 0x91, 0x41, 0x37, 0x1b, 0xa0,
+    0xf4, 0x89, 0x03, 0xe6, 0x6d, 0x78,
+    0x55, 0xc2, 0x04, 0x81, 0x34, 0x0f,
+    0xaf, 0xf9, 0x8a, 0x7f, 0x64, 0xd8,
+    0x32, 0x95, 0x36, 0xbc, 0xb3, 0xf3,
+    0x09, 0x90, 0x30, 0x25, 0x7c, 0x4d,
+    0xe4, 0x79, 0x24, 0x2f, 0x97, 0xda,
+    0x6d, 0x4c, 0xa5, 0xa4, 0x2b, 0x80,
+    0xb8, 0xe6, 0x3f, 0xe3, 0xf3, 0x2c,
+    0xdb, 0x58, 0x8c, 0xf7, 0x97, 0xb7,
+    0x51, 0x07, 0x90, 0xec, 0x83, 0xd5,
+    0x10, 0x77, 0x77, 0x18, 0x6a, 0x78,
+    0x08, 0x8a, 0x6a, 0x12, 0xf2, 0x4c,
+    0xf5, 0x11, 0xdc, 0x70, 0x71, 0x16,
+    0x2e, 0x85, 0xc6, 0x89, 0xdf, 0xa8,
+    0x24, 0x49, 0xa4, 0x2d, 0x17, 0xd6,
+    0xba, 0xcf, 0xa6, 0x37, 0x24, 0x1a,
+    0x0f, 0x5a, 0x0f, 0x05, 0xaf, 0x0f,
+    0x4f, 0x95, 0xa5, 0xb0, 0x86, 0xed,
+    0xd7, 0x6b, 0xd5, 0xd7, 0x8f, 0x8b,
+    0x09, 0x99, 0x37, 0x23, 0x29, 0x7b,
+    0xb7, 0x89, 0x5d, 0x74, 0x33, 0x9b,
+    0xa0, 0x29, 0x62, 0x10, 0x3a, 0xa0,
+    0x05, 0x25, 0x40, 0x9d, 0xb2, 0xf8,
+    0xdb, 0xe1, 0x8b, 0x05, 0x87, 0x8a,
+    0x14, 0xdf, 0xe8, 0x53, 0x51, 0x31,
+    0x46, 0xad, 0x54, 0xe2, 0x3c, 0xf5,
+    0x6e, 0x98, 0xfc, 0xd5, 0xe3, 0xec,
+    0x5e, 0xa5, 0xe7, 0x49, 0x10, 0x70,
+    0xca, 0x3e, 0x94, 0x7d, 0x62, 0x3a,
+    0xe6, 0xa6, 0xf2, 0x45, 0xf8, 0x8b,
+    0x01, 0x6e, 0x1d, 0x59, 0x67, 0x18,
+    0xe9, 0x5e, 0xd8, 0x35, 0xb8, 0xe1,
+    0x0b, 0xb0, 0x4a, 0xba, 0x9d, 0x6f,
+    0x9b, 0xbe, 0x2b, 0x3c, 0x9e, 0x49,
+    0x3a, 0xe8, 0xd4, 0x75, 0xcf, 0x48,
+    0x0e, 0xe4, 0xd6, 0x8d, 0x37, 0x67,
+    0x12, 0x15, 0xe2, 0x92, 0x0c, 0x7d,
+    0xd1, 0xb8, 0xd3, 0xe5, 0x73, 0xc4,
+    0x29, 0x34, 0xda, 0xbb, 0xce, 0x15,
+    0xec, 0xba, 0x28, 0xac, 0x11, 0xcf,
+    0x1a, 0xf6, 0xfd, 0x5a, 0xf9, 0xd4,
+    0x7e, 0xd0, 0xfc, 0x51, 0x9a, 0x71,
+    0x82, 0x1c, 0x06, 0x9b, 0xec, 0xa8,
+    0x35, 0xe3, 0x91, 0x04, 0xa2, 0xcb,
+    0xf4, 0x12, 0x52, 0x54, 0x26, 0x1b,
+    0x20, 0x95, 0xa1, 0xbe, 0x3f, 0x35,
+    0x5a, 0x1a, 0x11, 0xa6, 0xec, 0xc6,
+    0xa6, 0x45, 0x34, 0xbf, 0xad, 0x11,
+    0xae, 0x03, 0x54, 0x42, 0x63, 0x45,
+    0xb3, 0xb2, 0x1b, 0xb2, 0x5a, 0x3f,
+    0x2d, 0xf9, 0x24, 0x91, 0x29, 0x78,
+    0x55, 0x82, 0xf2, 0x78, 0x14, 0xc3,
+    0x27, 0x0e, 0xd2, 0x48, 0x7a, 0x35,
+    0x2c, 0x54, 0x2d, 0x95, 0xf1, 0x80
+  }
+};
+
 //
 // AES-128-CBC data sample
 //
@@ -400,6 +904,234 @@ AES_128_CTR_SAMPLE AesCtrSample = {
   }
 };
 
+//
+// NIST SP 800-38A F.2.3 CBC-AES192.Encrypt
+//
+AES_SAMPLE AesCbc192Sample = {
+  AES_192_KEY_SIZE,
+  //
+  // IV
+  //
+  {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+    0x0c, 0x0d, 0x0e, 0x0f
+  },
+  //
+  // Plain text
+  //
+  {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40,
+    0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11,
+    0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d,
+    0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf,
+    0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46,
+    0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+    0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f,
+    0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b,
+    0xe6, 0x6c, 0x37, 0x10
+  },
+  //
+  // Cipher text
+  //
+  {
+    0x4f, 0x02, 0x1d, 0xb2, 0x43, 0xbc,
+    0x63, 0x3d, 0x71, 0x78, 0x18, 0x3a,
+    0x9f, 0xa0, 0x71, 0xe8, 0xb4, 0xd9,
+    0xad, 0xa9, 0xad, 0x7d, 0xed, 0xf4,
+    0xe5, 0xe7, 0x38, 0x76, 0x3f, 0x69,
+    0x14, 0x5a, 0x57, 0x1b, 0x24, 0x20,
+    0x12, 0xfb, 0x7a, 0xe0, 0x7f, 0xa9,
+    0xba, 0xac, 0x3d, 0xf1, 0x02, 0xe0,
+    0x08, 0xb0, 0xe2, 0x79, 0x88, 0x59,
+    0x88, 0x81, 0xd9, 0x20, 0xa9, 0xe6,
+    0x4f, 0x56, 0x15, 0xcd
+  },
+  //
+  // Key
+  //
+  {
+    0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e,
+    0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b,
+    0x80, 0x90, 0x79, 0xe5, 0x62, 0xf8,
+    0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b
+  }
+};
+
+//
+// NIST SP 800-38A F.2.5 CBC-AES256.Encrypt
+//
+AES_SAMPLE AesCbc256Sample = {
+  AES_256_KEY_SIZE,
+  //
+  // IV
+  //
+  {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+    0x0c, 0x0d, 0x0e, 0x0f
+  },
+  //
+  // Plain text
+  //
+  {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40,
+    0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11,
+    0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d,
+    0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf,
+    0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46,
+    0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+    0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f,
+    0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b,
+    0xe6, 0x6c, 0x37, 0x10
+  },
+  //
+  // Cipher text
+  //
+  {
+    0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5,
+    0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb,
+    0x5f, 0x7b, 0xfb, 0xd6, 0x9c, 0xfc,
+    0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d,
+    0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70,
+    0x2c, 0x7d, 0x39, 0xf2, 0x33, 0x69,
+    0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30,
+    0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+    0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b,
+    0xe9, 0xfc, 0xda, 0x6c, 0x19, 0x07,
+    0x8c, 0x6a, 0x9d, 0x1b
+  },
+  //
+  // Key
+  //
+  {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca,
+    0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0,
+    0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35,
+    0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14,
+    0xdf, 0xf4
+  }
+};
+
+//
+// NIST SP 800-38A F.5.3 CTR-AES192.Encrypt
+//
+AES_SAMPLE AesCtr192Sample = {
+  AES_192_KEY_SIZE,
+  //
+  // IV
+  //
+  {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5,
+    0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb,
+    0xfc, 0xfd, 0xfe, 0xff
+  },
+  //
+  // Plain text
+  //
+  {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40,
+    0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11,
+    0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d,
+    0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf,
+    0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46,
+    0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+    0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f,
+    0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b,
+    0xe6, 0x6c, 0x37, 0x10
+  },
+  //
+  // Cipher text
+  //
+  {
+    0x1a, 0xbc, 0x93, 0x24, 0x17, 0x52,
+    0x1c, 0xa2, 0x4f, 0x2b, 0x04, 0x59,
+    0xfe, 0x7e, 0x6e, 0x0b, 0x09, 0x03,
+    0x39, 0xec, 0x0a, 0xa6, 0xfa, 0xef,
+    0xd5, 0xcc, 0xc2, 0xc6, 0xf4, 0xce,
+    0x8e, 0x94, 0x1e, 0x36, 0xb2, 0x6b,
+    0xd1, 0xeb, 0xc6, 0x70, 0xd1, 0xbd,
+    0x1d, 0x66, 0x56, 0x20, 0xab, 0xf7,
+    0x4f, 0x78, 0xa7, 0xf6, 0xd2, 0x98,
+    0x09, 0x58, 0x5a, 0x97, 0xda, 0xec,
+    0x58, 0xc6, 0xb0, 0x50
+  },
+  //
+  // Key
+  //
+  {
+    0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e,
+    0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b,
+    0x80, 0x90, 0x79, 0xe5, 0x62, 0xf8,
+    0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b
+  }
+};
+
+//
+// NIST SP 800-38A F.5.5 CTR-AES256.Encrypt
+//
+AES_SAMPLE AesCtr256Sample = {
+  AES_256_KEY_SIZE,
+  //
+  // IV
+  //
+  {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5,
+    0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb,
+    0xfc, 0xfd, 0xfe, 0xff
+  },
+  //
+  // Plain text
+  //
+  {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40,
+    0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11,
+    0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d,
+    0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf,
+    0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46,
+    0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+    0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f,
+    0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b,
+    0xe6, 0x6c, 0x37, 0x10
+  },
+  //
+  // Cipher text
+  //
+  {
+    0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57,
+    0x89, 0xa5, 0xb7, 0xa7, 0xf5, 0x04,
+    0xbb, 0xf3, 0xd2, 0x28, 0xf4, 0x43,
+    0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a,
+    0xca, 0x84, 0xe9, 0x90, 0xca, 0xca,
+    0xf5, 0xc5, 0x2b, 0x09, 0x30, 0xda,
+    0xa2, 0x3d, 0xe9, 0x4c, 0xe8, 0x70,
+    0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+    0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a,
+    0xad, 0xa6, 0x13, 0xc2, 0xdd, 0x08,
+    0x45, 0x79, 0x41, 0xa6
+  },
+  //
+  // Key
+  //
+  {
+    0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca,
+    0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0,
+    0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35,
+    0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+    0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14,
+    0xdf, 0xf4
+  }
+};
+
 //
 // Hash algorithms samples
 //
@@ -21,11 +21,13 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/UefiApplicationEntryPoint.h>
+#include <Library/OcCpuLib.h>
 #include <Library/OcCryptoLib.h>
 
 #include <Library/OcMiscLib.h>
 #include <Library/DebugLib.h>
 #include <Library/PrintLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Protocol/SimpleTextInEx.h>
 
@@ -64,6 +66,121 @@ TestRsa2048Sha256Verify (
   return Status;
 }
 
+#define RSA_BENCHMARK_ROUNDS  64
+
+EFI_STATUS
+EFIAPI
+TestRsaPerformance (
+  VOID
+  )
+{
+  EFI_STATUS      Status;
+  UINT8           DataSha256Hash[SHA256_DIGEST_SIZE];
+  RSA_PUBLIC_KEY  *PublicKeys[3];
+  UINT8           *Signatures[3];
+  UINTN           Index;
+  UINTN           Round;
+  UINT64          StartTime;
+  UINT64          VerifyTime;
+  BOOLEAN         SignatureVerified;
+
+  PublicKeys[0] = (RSA_PUBLIC_KEY *) Rsa2048Sha256Sample.PublicKey;
+  Signatures[0] = Rsa2048Sha256Sample.Signature;
+  PublicKeys[1] = (RSA_PUBLIC_KEY *) Rsa3072Sha256Sample.PublicKey;
+  Signatures[1] = Rsa3072Sha256Sample.Signature;
+  PublicKeys[2] = (RSA_PUBLIC_KEY *) Rsa4096Sha256Sample.PublicKey;
+  Signatures[2] = Rsa4096Sha256Sample.Signature;
+
+  Sha256 (
+    DataSha256Hash,
+    Rsa2048Sha256Sample.Data,
+    SIGNED_DATA_LEN
+    );
+
+  Status = EFI_SUCCESS;
+
+  for (Index = 0; Index < ARRAY_SIZE (PublicKeys); Index++) {
+    SignatureVerified = TRUE;
+
+    StartTime = GetPerformanceCounter ();
+    for (Round = 0; Round < RSA_BENCHMARK_ROUNDS; Round++) {
+      SignatureVerified &= RsaVerify (PublicKeys[Index], Signatures[Index], DataSha256Hash);
+    }
+    VerifyTime = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+    if (SignatureVerified) {
+      Print (
+        L"Rsa%uSha256 verification %Lu us\n",
+        RsaGetKeySize (PublicKeys[Index]) * 8,
+        DivU64x32 (VerifyTime, RSA_BENCHMARK_ROUNDS * 1000)
+        );
+    } else {
+      Print (L"Rsa%uSha256 signature verifying failed!\n", RsaGetKeySize (PublicKeys[Index]) * 8);
+      Status = EFI_INVALID_PARAMETER;
+    }
+  }
+
+  return Status;
+}
+
+/**
+  Check encryption and decryption of AES sample with any key size.
+
+  @param[in] Sample  AES sample.
+  @param[in] Name    Mode name to print.
+  @param[in] Ctr     Use CTR mode instead of CBC.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestAesSample (
+  IN CONST AES_SAMPLE  *Sample,
+  IN CONST CHAR16      *Name,
+  IN BOOLEAN           Ctr
+  )
+{
+  AES_CONTEXT  Ctx;
+  UINT8        Data[AES_SAMPLE_DATA_LEN];
+  BOOLEAN      AesTestPassed = TRUE;
+
+  CopyMem (Data, Sample->PlainText, AES_SAMPLE_DATA_LEN);
+  AesInitCtxIvEx (&Ctx, Sample->Key, Sample->KeySize, Sample->IV);
+
+  if (Ctr) {
+    AesCtrXcryptBuffer (&Ctx, Data, AES_SAMPLE_DATA_LEN);
+  } else {
+    AesCbcEncryptBuffer (&Ctx, Data, AES_SAMPLE_DATA_LEN);
+  }
+
+  if (CompareMem (Data, Sample->CipherText, AES_SAMPLE_DATA_LEN) == 0) {
+    Print (L"AES-%u %s encryption test passed\n", Sample->KeySize * 8, Name);
+  } else {
+    Print (L"AES-%u %s encryption test failed\n", Sample->KeySize * 8, Name);
+    AesTestPassed = FALSE;
+  }
+
+  ZeroMem (&Ctx, sizeof (Ctx));
+  AesInitCtxIvEx (&Ctx, Sample->Key, Sample->KeySize, Sample->IV);
+
+  if (Ctr) {
+    AesCtrXcryptBuffer (&Ctx, Data, AES_SAMPLE_DATA_LEN);
+  } else {
+    AesCbcDecryptBuffer (&Ctx, Data, AES_SAMPLE_DATA_LEN);
+  }
+
+  if (CompareMem (Data, Sample->PlainText, AES_SAMPLE_DATA_LEN) == 0) {
+    Print (L"AES-%u %s decryption test passed\n", Sample->KeySize * 8, Name);
+  } else {
+    Print (L"AES-%u %s decryption test failed\n", Sample->KeySize * 8, Name);
+    AesTestPassed = FALSE;
+  }
+
+  ZeroMem (&Ctx, sizeof (Ctx));
+
+  return AesTestPassed;
+}
+
 EFI_STATUS
 EFIAPI
 TestAesCtr (
@@ -120,6 +237,17 @@ TestAesCtr (
     AesTestPassed = FALSE;
   }
 
+  //
+  // NIST SP 800-38A AES-192 and AES-256 CTR samples
+  //
+  if (!TestAesSample (&AesCtr192Sample, L"CTR", TRUE)) {
+    AesTestPassed = FALSE;
+  }
+
+  if (!TestAesSample (&AesCtr256Sample, L"CTR", TRUE)) {
+    AesTestPassed = FALSE;
+  }
+
   //
   // Clean context on exit
   //
@@ -190,6 +318,17 @@ TestAesCbc (
     AesTestPassed = FALSE;
   }
 
+  //
+  // NIST SP 800-38A AES-192 and AES-256 CBC samples
+  //
+  if (!TestAesSample (&AesCbc192Sample, L"CBC", FALSE)) {
+    AesTestPassed = FALSE;
+  }
+
+  if (!TestAesSample (&AesCbc256Sample, L"CBC", FALSE)) {
+    AesTestPassed = FALSE;
+  }
+
   //
   // Clean context on exit
   //
@@ -205,6 +344,129 @@ TestAesCbc (
 }
 
 
+#define AES_BENCHMARK_SIZE  (16 * 1024 * 1024)
+
+EFI_STATUS
+EFIAPI
+TestAesPerformance (
+  VOID
+  )
+{
+  UINT8        *Data;
+  UINTN        Index;
+  UINT32       KeySize;
+  UINT64       StartTime;
+  UINT64       CbcTime;
+  UINT64       CtrTime;
+  AES_CONTEXT  Ctx;
+
+  Data = AllocatePool (AES_BENCHMARK_SIZE);
+  if (Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < AES_BENCHMARK_SIZE; Index++) {
+    Data[Index] = (UINT8) Index;
+  }
+
+  for (KeySize = AES_128_KEY_SIZE; KeySize <= AES_256_KEY_SIZE; KeySize += 8) {
+    //
+    // Key contents do not matter for throughput, reuse the sample data.
+    //
+    AesInitCtxIvEx (&Ctx, Data, KeySize, Data + AES_256_KEY_SIZE);
+
+    StartTime = GetPerformanceCounter ();
+    AesCbcDecryptBuffer (&Ctx, Data, AES_BENCHMARK_SIZE);
+    CbcTime = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+    StartTime = GetPerformanceCounter ();
+    AesCtrXcryptBuffer (&Ctx, Data, AES_BENCHMARK_SIZE);
+    CtrTime = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+    //
+    // Report throughput in KB/s to avoid floating point.
+    //
+    Print (
+      L"AES-%u CBC decrypt %Lu KB/s, CTR %Lu KB/s\n",
+      KeySize * 8,
+      DivU64x64Remainder (MultU64x32 (AES_BENCHMARK_SIZE / 1024, 1000000), MAX (CbcTime / 1000, 1), NULL),
+      DivU64x64Remainder (MultU64x32 (AES_BENCHMARK_SIZE / 1024, 1000000), MAX (CtrTime / 1000, 1), NULL)
+      );
+  }
+
+  FreePool (Data);
+
+  return EFI_SUCCESS;
+}
+
+#define HASH_SPLIT_DATA_LEN  1000
+
+/**
+  Check that hashing in pieces gives the same digests as hashing at once.
+  Piece sizes cover partial, exact, and overflowing 64-byte blocks.
+
+  @retval TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestHashSplit (
+  VOID
+  )
+{
+  STATIC CONST UINTN  SplitSizes[] = { 1, 63, 64, 65, 127 };
+
+  UINT8           Data[HASH_SPLIT_DATA_LEN];
+  UINT8           Md5Hash[MD5_DIGEST_SIZE];
+  UINT8           Sha1Hash[SHA1_DIGEST_SIZE];
+  UINT8           Sha256Hash[SHA256_DIGEST_SIZE];
+  UINT8           Md5SplitHash[MD5_DIGEST_SIZE];
+  UINT8           Sha1SplitHash[SHA1_DIGEST_SIZE];
+  UINT8           Sha256SplitHash[SHA256_DIGEST_SIZE];
+  MD5_CONTEXT     Md5Ctx;
+  SHA1_CONTEXT    Sha1Ctx;
+  SHA256_CONTEXT  Sha256Ctx;
+  UINTN           Index;
+  UINTN           Offset;
+  UINTN           Size;
+  BOOLEAN         HashTestPassed = TRUE;
+
+  for (Index = 0; Index < HASH_SPLIT_DATA_LEN; Index++) {
+    Data[Index] = (UINT8) (Index * 7 + 3);
+  }
+
+  Md5 (Md5Hash, Data, HASH_SPLIT_DATA_LEN);
+  Sha1 (Sha1Hash, Data, HASH_SPLIT_DATA_LEN);
+  Sha256 (Sha256Hash, Data, HASH_SPLIT_DATA_LEN);
+
+  for (Index = 0; Index < ARRAY_SIZE (SplitSizes); Index++) {
+    Md5Init (&Md5Ctx);
+    Sha1Init (&Sha1Ctx);
+    Sha256Init (&Sha256Ctx);
+
+    for (Offset = 0; Offset < HASH_SPLIT_DATA_LEN; Offset += Size) {
+      Size = MIN (SplitSizes[Index], HASH_SPLIT_DATA_LEN - Offset);
+      Md5Update (&Md5Ctx, &Data[Offset], Size);
+      Sha1Update (&Sha1Ctx, &Data[Offset], Size);
+      Sha256Update (&Sha256Ctx, &Data[Offset], Size);
+    }
+
+    Md5Final (&Md5Ctx, Md5SplitHash);
+    Sha1Final (&Sha1Ctx, Sha1SplitHash);
+    Sha256Final (&Sha256Ctx, Sha256SplitHash);
+
+    if (CompareMem (Md5SplitHash, Md5Hash, MD5_DIGEST_SIZE) == 0
+      && CompareMem (Sha1SplitHash, Sha1Hash, SHA1_DIGEST_SIZE) == 0
+      && CompareMem (Sha256SplitHash, Sha256Hash, SHA256_DIGEST_SIZE) == 0) {
+      Print (L"Hash update by %lu bytes test passed\n", SplitSizes[Index]);
+    } else {
+      Print (L"Hash update by %lu bytes test failed\n", SplitSizes[Index]);
+      HashTestPassed = FALSE;
+    }
+  }
+
+  return HashTestPassed;
+}
+
 EFI_STATUS
 EFIAPI
 TestHash (
@@ -276,6 +538,10 @@ TestHash (
     ZeroMem (Sha256Hash, SHA256_DIGEST_SIZE);
   }
 
+  if (!TestHashSplit ()) {
+    HashTestPassed = FALSE;
+  }
+
   if (HashTestPassed) {
     Status = EFI_SUCCESS;
   } else {
@@ -292,6 +558,89 @@ TestHash (
   return Status;
 }
 
+#define HASH_BENCHMARK_SIZE  (16 * 1024 * 1024)
+
+EFI_STATUS
+EFIAPI
+TestHashPerformance (
+  VOID
+  )
+{
+  UINT8        *Data;
+  UINTN        Index;
+  UINT64       StartTime;
+  UINT64       Md5Time;
+  UINT64       Sha1Time;
+  UINT64       Sha256Time;
+  UINT8        Hash[SHA256_DIGEST_SIZE];
+
+  Data = AllocatePool (HASH_BENCHMARK_SIZE);
+  if (Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < HASH_BENCHMARK_SIZE; Index++) {
+    Data[Index] = (UINT8) Index;
+  }
+
+  StartTime = GetPerformanceCounter ();
+  Md5 (Hash, Data, HASH_BENCHMARK_SIZE);
+  Md5Time = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+  StartTime = GetPerformanceCounter ();
+  Sha1 (Hash, Data, HASH_BENCHMARK_SIZE);
+  Sha1Time = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+  StartTime = GetPerformanceCounter ();
+  Sha256 (Hash, Data, HASH_BENCHMARK_SIZE);
+  Sha256Time = GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+
+  FreePool (Data);
+
+  //
+  // Report throughput in KB/s to avoid floating point.
+  //
+  Print (
+    L"Md5 %Lu KB/s, Sha1 %Lu KB/s, Sha256 %Lu KB/s\n",
+    DivU64x64Remainder (MultU64x32 (HASH_BENCHMARK_SIZE / 1024, 1000000), MAX (Md5Time / 1000, 1), NULL),
+    DivU64x64Remainder (MultU64x32 (HASH_BENCHMARK_SIZE / 1024, 1000000), MAX (Sha1Time / 1000, 1), NULL),
+    DivU64x64Remainder (MultU64x32 (HASH_BENCHMARK_SIZE / 1024, 1000000), MAX (Sha256Time / 1000, 1), NULL)
+    );
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+TestAcceleration (
+  VOID
+  )
+{
+  EFI_STATUS   Status;
+  OC_CPU_INFO  CpuInfo;
+
+  OcCpuScanProcessor (&CpuInfo);
+  OcCryptoInitAcceleration (CpuInfo.Features, CpuInfo.ExtFeatures);
+
+  //
+  // Validate accelerated implementations against the same samples.
+  //
+  Status = TestHash ();
+  TestHashPerformance ();
+
+  if (!EFI_ERROR (Status)) {
+    Status = TestAesCbc ();
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = TestAesCtr ();
+  }
+
+  TestAesPerformance ();
+
+  return Status;
+}
+
 EFI_STATUS
 EFIAPI
 UefiDriverMain (
@@ -311,6 +660,11 @@ UefiDriverMain (
     Print(L"All hash tests passed!\n");
   }
 
+  //
+  // Measure hash throughput
+  //
+  TestHashPerformance ();
+
   //
   // Test AES-128-CBC
   //
@@ -331,6 +685,21 @@ UefiDriverMain (
     Print(L"AES-128-CTR passed!\n");
   }
 
+  //
+  // Measure AES throughput
+  //
+  TestAesPerformance ();
+
+  //
+  // Test accelerated algorithms
+  //
+  Status = TestAcceleration ();
+  if (EFI_ERROR(Status)) {
+    Print(L"Accelerated tests failed!\n");
+  } else {
+    Print(L"All accelerated tests passed!\n");
+  }
+
   //
   // Test Rsa2048Sha256 signature
   //
@@ -341,6 +710,16 @@ UefiDriverMain (
     Print(L"Rsa2048Sha256 passed!\n");
   }
 
+  //
+  // Test RSA key sizes and measure verification latency
+  //
+  Status = TestRsaPerformance ();
+  if (EFI_ERROR(Status)) {
+    Print(L"RsaSha256 failed!\n");
+  } else {
+    Print(L"RsaSha256 passed!\n");
+  }
+
   return Status;
 }
 
@@ -368,6 +747,13 @@ UefiAppMain (
 
   WaitForKeyPress (L"Press any key...");
 
+  //
+  // Measure hash throughput
+  //
+  TestHashPerformance ();
+
+  WaitForKeyPress (L"Press any key...");
+
   //
   // Test AES-128-CBC
   //
@@ -392,6 +778,25 @@ UefiAppMain (
 
   WaitForKeyPress (L"Press any key...");
 
+  //
+  // Measure AES throughput
+  //
+  TestAesPerformance ();
+
+  WaitForKeyPress (L"Press any key...");
+
+  //
+  // Test accelerated algorithms
+  //
+  Status = TestAcceleration ();
+  if (EFI_ERROR(Status)) {
+    Print(L"Accelerated tests failed!\n");
+  } else {
+    Print(L"All accelerated tests passed!\n");
+  }
+
+  WaitForKeyPress (L"Press any key...");
+
   //
   // Test Rsa2048Sha256 signature
   //
@@ -401,6 +806,18 @@ UefiAppMain (
   } else {
     Print(L"Rsa2048Sha256 passed!\n");
   }
+
+  WaitForKeyPress (L"Press any key...");
+
+  //
+  // Test RSA key sizes and measure verification latency
+  //
+  Status = TestRsaPerformance ();
+  if (EFI_ERROR(Status)) {
+    Print(L"RsaSha256 failed!\n");
+  } else {
+    Print(L"RsaSha256 passed!\n");
+  }
   WaitForKeyPress (L"Press any key to exit");
 
 
@@ -0,0 +1,340 @@
+/** @file
+  Copyright (C) 2019, vit9696. All rights reserved.
+
+  All rights reserved.
+
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+**/
+
+#include <Library/OcMiscLib.h>
+
+/*
+ clang -g -fsanitize=undefined,address -I../Include -I../../Include -I../../../MdePkg/Include/ -include ../Include/Base.h DataPatcher.c ../../Library/OcMiscLib/DataPatcher.c -o DataPatcher
+
+ for fuzzing:
+ clang-mp-7.0 -Dmain=__main -g -fsanitize=undefined,address,fuzzer -I../Include -I../../Include -I../../../MdePkg/Include/ -include ../Include/Base.h DataPatcher.c ../../Library/OcMiscLib/DataPatcher.c -o DataPatcher
+ rm -rf DICT fuzz*.log ; mkdir DICT ; ./DataPatcher -jobs=4 DICT
+
+ rm -rf DataPatcher.dSYM DICT fuzz*.log DataPatcher
+*/
+
+#define MAX_TEST_PATCHES  8
+#define MAX_TEST_PATTERN  8
+
+//
+// Pattern bytes of every random patch after its marker are in 0-3 range,
+// marker bytes start at 0xF0. Masks only clear the two lower bits.
+// This way matching areas of different patches never overlap and
+// ApplyPatches must be equal to sequential ApplyPatch calls.
+//
+#define TEST_MARKER_BASE  0xF0U
+
+typedef struct {
+  UINT8  Pattern[MAX_TEST_PATTERN];
+  UINT8  PatternMask[MAX_TEST_PATTERN];
+  UINT8  Replace[MAX_TEST_PATTERN];
+  UINT8  ReplaceMask[MAX_TEST_PATTERN];
+} TEST_PATCH_DATA;
+
+STATIC UINT32 mFailures;
+
+STATIC
+VOID
+ApplySequential (
+  IN     CONST PATTERN_PATCH  *Patches,
+  IN     UINT32               PatchCount,
+  IN OUT UINT8                *Data,
+  IN     UINT32               DataSize,
+     OUT UINT32               *ReplaceCounts
+  )
+{
+  UINT32  Index;
+  UINT32  Size;
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    Size = DataSize;
+    if (Patches[Index].Limit > 0 && Patches[Index].Limit < DataSize) {
+      Size = Patches[Index].Limit;
+    }
+
+    ReplaceCounts[Index] = ApplyPatch (
+      Patches[Index].Pattern,
+      Patches[Index].PatternMask,
+      Patches[Index].PatternSize,
+      Patches[Index].Replace,
+      Patches[Index].ReplaceMask,
+      Data,
+      Size,
+      Patches[Index].Count,
+      Patches[Index].Skip
+      );
+  }
+}
+
+STATIC
+VOID
+ApplySinglePass (
+  IN     CONST PATTERN_PATCH  *Patches,
+  IN     UINT32               PatchCount,
+  IN OUT UINT8                *Data,
+  IN     UINT32               DataSize,
+     OUT UINT32               *ReplaceCounts
+  )
+{
+  PATTERN_MATCHER  Matcher;
+  RETURN_STATUS    Status;
+
+  Status = PatternMatcherInit (&Matcher, Patches, PatchCount);
+  if (RETURN_ERROR (Status)) {
+    printf ("PatternMatcherInit failed - %d\n", (int) Status);
+    ++mFailures;
+    return;
+  }
+
+  ApplyPatches (&Matcher, Data, DataSize, NULL, ReplaceCounts);
+  PatternMatcherFree (&Matcher);
+}
+
+/**
+  Run both patching modes on a copy of Data and compare results
+  with expectations or with each other when both are NULL.
+**/
+STATIC
+BOOLEAN
+CheckPatches (
+  IN CONST CHAR8          *Name,
+  IN CONST PATTERN_PATCH  *Patches,
+  IN UINT32               PatchCount,
+  IN CONST UINT8          *Data,
+  IN UINT32               DataSize,
+  IN CONST UINT8          *SequentialResult  OPTIONAL,
+  IN CONST UINT8          *SinglePassResult  OPTIONAL
+  )
+{
+  UINT8    *Sequential;
+  UINT8    *SinglePass;
+  UINT32   SequentialCounts[MAX_TEST_PATCHES];
+  UINT32   SinglePassCounts[MAX_TEST_PATCHES];
+  BOOLEAN  Success;
+
+  Sequential = AllocateCopyPool (DataSize, Data);
+  SinglePass = AllocateCopyPool (DataSize, Data);
+  if (Sequential == NULL || SinglePass == NULL) {
+    abort ();
+  }
+
+  ApplySequential (Patches, PatchCount, Sequential, DataSize, SequentialCounts);
+  ApplySinglePass (Patches, PatchCount, SinglePass, DataSize, SinglePassCounts);
+
+  if (SequentialResult == NULL && SinglePassResult == NULL) {
+    Success = CompareMem (Sequential, SinglePass, DataSize) == 0
+      && CompareMem (SequentialCounts, SinglePassCounts, PatchCount * sizeof (UINT32)) == 0;
+  } else {
+    Success = CompareMem (Sequential, SequentialResult, DataSize) == 0
+      && CompareMem (SinglePass, SinglePassResult, DataSize) == 0;
+  }
+
+  if (!Success) {
+    printf ("%s: mismatch\n", Name);
+    ++mFailures;
+  }
+
+  FreePool (Sequential);
+  FreePool (SinglePass);
+
+  return Success;
+}
+
+#define PATCH(Find, Repl) \
+  { (CONST UINT8 *) (Find), NULL, (CONST UINT8 *) (Repl), NULL, sizeof (Find) - 1, 0, 0, 0 }
+
+#define CHECK_PATCHES(Name, Patches, Data, Sequential, SinglePass) \
+  CheckPatches ( \
+    (Name), \
+    (Patches), \
+    ARRAY_SIZE (Patches), \
+    (CONST UINT8 *) (Data), \
+    sizeof (Data) - 1, \
+    (CONST UINT8 *) (Sequential), \
+    (CONST UINT8 *) (SinglePass) \
+    )
+
+STATIC
+VOID
+TestOverlappingPatches (
+  VOID
+  )
+{
+  //
+  // Preceding patch creates a match at the same offset: equal.
+  //
+  STATIC CONST PATTERN_PATCH ChainForward[] = {
+    PATCH ("AB", "CD"),
+    PATCH ("CD", "EF")
+  };
+  //
+  // Following patch creates a match of a preceding patch at the same offset: equal.
+  //
+  STATIC CONST PATTERN_PATCH ChainBackward[] = {
+    PATCH ("CD", "EF"),
+    PATCH ("AB", "CD")
+  };
+  //
+  // Overlapping findings of a single patch: equal.
+  //
+  STATIC CONST PATTERN_PATCH SelfOverlap[] = {
+    PATCH ("AA", "AB")
+  };
+  //
+  // Following patch at a lower offset creates a match of a preceding patch.
+  //
+  STATIC CONST PATTERN_PATCH LowerCreates[] = {
+    PATCH ("ZC", "YY"),
+    PATCH ("AB", "AZ")
+  };
+  //
+  // Following patch at a lower offset destroys a match of a preceding patch.
+  //
+  STATIC CONST PATTERN_PATCH LowerDestroys[] = {
+    PATCH ("BC", "XX"),
+    PATCH ("AB", "AZ")
+  };
+  //
+  // Preceding patch at a higher offset creates a match of a following patch.
+  //
+  STATIC CONST PATTERN_PATCH HigherCreates[] = {
+    PATCH ("CD", "CE"),
+    PATCH ("BCE", "QQQ")
+  };
+  //
+  // Preceding patch at a higher offset destroys a match of a following patch.
+  //
+  STATIC CONST PATTERN_PATCH HigherDestroys[] = {
+    PATCH ("CD", "XX"),
+    PATCH ("BCD", "QQQ")
+  };
+
+  CHECK_PATCHES ("ChainForward", ChainForward, "xABx", "xEFx", "xEFx");
+  CHECK_PATCHES ("ChainBackward", ChainBackward, "xABx", "xCDx", "xCDx");
+  CHECK_PATCHES ("SelfOverlap", SelfOverlap, "AAAAx", "ABABx", "ABABx");
+  CHECK_PATCHES ("LowerCreates", LowerCreates, "ABCx", "AZCx", "AYYx");
+  CHECK_PATCHES ("LowerDestroys", LowerDestroys, "ABCx", "AXXx", "AZCx");
+  CHECK_PATCHES ("HigherCreates", HigherCreates, "BCDx", "QQQx", "BCEx");
+  CHECK_PATCHES ("HigherDestroys", HigherDestroys, "BCDx", "BXXx", "QQQx");
+}
+
+STATIC
+UINT32
+NextRandom (
+  IN OUT UINT32  *Seed
+  )
+{
+  *Seed = *Seed * 1103515245U + 12345U;
+  return *Seed >> 16U;
+}
+
+/**
+  Build non-overlapping patches from a seed and compare both modes on Data.
+**/
+STATIC
+VOID
+TestDisjointPatches (
+  IN OUT UINT32  *Seed,
+  IN     UINT8   *Data,
+  IN     UINT32  DataSize
+  )
+{
+  TEST_PATCH_DATA  PatchData[MAX_TEST_PATCHES];
+  PATTERN_PATCH    Patches[MAX_TEST_PATCHES];
+  UINT32           PatchCount;
+  UINT32           Index;
+  UINT32           ByteIndex;
+
+  PatchCount = 1 + NextRandom (Seed) % MAX_TEST_PATCHES;
+
+  for (Index = 0; Index < PatchCount; ++Index) {
+    Patches[Index].PatternSize = 1 + NextRandom (Seed) % MAX_TEST_PATTERN;
+    Patches[Index].Count       = NextRandom (Seed) % 4;
+    Patches[Index].Skip        = NextRandom (Seed) % 3;
+    Patches[Index].Limit       = NextRandom (Seed) % 2 == 0 ? 0 : NextRandom (Seed) % (DataSize + 1);
+
+    PatchData[Index].Pattern[0]     = (UINT8) (TEST_MARKER_BASE + Index);
+    PatchData[Index].PatternMask[0] = 0xFF;
+    PatchData[Index].Replace[0]     = (UINT8) (TEST_MARKER_BASE + Index);
+    PatchData[Index].ReplaceMask[0] = 0xFF;
+
+    for (ByteIndex = 1; ByteIndex < Patches[Index].PatternSize; ++ByteIndex) {
+      PatchData[Index].Pattern[ByteIndex]     = (UINT8) (NextRandom (Seed) % 4);
+      PatchData[Index].PatternMask[ByteIndex] = NextRandom (Seed) % 4 == 0 ? 0xFC : 0xFF;
+      PatchData[Index].Replace[ByteIndex]     = (UINT8) (NextRandom (Seed) % 4);
+      PatchData[Index].ReplaceMask[ByteIndex] = NextRandom (Seed) % 4 == 0 ? 0xFC : 0xFF;
+    }
+
+    Patches[Index].Pattern     = PatchData[Index].Pattern;
+    Patches[Index].PatternMask = NextRandom (Seed) % 2 == 0 ? NULL : PatchData[Index].PatternMask;
+    Patches[Index].Replace     = PatchData[Index].Replace;
+    Patches[Index].ReplaceMask = NextRandom (Seed) % 2 == 0 ? NULL : PatchData[Index].ReplaceMask;
+  }
+
+  for (Index = 0; Index < DataSize; ++Index) {
+    if ((Data[Index] & 0x80U) != 0) {
+      Data[Index] = (UINT8) (TEST_MARKER_BASE + Data[Index] % PatchCount);
+    } else {
+      Data[Index] &= 3U;
+    }
+  }
+
+  CheckPatches ("Disjoint", Patches, PatchCount, Data, DataSize, NULL, NULL);
+}
+
+int main(int argc, char** argv) {
+  UINT32  Seed;
+  UINT32  Iteration;
+  UINT32  Index;
+  UINT8   Data[256];
+
+  TestOverlappingPatches ();
+
+  Seed = 1;
+  for (Iteration = 0; Iteration < 100000; ++Iteration) {
+    for (Index = 0; Index < sizeof (Data); ++Index) {
+      Data[Index] = (UINT8) (NextRandom (&Seed) % 3 == 0 ? 0x80 | NextRandom (&Seed) : NextRandom (&Seed));
+    }
+    TestDisjointPatches (&Seed, Data, 1 + NextRandom (&Seed) % sizeof (Data));
+  }
+
+  if (mFailures > 0) {
+    printf ("%u failures\n", mFailures);
+    return -1;
+  }
+
+  printf ("All tests passed\n");
+  return 0;
+}
+
+INT32 LLVMFuzzerTestOneInput(CONST UINT8 *Data, UINTN Size) {
+  UINT32  Seed;
+  UINT8   *NewData;
+
+  if (Size < sizeof (Seed) + 1 || Size > MAX_UINT32) {
+    return 0;
+  }
+
+  CopyMem (&Seed, Data, sizeof (Seed));
+  NewData = AllocateCopyPool (Size - sizeof (Seed), Data + sizeof (Seed));
+  if (NewData != NULL) {
+    TestDisjointPatches (&Seed, NewData, (UINT32) (Size - sizeof (Seed)));
+    if (mFailures > 0) {
+      abort ();
+    }
+    FreePool (NewData);
+  }
+
+  return 0;
+}
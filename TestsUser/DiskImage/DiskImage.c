@@ -6,11 +6,16 @@
 #include <Library/OcAppleKeysLib.h>
 #include <Library/OcCompressionLib.h>
 
+#include <pthread.h>
+#include <time.h>
+
+#include "DiskImageSamples.h"
+
 /**
 
-clang -g -fsanitize=undefined,address -Wno-incompatible-pointer-types-discards-qualifiers -fshort-wchar -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h DiskImage.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLibInternal.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcCompressionLib/zlib/zlib_uefi.c ../../Library/OcCompressionLib/zlib/adler32.c ../../Library/OcCompressionLib/zlib/deflate.c ../../Library/OcCompressionLib/zlib/crc32.c  ../../Library/OcCompressionLib/zlib/compress.c ../../Library/OcCompressionLib/zlib/infback.c ../../Library/OcCompressionLib/zlib/inffast.c  ../../Library/OcCompressionLib/zlib/inflate.c  ../../Library/OcCompressionLib/zlib/inftrees.c ../../Library/OcCompressionLib/zlib/trees.c ../../Library/OcCompressionLib/zlib/uncompr.c ../../Library/OcCryptoLib/Sha256.c  ../../Library/OcCryptoLib/Rsa2048Sha256.c ../../Library/OcAppleKeysLib/OcAppleKeysLib.c ../../Library/OcAppleChunklistLib/OcAppleChunklistLib.c ../../Library/OcAppleRamDiskLib/OcAppleRamDiskLib.c ../../Library/OcFileLib/ReadFile.c ../../Library/OcFileLib/FileProtocol.c -o DiskImage
+clang -g -fsanitize=undefined,address -Wno-incompatible-pointer-types-discards-qualifiers -fshort-wchar -pthread -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h DiskImage.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLibInternal.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcCompressionLib/zlib/zlib_uefi.c ../../Library/OcCompressionLib/zlib/adler32.c ../../Library/OcCompressionLib/zlib/deflate.c ../../Library/OcCompressionLib/zlib/crc32.c  ../../Library/OcCompressionLib/zlib/compress.c ../../Library/OcCompressionLib/zlib/infback.c ../../Library/OcCompressionLib/zlib/inffast.c  ../../Library/OcCompressionLib/zlib/inflate.c  ../../Library/OcCompressionLib/zlib/inftrees.c ../../Library/OcCompressionLib/zlib/trees.c ../../Library/OcCompressionLib/zlib/uncompr.c ../../Library/OcCompressionLib/adc/adc.c ../../Library/OcCompressionLib/bzip2/bzip2.c ../../Library/OcCompressionLib/lzfse/lzfse.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Library/OcCryptoLib/Sha256.c  ../../Library/OcCryptoLib/Rsa2048Sha256.c ../../Library/OcAppleKeysLib/OcAppleKeysLib.c ../../Library/OcAppleChunklistLib/OcAppleChunklistLib.c ../../Library/OcAppleRamDiskLib/OcAppleRamDiskLib.c ../../Library/OcFileLib/ReadFile.c ../../Library/OcFileLib/FileProtocol.c -o DiskImage
 
-clang-mp-7.0 -DFUZZING_TEST=1 -g -fsanitize=undefined,address,fuzzer -Wno-incompatible-pointer-types-discards-qualifiers -fshort-wchar -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h DiskImage.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLibInternal.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcCompressionLib/zlib/zlib_uefi.c ../../Library/OcCompressionLib/zlib/adler32.c ../../Library/OcCompressionLib/zlib/deflate.c ../../Library/OcCompressionLib/zlib/crc32.c  ../../Library/OcCompressionLib/zlib/compress.c ../../Library/OcCompressionLib/zlib/infback.c ../../Library/OcCompressionLib/zlib/inffast.c  ../../Library/OcCompressionLib/zlib/inflate.c  ../../Library/OcCompressionLib/zlib/inftrees.c ../../Library/OcCompressionLib/zlib/trees.c ../../Library/OcCompressionLib/zlib/uncompr.c ../../Library/OcCryptoLib/Sha256.c  ../../Library/OcCryptoLib/Rsa2048Sha256.c ../../Library/OcAppleKeysLib/OcAppleKeysLib.c ../../Library/OcAppleChunklistLib/OcAppleChunklistLib.c ../../Library/OcAppleRamDiskLib/OcAppleRamDiskLib.c../../Library/OcFileLib/ReadFile.c ../../Library/OcFileLib/FileProtocol.c -o DiskImage
+clang-mp-7.0 -DFUZZING_TEST=1 -g -fsanitize=undefined,address,fuzzer -Wno-incompatible-pointer-types-discards-qualifiers -fshort-wchar -pthread -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h DiskImage.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLib.c ../../Library/OcAppleDiskImageLib/OcAppleDiskImageLibInternal.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcCompressionLib/zlib/zlib_uefi.c ../../Library/OcCompressionLib/zlib/adler32.c ../../Library/OcCompressionLib/zlib/deflate.c ../../Library/OcCompressionLib/zlib/crc32.c  ../../Library/OcCompressionLib/zlib/compress.c ../../Library/OcCompressionLib/zlib/infback.c ../../Library/OcCompressionLib/zlib/inffast.c  ../../Library/OcCompressionLib/zlib/inflate.c  ../../Library/OcCompressionLib/zlib/inftrees.c ../../Library/OcCompressionLib/zlib/trees.c ../../Library/OcCompressionLib/zlib/uncompr.c ../../Library/OcCompressionLib/adc/adc.c ../../Library/OcCompressionLib/bzip2/bzip2.c ../../Library/OcCompressionLib/lzfse/lzfse.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Library/OcCryptoLib/Sha256.c  ../../Library/OcCryptoLib/Rsa2048Sha256.c ../../Library/OcAppleKeysLib/OcAppleKeysLib.c ../../Library/OcAppleChunklistLib/OcAppleChunklistLib.c ../../Library/OcAppleRamDiskLib/OcAppleRamDiskLib.c../../Library/OcFileLib/ReadFile.c ../../Library/OcFileLib/FileProtocol.c -o DiskImage
 rm -rf DICT fuzz*.log ; mkdir DICT ; UBSAN_OPTIONS='halt_on_error=1' ./DiskImage -jobs=4 DICT -rss_limit_mb=4096
 
 **/
@@ -46,7 +51,201 @@ uint8_t *readFile(const char *str, long *size) {
 #include <CommonCrypto/CommonDigest.h>
 #endif
 
+//
+// User-space stand-in for MP services, APs are emulated with threads.
+//
+#define TEST_MP_AP_COUNT 3
+
+//
+// Firmware MP services reap APs and signal the event from a periodic timer,
+// until then APs stay busy. Emulate this with a shorter delay.
+//
+#define TEST_MP_REAP_DELAY_NS 10000000
+
+STATIC volatile BOOLEAN mTestMpBusy;
+
+typedef struct {
+  EFI_AP_PROCEDURE  Procedure;
+  VOID              *Argument;
+  EFI_EVENT         WaitEvent;
+} TEST_MP_JOB;
+
+STATIC void *TestMpThread (void *Arg) {
+  TEST_MP_JOB *Job = Arg;
+  Job->Procedure (Job->Argument);
+  return NULL;
+}
+
+STATIC UINTN TestMpRunAll (TEST_MP_JOB *Job) {
+  pthread_t   Threads[TEST_MP_AP_COUNT];
+  UINTN       Count;
+
+  for (Count = 0; Count < TEST_MP_AP_COUNT; ++Count) {
+    if (pthread_create (&Threads[Count], NULL, TestMpThread, Job) != 0) {
+      break;
+    }
+  }
+
+  for (UINTN Index = 0; Index < Count; ++Index) {
+    pthread_join (Threads[Index], NULL);
+  }
+
+  return Count;
+}
+
+STATIC void *TestMpWaitThread (void *Arg) {
+  TEST_MP_JOB     *Job  = Arg;
+  struct timespec Delay = { 0, TEST_MP_REAP_DELAY_NS };
+  TestMpRunAll (Job);
+  nanosleep (&Delay, NULL);
+  __atomic_store_n (&mTestMpBusy, FALSE, __ATOMIC_RELEASE);
+  gBS->SignalEvent (Job->WaitEvent);
+  free (Job);
+  return NULL;
+}
+
+STATIC EFI_STATUS EFIAPI TestMpStartupAllAPs (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  IN  EFI_AP_PROCEDURE          Procedure,
+  IN  BOOLEAN                   SingleThread,
+  IN  EFI_EVENT                 WaitEvent OPTIONAL,
+  IN  UINTN                     TimeoutInMicroSeconds,
+  IN  VOID                      *ProcedureArgument OPTIONAL,
+  OUT UINTN                     **FailedCpuList OPTIONAL
+  ) {
+  TEST_MP_JOB Job = { Procedure, ProcedureArgument, WaitEvent };
+  TEST_MP_JOB *AsyncJob;
+  pthread_t   Thread;
+  UINTN       Count;
+
+  if (SingleThread) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (__atomic_exchange_n (&mTestMpBusy, TRUE, __ATOMIC_ACQUIRE)) {
+    return EFI_NOT_READY;
+  }
+
+  //
+  // Non-blocking mode returns at once and signals the event late after APs finish.
+  //
+  if (WaitEvent != NULL) {
+    AsyncJob = malloc (sizeof (*AsyncJob));
+    if (AsyncJob != NULL) {
+      *AsyncJob = Job;
+      if (pthread_create (&Thread, NULL, TestMpWaitThread, AsyncJob) == 0) {
+        pthread_detach (Thread);
+        return EFI_SUCCESS;
+      }
+
+      free (AsyncJob);
+    }
+
+    __atomic_store_n (&mTestMpBusy, FALSE, __ATOMIC_RELEASE);
+    return EFI_NOT_STARTED;
+  }
+
+  Count = TestMpRunAll (&Job);
+  __atomic_store_n (&mTestMpBusy, FALSE, __ATOMIC_RELEASE);
+  return Count > 0 ? EFI_SUCCESS : EFI_NOT_STARTED;
+}
+
+STATIC EFI_STATUS EFIAPI TestMpGetNumberOfProcessors (
+  IN  EFI_MP_SERVICES_PROTOCOL  *This,
+  OUT UINTN                     *NumberOfProcessors,
+  OUT UINTN                     *NumberOfEnabledProcessors
+  ) {
+  *NumberOfProcessors        = TEST_MP_AP_COUNT + 1;
+  *NumberOfEnabledProcessors = TEST_MP_AP_COUNT + 1;
+  return EFI_SUCCESS;
+}
+
+STATIC EFI_MP_SERVICES_PROTOCOL mTestMpServices = {
+  .GetNumberOfProcessors = TestMpGetNumberOfProcessors,
+  .StartupAllAPs         = TestMpStartupAllAPs
+};
+
+STATIC double TestMegabytesPerSecond (UINTN Size, struct timespec *Start, struct timespec *End) {
+  double Seconds = (End->tv_sec - Start->tv_sec) + (End->tv_nsec - Start->tv_nsec) / 1e9;
+  return Seconds > 0 ? Size / Seconds / (1024 * 1024) : 0;
+}
+
+STATIC VOID TestGenerateSample (UINT8 *Buffer) {
+  STATIC CONST CHAR8 *Words[] = {
+    "Apple", "disk", "image", "chunk", "sector", "block", "extent", "OpenCore", "\n", "0123"
+  };
+
+  UINT32 Seed   = 0x2545F491;
+  UINTN  Offset = 0;
+
+  while (Offset < TEST_SAMPLE_SIZE * 3 / 4) {
+    Seed = Seed * 1103515245 + 12345;
+    CONST CHAR8 *Word = Words[(Seed >> 16) % ARRAY_SIZE (Words)];
+    while (*Word != '\0' && Offset < TEST_SAMPLE_SIZE * 3 / 4) {
+      Buffer[Offset++] = *Word++;
+    }
+    if (Offset < TEST_SAMPLE_SIZE * 3 / 4) {
+      Buffer[Offset++] = ' ';
+    }
+  }
+
+  while (Offset < TEST_SAMPLE_SIZE) {
+    Seed = Seed * 1103515245 + 12345;
+    Buffer[Offset++] = (UINT8) (Seed >> 24);
+  }
+}
+
+typedef UINTN (*TEST_DECOMPRESS) (UINT8 *Dst, UINTN DstLen, CONST UINT8 *Src, UINTN SrcLen);
+
+STATIC BOOLEAN TestDecompressSample (CONST CHAR8 *Name, TEST_DECOMPRESS Decompress, CONST UINT8 *Sample, UINTN SampleSize) {
+  UINT8   Expected[TEST_SAMPLE_SIZE];
+  UINT8   Actual[TEST_SAMPLE_SIZE];
+  UINT8   Corrupted[4096];
+  UINTN   Size;
+  UINTN   Index;
+
+  TestGenerateSample (Expected);
+
+  Size = Decompress (Actual, sizeof (Actual), Sample, SampleSize);
+  if (Size != sizeof (Actual) || memcmp (Actual, Expected, sizeof (Actual)) != 0) {
+    printf ("%s sample decompression failed - %lu\n", Name, (unsigned long) Size);
+    return FALSE;
+  }
+
+  //
+  // Data not fitting the buffer and truncated data must be rejected.
+  //
+  if (Decompress (Actual, sizeof (Actual) - 1, Sample, SampleSize) != 0
+    || Decompress (Actual, sizeof (Actual), Sample, SampleSize / 2) == sizeof (Actual)) {
+    printf ("%s sample bounds checking failed\n", Name);
+    return FALSE;
+  }
+
+  //
+  // Corrupted data must never overflow, result is not important.
+  //
+  ASSERT (SampleSize <= sizeof (Corrupted));
+  for (Index = 0; Index < SampleSize * 8; Index += 7) {
+    memcpy (Corrupted, Sample, SampleSize);
+    Corrupted[Index / 8] ^= 1U << (Index % 8);
+    Decompress (Actual, sizeof (Actual), Corrupted, SampleSize);
+  }
+
+  printf ("%s sample decompressed fine\n", Name);
+  return TRUE;
+}
+
+STATIC BOOLEAN TestDecompressSamples (VOID) {
+  return TestDecompressSample ("ADC", DecompressADC, mTestAdcSample, sizeof (mTestAdcSample))
+    && TestDecompressSample ("BZIP2", DecompressBZIP2, mTestBzip2Sample, sizeof (mTestBzip2Sample))
+    && TestDecompressSample ("LZFSE", DecompressLZFSE, mTestLzfseSample, sizeof (mTestLzfseSample));
+}
+
 int main (int argc, char *argv[]) {
+  if (!TestDecompressSamples ()) {
+    return -1;
+  }
+
   if (argc < 2) {
     printf ("Please provide a valid Disk Image path.\n");
     return -1;
@@ -65,7 +264,9 @@ int main (int argc, char *argv[]) {
     long    ChunklistSize;
 
     uint8_t  *UncompDmg = NULL;
+    uint8_t  *UncompDmgMp = NULL;
     uint32_t UncompSize;
+    struct timespec Start, End;
 
     if ((Dmg = readFile (argv[i], &DmgSize)) == NULL) {
       printf ("Read fail\n");
@@ -122,11 +323,18 @@ int main (int argc, char *argv[]) {
         goto ContinueDmgLoop;
       }
 
-      Result = OcAppleDiskImageVerifyData (&DmgContext, &ChunklistContext);
+      Result = OcAppleDiskImageVerifyData (&DmgContext, &ChunklistContext, NULL);
       if (!Result) {
         printf ("Chunklist chunk verification error\n");
         goto ContinueDmgLoop;
       }
+
+      UINT64 FailedChunk;
+      Result = OcAppleChunklistVerifyData (&ChunklistContext, &ExtentTable, &mTestMpServices, &FailedChunk);
+      if (!Result) {
+        printf ("Chunklist MP chunk verification error at %llu\n", (unsigned long long) FailedChunk);
+        goto ContinueDmgLoop;
+      }
     }
 
     UncompSize = (DmgContext.SectorCount * APPLE_DISK_IMAGE_SECTOR_SIZE);
@@ -136,13 +344,36 @@ int main (int argc, char *argv[]) {
       goto ContinueDmgLoop;
     }
 
+    clock_gettime (CLOCK_MONOTONIC, &Start);
     Result = OcAppleDiskImageRead (&DmgContext, 0, UncompSize, UncompDmg);
+    clock_gettime (CLOCK_MONOTONIC, &End);
     if (!Result) {
       printf ("DMG read error\n");
       goto ContinueDmgLoop;
     }
 
-    printf ("Decompressed the entire DMG...\n");
+    printf ("Decompressed the entire DMG at %.2f MB/s...\n", TestMegabytesPerSecond (UncompSize, &Start, &End));
+
+    //
+    // Repeat with chunks decompressed on all emulated processors.
+    //
+    UncompDmgMp = malloc (UncompSize);
+    if (UncompDmgMp == NULL) {
+      printf ("DMG data allocation failed.\n");
+      goto ContinueDmgLoop;
+    }
+
+    OcAppleDiskImageSetMpServices (&DmgContext, &mTestMpServices);
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    Result = OcAppleDiskImageRead (&DmgContext, 0, UncompSize, UncompDmgMp);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    OcAppleDiskImageSetMpServices (&DmgContext, NULL);
+    if (!Result || memcmp (UncompDmg, UncompDmgMp, UncompSize) != 0) {
+      printf ("DMG MP read error\n");
+      goto ContinueDmgLoop;
+    }
+
+    printf ("Decompressed the entire DMG with %d APs at %.2f MB/s...\n", TEST_MP_AP_COUNT, TestMegabytesPerSecond (UncompSize, &Start, &End));
 
 #if 0
     FILE *Fh = fopen("out.bin", "wb");
@@ -175,6 +406,7 @@ int main (int argc, char *argv[]) {
     free (Dmg);
     free (Chunklist);
     free (UncompDmg);
+    free (UncompDmgMp);
   }
 
   return 0;
@@ -193,16 +425,24 @@ INT32 LLVMFuzzerTestOneInput(CONST UINT8 *Data, UINTN Size) {
     return 0;
   }
 
-  for (size_t Index = 0; Index < 4096; ++Index) {
-    ASAN_POISON_MEMORY_REGION (Test + Index, MAX_OUTPUT - Index);
-    UINT32 CurrentLength = DecompressZLIB (
-                           Test,
-                           Index,
-                           Data,
-                           Size
-                           );
-    ASAN_UNPOISON_MEMORY_REGION (Test + Index, MAX_OUTPUT - Index);
-    ASSERT (CurrentLength <= Index);
+  STATIC CONST TEST_DECOMPRESS Decompressors[] = {
+    DecompressZLIB, DecompressADC, DecompressBZIP2, DecompressLZFSE
+  };
+
+  for (size_t Type = 0; Type < ARRAY_SIZE (Decompressors); ++Type) {
+    for (size_t Index = 0; Index < 4096; ++Index) {
+      ASAN_POISON_MEMORY_REGION (Test + Index, MAX_OUTPUT - Index);
+      UINTN CurrentLength = Decompressors[Type] (
+                              Test,
+                              Index,
+                              Data,
+                              Size
+                              );
+      ASAN_UNPOISON_MEMORY_REGION (Test + Index, MAX_OUTPUT - Index);
+      ASSERT (CurrentLength <= Index);
+    }
   }
+
+  FreePool (Test);
   return 0;
 }
@@ -0,0 +1,468 @@
+/** @file
+  Compressed samples for DiskImage decompression tests.
+
+  Every sample decompresses into TEST_SAMPLE_SIZE bytes produced by
+  TestGenerateSample: pseudo-random words followed by pseudo-random bytes.
+  The bzip2 sample is produced by bzip2 -1, the LZFSE sample contains
+  V1, V2, LZVN and uncompressed blocks with matches crossing them.
+**/
+
+#ifndef DISK_IMAGE_SAMPLES_H
+#define DISK_IMAGE_SAMPLES_H
+
+#define TEST_SAMPLE_SIZE 2048
+
+STATIC CONST UINT8 mTestAdcSample[] = {
+  0xFF, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E,
+  0x74, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67,
+  0x65, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x4F, 0x70, 0x65, 0x6E,
+  0x43, 0x6F, 0x72, 0x65, 0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x30, 0x31,
+  0x32, 0x33, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x63, 0x68, 0x75,
+  0x6E, 0x6B, 0x20, 0x0A, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20,
+  0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72,
+  0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65,
+  0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x4F, 0x70,
+  0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20,
+  0x30, 0x31, 0x32, 0x33, 0x20, 0x41, 0x70, 0x70, 0x6C, 0xD2, 0x65, 0x20,
+  0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20,
+  0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20,
+  0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B,
+  0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x63, 0x68, 0x75, 0x6E,
+  0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74,
+  0x6F, 0x72, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x0A, 0x20, 0x64, 0x69,
+  0x73, 0x6B, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x10, 0x3F, 0x8B,
+  0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72,
+  0x1C, 0xC7, 0xC8, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x41, 0x70, 0x70,
+  0x6C, 0x65, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x73, 0x65, 0x63,
+  0x74, 0x6F, 0x72, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x0A, 0x20,
+  0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E,
+  0x74, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20,
+  0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20,
+  0x64, 0x69, 0x73, 0x6B, 0x0C, 0xC7, 0xFF, 0x65, 0x78, 0x74, 0x65, 0x6E,
+  0x74, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x63,
+  0x68, 0x75, 0x6E, 0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x30,
+  0x31, 0x32, 0x33, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x4F, 0x70,
+  0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x0A, 0x20, 0x73, 0x65, 0x63,
+  0x74, 0x6F, 0x72, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x62, 0x6C,
+  0x6F, 0x63, 0x6B, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65,
+  0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E,
+  0x74, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x4F, 0x70, 0x65, 0x6E,
+  0x43, 0x6F, 0x72, 0x65, 0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x65, 0x78,
+  0x74, 0x65, 0x6E, 0x74, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x63,
+  0x68, 0x75, 0x6E, 0x8C, 0x6B, 0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x65,
+  0x78, 0x74, 0x65, 0x6E, 0x74, 0x10, 0x3F, 0xFF, 0x30, 0x31, 0x32, 0x33,
+  0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43,
+  0x6F, 0x72, 0x65, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x64, 0x69,
+  0x73, 0x6B, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x4F, 0x70, 0x65,
+  0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F,
+  0x72, 0x65, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x63, 0x68, 0x75,
+  0x6E, 0x6B, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x30, 0x31, 0x32,
+  0x33, 0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E,
+  0x74, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x62, 0x6C, 0x6F, 0x63,
+  0x6B, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x62, 0x6C, 0x6F, 0x63,
+  0x6B, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x41, 0x70, 0x70,
+  0x6C, 0x65, 0x20, 0x41, 0xFF, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x41, 0x70,
+  0x70, 0x6C, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x62,
+  0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x30,
+  0x31, 0x32, 0x33, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x62, 0x6C,
+  0x6F, 0x63, 0x6B, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x62, 0x6C,
+  0x6F, 0x63, 0x6B, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x62, 0x6C,
+  0x6F, 0x63, 0x6B, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x69, 0x6D,
+  0x61, 0x67, 0x65, 0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x62, 0x6C, 0x6F,
+  0x63, 0x6B, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20,
+  0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20,
+  0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x4F, 0x70, 0x65,
+  0x6E, 0xB1, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65,
+  0x20, 0x0A, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x62, 0x6C,
+  0x6F, 0x63, 0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x69, 0x6D,
+  0x61, 0x67, 0x65, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65,
+  0x20, 0x64, 0x69, 0x73, 0x14, 0xC7, 0x93, 0x69, 0x6D, 0x61, 0x67, 0x65,
+  0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x4F, 0x70, 0x65, 0x6E,
+  0x43, 0x6F, 0x72, 0x18, 0x0F, 0xFF, 0x30, 0x31, 0x32, 0x33, 0x20, 0x64,
+  0x69, 0x73, 0x6B, 0x20, 0x0A, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20,
+  0x30, 0x31, 0x32, 0x33, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x63,
+  0x68, 0x75, 0x6E, 0x6B, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20,
+  0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72,
+  0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72,
+  0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x0A, 0x20, 0x0A, 0x20, 0x41,
+  0x70, 0x70, 0x6C, 0x65, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x4F,
+  0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x63, 0x68, 0x75, 0x6E,
+  0x6B, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x63, 0x68, 0x75, 0x6E,
+  0x6B, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x73, 0x65, 0x63,
+  0x74, 0x6F, 0xFF, 0x72, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20,
+  0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x73, 0x65, 0x63,
+  0x74, 0x6F, 0x72, 0x20, 0x0A, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20,
+  0x0A, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x65, 0x78, 0x74,
+  0x65, 0x6E, 0x74, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x65, 0x78,
+  0x74, 0x65, 0x6E, 0x74, 0x20, 0x64, 0x69, 0x73, 0x6B, 0x20, 0x30, 0x31,
+  0x32, 0x33, 0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x41, 0x70, 0x70,
+  0x6C, 0x65, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x4F, 0x70,
+  0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F,
+  0x72, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x73, 0x65, 0x63,
+  0x74, 0x6F, 0x72, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x73, 0xB0,
+  0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x30,
+  0x31, 0x32, 0x33, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x4F,
+  0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x69, 0x6D, 0x61, 0x67,
+  0x65, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x62, 0x6C, 0x6F, 0x63,
+  0x6B, 0x14, 0x3F, 0xB0, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x65,
+  0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x0A, 0x20, 0x4F, 0x70, 0x65, 0x6E,
+  0x43, 0x6F, 0x72, 0x65, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x62,
+  0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x65,
+  0x78, 0x74, 0x65, 0x6E, 0x74, 0x14, 0xC7, 0x80, 0x0A, 0x14, 0x0F, 0xD6,
+  0x30, 0x31, 0x32, 0x33, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72,
+  0x65, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x30, 0x31, 0x32, 0x33,
+  0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x0A, 0x20, 0x30, 0x31, 0x32,
+  0x33, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x30, 0x31, 0x32,
+  0x33, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74,
+  0x6F, 0x72, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x64, 0x69, 0x73, 0x6B,
+  0x20, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43,
+  0x6F, 0x72, 0x65, 0x0C, 0xC7, 0xD9, 0x30, 0x31, 0x32, 0x33, 0x20, 0x65,
+  0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x0A, 0x20, 0x65, 0x78, 0x74, 0x65,
+  0x6E, 0x74, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20,
+  0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72,
+  0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x64, 0x69, 0x73, 0x6B,
+  0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65,
+  0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x63, 0x68, 0x75, 0x6E,
+  0x6B, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x64, 0x69, 0x73, 0x6B,
+  0x14, 0xC7, 0xD6, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x69, 0x6D, 0x61,
+  0x67, 0x65, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x62, 0x6C, 0x6F,
+  0x63, 0x6B, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x65, 0x78,
+  0x74, 0x65, 0x6E, 0x74, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x65,
+  0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20,
+  0x0A, 0x20, 0x0A, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x65, 0x78,
+  0x74, 0x65, 0x6E, 0x74, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x69,
+  0x6D, 0x61, 0x67, 0x65, 0x20, 0x0A, 0x08, 0x01, 0xFF, 0x63, 0x68, 0x75,
+  0x6E, 0x6B, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x0A, 0x20, 0x64,
+  0x69, 0x73, 0x6B, 0x20, 0x63, 0x68, 0x75, 0x6E, 0x6B, 0x20, 0x64, 0x69,
+  0x73, 0x6B, 0x20, 0x0A, 0x20, 0x69, 0x6D, 0x61, 0x67, 0x65, 0x20, 0x62,
+  0x6C, 0x6F, 0x63, 0x6B, 0x20, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x20, 0x64,
+  0x69, 0x73, 0x6B, 0x20, 0x65, 0x78, 0x74, 0x65, 0x6E, 0x74, 0x20, 0x62,
+  0x6C, 0x55, 0x84, 0x6C, 0xDB, 0xBE, 0xE0, 0x03, 0xF2, 0x91, 0x29, 0x4C,
+  0x07, 0x8D, 0xE0, 0x62, 0xE3, 0x35, 0x74, 0xE4, 0x0E, 0x0C, 0xDA, 0x30,
+  0x05, 0xEB, 0xDE, 0xEA, 0xBD, 0x83, 0x51, 0xB8, 0x01, 0xD0, 0xEB, 0xE3,
+  0xD6, 0x10, 0x82, 0x43, 0xE4, 0x84, 0xE8, 0xAB, 0xA6, 0x0A, 0x9C, 0xB8,
+  0xDD, 0x61, 0x18, 0xB0, 0x78, 0x95, 0x67, 0xEB, 0xF6, 0xEF, 0x57, 0xD9,
+  0x03, 0x6B, 0x5F, 0xA5, 0xB6, 0xFF, 0x7F, 0x26, 0x1F, 0xC9, 0xCD, 0x34,
+  0x4D, 0xB1, 0xF6, 0x2F, 0xDB, 0x5E, 0xAD, 0xC9, 0x51, 0x13, 0xCE, 0x2F,
+  0xBB, 0xA5, 0x01, 0x99, 0x33, 0x0B, 0x43, 0x5B, 0x6F, 0xFE, 0x4A, 0x8C,
+  0x4D, 0x34, 0xAE, 0x2A, 0xFE, 0x5C, 0x47, 0x43, 0x40, 0xE8, 0x18, 0x9A,
+  0xD4, 0x56, 0xDC, 0xCB, 0x18, 0x80, 0xEF, 0xDC, 0x79, 0x1F, 0x29, 0xC9,
+  0x1C, 0x8D, 0xFB, 0x73, 0xFB, 0x74, 0xCD, 0x0B, 0x51, 0xF6, 0x79, 0xC8,
+  0x09, 0x76, 0x5E, 0x99, 0xA7, 0x10, 0x67, 0x22, 0xBA, 0x73, 0x0A, 0x22,
+  0xE3, 0x9D, 0x04, 0x1E, 0x08, 0xA9, 0x72, 0xED, 0x28, 0xC4, 0x7C, 0x87,
+  0xF8, 0xE9, 0xAD, 0x29, 0x3C, 0xF3, 0xC4, 0xAC, 0x77, 0x38, 0x7D, 0xB8,
+  0x7A, 0xAF, 0xAD, 0x1A, 0xDF, 0x57, 0xB5, 0x69, 0x74, 0x5E, 0x1A, 0xCF,
+  0x34, 0x43, 0xCE, 0x98, 0x42, 0xF4, 0x73, 0xD8, 0x0C, 0x9B, 0xAE, 0x4E,
+  0x86, 0x9C, 0xFF, 0x42, 0x60, 0x28, 0x00, 0x9C, 0xC3, 0x1B, 0x47, 0xFD,
+  0x33, 0xBF, 0x5E, 0x67, 0x57, 0x79, 0x33, 0x07, 0xA7, 0x76, 0x28, 0xB9,
+  0xF9, 0xC6, 0x5B, 0xDD, 0x03, 0x0A, 0x84, 0x9F, 0x01, 0x94, 0xE0, 0x70,
+  0x49, 0xAB, 0x68, 0x3E, 0x75, 0x5A, 0x54, 0xB9, 0x78, 0x02, 0xA0, 0xB7,
+  0xBF, 0x8D, 0x08, 0x71, 0x39, 0xF0, 0xD0, 0x3D, 0xDA, 0x77, 0x35, 0xFF,
+  0x04, 0xF0, 0x5C, 0x5E, 0xE3, 0xB6, 0x28, 0x99, 0xA8, 0x38, 0x45, 0x72,
+  0x26, 0x71, 0x51, 0x8E, 0x51, 0x7E, 0xF2, 0x47, 0x92, 0x34, 0x46, 0xC6,
+  0xF4, 0x72, 0xEF, 0xF0, 0xA1, 0x86, 0xB9, 0x6C, 0x2F, 0xE9, 0x95, 0xD3,
+  0xB2, 0x28, 0x5C, 0xD1, 0x99, 0xB6, 0xA9, 0xD4, 0xCC, 0x08, 0xB1, 0x74,
+  0x82, 0x32, 0xE5, 0xC5, 0xDB, 0xE2, 0xD1, 0x42, 0x22, 0x78, 0x74, 0xF3,
+  0x52, 0x91, 0x1B, 0x05, 0x36, 0x4C, 0x5E, 0xF1, 0x46, 0x12, 0xDE, 0xFF,
+  0xFC, 0x16, 0xB6, 0xE3, 0x8B, 0xF7, 0x32, 0xE7, 0xB1, 0x2C, 0x4B, 0xC6,
+  0xEC, 0xC0, 0xF5, 0x08, 0xEE, 0xEA, 0x29, 0x8C, 0xF3, 0x89, 0xA2, 0x89,
+  0xF2, 0x29, 0x9A, 0xA1, 0xBA, 0x96, 0x88, 0x8B, 0xC6, 0xF3, 0x75, 0x7B,
+  0x4B, 0xD2, 0x6E, 0x60, 0xD4, 0xC9, 0x23, 0x9E, 0x82, 0x87, 0xB6, 0xC9,
+  0x9E, 0x50, 0x59, 0x9E, 0x2A, 0x83, 0x2C, 0x2E, 0xAB, 0x70, 0x83, 0x06,
+  0x3A, 0xB3, 0x89, 0xBE, 0xAA, 0xE2, 0xDE, 0x37, 0x52, 0x27, 0xA7, 0x84,
+  0xBC, 0x33, 0x3D, 0x30, 0x5A, 0x8D, 0x5C, 0x6B, 0xF0, 0x33, 0x88, 0x4D,
+  0x5C, 0x15, 0x11, 0x32, 0xF3, 0xD1, 0xE2, 0xEF, 0x89, 0xCA, 0x04, 0x4D,
+  0xEE, 0x6F, 0x85, 0x19, 0x6C, 0x5B, 0x34, 0xB9, 0x91, 0x9D, 0x4A, 0xFF,
+  0x51, 0x4F, 0x08, 0xC3, 0x51, 0x4D, 0xE0, 0x7A, 0xDC, 0xB2, 0x9E, 0xB9,
+  0xD9, 0x70, 0xBC, 0x7A, 0xCB, 0x25, 0xCE, 0x8A, 0xBF, 0xA3, 0x04, 0xAD,
+  0x60, 0xF0, 0x6D, 0xD8, 0x60, 0xC7, 0x97, 0x26, 0x46, 0x53, 0x65, 0xC9,
+  0x21, 0xF9, 0x36, 0x3B, 0x40, 0x86, 0x68, 0x8D, 0xE0, 0xB8, 0xC9, 0x45,
+  0x83, 0x32, 0x29, 0xAD, 0x44, 0xA7, 0xE5, 0x43, 0x83, 0xC3, 0xFA, 0xC2,
+  0xD7, 0x1F, 0x0E, 0xDB, 0xFE, 0x54, 0x80, 0x99, 0x51, 0xEC, 0x60, 0x1A,
+  0xF6, 0xC4, 0xE2, 0x02, 0xC5, 0x36, 0xB6, 0xDB, 0xA0, 0xF8, 0x58, 0x50,
+  0xC4
+};
+
+STATIC CONST UINT8 mTestBzip2Sample[] = {
+  0x42, 0x5A, 0x68, 0x31, 0x31, 0x41, 0x59, 0x26, 0x53, 0x59, 0xBA, 0x34,
+  0xB3, 0x84, 0x00, 0x01, 0x59, 0x7F, 0xFF, 0xFF, 0xFD, 0x7B, 0x7D, 0xFB,
+  0xF5, 0xFF, 0xFF, 0x7F, 0xBF, 0xFF, 0xFD, 0xFE, 0xEF, 0xFF, 0xFF, 0xDF,
+  0xFF, 0x37, 0xFF, 0xFB, 0xFF, 0xFB, 0xFF, 0xDF, 0xFF, 0xFD, 0xFF, 0xDE,
+  0xFF, 0xFF, 0xFF, 0xC0, 0x02, 0xEC, 0x13, 0x70, 0x0C, 0x60, 0xAD, 0x55,
+  0x1A, 0x7A, 0x83, 0xD4, 0x1B, 0x49, 0xE8, 0x8F, 0x48, 0x68, 0xD3, 0xD4,
+  0xD1, 0x99, 0x26, 0x9A, 0x33, 0xD4, 0x46, 0x11, 0x88, 0x32, 0x62, 0x68,
+  0xD0, 0xD3, 0x08, 0x3C, 0x4D, 0x4F, 0x49, 0xE9, 0x0D, 0xA4, 0x19, 0xA2,
+  0x18, 0x8F, 0x40, 0x8F, 0x42, 0x33, 0x53, 0xC8, 0x8D, 0x1B, 0x50, 0xDA,
+  0x35, 0x34, 0x0D, 0x36, 0xA0, 0xC8, 0xD3, 0xD1, 0x90, 0xD1, 0x32, 0x7A,
+  0x09, 0xE9, 0xA1, 0xA4, 0xDE, 0xA6, 0x91, 0xFA, 0x99, 0x0D, 0x4C, 0x3A,
+  0x34, 0x00, 0x00, 0x06, 0x87, 0xA4, 0x03, 0x40, 0x34, 0x34, 0x03, 0x40,
+  0x00, 0x1A, 0x00, 0x00, 0xD0, 0x01, 0xA0, 0x00, 0x68, 0x00, 0x00, 0x00,
+  0x00, 0x68, 0x00, 0x00, 0x34, 0x01, 0xA0, 0x01, 0xA0, 0x00, 0x00, 0x00,
+  0x01, 0x90, 0x8A, 0x7E, 0x42, 0xAA, 0x03, 0x40, 0x00, 0xD0, 0x00, 0x00,
+  0x01, 0xA0, 0x1A, 0x00, 0x06, 0x86, 0x80, 0x00, 0x00, 0x06, 0x20, 0x03,
+  0x20, 0x0D, 0x03, 0x40, 0x00, 0x34, 0x00, 0xD0, 0x0D, 0x06, 0x80, 0x06,
+  0x40, 0x00, 0x00, 0x00, 0x00, 0xD0, 0x01, 0x24, 0x55, 0x23, 0x4D, 0x06,
+  0x80, 0x1A, 0x34, 0x06, 0x40, 0x34, 0x06, 0x80, 0x06, 0x80, 0x00, 0x00,
+  0x00, 0x00, 0x06, 0x80, 0x00, 0x00, 0x19, 0x00, 0x00, 0x34, 0x00, 0x01,
+  0xA0, 0x00, 0x34, 0xD3, 0x40, 0x01, 0xA0, 0x00, 0x0D, 0x1A, 0x1A, 0x0D,
+  0x34, 0x0B, 0xD3, 0xA6, 0xF5, 0xCB, 0xE0, 0xAF, 0xBD, 0xC1, 0x4C, 0xAF,
+  0xCD, 0x9E, 0xEC, 0x32, 0x2E, 0x44, 0x05, 0x2B, 0xCA, 0xC8, 0xE2, 0x2D,
+  0xF7, 0x80, 0x20, 0x14, 0xDB, 0xA7, 0xA4, 0x9D, 0xC2, 0xF3, 0x38, 0x6F,
+  0xF5, 0xCB, 0xDF, 0x64, 0x0D, 0xF5, 0x1B, 0x5D, 0xE3, 0x76, 0x2A, 0x3A,
+  0xFC, 0x6C, 0xA6, 0xD7, 0xAD, 0xDB, 0x86, 0xF1, 0xEA, 0x2E, 0x59, 0xB4,
+  0xB2, 0x84, 0xCF, 0x99, 0x09, 0x02, 0xD4, 0x75, 0x77, 0x62, 0xE5, 0x0B,
+  0x16, 0x05, 0xD9, 0x89, 0x64, 0x46, 0x42, 0xA0, 0x2A, 0xBB, 0x07, 0x62,
+  0xEC, 0xEC, 0x42, 0x38, 0x52, 0x51, 0x58, 0x10, 0x81, 0x58, 0xA1, 0x0A,
+  0x04, 0x04, 0x90, 0x8A, 0x15, 0x4C, 0x0C, 0xAE, 0xC5, 0xC2, 0x17, 0x70,
+  0x10, 0xA0, 0x26, 0x00, 0x10, 0x04, 0x21, 0x91, 0x98, 0xAA, 0x95, 0x44,
+  0x74, 0x25, 0x80, 0x72, 0xEB, 0x01, 0x0C, 0x81, 0x82, 0xB0, 0x51, 0x03,
+  0x92, 0x8C, 0xEC, 0xA5, 0xDC, 0x33, 0xB8, 0x75, 0x47, 0x42, 0xCC, 0x80,
+  0x02, 0xC5, 0x54, 0xA0, 0x24, 0xBB, 0x95, 0x66, 0x04, 0x04, 0x70, 0x60,
+  0x0A, 0xAA, 0x44, 0x0E, 0x19, 0x14, 0x22, 0x2A, 0xB3, 0x34, 0x0A, 0xA0,
+  0xA0, 0x70, 0x8C, 0x19, 0xB4, 0x62, 0xD1, 0x13, 0x3E, 0x88, 0x93, 0x73,
+  0x97, 0x8D, 0x41, 0x34, 0x25, 0x6C, 0xFE, 0xF4, 0xE3, 0x96, 0x2D, 0xFC,
+  0xFF, 0x1E, 0x77, 0xB1, 0xB4, 0x80, 0xB5, 0x3C, 0xBD, 0xA2, 0x46, 0x3B,
+  0xE0, 0x00, 0x12, 0x18, 0x60, 0x00, 0x16, 0xA2, 0x58, 0x00, 0x05, 0xEA,
+  0x6A, 0x68, 0xC2, 0xA2, 0xA0, 0x00, 0x2B, 0xB2, 0x3F, 0xEC, 0x15, 0x43,
+  0x23, 0x4C, 0x3A, 0x8C, 0xE3, 0xAC, 0x07, 0x5A, 0x49, 0x49, 0xF4, 0x53,
+  0x90, 0x78, 0xB5, 0xBE, 0x0F, 0x09, 0x70, 0x00, 0x0C, 0x65, 0x96, 0xC9,
+  0x50, 0xD8, 0x08, 0x42, 0x0F, 0x3A, 0x50, 0xCB, 0x15, 0x0C, 0x7F, 0x42,
+  0x8B, 0x5C, 0xC4, 0x8C, 0xC5, 0x27, 0x14, 0x24, 0x7A, 0x10, 0x1A, 0x64,
+  0x0C, 0xC5, 0xBA, 0xB0, 0x83, 0x00, 0x10, 0x20, 0x45, 0x0C, 0x58, 0x07,
+  0x8E, 0xF1, 0x9A, 0x89, 0x8B, 0xEB, 0x68, 0xB6, 0x1F, 0x90, 0x01, 0x31,
+  0x19, 0xFC, 0xDE, 0x7D, 0xA5, 0xE6, 0x23, 0xFA, 0x97, 0x08, 0x2A, 0xC4,
+  0xAD, 0x9A, 0x0E, 0xD7, 0x9C, 0xD3, 0x62, 0xA5, 0x2F, 0xF2, 0xD1, 0x3A,
+  0x08, 0xB9, 0x78, 0xBC, 0xCC, 0x55, 0x82, 0x32, 0x45, 0x09, 0x54, 0x84,
+  0x8F, 0xB3, 0x24, 0x46, 0xB2, 0x41, 0x24, 0x80, 0x32, 0x68, 0x49, 0xC4,
+  0x10, 0xC1, 0x44, 0x6C, 0x7B, 0x30, 0xC3, 0xB0, 0xEE, 0x0E, 0x3B, 0xA6,
+  0x18, 0x66, 0x76, 0x76, 0x76, 0x1D, 0xDC, 0x1D, 0xD9, 0x3B, 0xBB, 0x8C,
+  0xE3, 0x8C, 0xCC, 0x9D, 0x33, 0x0C, 0xCC, 0xEE, 0xEE, 0xCC, 0x33, 0xBE,
+  0x85, 0x09, 0x58, 0x80, 0x50, 0x80, 0x94, 0x08, 0x25, 0xCF, 0xDA, 0xE6,
+  0x33, 0x48, 0x4A, 0x4F, 0xD7, 0x24, 0x90, 0x77, 0xE0, 0x90, 0x97, 0x60,
+  0x41, 0xF0, 0x83, 0xA1, 0x33, 0x31, 0x02, 0xCE, 0xEC, 0x32, 0x4C, 0x33,
+  0x38, 0xCE, 0x0C, 0xC3, 0x8C, 0xCE, 0xE9, 0x86, 0x71, 0x98, 0x71, 0xD3,
+  0x0C, 0x3B, 0xBB, 0x8E, 0xE0, 0xED, 0xA7, 0xA4, 0x7C, 0xBB, 0x5C, 0x19,
+  0xF2, 0x49, 0x3A, 0x00, 0xF0, 0xF7, 0x10, 0x94, 0x44, 0x28, 0x0A, 0x5A,
+  0x25, 0x20, 0x70, 0x4A, 0x15, 0x00, 0x42, 0xA1, 0x2A, 0xB0, 0x0B, 0xF9,
+  0x8C, 0x86, 0xD8, 0x80, 0xA7, 0x29, 0x25, 0x20, 0x92, 0x54, 0x48, 0xEE,
+  0x05, 0xF2, 0x9A, 0x84, 0xA4, 0x58, 0x05, 0xEE, 0x98, 0x95, 0x87, 0x42,
+  0x50, 0x82, 0x08, 0x0F, 0xF4, 0x30, 0x25, 0x01, 0xBE, 0x04, 0xA1, 0x90,
+  0x96, 0x92, 0x67, 0x21, 0x32, 0x92, 0xC7, 0x24, 0x16, 0xE8, 0xEE, 0x3C,
+  0x64, 0xA5, 0x3E, 0x1C, 0x12, 0xE8, 0xFD, 0x25, 0xE4, 0xF5, 0x51, 0xF1,
+  0xB4, 0xB8, 0x88, 0xAC, 0x91, 0xD4, 0x9F, 0x9F, 0xAB, 0xDC, 0x24, 0xA3,
+  0xD2, 0xB3, 0x04, 0x3E, 0xDF, 0x27, 0xD9, 0xD7, 0xEE, 0x97, 0x5F, 0x0F,
+  0x39, 0x85, 0x45, 0x8E, 0xF1, 0xFD, 0x3C, 0xCF, 0xCF, 0xDA, 0x49, 0x81,
+  0x3C, 0x75, 0x02, 0xB1, 0xAE, 0x76, 0xEA, 0x68, 0xC6, 0x46, 0xAE, 0x09,
+  0xB7, 0x13, 0x34, 0xA9, 0x26, 0x46, 0xD0, 0x54, 0x38, 0xEE, 0xEE, 0x0E,
+  0x18, 0x5B, 0xB1, 0xF6, 0x31, 0xA3, 0xBD, 0xF8, 0x1B, 0xBA, 0x43, 0x26,
+  0xCF, 0x20, 0x76, 0x98, 0xE7, 0x11, 0xBC, 0x61, 0x62, 0xB7, 0x1D, 0xE2,
+  0xB5, 0x64, 0xC5, 0x67, 0x1D, 0xA1, 0x92, 0xFE, 0x5D, 0xC5, 0x59, 0x19,
+  0x2E, 0xED, 0x8A, 0x53, 0x36, 0xE8, 0x0E, 0x68, 0xC6, 0x19, 0x62, 0x14,
+  0x32, 0x6B, 0x08, 0x44, 0x9D, 0x8B, 0xF1, 0xCD, 0x79, 0xA8, 0x13, 0xF1,
+  0xCC, 0xC6, 0x38, 0xB9, 0xF1, 0xFB, 0x99, 0x9A, 0x97, 0x3D, 0xC3, 0x6B,
+  0x5C, 0x9C, 0xA4, 0x92, 0x0E, 0x02, 0xAF, 0xC6, 0x5E, 0x62, 0x9F, 0xD2,
+  0xE1, 0xA6, 0xAC, 0x24, 0xAD, 0x98, 0x37, 0xD0, 0x44, 0x2C, 0x17, 0x0D,
+  0x6D, 0xF4, 0xF7, 0x90, 0xF6, 0x6F, 0x79, 0xF4, 0xB1, 0x00, 0x25, 0xAB,
+  0x98, 0x4A, 0x85, 0xE2, 0x43, 0xAE, 0xD8, 0x86, 0x3F, 0x72, 0x2B, 0x85,
+  0xB3, 0x23, 0xDC, 0x35, 0x0F, 0xEC, 0x70, 0x60, 0x84, 0xFE, 0x42, 0x8B,
+  0xC8, 0xFE, 0x72, 0x06, 0xF4, 0xC0, 0x4A, 0x2A, 0xF0, 0xF1, 0xA1, 0xE8,
+  0xD4, 0x3A, 0x75, 0x17, 0x38, 0x2A, 0x11, 0x41, 0x73, 0xAF, 0x78, 0xB8,
+  0xF8, 0x07, 0xBC, 0x68, 0x64, 0xA0, 0x36, 0x35, 0x22, 0xCB, 0x16, 0x66,
+  0xC3, 0x2B, 0xA6, 0xFE, 0xA0, 0xB2, 0x12, 0x1E, 0x01, 0xB9, 0x12, 0x40,
+  0x15, 0x10, 0x27, 0x84, 0x7C, 0x1D, 0x21, 0xC4, 0x64, 0x39, 0x35, 0xDD,
+  0xC1, 0x0C, 0x29, 0x34, 0xC3, 0x95, 0x6E, 0x70, 0xEC, 0x3F, 0xC5, 0xDC,
+  0x91, 0x4E, 0x14, 0x24, 0x2E, 0x8D, 0x2C, 0xE1, 0x00
+};
+
+STATIC CONST UINT8 mTestLzfseSample[] = {
+  0x62, 0x76, 0x78, 0x32, 0x40, 0x00, 0x00, 0x00, 0x34, 0x00, 0x60, 0x02,
+  0x00, 0x03, 0x00, 0x60, 0x85, 0x4D, 0x2B, 0xB3, 0x6A, 0x0B, 0x00, 0x60,
+  0xA1, 0x00, 0x00, 0x00, 0x20, 0x78, 0xF0, 0x07, 0x70, 0x0E, 0x00, 0x00,
+  0xD7, 0x00, 0xD7, 0x9C, 0x03, 0x70, 0xCD, 0x35, 0x00, 0x00, 0xF0, 0x3D,
+  0x00, 0x00, 0xDF, 0x03, 0xF0, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xB7,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x25, 0x00, 0x00, 0x00, 0xC0, 0xED,
+  0xED, 0xED, 0x2D, 0x00, 0x00, 0x00, 0xB7, 0xDC, 0x02, 0x00, 0x00, 0xB7,
+  0x00, 0x00, 0x00, 0x00, 0xDC, 0xDE, 0xFE, 0x03, 0xB7, 0xAF, 0x04, 0xB7,
+  0xB7, 0xFF, 0x00, 0x3F, 0xC2, 0x3F, 0x70, 0xFB, 0x23, 0xFC, 0x03, 0x3F,
+  0x02, 0xB7, 0xB7, 0xFF, 0xC0, 0x2D, 0xDC, 0x02, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x7C, 0xA6, 0x27, 0xE4, 0xE6, 0xF2, 0x82, 0xE3, 0xF1, 0xF7, 0x0A,
+  0x50, 0xF9, 0xD3, 0x44, 0xB5, 0x51, 0xDB, 0xF3, 0xE1, 0xE8, 0x5B, 0x87,
+  0xAF, 0x79, 0xEE, 0x79, 0xC4, 0xDC, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xB7, 0x8E, 0x12, 0x62, 0x76, 0x78, 0x6E, 0xE8, 0x03,
+  0x00, 0x00, 0x13, 0x01, 0x00, 0x00, 0x20, 0x3A, 0x18, 0x15, 0xE6, 0x73,
+  0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x1C, 0x18, 0x13, 0x30, 0x41, 0x30,
+  0x09, 0x10, 0x45, 0x38, 0x4A, 0x20, 0x06, 0x18, 0x7B, 0x38, 0x12, 0xE1,
+  0x65, 0x38, 0x94, 0x08, 0x19, 0x38, 0x5A, 0xE1, 0x6E, 0x28, 0xA1, 0x20,
+  0x13, 0x10, 0x4A, 0xE1, 0x0A, 0x18, 0xA0, 0x20, 0x13, 0x38, 0x46, 0x30,
+  0x26, 0x30, 0x7E, 0x38, 0x9C, 0x28, 0x74, 0x20, 0x22, 0x18, 0x55, 0xE1,
+  0x0A, 0x28, 0x77, 0x20, 0x07, 0x38, 0xAD, 0x38, 0xA1, 0x39, 0x0D, 0xE1,
+  0x33, 0x28, 0x27, 0x38, 0x5F, 0x38, 0xA1, 0x38, 0x37, 0x39, 0x47, 0xE2,
+  0x20, 0x0A, 0x38, 0xA4, 0x38, 0x82, 0x30, 0x1E, 0x18, 0x38, 0x39, 0x53,
+  0x39, 0x40, 0x20, 0x74, 0x20, 0x1B, 0x18, 0x66, 0x18, 0x06, 0x38, 0x18,
+  0xE1, 0x74, 0x38, 0x78, 0x38, 0x78, 0x20, 0x3E, 0x38, 0xB8, 0x39, 0xD9,
+  0x39, 0x98, 0x10, 0x09, 0x18, 0x32, 0x18, 0x1E, 0x18, 0x0C, 0x10, 0x49,
+  0x38, 0x60, 0x28, 0x93, 0x18, 0x1D, 0x38, 0x06, 0x38, 0x1F, 0x39, 0x78,
+  0x20, 0x06, 0x20, 0xED, 0x18, 0x26, 0x38, 0x9E, 0x38, 0x66, 0x38, 0x49,
+  0x38, 0x06, 0x20, 0x06, 0x39, 0x4B, 0x20, 0xB9, 0x18, 0x17, 0x38, 0xD3,
+  0x38, 0x68, 0x38, 0x15, 0x39, 0x4B, 0x21, 0xCF, 0x38, 0x82, 0x30, 0x82,
+  0x18, 0x06, 0x39, 0x59, 0x38, 0x5C, 0x18, 0x1A, 0x3A, 0x33, 0x18, 0x21,
+  0x3A, 0x69, 0x21, 0x0E, 0xE1, 0x0A, 0x20, 0x76, 0x39, 0x69, 0x20, 0xAD,
+  0x38, 0x6D, 0x3A, 0x58, 0x10, 0x32, 0x3A, 0x64, 0x10, 0x95, 0x28, 0x41,
+  0x38, 0xBD, 0x10, 0x69, 0x39, 0x16, 0x28, 0x51, 0x21, 0x59, 0x20, 0x3F,
+  0x3A, 0x6D, 0x38, 0x99, 0xE4, 0x6F, 0x72, 0x20, 0x0A, 0x20, 0x2D, 0x30,
+  0xED, 0x3A, 0x0E, 0x3A, 0x4E, 0x10, 0x87, 0x38, 0xB1, 0x20, 0x7B, 0x38,
+  0x52, 0x38, 0x52, 0x38, 0x41, 0x20, 0x0E, 0x10, 0x2B, 0x06, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x62, 0x76, 0x78, 0x32, 0x40, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x08, 0x00, 0x70, 0x2A, 0x1F, 0x96,
+  0x33, 0xB7, 0x11, 0x00, 0x50, 0x8B, 0x00, 0x00, 0x00, 0x21, 0xA4, 0x00,
+  0x03, 0x8F, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x03, 0x70, 0xC8,
+  0x01, 0xC0, 0x01, 0x1C, 0x00, 0x00, 0x8F, 0x00, 0xF0, 0x08, 0x00, 0x3C,
+  0x02, 0x8F, 0x00, 0x8F, 0x02, 0x3C, 0x02, 0x00, 0x8F, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xB5, 0x86, 0x91, 0x30, 0x05, 0x46, 0x8E, 0x73,
+  0x1D, 0x62, 0x76, 0x78, 0x32, 0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x90,
+  0x00, 0x00, 0x06, 0x00, 0x70, 0xF3, 0x5C, 0xD5, 0xE8, 0xF6, 0x11, 0x00,
+  0x40, 0x91, 0x00, 0x00, 0x00, 0x0D, 0x40, 0xA0, 0x0C, 0x4F, 0xC1, 0x09,
+  0x27, 0x00, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x0F, 0x00, 0x9C, 0x70,
+  0xC2, 0x09, 0xF0, 0x12, 0x00, 0x00, 0x00, 0xF0, 0x12, 0x00, 0xBC, 0x04,
+  0x00, 0xBC, 0x04, 0x00, 0x2F, 0xC1, 0x4B, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0x0E, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xCE, 0xA3, 0xF3, 0xE8, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8A, 0x23, 0xDD, 0xE0, 0x7F,
+  0x32, 0x50, 0xAD, 0x10, 0x62, 0x76, 0x78, 0x2D, 0x40, 0x00, 0x00, 0x00,
+  0x33, 0x20, 0x4F, 0x70, 0x65, 0x6E, 0x43, 0x6F, 0x72, 0x65, 0x20, 0x69,
+  0x6D, 0x61, 0x67, 0x65, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x69, 0x6D,
+  0x61, 0x67, 0x65, 0x20, 0x0A, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x73,
+  0x65, 0x63, 0x74, 0x6F, 0x72, 0x20, 0x30, 0x31, 0x32, 0x33, 0x20, 0x69,
+  0x6D, 0x61, 0x67, 0x65, 0x20, 0x73, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x20,
+  0x30, 0x31, 0x32, 0x33, 0x62, 0x76, 0x78, 0x31, 0x18, 0x03, 0x00, 0x00,
+  0x40, 0x02, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x1D, 0x00, 0x00, 0x00,
+  0x07, 0x02, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0xFC, 0xFF, 0xFF, 0xFF,
+  0x2C, 0x00, 0x32, 0x01, 0x46, 0x01, 0x00, 0x01, 0xFC, 0xFF, 0xFF, 0xFF,
+  0x1A, 0x00, 0x34, 0x00, 0xE4, 0x00, 0x3A, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00,
+  0x0D, 0x00, 0x04, 0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00,
+  0x11, 0x00, 0x11, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x11, 0x00,
+  0x08, 0x00, 0x11, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00,
+  0x08, 0x00, 0x11, 0x00, 0x00, 0x00, 0x08, 0x00, 0x11, 0x00, 0x08, 0x00,
+  0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+  0x05, 0x00, 0x03, 0x00, 0x05, 0x00, 0x07, 0x00, 0x03, 0x00, 0x01, 0x00,
+  0x03, 0x00, 0x09, 0x00, 0x01, 0x00, 0x07, 0x00, 0x03, 0x00, 0x03, 0x00,
+  0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x05, 0x00,
+  0x01, 0x00, 0x05, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00,
+  0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x05, 0x00, 0x01, 0x00, 0x09, 0x00, 0x0B, 0x00, 0x03, 0x00,
+  0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x03, 0x00,
+  0x00, 0x00, 0x07, 0x00, 0x09, 0x00, 0x09, 0x00, 0x03, 0x00, 0x05, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00,
+  0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x05, 0x00,
+  0x09, 0x00, 0x01, 0x00, 0x03, 0x00, 0x05, 0x00, 0x05, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x09, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x0F, 0x00, 0x03, 0x00, 0x01, 0x00, 0x03, 0x00,
+  0x01, 0x00, 0x01, 0x00, 0x05, 0x00, 0x01, 0x00, 0x01, 0x00, 0x03, 0x00,
+  0x05, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x01, 0x00, 0x09, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x05, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x07, 0x00,
+  0x01, 0x00, 0x01, 0x00, 0x03, 0x00, 0x05, 0x00, 0x03, 0x00, 0x05, 0x00,
+  0x05, 0x00, 0x09, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x05, 0x00,
+  0x05, 0x00, 0x05, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x00, 0x00, 0x05, 0x00, 0x09, 0x00, 0x07, 0x00,
+  0x01, 0x00, 0x05, 0x00, 0x03, 0x00, 0x03, 0x00, 0x07, 0x00, 0x01, 0x00,
+  0x03, 0x00, 0x03, 0x00, 0x09, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x05, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x01, 0x00, 0x09, 0x00, 0x03, 0x00, 0x01, 0x00, 0x05, 0x00,
+  0x03, 0x00, 0x07, 0x00, 0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x07, 0x00, 0x01, 0x00,
+  0x03, 0x00, 0x01, 0x00, 0x05, 0x00, 0x01, 0x00, 0x09, 0x00, 0x03, 0x00,
+  0x01, 0x00, 0x01, 0x00, 0x05, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x0B, 0x00, 0x01, 0x00, 0x07, 0x00, 0x09, 0x00, 0x03, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x01, 0x00,
+  0x00, 0x00, 0x01, 0x00, 0x05, 0x00, 0x07, 0x00, 0x03, 0x00, 0x07, 0x00,
+  0x01, 0x00, 0x01, 0x00, 0x0D, 0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00,
+  0x03, 0x00, 0x05, 0x00, 0x01, 0x00, 0x03, 0x00, 0x05, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x03, 0x00,
+  0x03, 0x00, 0x03, 0x00, 0x09, 0x00, 0x05, 0x00, 0x03, 0x00, 0x05, 0x00,
+  0x01, 0x00, 0x09, 0x00, 0x00, 0x00, 0x07, 0x00, 0x09, 0x00, 0x03, 0x00,
+  0x03, 0x00, 0x00, 0x00, 0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00,
+  0x05, 0x00, 0x03, 0x00, 0x01, 0x00, 0x03, 0x00, 0x07, 0x00, 0x09, 0x00,
+  0x01, 0x00, 0x05, 0x00, 0x09, 0x00, 0x03, 0x00, 0x01, 0x00, 0x07, 0x00,
+  0x01, 0x00, 0x03, 0x00, 0x03, 0x00, 0x01, 0x00, 0x03, 0x00, 0x01, 0x00,
+  0x01, 0x00, 0x05, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x15, 0x36, 0x80, 0x0F, 0x03, 0xA4, 0xA4, 0x8F,
+  0x08, 0xF5, 0x4C, 0x29, 0x92, 0x16, 0xE1, 0x9B, 0xD2, 0x24, 0x2A, 0xDE,
+  0xEE, 0x55, 0xC3, 0x3E, 0xC8, 0x9B, 0xDE, 0x40, 0x7D, 0x2C, 0x2D, 0x3E,
+  0x21, 0xF3, 0x31, 0xF7, 0x44, 0x04, 0xAE, 0x82, 0x51, 0x44, 0xE3, 0x22,
+  0xCB, 0xB6, 0x1C, 0xCF, 0x59, 0x5A, 0x51, 0x2A, 0xAE, 0xA6, 0xCD, 0xC4,
+  0xCF, 0xD2, 0x6B, 0x39, 0xB1, 0x29, 0x72, 0x7C, 0xF7, 0x24, 0x86, 0x09,
+  0xE2, 0x5F, 0xF5, 0x70, 0xE9, 0xE8, 0x81, 0x4F, 0x93, 0x34, 0xE7, 0xCE,
+  0xB8, 0x27, 0xFB, 0xA6, 0x66, 0x22, 0x62, 0xEE, 0x0E, 0x51, 0xC1, 0x89,
+  0x38, 0x5A, 0xC2, 0x40, 0x54, 0x70, 0x96, 0x22, 0x93, 0x29, 0x71, 0xAE,
+  0xB3, 0xAE, 0x83, 0xF6, 0x19, 0x3B, 0x7E, 0x85, 0xDB, 0x44, 0x69, 0xE7,
+  0x33, 0x61, 0x4B, 0x28, 0xC4, 0x1E, 0x11, 0x72, 0x19, 0xBE, 0x38, 0x9F,
+  0x53, 0x95, 0xAE, 0x01, 0x16, 0xE9, 0xF2, 0x60, 0x69, 0xE0, 0xD8, 0x34,
+  0xD0, 0xE7, 0xA3, 0xF1, 0x3E, 0x22, 0xE9, 0xE3, 0xEE, 0x14, 0xC7, 0xC3,
+  0xF3, 0x16, 0x6D, 0x26, 0x42, 0x09, 0xE9, 0x60, 0xFD, 0x4B, 0xFB, 0xB7,
+  0x8B, 0xEC, 0xA9, 0x92, 0xE7, 0x8D, 0x1D, 0xFB, 0xCE, 0x0A, 0x4F, 0xFD,
+  0x57, 0x63, 0x03, 0x5B, 0x71, 0xA0, 0x83, 0x4A, 0xBC, 0xB9, 0xB4, 0xEA,
+  0x71, 0xE1, 0x89, 0x3C, 0x0C, 0x1B, 0xF1, 0x89, 0x3F, 0x8D, 0x57, 0x3C,
+  0xCB, 0x7A, 0x1C, 0x5A, 0xD3, 0xAB, 0x21, 0xD6, 0x0B, 0x98, 0xC1, 0x35,
+  0x5C, 0x41, 0xBC, 0xD0, 0x2C, 0x33, 0x03, 0xB1, 0xB0, 0x0B, 0x5E, 0x3D,
+  0xD1, 0x5F, 0x82, 0x1E, 0x74, 0xC2, 0xAC, 0x03, 0x91, 0xA4, 0xFE, 0x33,
+  0xD6, 0x3C, 0xDD, 0xDB, 0xEA, 0x54, 0x83, 0xC3, 0x92, 0x97, 0x14, 0xCE,
+  0xE8, 0x82, 0xF2, 0x5F, 0xFB, 0xA9, 0x30, 0xA8, 0x46, 0xB5, 0xEF, 0x1C,
+  0x4F, 0x42, 0x8D, 0x8C, 0x77, 0x16, 0x23, 0x43, 0xDB, 0x97, 0xBE, 0x02,
+  0xDA, 0xAB, 0x52, 0x89, 0xE8, 0x22, 0xAD, 0xD6, 0x15, 0xE2, 0x6C, 0xFC,
+  0x57, 0x48, 0x4B, 0xA6, 0x13, 0x50, 0x0A, 0x55, 0xCC, 0x78, 0x48, 0xDF,
+  0x64, 0x39, 0xA4, 0x18, 0x5C, 0x28, 0x6E, 0x90, 0x6A, 0xF6, 0x9B, 0xAA,
+  0x4E, 0x70, 0x53, 0x48, 0x12, 0xC7, 0x46, 0xF3, 0x02, 0xE5, 0x0E, 0xAC,
+  0x53, 0xB2, 0xED, 0x0E, 0xB4, 0x5C, 0x22, 0x9B, 0x16, 0xA9, 0x96, 0x21,
+  0xC7, 0x5C, 0x1E, 0x60, 0xF1, 0xF3, 0x08, 0x11, 0xAF, 0x78, 0x3E, 0x02,
+  0xBD, 0x1A, 0x17, 0xA4, 0xB0, 0xD7, 0x62, 0x00, 0xF5, 0xD6, 0xA1, 0xBA,
+  0xCF, 0xB5, 0x6D, 0xC1, 0x69, 0x64, 0x34, 0xC0, 0x2B, 0x68, 0xB8, 0x54,
+  0x7F, 0xF3, 0x39, 0x09, 0x3F, 0x96, 0x4D, 0x65, 0xF1, 0xB2, 0x5B, 0x67,
+  0xBF, 0xEA, 0x46, 0xD6, 0xE7, 0x98, 0xBA, 0xC5, 0xFA, 0x0B, 0xCF, 0x18,
+  0x63, 0xEE, 0x72, 0xEB, 0x64, 0x7B, 0x43, 0xE1, 0x8D, 0x32, 0x2F, 0x0C,
+  0x28, 0x67, 0x34, 0x80, 0x91, 0x35, 0x28, 0x9D, 0xF5, 0x42, 0x57, 0x40,
+  0x78, 0x12, 0x2E, 0xE1, 0xB4, 0x53, 0x90, 0x4A, 0xC6, 0xEE, 0xC5, 0x11,
+  0xE7, 0xC3, 0x7C, 0xBF, 0xCF, 0xEF, 0xE7, 0x68, 0x8B, 0x8F, 0xCC, 0xDF,
+  0xD0, 0x02, 0x7B, 0xEC, 0x7C, 0x53, 0x85, 0x31, 0x18, 0x32, 0x5F, 0xF2,
+  0x63, 0x54, 0x0A, 0xA0, 0x4B, 0xD0, 0x96, 0xE6, 0x38, 0xB9, 0x0A, 0xF0,
+  0x95, 0x6A, 0x4C, 0xF7, 0xAA, 0x7E, 0x20, 0x6D, 0xB9, 0xAC, 0x0F, 0x51,
+  0xC7, 0x11, 0x98, 0x01, 0x08, 0x90, 0x61, 0x87, 0x1C, 0x62, 0xCD, 0x55,
+  0xB6, 0x8B, 0x41, 0x8B, 0x8C, 0xAD, 0x4C, 0x0C, 0x3A, 0x06, 0x13, 0xB3,
+  0xDD, 0x6C, 0x5D, 0xE0, 0xFC, 0x03, 0x67, 0x64, 0x27, 0x68, 0x03, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x84, 0xC5, 0x28, 0xFC, 0x3F,
+  0x0D, 0xB6, 0x83, 0x5B, 0x21, 0xDE, 0x85, 0xCC, 0xAC, 0x70, 0x85, 0xEC,
+  0x8F, 0x1A, 0xEA, 0xEF, 0xA5, 0x6F, 0x7A, 0x02, 0xAB, 0x9B, 0x54, 0xE1,
+  0x0C, 0x50, 0x46, 0x36, 0x0D, 0x58, 0x6F, 0x90, 0x5F, 0x1F, 0x09, 0x86,
+  0x6F, 0x6D, 0x7B, 0xA2, 0x65, 0x8E, 0xA4, 0x03, 0x62, 0x76, 0x78, 0x24
+};
+
+#endif // DISK_IMAGE_SAMPLES_H
@@ -75,6 +75,10 @@ typedef UINT64 EFI_PHYSICAL_ADDRESS;
 typedef UINT64 EFI_VIRTUAL_ADDRESS;
 typedef VOID *EFI_HANDLE;
 typedef VOID *EFI_EVENT;
+typedef UINTN EFI_TPL;
+
+#define TPL_CALLBACK 8
+#define EVT_NOTIFY_SIGNAL 0x00000200
 typedef UINTN *BASE_LIST;
 typedef UINT64 EFI_LBA;
 
@@ -521,6 +525,7 @@ STATIC inline EFI_STATUS FreePool(void *x) { free (x); return EFI_SUCCESS; }
 #define CopyMem(a,b,c) (memmove)((a),(b),(c))
 #define ZeroMem(a,b) (memset)(a, 0, b)
 #define SetMem(Dst, Size, Value) (memset)(Dst, Value, Size)
+#define ScanMem8(Buffer, Size, Value) (memchr)(Buffer, Value, Size)
 #define AsciiSPrint snppprintf
 #define AsciiStrCmp strcmp
 #define AsciiStrLen strlen
@@ -533,7 +538,8 @@ STATIC inline EFI_STATUS FreePool(void *x) { free (x); return EFI_SUCCESS; }
 #define ASSERT(x) assert(x)
 #define DebugCodeEnabled() true
 #define DebugAssertEnabled() true
-static inline void FreePages(void *p,UINTN s) {}
+static inline void *AllocatePages(UINTN s) { return (malloc)(EFI_PAGES_TO_SIZE(s)); }
+static inline void FreePages(void *p,UINTN s) { (free)(p); }
 #define UnicodeSPrint(...) assert(false)
 #define CompareGuid(a, b) ((memcmp)((a), (b), sizeof (EFI_GUID)) == 0)
 #define CopyGuid(a, b) (memcpy)((a), (b), sizeof (EFI_GUID))
@@ -660,6 +666,16 @@ DivU64x32 (
   return Dividend / Divisor;
 }
 
+STATIC
+UINT32
+ModU64x32 (
+  UINT64 Dividend,
+  UINT32 Divisor
+  )
+{
+  return (UINT32) (Dividend % Divisor);
+}
+
 STATIC
 UINT64
 LShiftU64 (
@@ -834,6 +850,26 @@ GetPerformanceCounterProperties (
   return 0;
 }
 
+STATIC
+UINT64
+EFIAPI
+GetPerformanceCounter (
+  VOID
+  )
+{
+  return 0;
+}
+
+STATIC
+UINT64
+EFIAPI
+GetTimeInNanoSecond (
+  UINT64  Ticks
+  )
+{
+  return 0;
+}
+
 STATIC
 UINTN
 StrLen (
@@ -1119,6 +1155,19 @@ InsertTailList (
   _ListHead->BackLink    = Entry;
 }
 
+STATIC
+VOID
+InsertHeadList (
+  LIST_ENTRY  *ListHead,
+  LIST_ENTRY  *Entry
+  )
+{
+  Entry->ForwardLink           = ListHead->ForwardLink;
+  Entry->BackLink              = ListHead;
+  Entry->ForwardLink->BackLink = Entry;
+  ListHead->ForwardLink        = Entry;
+}
+
 STATIC
 VOID
 RemoveEntryList (
@@ -1175,6 +1224,16 @@ GetNextNode (
   return Node->ForwardLink;
 }
 
+STATIC
+LIST_ENTRY *
+GetPreviousNode (
+  LIST_ENTRY  *List,
+  LIST_ENTRY  *Node
+  )
+{
+  return Node->BackLink;
+}
+
 STATIC
 UINT16
 EFIAPI
@@ -1275,6 +1334,48 @@ WriteUnaligned64 (
   return Value;
 }
 
+STATIC
+VOID
+EFIAPI
+CpuPause (
+  VOID
+  )
+{
+}
+
+STATIC
+UINT32
+EFIAPI
+InterlockedCompareExchange32 (
+  IN OUT volatile UINT32  *Value,
+  IN     UINT32           CompareValue,
+  IN     UINT32           ExchangeValue
+  )
+{
+  __atomic_compare_exchange_n (Value, &CompareValue, ExchangeValue, FALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  return CompareValue;
+}
+
+STATIC
+UINT32
+EFIAPI
+InterlockedIncrement (
+  IN volatile UINT32  *Value
+  )
+{
+  return __atomic_add_fetch (Value, 1, __ATOMIC_SEQ_CST);
+}
+
+STATIC
+UINT32
+EFIAPI
+InterlockedDecrement (
+  IN volatile UINT32  *Value
+  )
+{
+  return __atomic_sub_fetch (Value, 1, __ATOMIC_SEQ_CST);
+}
+
 STATIC
 UINTN
 InternalBaseLibBitFieldReadUint (
@@ -1686,6 +1787,10 @@ struct EFI_BOOT_SERVICES_ {
   EFI_STATUS (*GetMemoryMap) (UINTN *MemoryMapSize, EFI_MEMORY_DESCRIPTOR *MemoryMap, UINTN *MapKey, UINTN *DescriptorSize, UINT32 *DescriptorVersion);
   EFI_STATUS (*FreePool) (void *x);
   EFI_STATUS (*LocateDevicePath) (EFI_GUID *Protocol, EFI_DEVICE_PATH_PROTOCOL **DevicePath, EFI_HANDLE *Device);
+  EFI_STATUS (*CreateEvent) (UINT32 Type, EFI_TPL NotifyTpl, EFI_EVENT_NOTIFY NotifyFunction, VOID *NotifyContext, EFI_EVENT *Event);
+  EFI_STATUS (*SignalEvent) (EFI_EVENT Event);
+  EFI_STATUS (*CheckEvent) (EFI_EVENT Event);
+  EFI_STATUS (*CloseEvent) (EFI_EVENT Event);
 };
 
 struct EFI_RUNTIME_SERVICES_ {
@@ -1755,6 +1860,50 @@ STATIC EFI_STATUS NilLocateDevicePath (EFI_GUID *Protocol, EFI_DEVICE_PATH_PROTO
   return EFI_UNSUPPORTED;
 }
 
+//
+// Events with optional notification functions called from SignalEvent.
+//
+typedef struct {
+  volatile BOOLEAN  Signaled;
+  EFI_EVENT_NOTIFY  NotifyFunction;
+  VOID              *NotifyContext;
+} NIL_EVENT;
+
+STATIC EFI_STATUS NilCreateEvent (UINT32 Type, EFI_TPL NotifyTpl, EFI_EVENT_NOTIFY NotifyFunction, VOID *NotifyContext, EFI_EVENT *Event) {
+  NIL_EVENT *NilEvent = AllocateZeroPool (sizeof (NIL_EVENT));
+
+  if (NilEvent == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NilEvent->NotifyFunction = NotifyFunction;
+  NilEvent->NotifyContext  = NotifyContext;
+  *Event = NilEvent;
+  return EFI_SUCCESS;
+}
+
+STATIC EFI_STATUS NilSignalEvent (EFI_EVENT Event) {
+  NIL_EVENT *NilEvent = Event;
+
+  if (NilEvent->NotifyFunction != NULL) {
+    NilEvent->NotifyFunction (Event, NilEvent->NotifyContext);
+  } else {
+    __atomic_store_n (&NilEvent->Signaled, TRUE, __ATOMIC_RELEASE);
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC EFI_STATUS NilCheckEvent (EFI_EVENT Event) {
+  NIL_EVENT *NilEvent = Event;
+  return __atomic_exchange_n (&NilEvent->Signaled, FALSE, __ATOMIC_ACQUIRE) ? EFI_SUCCESS : EFI_NOT_READY;
+}
+
+STATIC EFI_STATUS NilCloseEvent (EFI_EVENT Event) {
+  FreePool (Event);
+  return EFI_SUCCESS;
+}
+
 extern EFI_STATUS NilInstallConfigurationTableCustom(EFI_GUID *Guid, VOID *Table);
 
 #ifndef CONFIG_TABLE_INSTALLER
@@ -1771,7 +1920,11 @@ STATIC EFI_BOOT_SERVICES gNilBS = {
   .InstallProtocolInterface = NilInstallProtocolInterface,
   .GetMemoryMap = NilGetMemoryMap,
   .FreePool = FreePool,
-  .LocateDevicePath = NilLocateDevicePath
+  .LocateDevicePath = NilLocateDevicePath,
+  .CreateEvent = NilCreateEvent,
+  .SignalEvent = NilSignalEvent,
+  .CheckEvent = NilCheckEvent,
+  .CloseEvent = NilCloseEvent
 };
 
 STATIC EFI_BOOT_SERVICES *gBS = &gNilBS;
@@ -20,15 +20,15 @@
 #include <sys/time.h>
 
 /*
- clang -g -fsanitize=undefined,address -Wno-incompatible-pointer-types-discards-qualifiers -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h Prelinked.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcMachoLib/CxxSymbols.c ../../Library/OcMachoLib/Header.c ../../Library/OcMachoLib/Relocations.c ../../Library/OcMachoLib/Symbols.c ../../Library/OcAppleKernelLib/PrelinkedContext.c ../../Library/OcAppleKernelLib/PrelinkedKext.c ../../Library/OcAppleKernelLib/KextPatcher.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcAppleKernelLib/Link.c ../../Library/OcAppleKernelLib/Vtables.c ../../Library/OcAppleKernelLib/KernelReader.c ../../Library/OcCompressionLib/lzss/lzss.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Tests/KernelTest/Lilu.c ../../Tests/KernelTest/Vsmc.c -o Prelinked
+ clang -g -fsanitize=undefined,address -Wno-incompatible-pointer-types-discards-qualifiers -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h Prelinked.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcMachoLib/CxxSymbols.c ../../Library/OcMachoLib/Header.c ../../Library/OcMachoLib/Relocations.c ../../Library/OcMachoLib/Symbols.c ../../Library/OcAppleKernelLib/PrelinkedContext.c ../../Library/OcAppleKernelLib/PrelinkedKext.c ../../Library/OcAppleKernelLib/KextPatcher.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcAppleKernelLib/Link.c ../../Library/OcAppleKernelLib/LinkCache.c ../../Library/OcCryptoLib/Sha256.c ../../Library/OcAppleKernelLib/Vtables.c ../../Library/OcAppleKernelLib/KernelReader.c ../../Library/OcCompressionLib/lzss/lzss.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Tests/KernelTest/Lilu.c ../../Tests/KernelTest/Vsmc.c -o Prelinked
 
  for fuzzing:
- clang-mp-7.0 -DFUZZING_TEST=1 -g -fsanitize=undefined,address,fuzzer -Wno-incompatible-pointer-types-discards-qualifiers -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h Prelinked.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcMachoLib/CxxSymbols.c ../../Library/OcMachoLib/Header.c ../../Library/OcMachoLib/Relocations.c ../../Library/OcMachoLib/Symbols.c ../../Library/OcAppleKernelLib/PrelinkedContext.c ../../Library/OcAppleKernelLib/PrelinkedKext.c ../../Library/OcAppleKernelLib/KextPatcher.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcAppleKernelLib/Link.c ../../Library/OcAppleKernelLib/Vtables.c ../../Library/OcAppleKernelLib/KernelReader.c ../../Library/OcCompressionLib/lzss/lzss.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Tests/KernelTest/Lilu.c ../../Tests/KernelTest/Vsmc.c -o Prelinked
+ clang-mp-7.0 -DFUZZING_TEST=1 -g -fsanitize=undefined,address,fuzzer -Wno-incompatible-pointer-types-discards-qualifiers -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h Prelinked.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcMachoLib/CxxSymbols.c ../../Library/OcMachoLib/Header.c ../../Library/OcMachoLib/Relocations.c ../../Library/OcMachoLib/Symbols.c ../../Library/OcAppleKernelLib/PrelinkedContext.c ../../Library/OcAppleKernelLib/PrelinkedKext.c ../../Library/OcAppleKernelLib/KextPatcher.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcAppleKernelLib/Link.c ../../Library/OcAppleKernelLib/LinkCache.c ../../Library/OcCryptoLib/Sha256.c ../../Library/OcAppleKernelLib/Vtables.c ../../Library/OcAppleKernelLib/KernelReader.c ../../Library/OcCompressionLib/lzss/lzss.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Tests/KernelTest/Lilu.c ../../Tests/KernelTest/Vsmc.c -o Prelinked
  rm -rf DICT fuzz*.log ; mkdir DICT ; find /System/Library/Extensions/<< * >>/Contents/MacOS -type f -exec cp {} DICT \; UBSAN_OPTIONS='halt_on_error=1' ./Prelinked -jobs=4 DICT -rss_limit_mb=4096
 
  rm -rf Prelinked.dSYM DICT fuzz*.log Prelinked
 
- clang -DTEST_SLE=1 -g -O3 -fno-sanitize=undefined,address -Wno-incompatible-pointer-types-discards-qualifiers -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h Prelinked.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcMachoLib/CxxSymbols.c ../../Library/OcMachoLib/Header.c ../../Library/OcMachoLib/Relocations.c ../../Library/OcMachoLib/Symbols.c ../../Library/OcAppleKernelLib/PrelinkedContext.c ../../Library/OcAppleKernelLib/PrelinkedKext.c ../../Library/OcAppleKernelLib/KextPatcher.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcAppleKernelLib/Link.c ../../Library/OcAppleKernelLib/Vtables.c ../../Library/OcAppleKernelLib/KernelReader.c ../../Library/OcCompressionLib/lzss/lzss.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Tests/KernelTest/Lilu.c ../../Tests/KernelTest/Vsmc.c  -o Prelinked
+ clang -DTEST_SLE=1 -g -O3 -fno-sanitize=undefined,address -Wno-incompatible-pointer-types-discards-qualifiers -I../Include -I../../Include -I../../../MdePkg/Include/ -I../../../EfiPkg/Include/ -include ../Include/Base.h Prelinked.c ../../Library/OcXmlLib/OcXmlLib.c ../../Library/OcTemplateLib/OcTemplateLib.c ../../Library/OcSerializeLib/OcSerializeLib.c ../../Library/OcMiscLib/Base64Decode.c ../../Library/OcStringLib/OcAsciiLib.c ../../Library/OcMachoLib/CxxSymbols.c ../../Library/OcMachoLib/Header.c ../../Library/OcMachoLib/Relocations.c ../../Library/OcMachoLib/Symbols.c ../../Library/OcAppleKernelLib/PrelinkedContext.c ../../Library/OcAppleKernelLib/PrelinkedKext.c ../../Library/OcAppleKernelLib/KextPatcher.c ../../Library/OcMiscLib/DataPatcher.c ../../Library/OcAppleKernelLib/Link.c ../../Library/OcAppleKernelLib/LinkCache.c ../../Library/OcCryptoLib/Sha256.c ../../Library/OcAppleKernelLib/Vtables.c ../../Library/OcAppleKernelLib/KernelReader.c ../../Library/OcCompressionLib/lzss/lzss.c ../../Library/OcCompressionLib/lzvn/lzvn.c ../../Tests/KernelTest/Lilu.c ../../Tests/KernelTest/Vsmc.c  -o Prelinked
 
  for i in /System/Library/Extensions/<< * >>.kext ; do plist=$i/Contents/Info.plist ; kext="$i/Contents/MacOS/$(/usr/libexec/PlistBuddy -c 'Print CFBundleExecutable' "$plist")" ; echo "$kext $plist" ; ./Prelinked prelinkedkernel.unpack "$kext" "$plist" ; done
 
@@ -455,6 +455,218 @@ GetFileSize (
   return EFI_SUCCESS;
 }
 
+//
+// In-memory link cache file.
+//
+STATIC UINT8  *mLinkCacheFile;
+STATIC UINT32 mLinkCacheFileSize;
+STATIC UINT32 mLinkCacheWrites;
+
+EFI_STATUS
+SetFileData (
+  IN EFI_FILE_PROTOCOL  *WritableFs OPTIONAL,
+  IN CONST CHAR16       *FileName,
+  IN CONST VOID         *Buffer,
+  IN UINT32             Size
+  )
+{
+  ASSERT (WritableFs == &nilFilProtocol);
+
+  if (mLinkCacheFile != NULL) {
+    FreePool (mLinkCacheFile);
+  }
+
+  mLinkCacheFile = AllocateCopyPool (Size, Buffer);
+  if (mLinkCacheFile == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  mLinkCacheFileSize = Size;
+  ++mLinkCacheWrites;
+  return EFI_SUCCESS;
+}
+
+VOID *
+OcStorageReadFileUnicode (
+  IN  OC_STORAGE_CONTEXT               *Context,
+  IN  CONST CHAR16                     *FilePath,
+  OUT UINT32                           *FileSize OPTIONAL
+  )
+{
+  VOID  *Data;
+
+  if (mLinkCacheFile == NULL) {
+    return NULL;
+  }
+
+  Data = AllocateCopyPool (mLinkCacheFileSize, mLinkCacheFile);
+  if (Data != NULL && FileSize != NULL) {
+    *FileSize = mLinkCacheFileSize;
+  }
+
+  return Data;
+}
+
+/**
+  Inject Lilu and VirtualSMC, which depends on Lilu, into a copy of Kernel.
+
+  @param[in]  Kernel      Unpacked prelinkedkernel.
+  @param[in]  KernelSize  Kernel size.
+  @param[in]  AllocSize   Prelinked buffer size.
+  @param[in]  LinkCache   Use link cache.
+  @param[out] ResultSize  Resulting prelinkedkernel size.
+
+  @return  resulting prelinkedkernel or NULL.
+**/
+STATIC
+UINT8 *
+LinkCacheSession (
+  IN  CONST UINT8  *Kernel,
+  IN  UINT32       KernelSize,
+  IN  UINT32       AllocSize,
+  IN  BOOLEAN      LinkCache,
+  OUT UINT32       *ResultSize
+  )
+{
+  PRELINKED_CONTEXT   Context;
+  OC_STORAGE_CONTEXT  Storage;
+  EFI_STATUS          Status;
+  UINT8               *Result;
+
+  Result = AllocateZeroPool (AllocSize);
+  if (Result == NULL) {
+    return NULL;
+  }
+
+  CopyMem (Result, Kernel, KernelSize);
+
+  ZeroMem (&Storage, sizeof (Storage));
+  Storage.StorageRoot = &nilFilProtocol;
+
+  Status = PrelinkedContextInit (&Context, Result, KernelSize, AllocSize);
+  if (EFI_ERROR (Status)) {
+    FreePool (Result);
+    return NULL;
+  }
+
+  if (LinkCache) {
+    Status = PrelinkedLinkCacheLoad (&Context, &Storage, L"LinkCache.bin");
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = PrelinkedInjectPrepare (&Context);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = PrelinkedInjectKext (
+      &Context,
+      "/Library/Extensions/Lilu.kext",
+      LiluKextInfoPlistData,
+      LiluKextInfoPlistDataSize,
+      "Contents/MacOS/Lilu",
+      LiluKextData,
+      LiluKextDataSize
+      );
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = PrelinkedInjectKext (
+      &Context,
+      "/Library/Extensions/VirtualSMC.kext",
+      VsmcKextInfoPlistData,
+      VsmcKextInfoPlistDataSize,
+      "Contents/MacOS/VirtualSMC",
+      VsmcKextData,
+      VsmcKextDataSize
+      );
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = PrelinkedInjectComplete (&Context);
+  }
+
+  if (!EFI_ERROR (Status) && LinkCache) {
+    Status = PrelinkedLinkCacheSave (&Context, &Storage, L"LinkCache.bin");
+  }
+
+  *ResultSize = Context.PrelinkedSize;
+
+  PrelinkedContextFree (&Context);
+
+  if (EFI_ERROR (Status)) {
+    printf("Link cache session error %zx\n", Status);
+    FreePool (Result);
+    return NULL;
+  }
+
+  return Result;
+}
+
+/**
+  Check that link cache is saved, loaded, and replayed with the same result
+  as linking without link cache.
+
+  @param[in]  Kernel      Unpacked prelinkedkernel.
+  @param[in]  KernelSize  Kernel size.
+  @param[in]  AllocSize   Prelinked buffer size.
+
+  @return  TRUE on success.
+**/
+STATIC
+BOOLEAN
+TestLinkCache (
+  IN CONST UINT8  *Kernel,
+  IN UINT32       KernelSize,
+  IN UINT32       AllocSize
+  )
+{
+  UINT8    *Plain;
+  UINT8    *Recorded;
+  UINT8    *Replayed;
+  UINT32   PlainSize;
+  UINT32   RecordedSize;
+  UINT32   ReplayedSize;
+  UINT32   Writes;
+  BOOLEAN  Success;
+
+  mLinkCacheFile     = NULL;
+  mLinkCacheFileSize = 0;
+  mLinkCacheWrites   = 0;
+
+  Plain    = LinkCacheSession (Kernel, KernelSize, AllocSize, FALSE, &PlainSize);
+  Recorded = LinkCacheSession (Kernel, KernelSize, AllocSize, TRUE, &RecordedSize);
+  Writes   = mLinkCacheWrites;
+  Replayed = LinkCacheSession (Kernel, KernelSize, AllocSize, TRUE, &ReplayedSize);
+
+  //
+  // Recording session writes the cache, replay session must reuse it fully
+  // and thus write nothing.
+  //
+  Success = Plain != NULL && Recorded != NULL && Replayed != NULL
+    && Writes == 1 && mLinkCacheWrites == 1
+    && PlainSize == RecordedSize && PlainSize == ReplayedSize
+    && CompareMem (Plain, Recorded, PlainSize) == 0
+    && CompareMem (Plain, Replayed, PlainSize) == 0;
+
+  printf ("Link cache round trip %s (%u writes)\n", Success ? "passed" : "failed", mLinkCacheWrites);
+
+  if (Plain != NULL) {
+    FreePool (Plain);
+  }
+  if (Recorded != NULL) {
+    FreePool (Recorded);
+  }
+  if (Replayed != NULL) {
+    FreePool (Replayed);
+  }
+  if (mLinkCacheFile != NULL) {
+    FreePool (mLinkCacheFile);
+    mLinkCacheFile = NULL;
+  }
+
+  return Success;
+}
+
 int wrap_main(int argc, char** argv) {
   UINT32 AllocSize;
   PRELINKED_CONTEXT Context;
@@ -498,6 +710,16 @@ int wrap_main(int argc, char** argv) {
   ApplyKernelPatches (Prelinked, PrelinkedSize);
 #endif
 
+#ifndef TEST_SLE
+  UINT8 *OrigPrelinked = AllocateCopyPool (PrelinkedSize, Prelinked);
+  UINT32 OrigPrelinkedSize = PrelinkedSize;
+  if (OrigPrelinked == NULL) {
+    printf("Copy fail\n");
+    abort();
+    return -1;
+  }
+#endif
+
   EFI_STATUS Status = PrelinkedContextInit (&Context, Prelinked, PrelinkedSize, AllocSize);
 
   if (!EFI_ERROR (Status)) {
@@ -610,6 +832,11 @@ int wrap_main(int argc, char** argv) {
     printf("Context creation error %zx\n", Status);
   }
 
+#ifndef TEST_SLE
+  TestLinkCache (OrigPrelinked, OrigPrelinkedSize, AllocSize);
+  FreePool (OrigPrelinked);
+#endif
+
   free(Prelinked);
 
   return 0;
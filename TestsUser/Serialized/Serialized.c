@@ -16,6 +16,7 @@
 #include <Library/OcSerializeLib.h>
 #include <Library/OcMiscLib.h>
 #include <Library/OcConfigurationLib.h>
+#include <Library/OcXmlLib.h>
 
 #include <sys/time.h>
 
@@ -57,7 +58,554 @@ uint8_t *readFile(const char *str, uint32_t *size) {
   return string;
 }
 
+//
+// Checks PlistDictFind on a dictionary with PairCount unique keys followed by
+// a duplicate of the first key, before and after appending new pairs.
+//
+int testDictFind(uint32_t PairCount) {
+  char *b = malloc(64 + (PairCount + 1) * 48);
+  int   l = sprintf(b, "<plist><dict>");
+
+  for (uint32_t i = 0; i < PairCount; i++)
+    l += sprintf(b + l, "<key>k%u</key><integer>%u</integer>", i, i);
+  l += sprintf(b + l, "<key>k0</key><integer>%u</integer></dict></plist>", PairCount);
+
+  XML_DOCUMENT *Doc = XmlDocumentParse(b, l, FALSE);
+  XML_NODE     *Dict = Doc != NULL ? PlistDocumentRoot(Doc) : NULL;
+  if (Dict == NULL) {
+    printf("DictFind %u: parse fail\n", PairCount);
+    free(b);
+    return -1;
+  }
+
+  int   r = 0;
+  char  k[16];
+  UINT32 v;
+
+  for (int pass = 0; pass < 2 && r == 0; pass++) {
+    for (uint32_t i = 0; i < PairCount; i++) {
+      sprintf(k, "k%u", i);
+      if (!PlistIntegerValue(PlistDictFind(Dict, k), &v, sizeof(v), FALSE) || v != i) {
+        printf("DictFind %u: %s mismatch\n", PairCount, k);
+        r = -1;
+      }
+    }
+
+    if (PlistDictFind(Dict, "missing") != NULL || PlistDictFind(Dict, "") != NULL) {
+      printf("DictFind %u: found missing key\n", PairCount);
+      r = -1;
+    }
+
+    //
+    // Appending must invalidate the key index.
+    //
+    if (pass == 0) {
+      XmlNodeAppend(Dict, "key", NULL, "appended");
+      XmlNodeAppend(Dict, "integer", NULL, "1000");
+      XmlNodeAppend(Dict, "key", NULL, "k1");
+      XmlNodeAppend(Dict, "integer", NULL, "1001");
+      if (!PlistIntegerValue(PlistDictFind(Dict, "appended"), &v, sizeof(v), FALSE) || v != 1000) {
+        printf("DictFind %u: appended key mismatch\n", PairCount);
+        r = -1;
+      }
+    }
+  }
+
+  XmlDocumentFree(Doc);
+  free(b);
+  return r;
+}
+
+//
+// Binary plist dictionary with every supported scalar type, including
+// UTF-16 strings with paired and unpaired surrogates, and 1 to 16 byte integers.
+//
+STATIC CONST UINT8 mBplistValid[] = {
+  0x62, 0x70, 0x6C, 0x69, 0x73, 0x74, 0x30, 0x30, 0xDC, 0x01, 0x02, 0x03,
+  0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x55, 0x41, 0x73,
+  0x63, 0x69, 0x69, 0x57, 0x55, 0x6E, 0x69, 0x63, 0x6F, 0x64, 0x65, 0x54,
+  0x4C, 0x6F, 0x6E, 0x65, 0x54, 0x49, 0x6E, 0x74, 0x38, 0x55, 0x49, 0x6E,
+  0x74, 0x31, 0x36, 0x55, 0x49, 0x6E, 0x74, 0x33, 0x32, 0x55, 0x49, 0x6E,
+  0x74, 0x36, 0x34, 0x56, 0x49, 0x6E, 0x74, 0x31, 0x32, 0x38, 0x54, 0x44,
+  0x61, 0x74, 0x61, 0x54, 0x54, 0x72, 0x75, 0x65, 0x55, 0x46, 0x61, 0x6C,
+  0x73, 0x65, 0x55, 0x41, 0x72, 0x72, 0x61, 0x79, 0x53, 0x61, 0x62, 0x63,
+  0x64, 0x00, 0xE9, 0x20, 0xAC, 0xD8, 0x3D, 0xDE, 0x00, 0x64, 0xD8, 0x00,
+  0x00, 0x41, 0xDC, 0x00, 0xD8, 0x3D, 0x10, 0x7F, 0x11, 0x12, 0x34, 0x12,
+  0x12, 0x34, 0x56, 0x78, 0x13, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFE, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x44, 0xDE, 0xAD, 0xBE, 0xEF, 0x09,
+  0x08, 0xA2, 0x10, 0x0D, 0x00, 0x08, 0x00, 0x21, 0x00, 0x27, 0x00, 0x2F,
+  0x00, 0x34, 0x00, 0x39, 0x00, 0x3F, 0x00, 0x45, 0x00, 0x4B, 0x00, 0x52,
+  0x00, 0x57, 0x00, 0x5C, 0x00, 0x62, 0x00, 0x68, 0x00, 0x6C, 0x00, 0x75,
+  0x00, 0x7E, 0x00, 0x80, 0x00, 0x83, 0x00, 0x88, 0x00, 0x91, 0x00, 0xA2,
+  0x00, 0xA7, 0x00, 0xA8, 0x00, 0xA9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xAC,
+};
+
+//
+// Malformed binary plists, containers must be reported as having no children.
+//
+STATIC CONST UINT8 mBplistShared[] = {
+  0x62, 0x70, 0x6C, 0x69, 0x73, 0x74, 0x30, 0x30, 0xA2, 0x01, 0x01, 0xA0,
+  0x00, 0x08, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C,
+};
+
+STATIC CONST UINT8 mBplistCycle[] = {
+  0x62, 0x70, 0x6C, 0x69, 0x73, 0x74, 0x30, 0x30, 0xA1, 0x00, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0A,
+};
+
+STATIC CONST UINT8 mBplistIntKey[] = {
+  0x62, 0x70, 0x6C, 0x69, 0x73, 0x74, 0x30, 0x30, 0xD1, 0x01, 0x02, 0x10,
+  0x01, 0x10, 0x02, 0x00, 0x08, 0x00, 0x0B, 0x00, 0x0D, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0F,
+};
+
+STATIC CONST UINT8 mBplistUid[] = {
+  0x62, 0x70, 0x6C, 0x69, 0x73, 0x74, 0x30, 0x30, 0xA1, 0x01, 0x80, 0x01,
+  0x00, 0x08, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C,
+};
+
+int testBplistSample(const UINT8 *Data, uint32_t Size, int Valid) {
+  char *b = malloc(Size);
+  memcpy(b, Data, Size);
+
+  XML_DOCUMENT *Doc = XmlDocumentParse(b, Size, FALSE);
+  if (Doc == NULL) {
+    free(b);
+    return Valid ? -1 : 0;
+  }
+
+  XML_NODE *Root = PlistDocumentRoot(Doc);
+  int      r     = 0;
+
+  if (!Valid) {
+    if (Root != NULL && XmlNodeChildren(Root) != 0) {
+      r = -1;
+    }
+    XmlDocumentFree(Doc);
+    free(b);
+    return r;
+  }
+
+  char    s[32];
+  UINT8   d[8];
+  UINT64  v;
+  UINT32  sz;
+  BOOLEAN t;
+
+  #define BPLIST_CHECK(x) do { if (!(x)) { printf("Bplist check failed: %s\n", #x); r = -1; } } while (0)
+
+  BPLIST_CHECK(PlistNodeCast(Root, PLIST_NODE_TYPE_DICT) != NULL && PlistDictChildren(Root) == 12);
+
+  sz = sizeof(s);
+  BPLIST_CHECK(PlistStringValue(PlistDictFind(Root, "Ascii"), s, &sz) && sz == 4 && strcmp(s, "abc") == 0);
+  BPLIST_CHECK(PlistStringSize(PlistDictFind(Root, "Unicode"), &sz) && sz == 10);
+  BPLIST_CHECK(strcmp(XmlNodeContent(PlistDictFind(Root, "Unicode")), "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80") == 0);
+  BPLIST_CHECK(strcmp(XmlNodeContent(PlistDictFind(Root, "Lone")), "\xEF\xBF\xBD" "A" "\xEF\xBF\xBD\xEF\xBF\xBD") == 0);
+
+  BPLIST_CHECK(PlistIntegerValue(PlistDictFind(Root, "Int8"), &v, sizeof(v), FALSE) && v == 0x7F);
+  BPLIST_CHECK(PlistIntegerValue(PlistDictFind(Root, "Int16"), &v, sizeof(v), FALSE) && v == 0x1234);
+  BPLIST_CHECK(PlistIntegerValue(PlistDictFind(Root, "Int32"), &v, sizeof(v), FALSE) && v == 0x12345678);
+  BPLIST_CHECK(PlistIntegerValue(PlistDictFind(Root, "Int64"), &v, sizeof(v), FALSE) && v == 0xFFFFFFFFFFFFFFFEULL);
+  BPLIST_CHECK(strcmp(XmlNodeContent(PlistDictFind(Root, "Int64")), "-2") == 0);
+  BPLIST_CHECK(PlistIntegerValue(PlistDictFind(Root, "Int128"), &v, sizeof(v), FALSE) && v == 0xFFFFFFFFFFFFFFFFULL);
+  BPLIST_CHECK(strcmp(XmlNodeContent(PlistDictFind(Root, "Int128")), "18446744073709551615") == 0);
+
+  sz = sizeof(d);
+  BPLIST_CHECK(PlistDataValue(PlistDictFind(Root, "Data"), d, &sz) && sz == 4 && memcmp(d, "\xDE\xAD\xBE\xEF", 4) == 0);
+  sz = sizeof(d);
+  BPLIST_CHECK(PlistMetaDataValue(PlistDictFind(Root, "Int16"), d, &sz) && sz == 4 && memcmp(d, "\x34\x12\x00\x00", 4) == 0);
+
+  BPLIST_CHECK(PlistBooleanValue(PlistDictFind(Root, "True"), &t) && t);
+  BPLIST_CHECK(PlistBooleanValue(PlistDictFind(Root, "False"), &t) && !t);
+
+  XML_NODE *Array = PlistNodeCast(PlistDictFind(Root, "Array"), PLIST_NODE_TYPE_ARRAY);
+  BPLIST_CHECK(Array != NULL && XmlNodeChildren(Array) == 2);
+  if (Array != NULL && XmlNodeChildren(Array) == 2) {
+    BPLIST_CHECK(PlistIntegerValue(XmlNodeChild(Array, 0), &v, sizeof(v), FALSE) && v == 0x7F);
+    BPLIST_CHECK(strcmp(XmlNodeContent(XmlNodeChild(Array, 1)), "abc") == 0);
+  }
+
+  #undef BPLIST_CHECK
+
+  XmlDocumentFree(Doc);
+  free(b);
+  return r;
+}
+
+//
+// Calls every accessor on every node, used for fuzzing XML and binary plists.
+//
+void fuzzPlistNode(XML_NODE *Node) {
+  char     s[64];
+  UINT8    d[64];
+  UINT64   v;
+  UINT32   sz;
+  BOOLEAN  t;
+
+  XmlNodeName(Node);
+  const char *c = XmlNodeContent(Node);
+  if (c != NULL) {
+    (void) strlen(c);
+  }
+
+  PlistIntegerValue(Node, &v, sizeof(v), FALSE);
+  PlistIntegerValue(Node, &v, sizeof(v), TRUE);
+  PlistBooleanValue(Node, &t);
+  PlistStringSize(Node, &sz);
+  PlistDataSize(Node, &sz);
+  sz = sizeof(s);
+  PlistStringValue(Node, s, &sz);
+  sz = sizeof(d);
+  PlistDataValue(Node, d, &sz);
+  sz = sizeof(d);
+  PlistMetaDataValue(Node, d, &sz);
+
+  if (PlistNodeCast(Node, PLIST_NODE_TYPE_DICT) != NULL) {
+    UINT32 n = PlistDictChildren(Node);
+    for (UINT32 i = 0; i < n; i++) {
+      const char *k = PlistKeyValue(PlistDictChild(Node, i, NULL));
+      if (k != NULL) {
+        PlistDictFind(Node, k);
+      }
+    }
+    PlistDictFind(Node, "missing");
+  }
+
+  UINT32 n = XmlNodeChildren(Node);
+  for (UINT32 i = 0; i < n; i++) {
+    fuzzPlistNode(XmlNodeChild(Node, i));
+  }
+}
+
+void fuzzPlist(const UINT8 *Data, UINTN Size) {
+  if (Size > MAX_UINT32) {
+    return;
+  }
+
+  char *b = malloc(Size + 1);
+  if (b == NULL) {
+    return;
+  }
+  memcpy(b, Data, Size);
+  b[Size] = '\0';
+
+  XML_DOCUMENT *Doc = XmlDocumentParse(b, (UINT32) Size, TRUE);
+  if (Doc != NULL) {
+    XML_NODE *Root = PlistDocumentRoot(Doc);
+    if (Root != NULL) {
+      fuzzPlistNode(Root);
+    }
+    XmlDocumentFree(Doc);
+  }
+
+  free(b);
+}
+
+//
+// Runs the fuzzer body over all truncations and single byte mutations of the sample.
+//
+void fuzzPlistSample(const UINT8 *Data, uint32_t Size) {
+  UINT8 *b = malloc(Size);
+  memcpy(b, Data, Size);
+
+  for (uint32_t i = 0; i <= Size; i++) {
+    fuzzPlist(b, i);
+  }
+
+  for (uint32_t i = 0; i < Size; i++) {
+    for (uint32_t j = 0; j < 8; j++) {
+      b[i] ^= 1U << j;
+      fuzzPlist(b, Size);
+      b[i] ^= 1U << j;
+    }
+    b[i] = 0xFF;
+    fuzzPlist(b, Size);
+    b[i] = Data[i];
+  }
+
+  free(b);
+}
+
+int testBplist(void) {
+  if (testBplistSample(mBplistValid, sizeof(mBplistValid), 1) != 0
+    || testBplistSample(mBplistShared, sizeof(mBplistShared), 0) != 0
+    || testBplistSample(mBplistCycle, sizeof(mBplistCycle), 0) != 0
+    || testBplistSample(mBplistIntKey, sizeof(mBplistIntKey), 0) != 0
+    || testBplistSample(mBplistUid, sizeof(mBplistUid), 0) != 0) {
+    return -1;
+  }
+
+  //
+  // Truncated trailer must be rejected.
+  //
+  char *b = malloc(sizeof(mBplistValid));
+  memcpy(b, mBplistValid, sizeof(mBplistValid));
+  for (uint32_t i = 1; i <= 32; i++) {
+    XML_DOCUMENT *Doc = XmlDocumentParse(b, sizeof(mBplistValid) - i, FALSE);
+    if (Doc != NULL) {
+      printf("Bplist truncated by %u parsed\n", i);
+      XmlDocumentFree(Doc);
+      free(b);
+      return -1;
+    }
+  }
+  free(b);
+
+  fuzzPlistSample(mBplistValid, sizeof(mBplistValid));
+  fuzzPlistSample(mBplistShared, sizeof(mBplistShared));
+  fuzzPlistSample(mBplistCycle, sizeof(mBplistCycle));
+  fuzzPlistSample(mBplistIntKey, sizeof(mBplistIntKey));
+  fuzzPlistSample(mBplistUid, sizeof(mBplistUid));
+
+  return 0;
+}
+
+//
+// XML plists for lazy and eager parsing comparison.
+//
+STATIC CONST CHAR8 *mLazyDocuments[] = {
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+  "<plist version=\"1.0\">\n"
+  "<dict>\n"
+  "\t<!-- Comment before key -->\n"
+  "\t<key>Array</key>\n"
+  "\t<array>\n"
+  "\t\t<integer ID=\"0\" size=\"64\">0x10</integer>\n"
+  "\t\t<string ID=\"1\">Shared</string>\n"
+  "\t\t<dict ID=\"2\"/>\n"
+  "\t\t<dict>\n"
+  "\t\t\t<key>Nested</key>\n"
+  "\t\t\t<array><integer IDREF=\"0\" size=\"64\"/><string IDREF=\"1\"/><dict IDREF=\"2\"/></array>\n"
+  "\t\t\t<!-- Comment inside dict -->\n"
+  "\t\t\t<key>Empty</key><array/>\n"
+  "\t\t</dict>\n"
+  "\t\t<array><array><array><true/><false/></array></array></array>\n"
+  "\t</array>\n"
+  "\t<key>Data</key>\n"
+  "\t<data>AAECAw==</data>\n"
+  "\t<key>Entities</key>\n"
+  "\t<string>&lt;a&gt; &amp; b</string>\n"
+  "\t<key>Text</key>\n"
+  "\t<string></string>\n"
+  "</dict>\n"
+  "</plist>\n",
+
+  "<plist><array><dict><key>a</key><integer ID=\"5\">1</integer></dict>"
+  "<dict><key>b</key><integer IDREF=\"5\"/></dict><!----></array></plist>",
+};
+
+int compareXmlNodes(XML_NODE *A, XML_NODE *B) {
+  if (strcmp(XmlNodeName(A), XmlNodeName(B)) != 0) {
+    return -1;
+  }
+
+  const char *x = XmlNodeContent(A);
+  const char *y = XmlNodeContent(B);
+  if ((x == NULL) != (y == NULL) || (x != NULL && strcmp(x, y) != 0)) {
+    return -1;
+  }
+
+  UINT32 n = XmlNodeChildren(A);
+  if (n != XmlNodeChildren(B)) {
+    return -1;
+  }
+
+  for (UINT32 i = 0; i < n; i++) {
+    if (compareXmlNodes(XmlNodeChild(A, i), XmlNodeChild(B, i)) != 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+//
+// Accesses every other child, leaving the rest unparsed.
+//
+void touchXmlNodes(XML_NODE *Node, UINT32 Depth) {
+  UINT32 n = XmlNodeChildren(Node);
+  for (UINT32 i = Depth % 2; i < n; i += 2) {
+    touchXmlNodes(XmlNodeChild(Node, i), Depth + 1);
+  }
+}
+
+XML_DOCUMENT *parseXmlCopy(const char *Data, uint32_t Size, BOOLEAN Lazy, BOOLEAN WithRefs, char **Copy) {
+  *Copy = malloc(Size + 1);
+  memcpy(*Copy, Data, Size);
+  (*Copy)[Size] = '\0';
+  return Lazy ? XmlDocumentParseLazy(*Copy, Size, WithRefs) : XmlDocumentParse(*Copy, Size, WithRefs);
+}
+
+//
+// Exports the lazy document, parses the result eagerly and checks
+// that the export of it matches the export of the eager document.
+//
+int compareLazyExport(XML_DOCUMENT *Lazy, const char *Expected, uint32_t ExpectedSize, BOOLEAN WithRefs) {
+  UINT32 l;
+  char   *e = XmlDocumentExport(Lazy, &l, 0);
+  if (e == NULL || strlen(e) != l) {
+    free(e);
+    return -1;
+  }
+
+  XML_DOCUMENT *Doc = XmlDocumentParse(e, l, WithRefs);
+  int          r    = -1;
+  if (Doc != NULL) {
+    UINT32 rl;
+    char   *re = XmlDocumentExport(Doc, &rl, 0);
+    if (re != NULL && rl == ExpectedSize && memcmp(re, Expected, rl) == 0) {
+      r = 0;
+    }
+    free(re);
+    XmlDocumentFree(Doc);
+  }
+
+  free(e);
+  return r;
+}
+
+int testLazyDocument(const char *Data, uint32_t Size, BOOLEAN WithRefs) {
+  char *eb, *lb1, *lb2, *lb3;
+  int  r = -1;
+
+  XML_DOCUMENT *Eager = parseXmlCopy(Data, Size, FALSE, WithRefs, &eb);
+  XML_DOCUMENT *Lazy1 = parseXmlCopy(Data, Size, TRUE, WithRefs, &lb1);
+  XML_DOCUMENT *Lazy2 = parseXmlCopy(Data, Size, TRUE, WithRefs, &lb2);
+  XML_DOCUMENT *Lazy3 = parseXmlCopy(Data, Size, TRUE, WithRefs, &lb3);
+
+  UINT32 el, ll, ek, lk;
+  char   *e  = Eager != NULL ? XmlDocumentExport(Eager, &el, 0) : NULL;
+  char   *ek1 = Eager != NULL ? XmlDocumentExport(Eager, &ek, 1) : NULL;
+
+  if (e == NULL || ek1 == NULL || Lazy1 == NULL || Lazy2 == NULL || Lazy3 == NULL) {
+    printf("Lazy parse fail\n");
+  } else if (compareLazyExport(Lazy1, e, el, WithRefs) != 0) {
+    printf("Lazy untouched export mismatch\n");
+  } else if ((touchXmlNodes(XmlDocumentRoot(Lazy2), 0), compareLazyExport(Lazy2, e, el, WithRefs)) != 0) {
+    printf("Lazy partial export mismatch\n");
+  } else if (compareXmlNodes(XmlDocumentRoot(Eager), XmlDocumentRoot(Lazy3)) != 0) {
+    printf("Lazy tree mismatch\n");
+  } else {
+    //
+    // Fully parsed lazy document must export exactly like the eager one.
+    //
+    char *l  = XmlDocumentExport(Lazy3, &ll, 0);
+    char *lk1 = XmlDocumentExport(Lazy3, &lk, 1);
+    if (l != NULL && ll == el && memcmp(l, e, el) == 0
+      && lk1 != NULL && lk == ek && memcmp(lk1, ek1, ek) == 0) {
+      r = 0;
+    } else {
+      printf("Lazy full export mismatch\n");
+    }
+    free(l);
+    free(lk1);
+  }
+
+  free(e);
+  free(ek1);
+  if (Eager != NULL) XmlDocumentFree(Eager);
+  if (Lazy1 != NULL) XmlDocumentFree(Lazy1);
+  if (Lazy2 != NULL) XmlDocumentFree(Lazy2);
+  if (Lazy3 != NULL) XmlDocumentFree(Lazy3);
+  free(eb);
+  free(lb1);
+  free(lb2);
+  free(lb3);
+  return r;
+}
+
+//
+// XML plists only accepted by lazy parsing until the malformed subtree is accessed.
+// Once it fails to parse, the document refuses to export.
+//
+STATIC CONST CHAR8 *mLazyOnlyDocuments[] = {
+  "<plist><dict><key>a</key><array>text<string>x</string></array></dict></plist>",
+  "<plist><dict><key>a</key><true/><!-- Comment <inside> dict --></dict></plist>",
+  "<plist><array><true/><array><string>x</string>y</array></array></plist>",
+};
+
+int testLazyOnlyDocument(const char *Data) {
+  char   *b;
+  char   *e;
+  UINT32 l;
+  int    r = -1;
+
+  XML_DOCUMENT *Doc = parseXmlCopy(Data, strlen(Data), FALSE, TRUE, &b);
+  free(b);
+  if (Doc != NULL) {
+    XmlDocumentFree(Doc);
+    return -1;
+  }
+
+  //
+  // Not accessed children are exported as is.
+  //
+  Doc = parseXmlCopy(Data, strlen(Data), TRUE, TRUE, &b);
+  if (Doc != NULL) {
+    e = XmlDocumentExport(Doc, &l, 0);
+    if (e != NULL && strcmp(e, Data) == 0 && !XmlDocumentLazyFailed(Doc)) {
+      free(e);
+      touchXmlNodes(XmlDocumentRoot(Doc), 0);
+      touchXmlNodes(XmlDocumentRoot(Doc), 1);
+      e = XmlDocumentExport(Doc, &l, 0);
+      if (e == NULL && XmlDocumentLazyFailed(Doc)) {
+        r = 0;
+      }
+    }
+    free(e);
+    XmlDocumentFree(Doc);
+  }
+  free(b);
+
+  return r;
+}
+
+int testLazy(void) {
+  for (uint32_t i = 0; i < ARRAY_SIZE(mLazyDocuments); i++) {
+    if (testLazyDocument(mLazyDocuments[i], strlen(mLazyDocuments[i]), FALSE) != 0
+      || testLazyDocument(mLazyDocuments[i], strlen(mLazyDocuments[i]), TRUE) != 0) {
+      printf("Lazy document %u failed\n", i);
+      return -1;
+    }
+  }
+
+  for (uint32_t i = 0; i < ARRAY_SIZE(mLazyOnlyDocuments); i++) {
+    if (testLazyOnlyDocument(mLazyOnlyDocuments[i]) != 0) {
+      printf("Lazy only document %u failed\n", i);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
 int main(int argc, char** argv) {
+  //
+  // Key index is only built from XML_DICT_INDEX_MIN_PAIRS (8) pairs.
+  //
+  if (testDictFind(1) != 0 || testDictFind(6) != 0 || testDictFind(7) != 0
+    || testDictFind(8) != 0 || testDictFind(64) != 0) {
+    return -1;
+  }
+
+  if (testBplist() != 0 || testLazy() != 0) {
+    return -1;
+  }
+
   uint32_t f;
   uint8_t *b;
   if ((b = readFile(argc > 1 ? argv[1] : "Serialized.plist", &f)) == NULL) {
@@ -65,6 +613,11 @@ int main(int argc, char** argv) {
     return -1;
   }
 
+  if (argc <= 1 && testLazyDocument((char *) b, f, TRUE) != 0) {
+    free(b);
+    return -1;
+  }
+
   long long a = current_timestamp();
 
   OC_GLOBAL_CONFIG   Config;
@@ -80,6 +633,8 @@ int main(int argc, char** argv) {
 }
 
 INT32 LLVMFuzzerTestOneInput(CONST UINT8 *Data, UINTN Size) {
+  fuzzPlist(Data, Size);
+
   VOID *NewData = AllocatePool (Size);
   if (NewData) {
     CopyMem (NewData, Data, Size);